@@ -289,6 +289,9 @@ typedef uint32_t aom_codec_frame_flags_t;
 /*!\brief frame can be dropped without affecting the stream (no future frame
  * depends on this one) */
 #define AOM_FRAME_IS_DROPPABLE 0x2u
+/*!\brief this packet holds part of a frame and more packets of the frame
+ * follow, see AV1E_SET_TILE_GROUP_OUTPUT */
+#define AOM_FRAME_IS_FRAGMENT 0x8u
 /*!\brief this is an INTRA_ONLY frame */
 #define AOM_FRAME_IS_INTRAONLY 0x10u
 /*!\brief this is an S-frame */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AOM_AOM_THREAD_POOL_H_
+#define AOM_AOM_AOM_THREAD_POOL_H_
+
+/*!\file
+ * \brief Describes the thread pool that can be shared by several codec
+ * instances.
+ *
+ * By default each encoder or decoder instance starts its own worker threads.
+ * An application running many instances in one process can instead create a
+ * single pool and attach it to all of them with the AV1E_SET_THREAD_POOL and
+ * AV1D_SET_THREAD_POOL controls. The instances then queue their work on the
+ * threads of the pool, which serve it in the order it was submitted,
+ * whichever instance submitted it: an instance with a lot of queued work
+ * delays the work other instances submit after it. The number of threads an
+ * instance splits its work into is still set by g_threads (encoder) or
+ * threads (decoder).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!\brief Opaque thread pool
+ */
+typedef struct aom_thread_pool aom_thread_pool_t;
+
+/*!\brief Creates a thread pool.
+ *
+ * \param[in] num_threads  Number of threads of the pool, must be positive.
+ *
+ * \return A new pool, or NULL on error or if the library was built without
+ * multithreading support.
+ */
+aom_thread_pool_t *aom_thread_pool_create(int num_threads);
+
+/*!\brief Stops the threads of a pool and frees it.
+ *
+ * All the codec instances the pool is attached to must have been destroyed
+ * first.
+ *
+ * \param[in] pool  Pool returned by aom_thread_pool_create(), may be NULL.
+ */
+void aom_thread_pool_destroy(aom_thread_pool_t *pool);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AOM_AOM_AOM_THREAD_POOL_H_
@@ -20,6 +20,8 @@
 #include "aom/aom_encoder.h"
 #include "aom/aom_ext_ratectrl.h"
 #include "aom/aom_external_partition.h"
+#include "aom/aom_frame_buffer.h"
+#include "aom/aom_thread_pool.h"
 
 /*!\file
  * \brief Provides definitions for using AOM or AV1 encoder algorithm within the
@@ -1656,6 +1658,155 @@ enum aome_enc_control_id {
    */
   AV1E_SET_MODE_REF_DELTA_ENABLED = 176,
 
+  /*!\brief Codec control function to set how threads working on adjacent
+   * rows wait for each other's progress with row based multi-threading,
+   * unsigned int parameter
+   *
+   * - 0 = lock a mutex around every progress update (default)
+   * - 1 = publish progress atomically; waiting threads spin briefly before
+   *       blocking, so the common short waits avoid locking entirely
+   *
+   * The encoded output does not depend on this setting.
+   */
+  AV1E_SET_ROW_MT_SYNC_MODE = 177,
+
+  /*!\brief Codec control function to run the encoder threads on a thread
+   * pool owned by the application, aom_thread_pool_t* parameter
+   *
+   * The encoder queues the work it would otherwise give to its own g_threads
+   * - 1 threads on the pool, which may be shared with other encoder and
+   * decoder instances. The pool must outlive the encoder. NULL (default)
+   * means the encoder starts its own threads.
+   *
+   * \note Must be called before the first call to aom_codec_encode().
+   */
+  AV1E_SET_THREAD_POOL = 178,
+
+  /*!\brief Codec control function to get statistics of the scratch buffers
+   * the encoder allocates for each frame, aom_scratch_mem_stats_t* parameter
+   *
+   * These buffers are recycled from frame to frame, so once the encoder has
+   * reached a steady state num_heap_allocs stops increasing while num_allocs
+   * keeps growing.
+   */
+  AV1E_GET_SCRATCH_MEM_STATS = 179,
+
+  /*!\brief Codec control function to get the memory held by the main
+   * subsystems of the encoder, aom_memory_usage_t* parameter
+   */
+  AV1E_GET_MEMORY_USAGE = 180,
+
+  /*!\brief Codec control function to set a memory budget for the encoder in
+   * MiB, unsigned int parameter
+   *
+   * The budget covers the memory reported by AV1E_GET_MEMORY_USAGE. If the
+   * configuration does not fit in it, the encoder first uses fewer threads,
+   * then disables the TPL model and finally reduces g_lag_in_frames (the lag
+   * cannot be reduced when lookahead processing (LAP) is enabled). The control
+   * fails if the budget cannot be met even so. Allocations that would exceed
+   * the budget later on fail with AOM_CODEC_MEM_ERROR.
+   *
+   * - 0 = no budget (default)
+   *
+   * \note Must be called before the first call to aom_codec_encode(), after
+   * the configuration has been set.
+   */
+  AV1E_SET_MEMORY_BUDGET = 181,
+
+  /*!\brief Codec control function to make the encoder reference the source
+   * images instead of copying them, aom_source_frame_cb_t* parameter
+   *
+   * In this zero-copy mode each image passed to aom_codec_encode() is owned
+   * by the encoder until it calls the release callback with the user_priv of
+   * the image. The encoder holds up to about g_lag_in_frames images at a
+   * time. The images must:
+   * - be in a planar format (not AOM_IMG_FMT_NV12),
+   * - have the pointer and stride of the Y plane aligned to 32 bytes and those
+   *   of the U and V planes aligned to 16 bytes,
+   * - have a border of at least the value returned by AV1E_GET_SOURCE_BORDER
+   *   on all four sides,
+   * as images allocated by aom_img_alloc_with_border() with an alignment of
+   * 32 and that border are. The encoder writes into the border of the
+   * images. The application must not modify an image until it is released.
+   * Images refused by aom_codec_encode() with an error are not taken.
+   *
+   * \note Must be called before the first call to aom_codec_encode().
+   */
+  AV1E_SET_SOURCE_FRAME_CB = 182,
+
+  /*!\brief Codec control function to get the border in pixels the source
+   * images need in zero-copy mode, int* parameter
+   *
+   * The border depends on the configuration, so it must be queried after the
+   * configuration is final.
+   */
+  AV1E_GET_SOURCE_BORDER = 183,
+
+  /*!\brief Codec control function to set the functions the encoder gets the
+   * memory of its reference and reconstructed frames from,
+   * aom_frame_buffer_functions_t* parameter
+   *
+   * This is the encoder counterpart of aom_codec_set_frame_buffer_functions()
+   * and the callbacks follow the same rules. Unlike the decoder, the encoder
+   * keeps a frame buffer across frames: a buffer is only released when a
+   * larger one is needed, e.g. after a switch to a higher resolution, and
+   * when the encoder is destroyed. The callbacks may be called from the
+   * worker threads of the encoder, but never concurrently.
+   *
+   * \note Must be called before the first call to aom_codec_encode().
+   */
+  AV1E_SET_FRAME_BUFFER_FUNCTIONS = 184,
+
+  /*!\brief Codec control function to place the large buffers of the encoder
+   * in huge pages, int parameter
+   *
+   * The frame buffers, the lookahead and the TPL model buffers of at least
+   * 2 MiB are then mapped on 2 MiB boundaries, which reduces the TLB misses
+   * of motion search on large frames. Only supported on Linux.
+   *
+   * - 0 = regular pages (default)
+   * - 1 = transparent huge pages
+   * - 2 = explicit huge pages reserved by the system administrator, with
+   *       transparent huge pages as fallback
+   *
+   * \note Only affects buffers allocated after the call, so it should be
+   * called before the first call to aom_codec_encode().
+   */
+  AV1E_SET_HUGE_PAGES = 185,
+
+  /*!\brief Codec control function to deliver each tile group of a frame in
+   * its own packet, unsigned int parameter
+   *
+   * When enabled, the data of a temporal unit is split into several
+   * AOM_CODEC_CX_FRAME_PKT packets at tile group OBU boundaries. The first
+   * packet holds the OBUs that precede the first tile group (temporal
+   * delimiter, sequence header, frame header), each following packet starts
+   * with a tile group OBU, and any OBU following a tile group (e.g. the frame
+   * header of the next frame in the temporal unit) starts a new packet.
+   * data.frame.partition_id numbers the packets of a temporal unit from 0 and
+   * all of them but the last carry AOM_FRAME_IS_FRAGMENT. The number of tile
+   * groups is set by AV1E_SET_NUM_TG or AV1E_SET_MTU. Ignored with Annex B
+   * output.
+   *
+   * The temporal unit is split once it is fully coded and packed, so all of
+   * its packets are returned by the same aom_codec_encode() call: this does
+   * not lower the latency of the encoder, it only saves the application from
+   * parsing the OBUs to find the tile groups.
+   *
+   * - 0 = one packet per temporal unit (default)
+   * - 1 = one packet per tile group
+   */
+  AV1E_SET_TILE_GROUP_OUTPUT = 186,
+
+  /*!\brief Codec control function to get the time the encoder spent in its
+   * main coding stages during the last call to aom_codec_encode(),
+   * aom_frame_stage_times_t* parameter
+   *
+   * The times cover all the frames coded by that call, including the frames
+   * that do not produce a packet of their own, e.g. alt-ref frames.
+   */
+  AV1E_GET_FRAME_STAGE_TIMES = 187,
+
   // Any new encoder control IDs should be added above.
   // Maximum allowed encoder control ID is 229.
   // No encoder control ID should be added below.
@@ -1926,6 +2077,98 @@ typedef struct aom_gop_info {
   int layer_depth[250];
 } aom_gop_info_t;
 
+/*!\brief Statistics of the per-frame scratch buffers of the encoder.
+ *
+ * The counts are accumulated over all the threads of the encoder since it was
+ * created.
+ */
+typedef struct aom_scratch_mem_stats {
+  /*! Sum over the threads of the peak number of bytes held for scratch
+   * buffers */
+  uint64_t peak_bytes;
+  /*! Number of scratch buffers requested */
+  uint64_t num_allocs;
+  /*! Number of those requests that needed a heap allocation */
+  uint64_t num_heap_allocs;
+} aom_scratch_mem_stats_t;
+
+/*!\brief Memory held by the main subsystems of the encoder, in bytes.
+ */
+typedef struct aom_memory_usage {
+  /*! Sum of the subsystems below */
+  uint64_t total_bytes;
+  /*! Peak value of total_bytes since the encoder was created */
+  uint64_t peak_total_bytes;
+  /*! Lookahead queue of source frames */
+  uint64_t lookahead_bytes;
+  /*! TPL model statistics and reconstruction buffers */
+  uint64_t tpl_bytes;
+  /*! Reference and reconstructed frame buffers */
+  uint64_t frame_buffer_bytes;
+  /*! Per-thread coding buffers */
+  uint64_t thread_data_bytes;
+} aom_memory_usage_t;
+
+/*!\brief Coding stages of the encoder reported by AV1E_GET_FRAME_STAGE_TIMES.
+ */
+typedef enum {
+  AOM_ENC_STAGE_MOTION_SEARCH,     /**< Motion search of inter modes */
+  AOM_ENC_STAGE_RD_SEARCH,         /**< Partition and mode search */
+  AOM_ENC_STAGE_TPL,               /**< Temporal dependency model */
+  AOM_ENC_STAGE_TEMPORAL_FILTER,   /**< Temporal filtering of the source */
+  AOM_ENC_STAGE_GLOBAL_MOTION,     /**< Global motion estimation */
+  AOM_ENC_STAGE_LOOP_FILTER_PICK,  /**< Deblocking filter level search */
+  AOM_ENC_STAGE_CDEF_PICK,         /**< CDEF strength search */
+  AOM_ENC_STAGE_LR_PICK,           /**< Loop restoration search */
+  AOM_ENC_STAGE_BITSTREAM_PACKING, /**< Bitstream writing */
+  AOM_ENC_STAGE_COUNT              /**< Number of stages */
+} aom_enc_stage_t;
+
+/*!\brief Time spent by the encoder in its main coding stages, in microseconds.
+ *
+ * The motion search and RD search times are summed over the threads coding
+ * the superblocks, so with several threads they may exceed encode_us. The RD
+ * search time includes the motion search time. The other stages report the
+ * wall time of the stage.
+ */
+typedef struct aom_frame_stage_times {
+  /*! Time spent in each stage, indexed by aom_enc_stage_t */
+  int64_t stage_us[AOM_ENC_STAGE_COUNT];
+  /*! Wall time of the aom_codec_encode() call */
+  int64_t encode_us;
+} aom_frame_stage_times_t;
+
+/*!\brief Releases a source image referenced by the encoder in zero-copy mode.
+ *
+ * \param[in] cb_priv    Callback's private data
+ * \param[in] user_priv  user_priv of the image passed to aom_codec_encode()
+ */
+typedef void (*aom_release_source_frame_cb_fn_t)(void *cb_priv,
+                                                 void *user_priv);
+
+/*!\brief Callback enabling the zero-copy mode of the encoder, see
+ * AV1E_SET_SOURCE_FRAME_CB.
+ */
+typedef struct aom_source_frame_cb {
+  /*! Called from aom_codec_encode() or aom_codec_destroy() when the encoder
+   * no longer reads an image. NULL disables the zero-copy mode. */
+  aom_release_source_frame_cb_fn_t release_cb;
+  /*! Private data passed to release_cb */
+  void *cb_priv;
+} aom_source_frame_cb_t;
+
+/*!\brief External frame buffer functions of the encoder, see
+ * AV1E_SET_FRAME_BUFFER_FUNCTIONS.
+ */
+typedef struct aom_frame_buffer_functions {
+  /*! Called to get the memory of a frame buffer */
+  aom_get_frame_buffer_cb_fn_t get_fb;
+  /*! Called to release a frame buffer returned by get_fb */
+  aom_release_frame_buffer_cb_fn_t release_fb;
+  /*! Private data passed to get_fb and release_fb */
+  void *cb_priv;
+} aom_frame_buffer_functions_t;
+
 /*!\cond */
 /*!\brief Encoder control function parameter type
  *
@@ -2445,6 +2688,40 @@ AOM_CTRL_USE_TYPE(AV1E_GET_GOP_INFO, aom_gop_info_t *)
 AOM_CTRL_USE_TYPE(AV1E_SET_MODE_REF_DELTA_ENABLED, int)
 #define AOM_CTRL_AV1E_SET_MODE_REF_DELTA_ENABLED
 
+AOM_CTRL_USE_TYPE(AV1E_SET_ROW_MT_SYNC_MODE, unsigned int)
+#define AOM_CTRL_AV1E_SET_ROW_MT_SYNC_MODE
+
+AOM_CTRL_USE_TYPE(AV1E_SET_THREAD_POOL, aom_thread_pool_t *)
+#define AOM_CTRL_AV1E_SET_THREAD_POOL
+
+AOM_CTRL_USE_TYPE(AV1E_GET_SCRATCH_MEM_STATS, aom_scratch_mem_stats_t *)
+#define AOM_CTRL_AV1E_GET_SCRATCH_MEM_STATS
+
+AOM_CTRL_USE_TYPE(AV1E_GET_MEMORY_USAGE, aom_memory_usage_t *)
+#define AOM_CTRL_AV1E_GET_MEMORY_USAGE
+
+AOM_CTRL_USE_TYPE(AV1E_SET_MEMORY_BUDGET, unsigned int)
+#define AOM_CTRL_AV1E_SET_MEMORY_BUDGET
+
+AOM_CTRL_USE_TYPE(AV1E_SET_SOURCE_FRAME_CB, aom_source_frame_cb_t *)
+#define AOM_CTRL_AV1E_SET_SOURCE_FRAME_CB
+
+AOM_CTRL_USE_TYPE(AV1E_GET_SOURCE_BORDER, int *)
+#define AOM_CTRL_AV1E_GET_SOURCE_BORDER
+
+AOM_CTRL_USE_TYPE(AV1E_SET_FRAME_BUFFER_FUNCTIONS,
+                  aom_frame_buffer_functions_t *)
+#define AOM_CTRL_AV1E_SET_FRAME_BUFFER_FUNCTIONS
+
+AOM_CTRL_USE_TYPE(AV1E_SET_HUGE_PAGES, int)
+#define AOM_CTRL_AV1E_SET_HUGE_PAGES
+
+AOM_CTRL_USE_TYPE(AV1E_SET_TILE_GROUP_OUTPUT, unsigned int)
+#define AOM_CTRL_AV1E_SET_TILE_GROUP_OUTPUT
+
+AOM_CTRL_USE_TYPE(AV1E_GET_FRAME_STAGE_TIMES, aom_frame_stage_times_t *)
+#define AOM_CTRL_AV1E_GET_FRAME_STAGE_TIMES
+
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
@@ -27,6 +27,7 @@ extern "C" {
 
 /* Include controls common to both the encoder and decoder */
 #include "aom/aom.h"
+#include "aom/aom_thread_pool.h"
 
 /*!\name Algorithm interface for AV1
  *
@@ -69,6 +70,81 @@ typedef struct aom_inspect_init {
   void *inspect_ctx;
 } aom_inspect_init;
 
+/*!\brief Callback that reports the rows of a frame that are final.
+ *
+ * \param[in] priv  The row_output_priv member of aom_row_output_init.
+ * \param[in] img   Frame being decoded.
+ * \param[in] rows  Number of luma rows at the top of \p img whose pixels are
+ *                  final.
+ */
+typedef void (*aom_row_output_cb_fn_t)(void *priv, const aom_image_t *img,
+                                       unsigned int rows);
+
+/*!\brief Structure to hold the row output callback and its context.
+ *
+ * Parameter of the AV1D_SET_ROW_OUTPUT_CB control.
+ */
+typedef struct aom_row_output_init {
+  /*! Row output callback, NULL to disable it. */
+  aom_row_output_cb_fn_t row_output_cb;
+
+  /*! Row output callback context. */
+  void *row_output_priv;
+} aom_row_output_init;
+
+/*!\brief Structure to hold the decode time of the last frames.
+ *
+ * Parameter of the AV1D_GET_FRAME_DECODE_TIME control.
+ */
+typedef struct aom_frame_decode_time {
+  /*! Wall time spent decoding the frames, in microseconds. */
+  int64_t decode_us;
+
+  /*! Part of decode_us spent decoding the tiles, before the in-loop filters
+   * run. */
+  int64_t tiles_decode_us;
+} aom_frame_decode_time_t;
+
+/*!\brief Decoding stages reported by AV1D_GET_FRAME_STAGE_STATS.
+ */
+typedef enum {
+  AOM_DEC_STAGE_ENTROPY_DECODE,    /**< Mode info and coefficient parsing */
+  AOM_DEC_STAGE_PREDICTION,        /**< Intra and inter prediction */
+  AOM_DEC_STAGE_INVERSE_TRANSFORM, /**< Inverse transform and reconstruction */
+  AOM_DEC_STAGE_DEBLOCK,           /**< Deblocking filter */
+  AOM_DEC_STAGE_CDEF,              /**< CDEF */
+  AOM_DEC_STAGE_LOOP_RESTORATION,  /**< Loop restoration */
+  AOM_DEC_STAGE_FILM_GRAIN,        /**< Film grain synthesis */
+  AOM_DEC_STAGE_COUNT              /**< Number of stages */
+} aom_dec_stage_t;
+
+/*!\brief Structure to hold the time spent in each decoding stage and the
+ * number of blocks decoded.
+ *
+ * Parameter of the AV1D_GET_FRAME_STAGE_STATS control.
+ */
+typedef struct aom_dec_stage_stats {
+  /*! Time spent in each stage, indexed by aom_dec_stage_t, in microseconds.
+   *
+   * The entropy decode, prediction and inverse transform times are summed
+   * over the decoder threads and are only measured when enabled with
+   * AV1D_SET_BLOCK_STAGE_TIMING. The other stages report the wall time of the
+   * stage. When deblocking and CDEF run as one multithreaded pass, the wall
+   * time of the pass is split between them in proportion to the time the
+   * threads spent in each. */
+  int64_t stage_us[AOM_DEC_STAGE_COUNT];
+
+  /*! Time the decoder threads spent waiting for the superblocks they depend
+   * on or for work, summed over the threads, in microseconds. */
+  int64_t idle_us;
+
+  /*! Number of coding blocks decoded. */
+  uint64_t num_blocks;
+
+  /*! Number of transform blocks that have nonzero coefficients. */
+  uint64_t num_coded_tx_blocks;
+} aom_dec_stage_stats_t;
+
 /*!\brief Structure to collect a buffer index when inspecting.
  *
  * Defines a structure to hold the buffer and return an index
@@ -475,6 +551,118 @@ enum aom_dec_control_id {
    *   maximum
    */
   AOMD_SET_FRAME_SIZE_LIMIT,
+
+  /*!\brief Codec control function to run the decoder threads on a thread
+   * pool owned by the application, aom_thread_pool_t* parameter
+   *
+   * The decoder queues the work it would otherwise give to its own threads on
+   * the pool, which may be shared with other decoder and encoder instances.
+   * The pool must outlive the decoder. NULL (default) means the decoder
+   * starts its own threads.
+   *
+   * \note Must be called before the first call to aom_codec_decode().
+   */
+  AV1D_SET_THREAD_POOL,
+
+  /*!\brief Codec control function to report the rows of the frames being
+   * decoded as soon as they are final, aom_row_output_init* parameter
+   *
+   * While aom_codec_decode() decodes a frame that is shown, the callback is
+   * called with the number of luma rows at the top of the frame that went
+   * through all the in-loop filters, so that an application can start to
+   * display them before the whole frame is decoded. The chroma rows are final
+   * down to the corresponding subsampled row. The calls for a frame are made
+   * in order with an increasing row count, and the last one, made before
+   * aom_codec_decode() returns, covers the whole frame. The rows reported can
+   * be read until the next call to aom_codec_decode(), but not modified.
+   *
+   * The rows are reported as they are completed when the last in-loop filter
+   * of the frame is the deblocking filter or CDEF. When loop restoration or
+   * superres is used, the whole frame is reported once it is done.
+   *
+   * The callback may be called from any of the decoder threads, and holds
+   * up the filtering of that thread until it returns. Film grain is not
+   * applied to the reported rows; it is applied to the image returned by
+   * aom_codec_get_frame(). Frames shown with show_existing_frame and frames
+   * decoded in large scale tile mode are not reported.
+   *
+   * NULL or a NULL row_output_cb (default) disables the callback.
+   */
+  AV1D_SET_ROW_OUTPUT_CB,
+
+  /*!\brief Codec control function to get the time spent decoding the frames
+   * of the last call to aom_codec_decode(), aom_frame_decode_time_t*
+   * parameter
+   *
+   * The times add up all the frames decoded by the call, including the frames
+   * that are not shown.
+   */
+  AV1D_GET_FRAME_DECODE_TIME,
+
+  /*!\brief Codec control function to enable the timing of the entropy
+   * decode, prediction and inverse transform stages reported by
+   * AV1D_GET_FRAME_STAGE_STATS, int parameter
+   *
+   * These stages are interleaved block by block, so timing them reads the
+   * clock for every transform block, which slows down decoding noticeably.
+   *
+   * - 0 = disabled (default)
+   * - 1 = enabled
+   */
+  AV1D_SET_BLOCK_STAGE_TIMING,
+
+  /*!\brief Codec control function to get the time spent in each decoding
+   * stage for the frames of the last call to aom_codec_decode(),
+   * aom_dec_stage_stats_t* parameter
+   *
+   * Like AV1D_GET_FRAME_DECODE_TIME, the statistics add up all the frames
+   * decoded by the call. Film grain is applied by aom_codec_get_frame(), so
+   * its time is only included once the frames have been retrieved.
+   */
+  AV1D_GET_FRAME_STAGE_STATS,
+
+  /*!\brief Codec control function to add the film grain directly to the
+   * decoded frame buffer when possible, int parameter
+   *
+   * By default the decoder copies each output frame that has film grain into
+   * a second frame buffer and adds the grain to the copy, because the decoded
+   * frame may still be needed as a reference. When this control is enabled,
+   * output frames that are not used as references have the grain added in
+   * place, saving the copy and the extra frame buffer. The buffer comes from
+   * the aom_get_frame_buffer_cb_fn_t callback when one is set. Frames that
+   * are still referenced are handled as before.
+   *
+   * An image returned by aom_codec_get_frame() is then the decoded frame
+   * buffer itself, so AV1_GET_NEW_FRAME_IMAGE and AV1_COPY_NEW_FRAME_IMAGE
+   * return it with the grain applied.
+   *
+   * - 0 = disabled (default)
+   * - 1 = enabled
+   */
+  AV1D_SET_INPLACE_FILM_GRAIN,
+
+  /*!\brief Codec control function to decode consecutive temporal units in
+   * parallel, unsigned int parameter
+   *
+   * Each temporal unit is decoded by its own frame worker thread, which
+   * starts as soon as the tiles of the previous temporal unit are decoded and
+   * waits for the rows of the reference frames that its prediction reads.
+   * This helps most on streams with few tiles, where the tile and row
+   * threads have little to share. The output is the same as in serial mode.
+   *
+   * The frames of a temporal unit are returned by aom_codec_get_frame() after
+   * the call to aom_codec_decode() that receives the next temporal unit, or
+   * after a flush. Two frame decoders are used, each with the number of
+   * threads of the configuration, and more frame buffers are in use at a
+   * time. AV1D_SET_ROW_OUTPUT_CB has no effect, and AV1_SET_REFERENCE, large
+   * scale tile decoding and the inspection interface are not supported.
+   *
+   * - 0 = disabled (default)
+   * - 1 = enabled
+   *
+   * \note Must be called before the first call to aom_codec_decode().
+   */
+  AV1D_SET_FRAME_PARALLEL,
 };
 
 /*!\cond */
@@ -610,6 +798,27 @@ AOM_CTRL_USE_TYPE(AOMD_GET_ORDER_HINT, unsigned int *)
 
 AOM_CTRL_USE_TYPE(AOMD_SET_FRAME_SIZE_LIMIT, unsigned int)
 #define AOM_CTRL_AOMD_SET_FRAME_SIZE_LIMIT
+
+AOM_CTRL_USE_TYPE(AV1D_SET_THREAD_POOL, aom_thread_pool_t *)
+#define AOM_CTRL_AV1D_SET_THREAD_POOL
+
+AOM_CTRL_USE_TYPE(AV1D_SET_ROW_OUTPUT_CB, aom_row_output_init *)
+#define AOM_CTRL_AV1D_SET_ROW_OUTPUT_CB
+
+AOM_CTRL_USE_TYPE(AV1D_GET_FRAME_DECODE_TIME, aom_frame_decode_time_t *)
+#define AOM_CTRL_AV1D_GET_FRAME_DECODE_TIME
+
+AOM_CTRL_USE_TYPE(AV1D_SET_BLOCK_STAGE_TIMING, int)
+#define AOM_CTRL_AV1D_SET_BLOCK_STAGE_TIMING
+
+AOM_CTRL_USE_TYPE(AV1D_GET_FRAME_STAGE_STATS, aom_dec_stage_stats_t *)
+#define AOM_CTRL_AV1D_GET_FRAME_STAGE_STATS
+
+AOM_CTRL_USE_TYPE(AV1D_SET_INPLACE_FILM_GRAIN, int)
+#define AOM_CTRL_AV1D_SET_INPLACE_FILM_GRAIN
+
+AOM_CTRL_USE_TYPE(AV1D_SET_FRAME_PARALLEL, unsigned int)
+#define AOM_CTRL_AV1D_SET_FRAME_PARALLEL
 /*!\endcond */
 /*! @} - end defgroup aom_decoder */
 #ifdef __cplusplus
@@ -158,6 +158,13 @@ if(CONFIG_AV1_DECODER)
               "${AOM_ROOT}/aom_dsp/bitreader.c"
               "${AOM_ROOT}/aom_dsp/bitreader.h" "${AOM_ROOT}/aom_dsp/entdec.c"
               "${AOM_ROOT}/aom_dsp/entdec.h")
+
+  list(APPEND AOM_DSP_DECODER_INTRIN_SSE2
+              "${AOM_ROOT}/aom_dsp/x86/entdec_sse2.c"
+              "${AOM_ROOT}/aom_dsp/x86/entdec_sse2.h")
+
+  list(APPEND AOM_DSP_DECODER_INTRIN_AVX2
+              "${AOM_ROOT}/aom_dsp/x86/entdec_avx2.c")
 endif()
 
 if(CONFIG_AV1_ENCODER)
@@ -187,7 +194,9 @@ if(CONFIG_AV1_ENCODER)
 
   if(CONFIG_HIGHWAY)
     list(APPEND AOM_DSP_ENCODER_SOURCES "${AOM_ROOT}/aom_dsp/reduce_sum_hwy.h"
-                "${AOM_ROOT}/aom_dsp/sad_hwy.h")
+                "${AOM_ROOT}/aom_dsp/quantize_hwy.h"
+                "${AOM_ROOT}/aom_dsp/sad_hwy.h"
+                "${AOM_ROOT}/aom_dsp/variance_hwy.h")
   endif()
 
   # Flow estimation library and grain/noise table/model.
@@ -272,7 +281,9 @@ if(CONFIG_AV1_ENCODER)
     list(APPEND AOM_DSP_ENCODER_INTRIN_AVX2
                 "${AOM_ROOT}/aom_dsp/x86/sad_hwy_avx2.cc")
     list(APPEND AOM_DSP_ENCODER_INTRIN_AVX512
-                "${AOM_ROOT}/aom_dsp/x86/sad_hwy_avx512.cc")
+                "${AOM_ROOT}/aom_dsp/x86/quantize_hwy_avx512.cc"
+                "${AOM_ROOT}/aom_dsp/x86/sad_hwy_avx512.cc"
+                "${AOM_ROOT}/aom_dsp/x86/variance_hwy_avx512.cc")
     list(REMOVE_ITEM AOM_DSP_ENCODER_INTRIN_AVX2
                      "${AOM_ROOT}/aom_dsp/x86/sad_impl_avx2.c")
   endif()
@@ -449,6 +460,11 @@ function(setup_aom_dsp_targets)
     add_intrinsics_object_library("-msse2" "sse2" "aom_dsp_common"
                                   "AOM_DSP_COMMON_INTRIN_SSE2")
 
+    if(CONFIG_AV1_DECODER)
+      add_intrinsics_object_library("-msse2" "sse2" "aom_dsp_decoder"
+                                    "AOM_DSP_DECODER_INTRIN_SSE2")
+    endif()
+
     if(CONFIG_AV1_ENCODER)
       if("${AOM_TARGET_CPU}" STREQUAL "x86_64")
         list(APPEND AOM_DSP_ENCODER_ASM_SSE2 ${AOM_DSP_ENCODER_ASM_SSE2_X86_64})
@@ -494,6 +510,10 @@ function(setup_aom_dsp_targets)
   if(HAVE_AVX2)
     add_intrinsics_object_library("-mavx2" "avx2" "aom_dsp_common"
                                   "AOM_DSP_COMMON_INTRIN_AVX2")
+    if(CONFIG_AV1_DECODER)
+      add_intrinsics_object_library("-mavx2" "avx2" "aom_dsp_decoder"
+                                    "AOM_DSP_DECODER_INTRIN_AVX2")
+    endif()
     if(CONFIG_AV1_ENCODER)
       add_intrinsics_object_library("-mavx2" "avx2" "aom_dsp_encoder"
                                     "AOM_DSP_ENCODER_INTRIN_AVX2")
@@ -674,6 +674,17 @@ if (aom_config("CONFIG_AV1_HIGHBITDEPTH") eq "yes") {
   specialize qw/aom_highbd_lpf_horizontal_4_dual neon sse2 avx2/;
 }
 
+#
+# Entropy decoding
+#
+if (aom_config("CONFIG_AV1_DECODER") eq "yes") {
+  add_proto qw/int aom_ec_find_symbol/, "unsigned int c, unsigned int rng, const uint16_t *icdf, int nsyms";
+  specialize qw/aom_ec_find_symbol sse2 avx2/;
+
+  add_proto qw/void aom_update_cdf/, "uint16_t *cdf, int val, int nsyms";
+  specialize qw/aom_update_cdf sse2 avx2/;
+}  # CONFIG_AV1_DECODER
+
 #
 # Encoder functions.
 #
@@ -742,6 +753,12 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   add_proto qw/void aom_quantize_b_64x64/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
   specialize qw/aom_quantize_b_64x64 neon ssse3 avx2/;
 
+  if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+    specialize qw/aom_quantize_b       avx512/;
+    specialize qw/aom_quantize_b_32x32 avx512/;
+    specialize qw/aom_quantize_b_64x64 avx512/;
+  }
+
   if (aom_config("CONFIG_REALTIME_ONLY") ne "yes") {
     add_proto qw/void aom_quantize_b_adaptive/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
     specialize qw/aom_quantize_b_adaptive sse2 avx2/;
@@ -764,6 +781,12 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes" && aom_config("CONFIG_AV1_HIGHBITD
   add_proto qw/void aom_highbd_quantize_b_64x64/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
   specialize qw/aom_highbd_quantize_b_64x64 sse2 avx2 neon/;
 
+  if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+    specialize qw/aom_highbd_quantize_b       avx512/;
+    specialize qw/aom_highbd_quantize_b_32x32 avx512/;
+    specialize qw/aom_highbd_quantize_b_64x64 avx512/;
+  }
+
   if (aom_config("CONFIG_REALTIME_ONLY") ne "yes") {
     add_proto qw/void aom_highbd_quantize_b_adaptive/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
     specialize qw/aom_highbd_quantize_b_adaptive sse2 avx2 neon/;
@@ -1063,6 +1086,7 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
     ($w, $h) = @$_;
     add_proto qw/void/, "aom_sad${w}x${h}x4d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
     add_proto qw/void/, "aom_sad${w}x${h}x3d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
+    add_proto qw/void/, "aom_sad${w}x${h}x8d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[8], int ref_stride, uint32_t sad_array[8]";
     if ($h >= 16) {
       add_proto qw/void/, "aom_sad_skip_${w}x${h}x4d", "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[4], int ref_stride, uint32_t sad_array[4]";
     }
@@ -1161,6 +1185,14 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   specialize qw/aom_sad8x32x3d         neon/;
   specialize qw/aom_sad4x16x3d         neon/;
 
+  if(aom_config("CONFIG_HIGHWAY") eq "yes") {
+    specialize qw/aom_sad128x128x8d avx2 avx512/;
+    specialize qw/aom_sad128x64x8d  avx2 avx512/;
+    specialize qw/aom_sad64x128x8d  avx2 avx512/;
+    specialize qw/aom_sad64x64x8d   avx2 avx512/;
+    specialize qw/aom_sad64x32x8d   avx2 avx512/;
+  }
+
   #
   # Multi-block SAD, comparing a reference to N independent blocks
   #
@@ -1475,6 +1507,22 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
     specialize qw/aom_sub_pixel_avg_variance64x16 neon ssse3/;
   }
 
+  # Highway kernels cover the block sizes at least 16 pixels wide.
+  my @hwy_variance_block_sizes = ([128, 128], [128, 64], [64, 128], [64, 64],
+                                  [64, 32], [32, 64], [32, 32], [32, 16],
+                                  [16, 32], [16, 16], [16, 8]);
+  if (aom_config("CONFIG_REALTIME_ONLY") ne "yes") {
+    push @hwy_variance_block_sizes, ([16, 4], [32, 8], [16, 64], [64, 16]);
+  }
+  if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+    foreach (@hwy_variance_block_sizes) {
+      ($w, $h) = @$_;
+      specialize "aom_variance${w}x${h}", qw/avx512/;
+      specialize "aom_sub_pixel_variance${w}x${h}", qw/avx512/;
+      specialize "aom_sub_pixel_avg_variance${w}x${h}", qw/avx512/;
+    }
+  }
+
   if (aom_config("CONFIG_AV1_HIGHBITDEPTH") eq "yes") {
     foreach $bd (8, 10, 12) {
       foreach (@encoder_block_sizes) {
@@ -1548,6 +1596,15 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
       }
     }
 
+    if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+      foreach $bd (8, 10, 12) {
+        foreach (@hwy_variance_block_sizes) {
+          ($w, $h) = @$_;
+          specialize "aom_highbd_${bd}_variance${w}x${h}", qw/avx512/;
+        }
+      }
+    }
+
     specialize qw/aom_highbd_12_sub_pixel_variance128x128 sse2 neon/;
     specialize qw/aom_highbd_12_sub_pixel_variance128x64  sse2 neon/;
     specialize qw/aom_highbd_12_sub_pixel_variance64x128  sse2 neon/;
@@ -16,6 +16,7 @@
 #include <limits.h>
 
 #include "config/aom_config.h"
+#include "config/aom_dsp_rtcd.h"
 
 #include "aom/aomdx.h"
 #include "aom/aom_integer.h"
@@ -221,7 +222,14 @@ static inline int aom_read_symbol_(aom_reader *r, aom_cdf_prob *cdf,
                                    int nsymbs ACCT_STR_PARAM) {
   int ret;
   ret = aom_read_cdf(r, cdf, nsymbs, ACCT_STR_NAME);
-  if (r->allow_update_cdf) update_cdf(cdf, ret, nsymbs);
+  if (r->allow_update_cdf) {
+    // See od_ec_decode_cdf_q15() for why small CDFs are adapted inline.
+    if (nsymbs < 4) {
+      update_cdf(cdf, ret, nsymbs);
+    } else {
+      aom_update_cdf(cdf, ret, nsymbs);
+    }
+  }
   return ret;
 }
 
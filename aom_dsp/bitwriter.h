@@ -104,6 +104,20 @@ static inline void aom_write_symbol(aom_writer *w, int symb, aom_cdf_prob *cdf,
   if (w->allow_update_cdf) update_cdf(cdf, symb, nsymbs);
 }
 
+// Writes n symbols as a sequence of aom_write_symbol() calls would, where
+// symbs[i] is coded with cdfs[i], an nsymbs[i]-symbol CDF. A CDF may be used
+// by several symbols of the run.
+static inline void aom_write_symbols(aom_writer *w, const uint8_t *symbs,
+                                     aom_cdf_prob *const *cdfs,
+                                     const uint8_t *nsymbs, int n) {
+#if CONFIG_BITSTREAM_DEBUG
+  for (int i = 0; i < n; ++i) aom_write_symbol(w, symbs[i], cdfs[i], nsymbs[i]);
+#else
+  od_ec_encode_cdf_q15_run(&w->ec, symbs, cdfs, nsymbs, n,
+                           w->allow_update_cdf);
+#endif
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
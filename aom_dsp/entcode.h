@@ -14,6 +14,8 @@
 
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
+
 #include "aom_dsp/odintrin.h"
 #include "aom_dsp/prob.h"
 
@@ -21,8 +23,14 @@
 #define EC_MIN_PROB 4  // must be <= (1<<EC_PROB_SHIFT)/16
 
 /*OPT: od_ec_window must be at least 32 bits, but if you have fast arithmetic
-   on a larger type, you can speed up the decoder by using it here.*/
+   on a larger type, you can speed up the decoder by using it here.
+  A 64-bit window needs a refill only every 48 or so bits instead of every 16,
+   and each refill loads its bytes at once (see od_ec_dec_refill()).*/
+#if UINTPTR_MAX > UINT32_MAX
+typedef uint64_t od_ec_window;
+#else
 typedef uint32_t od_ec_window;
+#endif
 
 /*The size in bits of od_ec_window.*/
 #define OD_EC_WINDOW_SIZE ((int)sizeof(od_ec_window) * CHAR_BIT)
@@ -10,6 +10,9 @@
  */
 
 #include <assert.h>
+
+#include "config/aom_dsp_rtcd.h"
+
 #include "aom_dsp/entdec.h"
 #include "aom_dsp/prob.h"
 
@@ -73,6 +76,14 @@
   Even relatively modest values like 100 would work fine.*/
 #define OD_EC_LOTS_OF_BITS (0x4000)
 
+/*Loads 8 bytes as a big-endian value. Compilers turn this into a single load
+   and byte swap.*/
+static inline uint64_t od_ec_load_be64(const unsigned char *p) {
+  return (uint64_t)p[0] << 56 | (uint64_t)p[1] << 48 | (uint64_t)p[2] << 40 |
+         (uint64_t)p[3] << 32 | (uint64_t)p[4] << 24 | (uint64_t)p[5] << 16 |
+         (uint64_t)p[6] << 8 | (uint64_t)p[7];
+}
+
 /*The return value of od_ec_dec_tell does not change across an od_ec_dec_refill
    call.*/
 static void od_ec_dec_refill(od_ec_dec *dec) {
@@ -86,6 +97,18 @@ static void od_ec_dec_refill(od_ec_dec *dec) {
   bptr = dec->bptr;
   end = dec->end;
   s = OD_EC_WINDOW_SIZE - 9 - (cnt + 15);
+  if (OD_EC_WINDOW_SIZE == 64 && end - bptr >= 8) {
+    /*Unless we are close to the end of the buffer, all the bytes the loop
+       below would insert (at most 7, as s < OD_EC_WINDOW_SIZE - 8) are
+       inserted at once.*/
+    const int n = (s >> 3) + 1;
+    assert(s >= 0 && n <= 7);
+    dif ^= (od_ec_window)(od_ec_load_be64(bptr) >> (64 - 8 * n)) << (s & 7);
+    dec->dif = dif;
+    dec->cnt = cnt + 8 * n;
+    dec->bptr = bptr + n;
+    return;
+  }
   for (; s >= 0 && bptr < end; s -= 8, bptr++) {
     /*Each time a byte is inserted into the window (dif), bptr advances and cnt
        is incremented by 8, so the total number of consumed bits (the return
@@ -143,7 +166,9 @@ static int od_ec_dec_normalize(od_ec_dec *dec, od_ec_window dif, unsigned rng,
 void od_ec_dec_init(od_ec_dec *dec, const unsigned char *buf,
                     uint32_t storage) {
   dec->buf = buf;
-  dec->tell_offs = 10 - (OD_EC_WINDOW_SIZE - 8);
+  /*The window holds cnt + 14 unconsumed bits whatever its size, so that
+     od_ec_dec_tell() initially returns 1, as od_ec_enc_tell() does.*/
+  dec->tell_offs = -14;
   dec->end = buf + storage;
   dec->bptr = buf;
   dec->dif = ((od_ec_window)1 << (OD_EC_WINDOW_SIZE - 1)) - 1;
@@ -181,6 +206,37 @@ int od_ec_decode_bool_q15(od_ec_dec *dec, unsigned f) {
   return od_ec_dec_normalize(dec, dif, r_new, ret);
 }
 
+/*Returns the lower end of the coding interval of symbol i (scaled to the
+   current range r), which the top 16 bits of the window are compared with.
+  n: The number of symbols in the alphabet minus one.*/
+static inline unsigned od_ec_cdf_threshold(unsigned r, const uint16_t *icdf,
+                                           int i, int n) {
+  return ((r >> 8) * (uint32_t)(icdf[i] >> EC_PROB_SHIFT) >>
+          (7 - EC_PROB_SHIFT)) +
+         EC_MIN_PROB * (n - i);
+}
+
+/*Returns the first symbol whose interval lower end does not exceed c, the
+   top 16 bits of the window.*/
+static inline int od_ec_find_symbol(unsigned c, unsigned r,
+                                    const uint16_t *icdf, int nsyms) {
+  const int n = nsyms - 1;
+  int ret = -1;
+  do {
+    ret++;
+  } while (c < od_ec_cdf_threshold(r, icdf, ret, n));
+  return ret;
+}
+
+int aom_ec_find_symbol_c(unsigned int c, unsigned int rng,
+                         const uint16_t *icdf, int nsyms) {
+  return od_ec_find_symbol(c, rng, icdf, nsyms);
+}
+
+void aom_update_cdf_c(uint16_t *cdf, int val, int nsyms) {
+  update_cdf(cdf, (int8_t)val, nsyms);
+}
+
 /*Decodes a symbol given an inverse cumulative distribution function (CDF)
    table in Q15.
   icdf: CDF_PROB_TOP minus the CDF, such that symbol s falls in the range
@@ -207,14 +263,15 @@ int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
   assert(32768U <= r);
   assert(7 - EC_PROB_SHIFT >= 0);
   c = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
-  v = r;
-  ret = -1;
-  do {
-    u = v;
-    v = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >>
-         (7 - EC_PROB_SHIFT));
-    v += EC_MIN_PROB * (N - ret);
-  } while (c < v);
+  /*Alphabets of 2 or 3 symbols take at most three steps of the linear
+     search, which is cheaper than dispatching to the vectorized one.*/
+  if (nsyms < 4) {
+    ret = od_ec_find_symbol(c, r, icdf, nsyms);
+  } else {
+    ret = aom_ec_find_symbol(c, r, icdf, nsyms);
+  }
+  u = ret > 0 ? od_ec_cdf_threshold(r, icdf, ret - 1, N) : r;
+  v = od_ec_cdf_threshold(r, icdf, ret, N);
   assert(v < u);
   assert(u <= r);
   r = u - v;
@@ -48,6 +48,59 @@
    URL="http://researchcommons.waikato.ac.nz/bitstream/handle/10289/78/content.pdf"
   }*/
 
+/*Writes the bytes of low that are ready to the output buffer, growing it if
+   necessary.
+  low: The low end of the current range. The bits written are removed from it.
+  c: The number of bits of data in low (enc->cnt).
+  s: c plus the number of bits low is about to be shifted by. This must be at
+      least 40.
+  Return: The new value of s.
+          If the buffer cannot be grown, nothing is written and enc->error is
+           set.*/
+static int od_ec_enc_flush(od_ec_enc *enc, od_ec_enc_window *low, int c,
+                           int s) {
+  unsigned char *out = enc->buf;
+  uint32_t storage = enc->storage;
+  uint32_t offs = enc->offs;
+  if (offs + 8 > storage) {
+    storage = 2 * storage + 8;
+    out = (unsigned char *)realloc(out, sizeof(*out) * storage);
+    if (out == NULL) {
+      enc->error = -1;
+      return s;
+    }
+    enc->buf = out;
+    enc->storage = storage;
+  }
+  // Need to add 1 byte here since enc->cnt always counts 1 byte less
+  // (enc->cnt = -9) to ensure correct operation
+  uint8_t num_bytes_ready = (s >> 3) + 1;
+
+  // Update "c" to contain the number of non-ready bits in "low". Since "low"
+  // has 64-bit capacity, we need to add the (64 - 40) cushion bits and take
+  // off the number of ready bits.
+  const int d = s - c;
+  c += 24 - (num_bytes_ready << 3);
+
+  // Prepare "output" and update "low"
+  uint64_t output = *low >> c;
+  *low &= ((uint64_t)1 << c) - 1;
+
+  // Prepare data and carry mask
+  uint64_t mask = (uint64_t)1 << (num_bytes_ready << 3);
+  uint64_t carry = output & mask;
+
+  mask = mask - 0x01;
+  output = output & mask;
+
+  // Write data in a single operation
+  write_enc_data_to_out_buf(out, offs, output, carry, &enc->offs,
+                            num_bytes_ready);
+
+  // The number of residual bits, the new value of enc->cnt
+  return c + d - 24;
+}
+
 /*Takes updated low and range values, renormalizes them so that
    32768 <= rng < 65536 (flushing bytes from low to the output buffer if
    necessary), and stores them back in the encoder context.
@@ -76,46 +129,8 @@ static void od_ec_enc_normalize(od_ec_enc *enc, od_ec_enc_window low,
      the leading 0x00's as a special case.
   */
   if (s >= 40) {  // 56 - 16
-    unsigned char *out = enc->buf;
-    uint32_t storage = enc->storage;
-    uint32_t offs = enc->offs;
-    if (offs + 8 > storage) {
-      storage = 2 * storage + 8;
-      out = (unsigned char *)realloc(out, sizeof(*out) * storage);
-      if (out == NULL) {
-        enc->error = -1;
-        return;
-      }
-      enc->buf = out;
-      enc->storage = storage;
-    }
-    // Need to add 1 byte here since enc->cnt always counts 1 byte less
-    // (enc->cnt = -9) to ensure correct operation
-    uint8_t num_bytes_ready = (s >> 3) + 1;
-
-    // Update "c" to contain the number of non-ready bits in "low". Since "low"
-    // has 64-bit capacity, we need to add the (64 - 40) cushion bits and take
-    // off the number of ready bits.
-    c += 24 - (num_bytes_ready << 3);
-
-    // Prepare "output" and update "low"
-    uint64_t output = low >> c;
-    low = low & (((uint64_t)1 << c) - 1);
-
-    // Prepare data and carry mask
-    uint64_t mask = (uint64_t)1 << (num_bytes_ready << 3);
-    uint64_t carry = output & mask;
-
-    mask = mask - 0x01;
-    output = output & mask;
-
-    // Write data in a single operation
-    write_enc_data_to_out_buf(out, offs, output, carry, &enc->offs,
-                              num_bytes_ready);
-
-    // Update state of the encoder: enc->cnt to contain the number of residual
-    // bits
-    s = c + d - 24;
+    s = od_ec_enc_flush(enc, &low, c, s);
+    if (enc->error) return;
   }
   enc->low = low << d;
   enc->rng = rng << d;
@@ -152,35 +167,43 @@ void od_ec_enc_reset(od_ec_enc *enc) {
 /*Frees the buffers used by the encoder.*/
 void od_ec_enc_clear(od_ec_enc *enc) { free(enc->buf); }
 
-/*Encodes a symbol given its frequency in Q15.
+/*Narrows the range [l, l + r) to that of a symbol given its frequency in Q15.
   fl: CDF_PROB_TOP minus the cumulative frequency of all symbols that come
   before the one to be encoded.
   fh: CDF_PROB_TOP minus the cumulative frequency of all symbols up to and
   including the one to be encoded.*/
-static void od_ec_encode_q15(od_ec_enc *enc, unsigned fl, unsigned fh, int s,
-                             int nsyms) {
-  od_ec_enc_window l;
-  unsigned r;
+static inline void od_ec_enc_narrow(od_ec_enc_window *l, unsigned *r,
+                                    unsigned fl, unsigned fh, int s,
+                                    int nsyms) {
   unsigned u;
   unsigned v;
-  l = enc->low;
-  r = enc->rng;
-  assert(32768U <= r);
+  assert(32768U <= *r);
   assert(fh <= fl);
   assert(fl <= 32768U);
   assert(7 - EC_PROB_SHIFT >= 0);
   const int N = nsyms - 1;
   if (fl < CDF_PROB_TOP) {
-    u = ((r >> 8) * (uint32_t)(fl >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
+    u = ((*r >> 8) * (uint32_t)(fl >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
         EC_MIN_PROB * (N - (s - 1));
-    v = ((r >> 8) * (uint32_t)(fh >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
+    v = ((*r >> 8) * (uint32_t)(fh >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
         EC_MIN_PROB * (N - (s + 0));
-    l += r - u;
-    r = u - v;
+    *l += *r - u;
+    *r = u - v;
   } else {
-    r -= ((r >> 8) * (uint32_t)(fh >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
-         EC_MIN_PROB * (N - (s + 0));
+    *r -= ((*r >> 8) * (uint32_t)(fh >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
+          EC_MIN_PROB * (N - (s + 0));
   }
+}
+
+/*Encodes a symbol given its frequency in Q15.
+  See od_ec_enc_narrow() for the meaning of fl and fh.*/
+static void od_ec_encode_q15(od_ec_enc *enc, unsigned fl, unsigned fh, int s,
+                             int nsyms) {
+  od_ec_enc_window l;
+  unsigned r;
+  l = enc->low;
+  r = enc->rng;
+  od_ec_enc_narrow(&l, &r, fl, fh, s, nsyms);
   od_ec_enc_normalize(enc, l, r);
 #if OD_MEASURE_EC_OVERHEAD
   enc->entropy -= OD_LOG2((double)(OD_ICDF(fh) - OD_ICDF(fl)) / CDF_PROB_TOP.);
@@ -228,6 +251,60 @@ void od_ec_encode_cdf_q15(od_ec_enc *enc, int s, const uint16_t *icdf,
   od_ec_encode_q15(enc, s > 0 ? icdf[s - 1] : OD_ICDF(0), icdf[s], s, nsyms);
 }
 
+/*Encodes a run of symbols given their CDF tables in Q15, as a sequence of
+   calls to od_ec_encode_cdf_q15() would, optionally adapting each CDF after
+   its symbol with update_cdf().
+  The state of the encoder is kept in registers for the whole run instead of
+   being loaded and stored back for every symbol.
+  s: The index of each symbol to encode.
+  icdf: The CDF of each symbol, in the format od_ec_encode_cdf_q15() takes.
+        The same CDF may be used by several symbols of the run.
+  nsyms: The number of symbols in the alphabet of each symbol.
+  n: The number of symbols in the run.
+  adapt: Whether to adapt the CDFs.*/
+void od_ec_encode_cdf_q15_run(od_ec_enc *enc, const uint8_t *s,
+                              uint16_t *const *icdf, const uint8_t *nsyms,
+                              int n, int adapt) {
+  od_ec_enc_window l;
+  unsigned r;
+  int c;
+  if (enc->error) return;
+  l = enc->low;
+  r = enc->rng;
+  c = enc->cnt;
+  for (int i = 0; i < n; ++i) {
+    uint16_t *const cdf = icdf[i];
+    const int sym = s[i];
+    assert(sym < nsyms[i]);
+    assert(cdf[nsyms[i] - 1] == OD_ICDF(CDF_PROB_TOP));
+    od_ec_enc_narrow(&l, &r, sym > 0 ? cdf[sym - 1] : OD_ICDF(0), cdf[sym],
+                     sym, nsyms[i]);
+    /*Renormalize as od_ec_enc_normalize() does.*/
+    const int d = 16 - OD_ILOG_NZ(r);
+    int cs = c + d;
+    if (cs >= 40) {
+      /*Flushing through a copy lets l stay in a register.*/
+      od_ec_enc_window low = l;
+      cs = od_ec_enc_flush(enc, &low, c, cs);
+      if (enc->error) return;
+      l = low;
+    }
+    l <<= d;
+    r <<= d;
+    c = cs;
+#if OD_MEASURE_EC_OVERHEAD
+    enc->entropy -= OD_LOG2(
+        (double)(OD_ICDF(cdf[sym]) - (sym > 0 ? OD_ICDF(cdf[sym - 1]) : 0)) /
+        CDF_PROB_TOP.);
+    enc->nb_symbols++;
+#endif
+    if (adapt) update_cdf(cdf, (int8_t)sym, nsyms[i]);
+  }
+  enc->low = l;
+  enc->rng = r;
+  enc->cnt = c;
+}
+
 #if OD_MEASURE_EC_OVERHEAD
 #include <stdio.h>
 #endif
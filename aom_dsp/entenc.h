@@ -59,6 +59,9 @@ void od_ec_encode_bool_q15(od_ec_enc *enc, int val, unsigned f_q15)
     OD_ARG_NONNULL(1);
 void od_ec_encode_cdf_q15(od_ec_enc *enc, int s, const uint16_t *cdf, int nsyms)
     OD_ARG_NONNULL(1) OD_ARG_NONNULL(3);
+void od_ec_encode_cdf_q15_run(od_ec_enc *enc, const uint8_t *s,
+                              uint16_t *const *icdf, const uint8_t *nsyms,
+                              int n, int adapt) OD_ARG_NONNULL(1);
 
 void od_ec_enc_bits(od_ec_enc *enc, uint32_t fl, unsigned ftb)
     OD_ARG_NONNULL(1);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+#ifndef AOM_AOM_DSP_QUANTIZE_HWY_H_
+#define AOM_AOM_DSP_QUANTIZE_HWY_H_
+
+#include "config/aom_config.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "third_party/highway/hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+
+namespace {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Returns (a * b) >> shift computed with 64-bit intermediates, for results
+// that fit in 32 bits.
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> MulShift(D d, hn::VFromD<D> a,
+                                           hn::VFromD<D> b, int shift) {
+  const auto even = hn::ShiftRightSame(hn::MulEven(a, b), shift);
+  const auto odd = hn::ShiftRightSame(hn::MulOdd(a, b), shift);
+  return hn::OddEven(hn::BitCast(d, hn::ShiftLeft<32>(odd)),
+                     hn::BitCast(d, even));
+}
+
+// Quantizes one vector of coefficients in raster order and returns the
+// largest iscan + 1 of the nonzero results, or 0 if there are none.
+template <bool Highbd, int LogScale, typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> QuantizeVector(
+    D d, const tran_low_t *coeff_ptr, const int16_t *iscan,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, hn::VFromD<D> zbin,
+    hn::VFromD<D> round, hn::VFromD<D> quant, hn::VFromD<D> quant_shift,
+    hn::VFromD<D> dequant) {
+  const auto coeff = hn::LoadU(d, coeff_ptr);
+  const auto abs_coeff = hn::Abs(coeff);
+  const auto zbin_mask = hn::Ge(abs_coeff, zbin);
+  if (hn::AllFalse(d, zbin_mask)) {
+    hn::StoreU(hn::Zero(d), d, qcoeff_ptr);
+    hn::StoreU(hn::Zero(d), d, dqcoeff_ptr);
+    return hn::Zero(d);
+  }
+
+  auto tmp = hn::Add(abs_coeff, round);
+  HWY_IF_CONSTEXPR(!Highbd) { tmp = hn::Min(tmp, hn::Set(d, INT16_MAX)); }
+  // The reference code scales tmp by the flat quantization matrix weight
+  // (1 << AOM_QM_BITS) first; ((tmp << AOM_QM_BITS) * quant) >> 16 is
+  // (tmp * quant) >> (16 - AOM_QM_BITS).
+  const auto tmp_quant = MulShift(d, tmp, quant, 16 - AOM_QM_BITS);
+  const auto tmp2 = hn::Add(tmp_quant, hn::ShiftLeft<AOM_QM_BITS>(tmp));
+  auto abs_qcoeff =
+      MulShift(d, tmp2, quant_shift, 16 - LogScale + AOM_QM_BITS);
+  abs_qcoeff = hn::IfThenElseZero(zbin_mask, abs_qcoeff);
+  const auto abs_dqcoeff =
+      hn::ShiftRight<LogScale>(hn::Mul(abs_qcoeff, dequant));
+
+  const auto sign = hn::ShiftRight<31>(coeff);
+  hn::StoreU(hn::Sub(hn::Xor(abs_qcoeff, sign), sign), d, qcoeff_ptr);
+  hn::StoreU(hn::Sub(hn::Xor(abs_dqcoeff, sign), sign), d, dqcoeff_ptr);
+
+  constexpr hn::Rebind<int16_t, D> int16_tag;
+  const auto eob = hn::Add(hn::PromoteTo(d, hn::LoadU(int16_tag, iscan)),
+                           hn::Set(d, 1));
+  return hn::IfThenElseZero(hn::Ne(abs_qcoeff, hn::Zero(d)), eob);
+}
+
+// Vectorized aom_quantize_b_helper_c() and aom_highbd_quantize_b_helper_c()
+// without quantization matrices. Coefficients are visited in raster order
+// and the end of block is derived from iscan, so scan is unused.
+template <bool Highbd, int LogScale>
+HWY_ATTR void QuantizeB(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                        const int16_t *zbin_ptr, const int16_t *round_ptr,
+                        const int16_t *quant_ptr,
+                        const int16_t *quant_shift_ptr,
+                        tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                        const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                        const int16_t *iscan) {
+  // Transform blocks have at least 16 coefficients.
+  constexpr hn::CappedTag<int32_t, 16> d;
+  const int vw = static_cast<int>(hn::Lanes(d));
+  const auto dc_mask = hn::FirstN(d, 1);
+  const auto load_param = [&](const int16_t *param, int log_scale) HWY_ATTR {
+    return hn::IfThenElse(
+        dc_mask, hn::Set(d, ROUND_POWER_OF_TWO(param[0], log_scale)),
+        hn::Set(d, ROUND_POWER_OF_TWO(param[1], log_scale)));
+  };
+  auto zbin = load_param(zbin_ptr, LogScale);
+  auto round = load_param(round_ptr, LogScale);
+  auto quant = load_param(quant_ptr, 0);
+  auto quant_shift = load_param(quant_shift_ptr, 0);
+  auto dequant = load_param(dequant_ptr, 0);
+
+  auto eob = QuantizeVector<Highbd, LogScale>(d, coeff_ptr, iscan, qcoeff_ptr,
+                                               dqcoeff_ptr, zbin, round, quant,
+                                               quant_shift, dequant);
+  // Only the first coefficient uses the DC parameters.
+  zbin = hn::Set(d, hn::ExtractLane(zbin, 1));
+  round = hn::Set(d, hn::ExtractLane(round, 1));
+  quant = hn::Set(d, hn::ExtractLane(quant, 1));
+  quant_shift = hn::Set(d, hn::ExtractLane(quant_shift, 1));
+  dequant = hn::Set(d, hn::ExtractLane(dequant, 1));
+  for (intptr_t i = vw; i < n_coeffs; i += vw) {
+    eob = hn::Max(eob, QuantizeVector<Highbd, LogScale>(
+                           d, coeff_ptr + i, iscan + i, qcoeff_ptr + i,
+                           dqcoeff_ptr + i, zbin, round, quant, quant_shift,
+                           dequant));
+  }
+  *eob_ptr = static_cast<uint16_t>(hn::ReduceMax(d, eob));
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace
+
+#define MAKE_QUANTIZE_B(name, highbd, log_scale, suffix)                      \
+  extern "C" void name##_##suffix(                                            \
+      const tran_low_t *coeff_ptr, intptr_t n_coeffs,                         \
+      const int16_t *zbin_ptr, const int16_t *round_ptr,                      \
+      const int16_t *quant_ptr, const int16_t *quant_shift_ptr,               \
+      tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,                        \
+      const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,     \
+      const int16_t *iscan);                                                  \
+  HWY_ATTR void name##_##suffix(                                              \
+      const tran_low_t *coeff_ptr, intptr_t n_coeffs,                         \
+      const int16_t *zbin_ptr, const int16_t *round_ptr,                      \
+      const int16_t *quant_ptr, const int16_t *quant_shift_ptr,               \
+      tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,                        \
+      const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,     \
+      const int16_t *iscan) {                                                 \
+    (void)scan;                                                               \
+    HWY_NAMESPACE::QuantizeB<highbd, log_scale>(                              \
+        coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr, \
+        qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan);                \
+  }
+
+#define MAKE_QUANTIZERS(suffix)                                  \
+  MAKE_QUANTIZE_B(aom_quantize_b, false, 0, suffix)              \
+  MAKE_QUANTIZE_B(aom_quantize_b_32x32, false, 1, suffix)        \
+  MAKE_QUANTIZE_B(aom_quantize_b_64x64, false, 2, suffix)
+
+#define MAKE_HIGHBD_QUANTIZERS(suffix)                               \
+  MAKE_QUANTIZE_B(aom_highbd_quantize_b, true, 0, suffix)            \
+  MAKE_QUANTIZE_B(aom_highbd_quantize_b_32x32, true, 1, suffix)      \
+  MAKE_QUANTIZE_B(aom_highbd_quantize_b_64x64, true, 2, suffix)
+
+HWY_AFTER_NAMESPACE();
+
+#endif  // AOM_AOM_DSP_QUANTIZE_HWY_H_
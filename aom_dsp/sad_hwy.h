@@ -51,6 +51,27 @@ HWY_MAYBE_UNUSED unsigned int SumOfAbsoluteDiff(
       hn::ReduceSum(intermediate_sum_tag, sum_sad));
 }
 
+// Reduces the per-lane sums of 4 references and stores the 4 totals.
+template <typename D>
+HWY_ATTR HWY_INLINE void StoreSad4(
+    D pixel_tag, hn::VFromD<hn::Repartition<uint64_t, D>> sum_sad_0,
+    hn::VFromD<hn::Repartition<uint64_t, D>> sum_sad_1,
+    hn::VFromD<hn::Repartition<uint64_t, D>> sum_sad_2,
+    hn::VFromD<hn::Repartition<uint64_t, D>> sum_sad_3, uint32_t res[4]) {
+  (void)pixel_tag;
+  constexpr hn::Repartition<uint32_t, D> uint32_tag;
+  auto r02 = hn::InterleaveEven(uint32_tag, hn::BitCast(uint32_tag, sum_sad_0),
+                                hn::BitCast(uint32_tag, sum_sad_2));
+  auto r13 = hn::InterleaveEven(uint32_tag, hn::BitCast(uint32_tag, sum_sad_1),
+                                hn::BitCast(uint32_tag, sum_sad_3));
+  auto r0123 = hn::Add(hn::InterleaveLower(uint32_tag, r02, r13),
+                       hn::InterleaveUpper(uint32_tag, r02, r13));
+
+  auto block_sum = BlockReduceSum(uint32_tag, r0123);
+  constexpr hn::FixedTag<uint32_t, 4> block_sum_tag;
+  hn::StoreU(block_sum, block_sum_tag, res);
+}
+
 template <int BlockWidth, int NumRef>
 HWY_MAYBE_UNUSED void SumOfAbsoluteDiffND(const uint8_t *src_ptr,
                                           int src_stride,
@@ -98,17 +119,54 @@ HWY_MAYBE_UNUSED void SumOfAbsoluteDiffND(const uint8_t *src_ptr,
       ref_3 += ref_stride;
     }
   }
-  constexpr hn::Repartition<uint32_t, decltype(pixel_tag)> uint32_tag;
-  auto r02 = hn::InterleaveEven(uint32_tag, hn::BitCast(uint32_tag, sum_sad_0),
-                                hn::BitCast(uint32_tag, sum_sad_2));
-  auto r13 = hn::InterleaveEven(uint32_tag, hn::BitCast(uint32_tag, sum_sad_1),
-                                hn::BitCast(uint32_tag, sum_sad_3));
-  auto r0123 = hn::Add(hn::InterleaveLower(uint32_tag, r02, r13),
-                       hn::InterleaveUpper(uint32_tag, r02, r13));
+  StoreSad4(pixel_tag, sum_sad_0, sum_sad_1, sum_sad_2, sum_sad_3, res);
+}
 
-  auto block_sum = BlockReduceSum(uint32_tag, r0123);
-  constexpr hn::FixedTag<uint32_t, 4> block_sum_tag;
-  hn::StoreU(block_sum, block_sum_tag, res);
+// Compares one source block against 8 reference blocks. Each source vector
+// is loaded once and reused for all of the references.
+template <int BlockWidth>
+HWY_MAYBE_UNUSED void SumOfAbsoluteDiff8D(const uint8_t *src_ptr,
+                                          int src_stride,
+                                          const uint8_t *const ref_ptr[8],
+                                          int ref_stride, int h,
+                                          uint32_t res[8]) {
+  constexpr hn::CappedTag<uint8_t, BlockWidth> pixel_tag;
+  constexpr hn::Repartition<uint64_t, decltype(pixel_tag)> intermediate_sum_tag;
+  const int vw = hn::Lanes(pixel_tag);
+  auto sum_sad_0 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_1 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_2 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_3 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_4 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_5 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_6 = hn::Zero(intermediate_sum_tag);
+  auto sum_sad_7 = hn::Zero(intermediate_sum_tag);
+  for (int i = 0; i < h; ++i) {
+    const ptrdiff_t ref_offset = static_cast<ptrdiff_t>(i) * ref_stride;
+    for (int j = 0; j < BlockWidth; j += vw) {
+      const auto src_vec = hn::LoadU(pixel_tag, &src_ptr[j]);
+      const ptrdiff_t k = ref_offset + j;
+      const auto ref_vec_0 = hn::LoadU(pixel_tag, ref_ptr[0] + k);
+      sum_sad_0 = hn::Add(sum_sad_0, hn::SumsOf8AbsDiff(src_vec, ref_vec_0));
+      const auto ref_vec_1 = hn::LoadU(pixel_tag, ref_ptr[1] + k);
+      sum_sad_1 = hn::Add(sum_sad_1, hn::SumsOf8AbsDiff(src_vec, ref_vec_1));
+      const auto ref_vec_2 = hn::LoadU(pixel_tag, ref_ptr[2] + k);
+      sum_sad_2 = hn::Add(sum_sad_2, hn::SumsOf8AbsDiff(src_vec, ref_vec_2));
+      const auto ref_vec_3 = hn::LoadU(pixel_tag, ref_ptr[3] + k);
+      sum_sad_3 = hn::Add(sum_sad_3, hn::SumsOf8AbsDiff(src_vec, ref_vec_3));
+      const auto ref_vec_4 = hn::LoadU(pixel_tag, ref_ptr[4] + k);
+      sum_sad_4 = hn::Add(sum_sad_4, hn::SumsOf8AbsDiff(src_vec, ref_vec_4));
+      const auto ref_vec_5 = hn::LoadU(pixel_tag, ref_ptr[5] + k);
+      sum_sad_5 = hn::Add(sum_sad_5, hn::SumsOf8AbsDiff(src_vec, ref_vec_5));
+      const auto ref_vec_6 = hn::LoadU(pixel_tag, ref_ptr[6] + k);
+      sum_sad_6 = hn::Add(sum_sad_6, hn::SumsOf8AbsDiff(src_vec, ref_vec_6));
+      const auto ref_vec_7 = hn::LoadU(pixel_tag, ref_ptr[7] + k);
+      sum_sad_7 = hn::Add(sum_sad_7, hn::SumsOf8AbsDiff(src_vec, ref_vec_7));
+    }
+    src_ptr += src_stride;
+  }
+  StoreSad4(pixel_tag, sum_sad_0, sum_sad_1, sum_sad_2, sum_sad_3, res);
+  StoreSad4(pixel_tag, sum_sad_4, sum_sad_5, sum_sad_6, sum_sad_7, res + 4);
 }
 
 }  // namespace HWY_NAMESPACE
@@ -136,6 +194,17 @@ HWY_MAYBE_UNUSED void SumOfAbsoluteDiffND(const uint8_t *src_ptr,
                                              ref_stride, h, res);              \
   }
 
+#define FSAD_8D(w, h, suffix)                                                  \
+  extern "C" void aom_sad##w##x##h##x8d_##suffix(                              \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *const ref_ptr[8], \
+      int ref_stride, uint32_t res[8]);                                        \
+  HWY_ATTR void aom_sad##w##x##h##x8d_##suffix(                                \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *const ref_ptr[8], \
+      int ref_stride, uint32_t res[8]) {                                       \
+    HWY_NAMESPACE::SumOfAbsoluteDiff8D<w>(src_ptr, src_stride, ref_ptr,        \
+                                          ref_stride, h, res);                 \
+  }
+
 #define FSAD_3D(w, h, suffix)                                                  \
   extern "C" void aom_sad##w##x##h##x3d_##suffix(                              \
       const uint8_t *src_ptr, int src_stride, const uint8_t *const ref_ptr[4], \
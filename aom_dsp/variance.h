@@ -91,6 +91,9 @@ typedef struct aom_variance_vtable {
   aom_subp_avg_variance_fn_t svaf;
   aom_sad_multi_d_fn_t sdx4df;
   aom_sad_multi_d_fn_t sdx3df;
+  // Same as sadx4, but for 8 references. NULL when not available, in which
+  // case callers fall back to two sdx4df calls.
+  aom_sad_multi_d_fn_t sdx8df;
   // Same as sadx4, but downsample the rows by a factor of 2.
   aom_sad_multi_d_fn_t sdsx4df;
   aom_masked_sad_fn_t msdf;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+#ifndef AOM_AOM_DSP_VARIANCE_HWY_H_
+#define AOM_AOM_DSP_VARIANCE_HWY_H_
+
+#include "config/aom_config.h"
+
+#include "aom/aom_integer.h"
+#include "aom_dsp/aom_filter.h"
+#include "aom_ports/mem.h"
+#include "third_party/highway/hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+
+namespace {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Accumulates the sum and sum of squares of src - ref for one vector of
+// pixels. The squares of a pair of adjacent lanes are added in 32 bits, which
+// does not overflow for differences of up to 12 bits.
+template <typename D, typename DW>
+HWY_ATTR HWY_INLINE void AccumulateDiff(D int16_tag, DW int32_tag,
+                                        hn::VFromD<D> diff,
+                                        hn::VFromD<DW> &sum,
+                                        hn::VFromD<DW> &sse) {
+  (void)int16_tag;
+  sum = hn::Add(sum, hn::SumsOf2(diff));
+  sse = hn::Add(sse, hn::WidenMulPairwiseAdd(int32_tag, diff, diff));
+}
+
+template <int BlockWidth, int BlockHeight>
+HWY_MAYBE_UNUSED HWY_ATTR void GetVariance(const uint8_t *src_ptr,
+                                           int src_stride,
+                                           const uint8_t *ref_ptr,
+                                           int ref_stride, uint32_t *sse,
+                                           int *sum) {
+  constexpr hn::CappedTag<int16_t, BlockWidth> int16_tag;
+  constexpr hn::Rebind<uint8_t, decltype(int16_tag)> pixel_tag;
+  constexpr hn::RepartitionToWide<decltype(int16_tag)> int32_tag;
+  const int vw = hn::Lanes(int16_tag);
+  auto sum_vec = hn::Zero(int32_tag);
+  auto sse_vec = hn::Zero(int32_tag);
+  for (int i = 0; i < BlockHeight; ++i) {
+    for (int j = 0; j < BlockWidth; j += vw) {
+      const auto src =
+          hn::PromoteTo(int16_tag, hn::LoadU(pixel_tag, src_ptr + j));
+      const auto ref =
+          hn::PromoteTo(int16_tag, hn::LoadU(pixel_tag, ref_ptr + j));
+      AccumulateDiff(int16_tag, int32_tag, hn::Sub(src, ref), sum_vec,
+                     sse_vec);
+    }
+    src_ptr += src_stride;
+    ref_ptr += ref_stride;
+  }
+  *sum = hn::ReduceSum(int32_tag, sum_vec);
+  *sse = static_cast<uint32_t>(hn::ReduceSum(int32_tag, sse_vec));
+}
+
+template <int BlockWidth, int BlockHeight>
+HWY_MAYBE_UNUSED HWY_ATTR uint32_t Variance(const uint8_t *src_ptr,
+                                            int src_stride,
+                                            const uint8_t *ref_ptr,
+                                            int ref_stride, uint32_t *sse) {
+  int sum;
+  GetVariance<BlockWidth, BlockHeight>(src_ptr, src_stride, ref_ptr,
+                                       ref_stride, sse, &sum);
+  return *sse - static_cast<uint32_t>((static_cast<int64_t>(sum) * sum) /
+                                      (BlockWidth * BlockHeight));
+}
+
+// Bilinear filters one row of pixels horizontally, as in
+// var_filter_block2d_bil_first_pass_c().
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> FilterRow(D uint16_tag, const uint8_t *src,
+                                            hn::VFromD<D> filter0,
+                                            hn::VFromD<D> filter1) {
+  constexpr hn::Rebind<uint8_t, D> pixel_tag;
+  const auto a = hn::PromoteTo(uint16_tag, hn::LoadU(pixel_tag, src));
+  const auto b = hn::PromoteTo(uint16_tag, hn::LoadU(pixel_tag, src + 1));
+  const auto sum = hn::Add(hn::Mul(a, filter0), hn::Mul(b, filter1));
+  return hn::ShiftRight<FILTER_BITS>(
+      hn::Add(sum, hn::Set(uint16_tag, 1 << (FILTER_BITS - 1))));
+}
+
+// Equivalent to filtering the block into a temporary buffer with the two-pass
+// bilinear filter of aom_sub_pixel_variance*_c() (optionally averaged with
+// second_pred) and then taking its variance, but done one vector column at a
+// time without the intermediate buffers.
+template <int BlockWidth, int BlockHeight>
+HWY_MAYBE_UNUSED HWY_ATTR uint32_t SubPixelVariance(
+    const uint8_t *src_ptr, int src_stride, int xoffset, int yoffset,
+    const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,
+    const uint8_t *second_pred = nullptr) {
+  constexpr hn::CappedTag<uint16_t, BlockWidth> uint16_tag;
+  constexpr hn::RebindToSigned<decltype(uint16_tag)> int16_tag;
+  constexpr hn::Rebind<uint8_t, decltype(uint16_tag)> pixel_tag;
+  constexpr hn::RepartitionToWide<decltype(int16_tag)> int32_tag;
+  const int vw = hn::Lanes(uint16_tag);
+  const auto hfilter0 = hn::Set(uint16_tag, bilinear_filters_2t[xoffset][0]);
+  const auto hfilter1 = hn::Set(uint16_tag, bilinear_filters_2t[xoffset][1]);
+  const auto vfilter0 = hn::Set(uint16_tag, bilinear_filters_2t[yoffset][0]);
+  const auto vfilter1 = hn::Set(uint16_tag, bilinear_filters_2t[yoffset][1]);
+  const auto round = hn::Set(uint16_tag, 1 << (FILTER_BITS - 1));
+  auto sum_vec = hn::Zero(int32_tag);
+  auto sse_vec = hn::Zero(int32_tag);
+  for (int j = 0; j < BlockWidth; j += vw) {
+    const uint8_t *src = src_ptr + j;
+    const uint8_t *ref = ref_ptr + j;
+    auto prev = FilterRow(uint16_tag, src, hfilter0, hfilter1);
+    for (int i = 0; i < BlockHeight; ++i) {
+      src += src_stride;
+      const auto cur = FilterRow(uint16_tag, src, hfilter0, hfilter1);
+      auto pred = hn::ShiftRight<FILTER_BITS>(
+          hn::Add(hn::Add(hn::Mul(prev, vfilter0), hn::Mul(cur, vfilter1)),
+                  round));
+      if (second_pred != nullptr) {
+        const auto avg = hn::PromoteTo(
+            uint16_tag,
+            hn::LoadU(pixel_tag, second_pred + i * BlockWidth + j));
+        pred = hn::AverageRound(pred, avg);
+      }
+      const auto diff = hn::Sub(
+          hn::BitCast(int16_tag, pred),
+          hn::BitCast(int16_tag,
+                      hn::PromoteTo(uint16_tag, hn::LoadU(pixel_tag, ref))));
+      AccumulateDiff(int16_tag, int32_tag, diff, sum_vec, sse_vec);
+      prev = cur;
+      ref += ref_stride;
+    }
+  }
+  const int sum = hn::ReduceSum(int32_tag, sum_vec);
+  *sse = static_cast<uint32_t>(hn::ReduceSum(int32_tag, sse_vec));
+  return *sse - static_cast<uint32_t>((static_cast<int64_t>(sum) * sum) /
+                                      (BlockWidth * BlockHeight));
+}
+
+#if CONFIG_AV1_HIGHBITDEPTH
+// Mirrors highbd_variance64() and the per-bit-depth scaling of
+// aom_highbd_{8,10,12}_variance*_c().
+template <int BlockWidth, int BlockHeight, int BitDepth>
+HWY_MAYBE_UNUSED HWY_ATTR uint32_t HighbdVariance(const uint8_t *src8,
+                                                  int src_stride,
+                                                  const uint8_t *ref8,
+                                                  int ref_stride,
+                                                  uint32_t *sse) {
+  constexpr hn::CappedTag<int16_t, BlockWidth> int16_tag;
+  constexpr hn::RebindToUnsigned<decltype(int16_tag)> pixel_tag;
+  constexpr hn::RepartitionToWide<decltype(int16_tag)> int32_tag;
+  constexpr hn::RebindToUnsigned<decltype(int32_tag)> uint32_tag;
+  constexpr hn::RepartitionToWide<decltype(uint32_tag)> uint64_tag;
+  const uint16_t *src_ptr = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref_ptr = CONVERT_TO_SHORTPTR(ref8);
+  const int vw = hn::Lanes(int16_tag);
+  auto sum_vec = hn::Zero(int32_tag);
+  auto sse_vec = hn::Zero(uint64_tag);
+  for (int i = 0; i < BlockHeight; ++i) {
+    // A row of squared 12-bit differences fits in 32 bits per lane.
+    auto row_sse = hn::Zero(int32_tag);
+    for (int j = 0; j < BlockWidth; j += vw) {
+      const auto src =
+          hn::BitCast(int16_tag, hn::LoadU(pixel_tag, src_ptr + j));
+      const auto ref =
+          hn::BitCast(int16_tag, hn::LoadU(pixel_tag, ref_ptr + j));
+      AccumulateDiff(int16_tag, int32_tag, hn::Sub(src, ref), sum_vec,
+                     row_sse);
+    }
+    sse_vec = hn::Add(sse_vec, hn::SumsOf2(hn::BitCast(uint32_tag, row_sse)));
+    src_ptr += src_stride;
+    ref_ptr += ref_stride;
+  }
+  const int64_t sum_long = hn::ReduceSum(int32_tag, sum_vec);
+  const uint64_t sse_long = hn::ReduceSum(uint64_tag, sse_vec);
+  *sse = static_cast<uint32_t>(
+      ROUND_POWER_OF_TWO(sse_long, 2 * (BitDepth - 8)));
+  const int sum =
+      static_cast<int>(ROUND_POWER_OF_TWO(sum_long, BitDepth - 8));
+  const int64_t var = static_cast<int64_t>(*sse) -
+                      ((static_cast<int64_t>(sum) * sum) /
+                       (BlockWidth * BlockHeight));
+  return var >= 0 ? static_cast<uint32_t>(var) : 0;
+}
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+
+}  // namespace HWY_NAMESPACE
+}  // namespace
+
+#define FVAR(w, h, suffix)                                                    \
+  extern "C" unsigned int aom_variance##w##x##h##_##suffix(                   \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, unsigned int *sse);                                     \
+  HWY_ATTR unsigned int aom_variance##w##x##h##_##suffix(                     \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, unsigned int *sse) {                                    \
+    return HWY_NAMESPACE::Variance<w, h>(src_ptr, src_stride, ref_ptr,        \
+                                         ref_stride, sse);                    \
+  }
+
+#define FSUBPIX_VAR(w, h, suffix)                                             \
+  extern "C" uint32_t aom_sub_pixel_variance##w##x##h##_##suffix(             \
+      const uint8_t *src_ptr, int src_stride, int xoffset, int yoffset,       \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse);                 \
+  HWY_ATTR uint32_t aom_sub_pixel_variance##w##x##h##_##suffix(               \
+      const uint8_t *src_ptr, int src_stride, int xoffset, int yoffset,       \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse) {                \
+    return HWY_NAMESPACE::SubPixelVariance<w, h>(                             \
+        src_ptr, src_stride, xoffset, yoffset, ref_ptr, ref_stride, sse);     \
+  }
+
+#define FSUBPIX_AVG_VAR(w, h, suffix)                                         \
+  extern "C" uint32_t aom_sub_pixel_avg_variance##w##x##h##_##suffix(         \
+      const uint8_t *src_ptr, int src_stride, int xoffset, int yoffset,       \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,                  \
+      const uint8_t *second_pred);                                            \
+  HWY_ATTR uint32_t aom_sub_pixel_avg_variance##w##x##h##_##suffix(           \
+      const uint8_t *src_ptr, int src_stride, int xoffset, int yoffset,       \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,                  \
+      const uint8_t *second_pred) {                                           \
+    return HWY_NAMESPACE::SubPixelVariance<w, h>(src_ptr, src_stride,         \
+                                                 xoffset, yoffset, ref_ptr,   \
+                                                 ref_stride, sse,             \
+                                                 second_pred);                \
+  }
+
+#define FHIGHBD_VAR_BD(w, h, bd, suffix)                                      \
+  extern "C" uint32_t aom_highbd_##bd##_variance##w##x##h##_##suffix(         \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse);                                         \
+  HWY_ATTR uint32_t aom_highbd_##bd##_variance##w##x##h##_##suffix(           \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    return HWY_NAMESPACE::HighbdVariance<w, h, bd>(src_ptr, src_stride,       \
+                                                   ref_ptr, ref_stride, sse); \
+  }
+
+#define FHIGHBD_VAR(w, h, suffix)  \
+  FHIGHBD_VAR_BD(w, h, 8, suffix)  \
+  FHIGHBD_VAR_BD(w, h, 10, suffix) \
+  FHIGHBD_VAR_BD(w, h, 12, suffix)
+
+#define FOR_EACH_VARIANCE_BLOCK_SIZE(X, suffix) \
+  X(128, 128, suffix)                           \
+  X(128, 64, suffix)                            \
+  X(64, 128, suffix)                            \
+  X(64, 64, suffix)                             \
+  X(64, 32, suffix)                             \
+  X(32, 64, suffix)                             \
+  X(32, 32, suffix)                             \
+  X(32, 16, suffix)                             \
+  X(16, 32, suffix)                             \
+  X(16, 16, suffix)                             \
+  X(16, 8, suffix)
+
+// Realtime mode doesn't use 4:1 rectangular blocks.
+#define FOR_EACH_VARIANCE_EXT_BLOCK_SIZE(X, suffix) \
+  X(16, 4, suffix)                                  \
+  X(32, 8, suffix)                                  \
+  X(16, 64, suffix)                                 \
+  X(64, 16, suffix)
+
+HWY_AFTER_NAMESPACE();
+
+#endif  // AOM_AOM_DSP_VARIANCE_HWY_H_
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "config/aom_dsp_rtcd.h"
+
+#include "aom_dsp/x86/entdec_sse2.h"
+
+// CDFs of more than 8 symbols are handled as one vector of 16 entries: the
+// 8 entries starting at index 0 and the 8 ending at index nsyms - 1, which
+// overlap unless nsyms is 16. Both halves are loaded and stored separately,
+// exactly as the SSE2 version does.
+
+static inline __m256i ec_load_cdf_16(const uint16_t *cdf, int start) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)cdf)),
+      _mm_loadu_si128((const __m128i *)(cdf + start)), 1);
+}
+
+int aom_ec_find_symbol_avx2(unsigned int c, unsigned int rng,
+                            const uint16_t *icdf, int nsyms) {
+  // Smaller CDFs are shorter than a vector.
+  if (nsyms < 4) return aom_ec_find_symbol_c(c, rng, icdf, nsyms);
+  if (nsyms <= 8) return ec_find_symbol_sse2(c, rng, icdf, nsyms);
+  const int start = nsyms - 8;
+  const __m256i cdf = ec_load_cdf_16(icdf, start);
+  // See ec_thresholds().
+  const __m256i p = _mm256_and_si256(_mm256_add_epi16(cdf, cdf),
+                                     _mm256_set1_epi16((int16_t)0xff80));
+  const __m256i min_prob = _mm256_sub_epi16(
+      _mm256_setr_m128i(_mm_set1_epi16(EC_MIN_PROB * (nsyms - 1)),
+                        _mm_set1_epi16(EC_MIN_PROB * (nsyms - 1 - start))),
+      _mm256_setr_epi16(0, EC_MIN_PROB, 2 * EC_MIN_PROB, 3 * EC_MIN_PROB,
+                        4 * EC_MIN_PROB, 5 * EC_MIN_PROB, 6 * EC_MIN_PROB,
+                        7 * EC_MIN_PROB, 0, EC_MIN_PROB, 2 * EC_MIN_PROB,
+                        3 * EC_MIN_PROB, 4 * EC_MIN_PROB, 5 * EC_MIN_PROB,
+                        6 * EC_MIN_PROB, 7 * EC_MIN_PROB));
+  const __m256i v = _mm256_add_epi16(
+      _mm256_mulhi_epu16(_mm256_set1_epi16((int16_t)(rng & 0xff00)), p),
+      min_prob);
+  const __m256i above = _mm256_subs_epu16(v, _mm256_set1_epi16((int16_t)c));
+  const unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+      _mm256_cmpeq_epi16(above, _mm256_setzero_si256()));
+  // The last entry always qualifies. The entries of the upper half that are
+  // shared with the lower half only qualify if an earlier entry does.
+  const int first = get_msb(mask & -mask) >> 1;
+  return first < 8 ? first : first - 8 + start;
+}
+
+void aom_update_cdf_avx2(uint16_t *cdf, int val, int nsyms) {
+  if (nsyms < 4) {
+    aom_update_cdf_c(cdf, val, nsyms);
+    return;
+  }
+  if (nsyms <= 8) {
+    ec_update_cdf_sse2(cdf, val, nsyms);
+    return;
+  }
+  const int start = nsyms - 8;
+  const __m256i p = ec_load_cdf_16(cdf, start);
+  const __m128i rate = ec_adaptation_rate(cdf, nsyms);
+  const __m256i lane = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4,
+                                         5, 6, 7);
+  const __m256i up = _mm256_cmpgt_epi16(
+      _mm256_setr_m128i(_mm_set1_epi16(val), _mm_set1_epi16(val - start)),
+      lane);
+  const __m256i inc = _mm256_srl_epi16(
+      _mm256_sub_epi16(_mm256_set1_epi16((int16_t)CDF_PROB_TOP), p), rate);
+  const __m256i dec = _mm256_srl_epi16(p, rate);
+  const __m256i out =
+      _mm256_sub_epi16(_mm256_add_epi16(p, _mm256_and_si256(up, inc)),
+                       _mm256_andnot_si256(up, dec));
+  // Both halves were adapted from the original values of the entries they
+  // share.
+  _mm_storeu_si128((__m128i *)(cdf + start), _mm256_extracti128_si256(out, 1));
+  _mm_storeu_si128((__m128i *)cdf, _mm256_castsi256_si128(out));
+  cdf[nsyms] += (cdf[nsyms] < 32);
+}
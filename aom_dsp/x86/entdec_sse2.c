@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "config/aom_dsp_rtcd.h"
+
+#include "aom_dsp/x86/entdec_sse2.h"
+
+int aom_ec_find_symbol_sse2(unsigned int c, unsigned int rng,
+                            const uint16_t *icdf, int nsyms) {
+  // Smaller CDFs are shorter than a vector.
+  if (nsyms < 4) return aom_ec_find_symbol_c(c, rng, icdf, nsyms);
+  return ec_find_symbol_sse2(c, rng, icdf, nsyms);
+}
+
+void aom_update_cdf_sse2(uint16_t *cdf, int val, int nsyms) {
+  if (nsyms < 4) {
+    aom_update_cdf_c(cdf, val, nsyms);
+    return;
+  }
+  ec_update_cdf_sse2(cdf, val, nsyms);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AOM_DSP_X86_ENTDEC_SSE2_H_
+#define AOM_AOM_DSP_X86_ENTDEC_SSE2_H_
+
+#include <emmintrin.h>  // SSE2
+
+#include "aom_dsp/entcode.h"
+#include "aom_dsp/prob.h"
+#include "aom_ports/bitops.h"
+
+// The CDF of an nsyms-symbol alphabet has nsyms entries followed by its
+// adaptation counter. The entries are processed as one vector of width 4 or 8
+// starting at index 0 and, if nsyms is larger than the width, a second one
+// ending at index nsyms - 1 that may overlap the first. The counter is never
+// part of a vector, and loads and stores of the same vector match exactly so
+// that consecutive accesses to one CDF benefit from store forwarding.
+
+static inline __m128i ec_load_cdf(const uint16_t *cdf, int width) {
+  return width == 8 ? _mm_loadu_si128((const __m128i *)cdf)
+                    : _mm_loadl_epi64((const __m128i *)cdf);
+}
+
+static inline void ec_store_cdf(uint16_t *cdf, __m128i v, int width) {
+  if (width == 8) {
+    _mm_storeu_si128((__m128i *)cdf, v);
+  } else {
+    _mm_storel_epi64((__m128i *)cdf, v);
+  }
+}
+
+// Returns the interval thresholds of entries start to start + 7 for a range
+// of rng, as computed by od_ec_decode_cdf_q15(). The entries of icdf before
+// the last one must be below CDF_PROB_TOP, which holds for all AV1 CDFs.
+static inline __m128i ec_thresholds(__m128i icdf, unsigned int rng, int start,
+                                    int nsyms) {
+  // (r >> 8) * (icdf >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT) is the high half
+  // of ((r >> 8) << 8) * ((icdf >> EC_PROB_SHIFT) << 7).
+  const __m128i r = _mm_set1_epi16((int16_t)(rng & 0xff00));
+  const __m128i p = _mm_and_si128(_mm_add_epi16(icdf, icdf),
+                                  _mm_set1_epi16((int16_t)0xff80));
+  const __m128i min_prob = _mm_sub_epi16(
+      _mm_set1_epi16(EC_MIN_PROB * (nsyms - 1 - start)),
+      _mm_setr_epi16(0, EC_MIN_PROB, 2 * EC_MIN_PROB, 3 * EC_MIN_PROB,
+                     4 * EC_MIN_PROB, 5 * EC_MIN_PROB, 6 * EC_MIN_PROB,
+                     7 * EC_MIN_PROB));
+  return _mm_add_epi16(_mm_mulhi_epu16(r, p), min_prob);
+}
+
+// Returns a mask with two bits set for each of the first width thresholds
+// that are not above c.
+static inline int ec_symbol_mask(__m128i v, unsigned int c, int width) {
+  const __m128i above = _mm_subs_epu16(v, _mm_set1_epi16((int16_t)c));
+  const int mask =
+      _mm_movemask_epi8(_mm_cmpeq_epi16(above, _mm_setzero_si128()));
+  return mask & ((1 << (2 * width)) - 1);
+}
+
+// Returns the index of the lowest entry flagged in a mask from
+// ec_symbol_mask(), which must not be 0.
+static inline int ec_first_symbol(int mask) {
+  return get_msb((unsigned int)(mask & -mask)) >> 1;
+}
+
+// Adapts entries start to start + 7 of a CDF towards symbol val, as
+// update_cdf() does.
+static inline __m128i ec_adapt_cdf(__m128i cdf, int val, int start,
+                                   __m128i rate) {
+  const __m128i lane = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m128i up = _mm_cmpgt_epi16(_mm_set1_epi16(val - start), lane);
+  const __m128i inc = _mm_srl_epi16(
+      _mm_sub_epi16(_mm_set1_epi16((int16_t)CDF_PROB_TOP), cdf), rate);
+  const __m128i dec = _mm_srl_epi16(cdf, rate);
+  // The last entry of the CDF is 0 and stays 0.
+  return _mm_sub_epi16(_mm_add_epi16(cdf, _mm_and_si128(up, inc)),
+                       _mm_andnot_si128(up, dec));
+}
+
+static inline __m128i ec_adaptation_rate(const uint16_t *cdf, int nsyms) {
+  return _mm_cvtsi32_si128(4 + (cdf[nsyms] >> 4) + (nsyms > 3));
+}
+
+static inline int ec_find_symbol_sse2(unsigned int c, unsigned int rng,
+                                      const uint16_t *icdf, int nsyms) {
+  const int width = nsyms < 8 ? 4 : 8;
+  const __m128i lo = ec_load_cdf(icdf, width);
+  const int mask = ec_symbol_mask(ec_thresholds(lo, rng, 0, nsyms), c, width);
+  if (mask) return ec_first_symbol(mask);
+  // The last entry always qualifies, so the symbol is in the second vector.
+  // Any entries it shares with the first do not qualify.
+  const int start = nsyms - width;
+  const __m128i hi = ec_load_cdf(icdf + start, width);
+  return start + ec_first_symbol(ec_symbol_mask(
+                     ec_thresholds(hi, rng, start, nsyms), c, width));
+}
+
+static inline void ec_update_cdf_sse2(uint16_t *cdf, int val, int nsyms) {
+  const int width = nsyms < 8 ? 4 : 8;
+  const __m128i rate = ec_adaptation_rate(cdf, nsyms);
+  const __m128i lo = ec_adapt_cdf(ec_load_cdf(cdf, width), val, 0, rate);
+  if (nsyms > width) {
+    // Both vectors are adapted before either is stored, so that the entries
+    // they share are updated from their original values.
+    const int start = nsyms - width;
+    ec_store_cdf(cdf + start,
+                 ec_adapt_cdf(ec_load_cdf(cdf + start, width), val, start,
+                              rate),
+                 width);
+  }
+  ec_store_cdf(cdf, lo, width);
+  cdf[nsyms] += (cdf[nsyms] < 32);
+}
+
+#endif  // AOM_AOM_DSP_X86_ENTDEC_SSE2_H_
@@ -23,3 +23,4 @@ FOR_EACH_SAD_BLOCK_SIZE(FSAD_AVG, avx2)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_4D, avx2)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_4D_SKIP, avx2)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_3D, avx2)
+FOR_EACH_SAD_BLOCK_SIZE(FSAD_8D, avx2)
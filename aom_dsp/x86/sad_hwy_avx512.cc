@@ -20,3 +20,4 @@ FOR_EACH_SAD_BLOCK_SIZE(FSAD_AVG, avx512)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_4D, avx512)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_4D_SKIP, avx512)
 FOR_EACH_SAD_BLOCK_SIZE(FSAD_3D, avx512)
+FOR_EACH_SAD_BLOCK_SIZE(FSAD_8D, avx512)
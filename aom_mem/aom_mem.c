@@ -9,12 +9,45 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+// Enable GNU extensions in glibc so that we can map anonymous memory in huge
+// pages. This must be before any #include statements.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "aom_mem.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 #include "include/aom_mem_intrnl.h"
 #include "aom/aom_integer.h"
+#include "aom_ports/aom_atomics.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define HAVE_HUGE_PAGES 1
+#else
+#define HAVE_HUGE_PAGES 0
+#endif
+
+// Allocations made by aom_memalign_tagged() start with this header. The
+// address saved before the aligned pointer then has TAGGED_ALLOC_FLAG set,
+// which malloc() never returns as it aligns to at least 8 bytes.
+typedef struct {
+  AomMemAccount *account;
+  // Bytes counted in 'account': the requested size, or 'map_size' for
+  // allocations placed in huge pages.
+  size_t size;
+  // Length of the mapping holding the allocation if it was placed in huge
+  // pages, 0 if it comes from malloc().
+  size_t map_size;
+  int tag;
+} TaggedAllocHeader;
+
+#define TAGGED_ALLOC_FLAG ((size_t)1)
+#define TAGGED_HEADER_SIZE                               \
+  ((sizeof(TaggedAllocHeader) + DEFAULT_ALIGNMENT - 1) & \
+   ~(size_t)(DEFAULT_ALIGNMENT - 1))
 
 static size_t GetAllocationPaddingSize(size_t align) {
   assert(align > 0);
@@ -74,9 +107,160 @@ void *aom_calloc(size_t num, size_t size) {
   return x;
 }
 
+#if AOM_HAVE_ATOMICS
+#define ACCOUNT_ADD(p, value) aom_atomic_fetch_add_size((p), (value))
+#else
+// Without atomics the counters are only exact if the tagged allocations of an
+// account all happen on one thread.
+static size_t account_add_plain(size_t *p, size_t value) {
+  const size_t prev = *p;
+  *p += value;
+  return prev;
+}
+#define ACCOUNT_ADD(p, value) account_add_plain((p), (value))
+#endif
+
+// Returns 0 if counting 'size' more bytes would exceed the limit of 'account'.
+static int account_add(AomMemAccount *account, int tag, size_t size) {
+  const size_t total = ACCOUNT_ADD(&account->total, size) + size;
+  if (account->limit != 0 && total > account->limit) {
+    ACCOUNT_ADD(&account->total, (size_t)0 - size);
+    return 0;
+  }
+  ACCOUNT_ADD(&account->bytes[tag], size);
+#if AOM_HAVE_ATOMICS
+  size_t peak = aom_atomic_load_size(&account->peak_total);
+  while (total > peak &&
+         !aom_atomic_compare_exchange_size(&account->peak_total, &peak,
+                                           total)) {
+  }
+#else
+  if (total > account->peak_total) account->peak_total = total;
+#endif
+  return 1;
+}
+
+static void account_sub(AomMemAccount *account, int tag, size_t size) {
+  ACCOUNT_ADD(&account->bytes[tag], (size_t)0 - size);
+  ACCOUNT_ADD(&account->total, (size_t)0 - size);
+}
+
+#if HAVE_HUGE_PAGES
+// Returns the length of the mapping map_huge_pages() makes for 'size' bytes,
+// or 0 if 'size' is too large.
+static size_t get_huge_pages_map_size(size_t size) {
+  if (size > SIZE_MAX - 2 * AOM_HUGE_PAGE_SIZE) return 0;
+  return (size + AOM_HUGE_PAGE_SIZE - 1) & ~(AOM_HUGE_PAGE_SIZE - 1);
+}
+
+// Maps get_huge_pages_map_size(size) bytes aligned to AOM_HUGE_PAGE_SIZE and
+// backed by huge pages if the system can provide them. Returns NULL on
+// failure.
+static void *map_huge_pages(int mode, size_t size, size_t *map_size) {
+  const size_t len = get_huge_pages_map_size(size);
+  if (len == 0) return NULL;
+#if defined(MAP_HUGETLB)
+  if (mode == AOM_HUGE_PAGES_EXPLICIT) {
+    void *const addr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr != MAP_FAILED) {
+      *map_size = len;
+      return addr;
+    }
+  }
+#else
+  (void)mode;
+#endif
+  // Map one more huge page than needed and trim the mapping so that it starts
+  // and ends on huge page boundaries.
+  const size_t padded_len = len + AOM_HUGE_PAGE_SIZE;
+  unsigned char *const addr =
+      (unsigned char *)mmap(NULL, padded_len, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if ((void *)addr == MAP_FAILED) return NULL;
+  unsigned char *const aligned =
+      (unsigned char *)aom_align_addr(addr, AOM_HUGE_PAGE_SIZE);
+  const size_t head = (size_t)(aligned - addr);
+  if (head > 0) munmap(addr, head);
+  if (padded_len - head > len) munmap(aligned + len, padded_len - head - len);
+#if defined(MADV_HUGEPAGE)
+  madvise(aligned, len, MADV_HUGEPAGE);
+#endif
+  *map_size = len;
+  return aligned;
+}
+#endif  // HAVE_HUGE_PAGES
+
+void *aom_memalign_tagged(AomMemAccount *account, int tag, size_t align,
+                          size_t size) {
+  if (account == NULL) return aom_memalign(align, size);
+  assert(tag >= 0 && tag < AOM_MEM_MAX_TAGS);
+  if (!check_size_argument_overflow(1, size, align + TAGGED_HEADER_SIZE))
+    return NULL;
+  const size_t aligned_size =
+      size + TAGGED_HEADER_SIZE + GetAllocationPaddingSize(align);
+  unsigned char *addr = NULL;
+  size_t map_size = 0;
+#if HAVE_HUGE_PAGES
+  if (account->huge_pages != AOM_HUGE_PAGES_OFF &&
+      aligned_size >= AOM_HUGE_PAGE_SIZE) {
+    // The whole mapping is counted, as huge pages are never shared with other
+    // allocations. If it does not fit in the limit, fall back to malloc().
+    const size_t len = get_huge_pages_map_size(aligned_size);
+    if (len > 0 && account_add(account, tag, len)) {
+      addr = (unsigned char *)map_huge_pages(account->huge_pages, aligned_size,
+                                             &map_size);
+      if (!addr) account_sub(account, tag, len);
+      assert(!addr || map_size == len);
+    }
+  }
+#endif
+  if (!addr) {
+    if (!account_add(account, tag, size)) return NULL;
+    addr = (unsigned char *)malloc(aligned_size);
+    if (!addr) {
+      account_sub(account, tag, size);
+      return NULL;
+    }
+  }
+  TaggedAllocHeader *const header = (TaggedAllocHeader *)addr;
+  header->account = account;
+  header->size = map_size > 0 ? map_size : size;
+  header->map_size = map_size;
+  header->tag = tag;
+  void *const x =
+      aom_align_addr(addr + TAGGED_HEADER_SIZE + ADDRESS_STORAGE_SIZE, align);
+  SetActualMallocAddress(x, (void *)((size_t)addr | TAGGED_ALLOC_FLAG));
+  return x;
+}
+
+void *aom_malloc_tagged(AomMemAccount *account, int tag, size_t size) {
+  return aom_memalign_tagged(account, tag, DEFAULT_ALIGNMENT, size);
+}
+
+void *aom_calloc_tagged(AomMemAccount *account, int tag, size_t num,
+                        size_t size) {
+  if (!check_size_argument_overflow(num, size, DEFAULT_ALIGNMENT)) return NULL;
+  const size_t total_size = num * size;
+  void *const x = aom_malloc_tagged(account, tag, total_size);
+  if (x) memset(x, 0, total_size);
+  return x;
+}
+
 void aom_free(void *memblk) {
   if (memblk) {
-    void *addr = GetActualMallocAddress(memblk);
-    free(addr);
+    size_t addr = (size_t)GetActualMallocAddress(memblk);
+    if (addr & TAGGED_ALLOC_FLAG) {
+      addr &= ~TAGGED_ALLOC_FLAG;
+      const TaggedAllocHeader *const header = (TaggedAllocHeader *)addr;
+      account_sub(header->account, header->tag, header->size);
+#if HAVE_HUGE_PAGES
+      if (header->map_size > 0) {
+        munmap((void *)addr, header->map_size);
+        return;
+      }
+#endif
+    }
+    free((void *)addr);
   }
 }
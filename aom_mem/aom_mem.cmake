@@ -15,6 +15,8 @@ set(AOM_AOM_MEM_AOM_MEM_CMAKE_ 1)
 
 list(APPEND AOM_MEM_SOURCES "${AOM_ROOT}/aom_mem/aom_mem.c"
             "${AOM_ROOT}/aom_mem/aom_mem.h"
+            "${AOM_ROOT}/aom_mem/aom_mem_pool.c"
+            "${AOM_ROOT}/aom_mem/aom_mem_pool.h"
             "${AOM_ROOT}/aom_mem/include/aom_mem_intrnl.h")
 
 # Creates the aom_mem build target and makes libaom depend on it. The libaom
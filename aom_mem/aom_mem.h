@@ -39,6 +39,56 @@ void *aom_malloc(size_t size);
 void *aom_calloc(size_t num, size_t size);
 void aom_free(void *memblk);
 
+// Maximum number of tags an AomMemAccount keeps separate counts for.
+#define AOM_MEM_MAX_TAGS 8
+
+// Running totals of the memory allocated on behalf of one owner (e.g. an
+// encoder instance) through aom_memalign_tagged() and friends, broken down by
+// tags chosen by the owner. The counters are updated atomically, so tagged
+// allocations and frees may happen on any thread. An all-zero AomMemAccount
+// is valid and has no limit.
+typedef struct AomMemAccount {
+  // Bytes currently allocated under each tag.
+  size_t bytes[AOM_MEM_MAX_TAGS];
+  // Sum of 'bytes'.
+  size_t total;
+  // Maximum value reached by 'total'.
+  size_t peak_total;
+  // When nonzero, tagged allocations that would take 'total' above 'limit'
+  // fail.
+  size_t limit;
+  // An AomHugePages value selecting the pages backing large tagged
+  // allocations.
+  int huge_pages;
+} AomMemAccount;
+
+// Size of the huge pages used for large tagged allocations. Allocations of at
+// least this size are the only ones placed in huge pages.
+#define AOM_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+typedef enum {
+  // Regular heap allocations.
+  AOM_HUGE_PAGES_OFF,
+  // Mappings aligned to AOM_HUGE_PAGE_SIZE that the kernel is advised to back
+  // with transparent huge pages.
+  AOM_HUGE_PAGES_TRANSPARENT,
+  // Mappings taken from the reserved huge page pool of the system, with a
+  // fallback to AOM_HUGE_PAGES_TRANSPARENT when the pool is exhausted.
+  AOM_HUGE_PAGES_EXPLICIT,
+} AomHugePages;
+
+// Same as aom_memalign(), aom_malloc() and aom_calloc(), but the allocation is
+// counted under 'tag' in 'account' until it is passed to aom_free(). If
+// 'account' is NULL they behave exactly as the untagged functions. An
+// allocation placed in huge pages is counted as the whole length of its
+// mapping. Huge pages are only available on Linux; elsewhere 'huge_pages' has
+// no effect.
+void *aom_memalign_tagged(AomMemAccount *account, int tag, size_t align,
+                          size_t size);
+void *aom_malloc_tagged(AomMemAccount *account, int tag, size_t size);
+void *aom_calloc_tagged(AomMemAccount *account, int tag, size_t num,
+                        size_t size);
+
 static inline void *aom_memset16(void *dest, int val, size_t length) {
   size_t i;
   uint16_t *dest16 = (uint16_t *)dest;
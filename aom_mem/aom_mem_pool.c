@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "aom_mem/aom_mem_pool.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aom_mem/aom_mem.h"
+
+// Header stored right before each buffer handed out by the pool.
+typedef struct AomMemPoolBlock {
+  AomMemPool *pool;
+  struct AomMemPoolBlock *next;
+  // Address returned by aom_memalign().
+  void *base;
+  size_t size;
+  size_t align;
+  // Tag of the pool when the block was allocated.
+  uint32_t tag;
+} AomMemPoolBlock;
+
+// Alignment of the block headers and minimum alignment of the buffers.
+#define POOL_MIN_ALIGN 16
+
+static size_t header_size(void) {
+  return (sizeof(AomMemPoolBlock) + POOL_MIN_ALIGN - 1) &
+         ~(size_t)(POOL_MIN_ALIGN - 1);
+}
+
+static AomMemPoolBlock *get_block(void *mem) {
+  return (AomMemPoolBlock *)((uint8_t *)mem - header_size());
+}
+
+static void *get_buffer(AomMemPoolBlock *block) {
+  return (uint8_t *)block + header_size();
+}
+
+// Returns the block to the heap.
+static void free_block(AomMemPool *pool, AomMemPoolBlock *block) {
+  pool->bytes -=
+      (size_t)((uint8_t *)get_buffer(block) - (uint8_t *)block->base) +
+      block->size;
+  aom_free(block->base);
+}
+
+void *aom_mem_pool_alloc(AomMemPool *pool, size_t align, size_t size) {
+  assert(align > 0 && (align & (align - 1)) == 0);
+  if (align < POOL_MIN_ALIGN) align = POOL_MIN_ALIGN;
+
+  AomMemPoolBlock **prev = &pool->free_list;
+  for (AomMemPoolBlock *block = pool->free_list; block != NULL;
+       block = block->next) {
+    if (block->size == size && block->align == align) {
+      *prev = block->next;
+      block->next = NULL;
+      pool->num_allocs++;
+      return get_buffer(block);
+    }
+    prev = &block->next;
+  }
+
+  // The header sits at the end of the padding, so that the buffer following
+  // it is aligned.
+  const size_t padding = (header_size() + align - 1) & ~(align - 1);
+  if (size > SIZE_MAX - padding) return NULL;
+  uint8_t *const base = (uint8_t *)aom_memalign(align, padding + size);
+  if (base == NULL) return NULL;
+  AomMemPoolBlock *const block =
+      (AomMemPoolBlock *)(base + padding - header_size());
+  block->pool = pool;
+  block->next = NULL;
+  block->base = base;
+  block->size = size;
+  block->align = align;
+  block->tag = pool->tag;
+
+  pool->bytes += padding + size;
+  if (pool->bytes > pool->peak_bytes) pool->peak_bytes = pool->bytes;
+  pool->num_allocs++;
+  pool->num_heap_allocs++;
+  return get_buffer(block);
+}
+
+void *aom_mem_pool_calloc(AomMemPool *pool, size_t align, size_t size) {
+  void *const mem = aom_mem_pool_alloc(pool, align, size);
+  if (mem != NULL) memset(mem, 0, size);
+  return mem;
+}
+
+void aom_mem_pool_free(void *mem) {
+  if (mem == NULL) return;
+  AomMemPoolBlock *const block = get_block(mem);
+  AomMemPool *const pool = block->pool;
+  if (block->tag != pool->tag) {
+    // Allocated for an earlier setting: its size is not expected again.
+    free_block(pool, block);
+    return;
+  }
+  block->next = pool->free_list;
+  pool->free_list = block;
+}
+
+void aom_mem_pool_set_tag(AomMemPool *pool, uint32_t tag) {
+  if (tag == pool->tag) return;
+  aom_mem_pool_trim(pool);
+  pool->tag = tag;
+}
+
+void aom_mem_pool_trim(AomMemPool *pool) {
+  AomMemPoolBlock *block = pool->free_list;
+  while (block != NULL) {
+    AomMemPoolBlock *const next = block->next;
+    free_block(pool, block);
+    block = next;
+  }
+  pool->free_list = NULL;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AOM_MEM_AOM_MEM_POOL_H_
+#define AOM_AOM_MEM_AOM_MEM_POOL_H_
+
+#include <stddef.h>
+
+#include "aom/aom_integer.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// A pool of scratch buffers that are allocated and freed over and over, e.g.
+// once per frame or per coding stage. Freed buffers are kept in the pool and
+// handed out again to later requests of the same size and alignment, so that
+// once every buffer size has been seen no further heap allocation is made.
+//
+// The sizes requested usually follow some setting of the user, e.g. the frame
+// size. The user sets a tag describing that setting with aom_mem_pool_set_tag()
+// before allocating: when the tag changes, the cached buffers are returned to
+// the heap, and so are the buffers still in use once they are freed, as no
+// later request is expected to have their size. aom_mem_pool_trim() also
+// returns the cached buffers to the heap.
+//
+// A pool is not thread safe: it must only be used by one thread at a time. An
+// all-zero AomMemPool is a valid empty pool.
+
+struct AomMemPoolBlock;
+
+typedef struct AomMemPool {
+  // Blocks that were freed and can be handed out again.
+  struct AomMemPoolBlock *free_list;
+  // Tag set by aom_mem_pool_set_tag(). Blocks allocated under another tag are
+  // not cached when freed.
+  uint32_t tag;
+  // Bytes currently obtained from the heap, whether in use or cached.
+  size_t bytes;
+  // Maximum value of 'bytes' since the pool was created.
+  size_t peak_bytes;
+  // Number of buffers handed out.
+  uint64_t num_allocs;
+  // Number of those requests that needed a heap allocation.
+  uint64_t num_heap_allocs;
+} AomMemPool;
+
+// Returns a buffer of 'size' bytes aligned to 'align' (a power of 2), or NULL
+// on allocation failure.
+void *aom_mem_pool_alloc(AomMemPool *pool, size_t align, size_t size);
+
+// Same as aom_mem_pool_alloc() but zeroes the buffer.
+void *aom_mem_pool_calloc(AomMemPool *pool, size_t align, size_t size);
+
+// Returns a buffer obtained from aom_mem_pool_alloc() or aom_mem_pool_calloc()
+// to the pool it came from. 'mem' may be NULL.
+void aom_mem_pool_free(void *mem);
+
+// Sets the tag of the pool. If it differs from the current one, the cached
+// buffers are returned to the heap, as are the buffers in use once freed.
+void aom_mem_pool_set_tag(AomMemPool *pool, uint32_t tag);
+
+// Returns the cached buffers of the pool to the heap. Buffers in use are not
+// affected.
+void aom_mem_pool_trim(AomMemPool *pool);
+
+#if defined(__cplusplus)
+}  // extern "C"
+#endif
+
+#endif  // AOM_AOM_MEM_AOM_MEM_POOL_H_
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AOM_PORTS_AOM_ATOMICS_H_
+#define AOM_AOM_PORTS_AOM_ATOMICS_H_
+
+// Minimal atomic operations on plain ints and size_ts, for the few places that
+// poll progress counters or update statistics shared between threads. All
+// operations are sequentially consistent except aom_atomic_load_acquire().
+// AOM_HAVE_ATOMICS is 0 when the compiler provides no suitable builtins;
+// callers must then fall back to mutex protected accesses.
+
+#include <stddef.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AOM_HAVE_ATOMICS 1
+
+static inline int aom_atomic_load(const int *p) {
+  return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+static inline int aom_atomic_load_acquire(const int *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void aom_atomic_store(int *p, int value) {
+  __atomic_store_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+static inline int aom_atomic_fetch_add(int *p, int value) {
+  return __atomic_fetch_add(p, value, __ATOMIC_SEQ_CST);
+}
+
+// Replaces *p with 'desired' if it equals *expected and returns 1. Otherwise
+// stores the current value of *p in *expected and returns 0.
+static inline int aom_atomic_compare_exchange(int *p, int *expected,
+                                              int desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, /*weak=*/0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline size_t aom_atomic_load_size(const size_t *p) {
+  return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+static inline size_t aom_atomic_fetch_add_size(size_t *p, size_t value) {
+  return __atomic_fetch_add(p, value, __ATOMIC_SEQ_CST);
+}
+
+static inline int aom_atomic_compare_exchange_size(size_t *p, size_t *expected,
+                                                   size_t desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, /*weak=*/0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+#define aom_cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+#define aom_cpu_relax() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define aom_cpu_relax() __asm__ __volatile__("" ::: "memory")
+#endif
+
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define AOM_HAVE_ATOMICS 1
+
+// The Interlocked intrinsics are full barriers.
+static inline int aom_atomic_load(const int *p) {
+  return (int)_InterlockedCompareExchange((volatile long *)p, 0, 0);
+}
+
+static inline int aom_atomic_load_acquire(const int *p) {
+  return aom_atomic_load(p);
+}
+
+static inline void aom_atomic_store(int *p, int value) {
+  _InterlockedExchange((volatile long *)p, value);
+}
+
+static inline int aom_atomic_fetch_add(int *p, int value) {
+  return (int)_InterlockedExchangeAdd((volatile long *)p, value);
+}
+
+static inline int aom_atomic_compare_exchange(int *p, int *expected,
+                                              int desired) {
+  const int prev = (int)_InterlockedCompareExchange((volatile long *)p,
+                                                    desired, *expected);
+  if (prev == *expected) return 1;
+  *expected = prev;
+  return 0;
+}
+
+#if defined(_WIN64)
+static inline size_t aom_atomic_fetch_add_size(size_t *p, size_t value) {
+  return (size_t)_InterlockedExchangeAdd64((volatile __int64 *)p,
+                                           (__int64)value);
+}
+
+static inline int aom_atomic_compare_exchange_size(size_t *p, size_t *expected,
+                                                   size_t desired) {
+  const size_t prev = (size_t)_InterlockedCompareExchange64(
+      (volatile __int64 *)p, (__int64)desired, (__int64)*expected);
+  if (prev == *expected) return 1;
+  *expected = prev;
+  return 0;
+}
+#else
+static inline size_t aom_atomic_fetch_add_size(size_t *p, size_t value) {
+  return (size_t)_InterlockedExchangeAdd((volatile long *)p, (long)value);
+}
+
+static inline int aom_atomic_compare_exchange_size(size_t *p, size_t *expected,
+                                                   size_t desired) {
+  const size_t prev = (size_t)_InterlockedCompareExchange(
+      (volatile long *)p, (long)desired, (long)*expected);
+  if (prev == *expected) return 1;
+  *expected = prev;
+  return 0;
+}
+#endif  // defined(_WIN64)
+
+static inline size_t aom_atomic_load_size(const size_t *p) {
+  return aom_atomic_fetch_add_size((size_t *)p, 0);
+}
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define aom_cpu_relax() _mm_pause()
+#elif defined(_M_ARM) || defined(_M_ARM64)
+#define aom_cpu_relax() __yield()
+#else
+#define aom_cpu_relax() ((void)0)
+#endif
+
+#else
+#define AOM_HAVE_ATOMICS 0
+#endif
+
+#endif  // AOM_AOM_PORTS_AOM_ATOMICS_H_
@@ -45,10 +45,14 @@ int aom_free_frame_buffer(YV12_BUFFER_CONFIG *ybf) {
     }
 #endif  // CONFIG_AV1_ENCODER && !CONFIG_REALTIME_ONLY
     aom_remove_metadata_from_frame_buffer(ybf);
+    struct AomMemAccount *const mem_account = ybf->mem_account;
+    const int mem_tag = ybf->mem_tag;
     /* buffer_alloc isn't accessed by most functions.  Rather y_buffer,
       u_buffer and v_buffer point to buffer_alloc and are used.  Clear out
       all of this so that a freed pointer isn't inadvertently used */
     memset(ybf, 0, sizeof(YV12_BUFFER_CONFIG));
+    ybf->mem_account = mem_account;
+    ybf->mem_tag = mem_tag;
     return 0;
   }
 
@@ -111,6 +115,12 @@ static int realloc_frame_buffer_aligned(
       if (fb->data == NULL || fb->size < external_frame_size)
         return AOM_CODEC_MEM_ERROR;
 
+      // The frame may have been given internal memory in the meantime, e.g.
+      // by aom_yv12_realloc_with_new_border().
+      if (ybf->buffer_alloc_sz > 0) {
+        aom_free(ybf->buffer_alloc);
+        ybf->buffer_alloc_sz = 0;
+      }
       ybf->buffer_alloc = (uint8_t *)aom_align_addr(fb->data, 32);
 
 #if defined(__has_feature)
@@ -129,7 +139,8 @@ static int realloc_frame_buffer_aligned(
 
       if (frame_size != (size_t)frame_size) return AOM_CODEC_MEM_ERROR;
 
-      ybf->buffer_alloc = (uint8_t *)aom_memalign(32, (size_t)frame_size);
+      ybf->buffer_alloc = (uint8_t *)aom_memalign_tagged(
+          ybf->mem_account, ybf->mem_tag, 32, (size_t)frame_size);
       if (!ybf->buffer_alloc) return AOM_CODEC_MEM_ERROR;
 
       ybf->buffer_alloc_sz = (size_t)frame_size;
@@ -117,6 +117,10 @@ typedef struct yv12_buffer_config {
 
   uint8_t *buffer_alloc;
   size_t buffer_alloc_sz;
+  // When not NULL, buffer_alloc is counted under mem_tag in this account when
+  // it is allocated. Kept by aom_free_frame_buffer().
+  struct AomMemAccount *mem_account;
+  int mem_tag;
   int border;
   size_t frame_size;
   int subsampling_x;
@@ -42,32 +42,62 @@ struct AVxWorkerImpl {
 
 static void execute(AVxWorker *const worker);  // Forward declaration.
 
-static THREADFN thread_loop(void *ptr) {
-  AVxWorker *const worker = (AVxWorker *)ptr;
+static void set_thread_name(const char *name) {
 #ifdef HAVE_PTHREAD_SETNAME_NP
 #ifdef __APPLE__
-  if (worker->thread_name != NULL) {
+  if (name != NULL) {
     // Apple's version of pthread_setname_np takes one argument and operates on
     // the current thread only. The maximum size of the thread_name buffer was
     // noted in the Chromium source code and was confirmed by experiments. If
     // thread_name is too long, pthread_setname_np returns -1 with errno
     // ENAMETOOLONG (63).
     char thread_name[64];
-    strncpy(thread_name, worker->thread_name, sizeof(thread_name) - 1);
+    strncpy(thread_name, name, sizeof(thread_name) - 1);
     thread_name[sizeof(thread_name) - 1] = '\0';
     pthread_setname_np(thread_name);
   }
 #elif (defined(__GLIBC__) && !defined(__GNU__)) || defined(__BIONIC__)
-  if (worker->thread_name != NULL) {
+  if (name != NULL) {
     // Linux and Android require names (with nul) fit in 16 chars, otherwise
     // pthread_setname_np() returns ERANGE (34).
     char thread_name[16];
-    strncpy(thread_name, worker->thread_name, sizeof(thread_name) - 1);
+    strncpy(thread_name, name, sizeof(thread_name) - 1);
     thread_name[sizeof(thread_name) - 1] = '\0';
     pthread_setname_np(pthread_self(), thread_name);
   }
 #endif
+#else
+  (void)name;
 #endif
+}
+
+// Initializes 'attr' with a stack large enough for the codec. Returns false on
+// error, in which case 'attr' does not need to be destroyed.
+static int init_thread_attr(pthread_attr_t *attr) {
+  if (pthread_attr_init(attr)) return 0;
+  // Debug ASan builds require at least ~1MiB of stack; prevents
+  // failures on macOS arm64 where the default is 512KiB.
+  // See: https://crbug.com/aomedia/3379
+#if defined(AOM_ADDRESS_SANITIZER) && defined(__APPLE__) && AOM_ARCH_ARM && \
+    !defined(NDEBUG)
+  const size_t kMinStackSize = 1024 * 1024;
+#else
+  const size_t kMinStackSize = 256 * 1024;
+#endif
+  size_t stacksize;
+  if (!pthread_attr_getstacksize(attr, &stacksize)) {
+    if (stacksize < kMinStackSize &&
+        pthread_attr_setstacksize(attr, kMinStackSize)) {
+      pthread_attr_destroy(attr);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static THREADFN thread_loop(void *ptr) {
+  AVxWorker *const worker = (AVxWorker *)ptr;
+  set_thread_name(worker->thread_name);
   pthread_mutex_lock(&worker->impl_->mutex_);
   for (;;) {
     while (worker->status_ == AVX_WORKER_STATUS_OK) {  // wait in idling mode
@@ -118,6 +148,281 @@ static void change_state(AVxWorker *const worker, AVxWorkerStatus new_status) {
   pthread_mutex_unlock(&worker->impl_->mutex_);
 }
 
+//------------------------------------------------------------------------------
+// Thread pool
+
+// Queue of the workers launched on one pool thread, stored in a circular
+// buffer. Jobs are popped oldest first, by the owner thread and by the threads
+// stealing from it alike.
+typedef struct {
+  pthread_mutex_t mutex_;
+  AVxWorker **jobs_;
+  int capacity_;
+  int head_;  // index of the oldest job
+  int size_;
+} AVxJobQueue;
+
+typedef struct {
+  AVxThreadPool *pool_;
+  int index_;
+  pthread_t thread_;
+} AVxPoolThread;
+
+struct aom_thread_pool {
+  // Protects the fields below as well as the status_ of the bound workers.
+  // When both are needed, 'mutex_' must be acquired before a queue's mutex.
+  pthread_mutex_t mutex_;
+  // Signaled when a job is queued and at shutdown.
+  pthread_cond_t work_cond_;
+  // Broadcast when a job finishes.
+  pthread_cond_t done_cond_;
+  // Number of queued jobs not yet reserved by a thread. A thread reserves a
+  // job by decrementing this counter, after which it is guaranteed to find a
+  // job in one of the queues.
+  int num_pending_;
+  // Queue that receives the next launched job.
+  int next_queue_;
+  int shutdown_;
+  // There is one queue per thread. 'num_threads_' is only lower than
+  // 'num_queues_' while aom_thread_pool_create() cleans up after a failure.
+  int num_queues_;
+  int num_threads_;
+  AVxJobQueue *queues_;
+  AVxPoolThread *threads_;
+};
+
+// Appends 'worker' to 'queue'. Returns false if the queue could not grow.
+static int job_queue_push(AVxJobQueue *const queue, AVxWorker *const worker) {
+  if (queue->size_ == queue->capacity_) {
+    const int new_capacity = queue->capacity_ > 0 ? 2 * queue->capacity_ : 8;
+    AVxWorker **const jobs =
+        (AVxWorker **)aom_malloc(new_capacity * sizeof(*jobs));
+    if (jobs == NULL) return 0;
+    for (int i = 0; i < queue->size_; ++i) {
+      jobs[i] = queue->jobs_[(queue->head_ + i) % queue->capacity_];
+    }
+    aom_free(queue->jobs_);
+    queue->jobs_ = jobs;
+    queue->capacity_ = new_capacity;
+    queue->head_ = 0;
+  }
+  queue->jobs_[(queue->head_ + queue->size_) % queue->capacity_] = worker;
+  ++queue->size_;
+  return 1;
+}
+
+// Removes and returns the oldest job of 'queue', or NULL if it is empty.
+static AVxWorker *job_queue_pop(AVxJobQueue *const queue) {
+  AVxWorker *worker = NULL;
+  pthread_mutex_lock(&queue->mutex_);
+  if (queue->size_ > 0) {
+    --queue->size_;
+    worker = queue->jobs_[queue->head_];
+    queue->head_ = (queue->head_ + 1) % queue->capacity_;
+  }
+  pthread_mutex_unlock(&queue->mutex_);
+  return worker;
+}
+
+// Removes 'worker' from 'queue'. Returns false if it is not queued there.
+static int job_queue_remove(AVxJobQueue *const queue,
+                            const AVxWorker *const worker) {
+  int found = 0;
+  pthread_mutex_lock(&queue->mutex_);
+  for (int i = 0; i < queue->size_; ++i) {
+    if (queue->jobs_[(queue->head_ + i) % queue->capacity_] != worker) continue;
+    for (int j = i + 1; j < queue->size_; ++j) {
+      queue->jobs_[(queue->head_ + j - 1) % queue->capacity_] =
+          queue->jobs_[(queue->head_ + j) % queue->capacity_];
+    }
+    --queue->size_;
+    found = 1;
+    break;
+  }
+  pthread_mutex_unlock(&queue->mutex_);
+  return found;
+}
+
+// Takes a job reserved by the caller: first from the queue of thread 'index',
+// then from the other queues in turn.
+static AVxWorker *take_reserved_job(AVxThreadPool *const pool, int index) {
+  for (int i = 0;; ++i) {
+    const int q = (index + i) % pool->num_queues_;
+    AVxWorker *const worker = job_queue_pop(&pool->queues_[q]);
+    if (worker != NULL) return worker;
+  }
+}
+
+static void finish_pool_job(AVxThreadPool *const pool,
+                            AVxWorker *const worker) {
+  pthread_mutex_lock(&pool->mutex_);
+  assert(worker->status_ == AVX_WORKER_STATUS_WORKING);
+  worker->status_ = AVX_WORKER_STATUS_OK;
+  pthread_cond_broadcast(&pool->done_cond_);
+  pthread_mutex_unlock(&pool->mutex_);
+}
+
+static THREADFN pool_thread_loop(void *ptr) {
+  AVxPoolThread *const thread = (AVxPoolThread *)ptr;
+  AVxThreadPool *const pool = thread->pool_;
+  set_thread_name("aom pool worker");
+  pthread_mutex_lock(&pool->mutex_);
+  for (;;) {
+    while (pool->num_pending_ == 0 && !pool->shutdown_) {
+      pthread_cond_wait(&pool->work_cond_, &pool->mutex_);
+    }
+    if (pool->num_pending_ == 0) break;  // shutdown
+    --pool->num_pending_;
+    pthread_mutex_unlock(&pool->mutex_);
+    AVxWorker *const worker = take_reserved_job(pool, thread->index_);
+    execute(worker);
+    finish_pool_job(pool, worker);
+    pthread_mutex_lock(&pool->mutex_);
+  }
+  pthread_mutex_unlock(&pool->mutex_);
+  return THREAD_EXIT_SUCCESS;
+}
+
+static void pool_launch(AVxWorker *const worker) {
+  AVxThreadPool *const pool = worker->pool;
+  pthread_mutex_lock(&pool->mutex_);
+  assert(worker->status_ == AVX_WORKER_STATUS_OK);
+  worker->status_ = AVX_WORKER_STATUS_WORKING;
+  AVxJobQueue *const queue = &pool->queues_[pool->next_queue_];
+  pool->next_queue_ = (pool->next_queue_ + 1) % pool->num_queues_;
+  pthread_mutex_lock(&queue->mutex_);
+  const int queued = job_queue_push(queue, worker);
+  pthread_mutex_unlock(&queue->mutex_);
+  if (queued) {
+    ++pool->num_pending_;
+    pthread_cond_signal(&pool->work_cond_);
+  }
+  pthread_mutex_unlock(&pool->mutex_);
+  if (!queued) {
+    // Out of memory: run the job on the calling thread instead.
+    execute(worker);
+    finish_pool_job(pool, worker);
+  }
+}
+
+static void pool_sync(AVxWorker *const worker) {
+  AVxThreadPool *const pool = worker->pool;
+  int run_here = 0;
+  pthread_mutex_lock(&pool->mutex_);
+  // If no thread has picked up the job yet, take it back and run it here
+  // rather than wait for a pool thread to become free. Only unreserved jobs
+  // may be taken, hence the check on num_pending_.
+  if (worker->status_ == AVX_WORKER_STATUS_WORKING && pool->num_pending_ > 0) {
+    for (int q = 0; q < pool->num_queues_ && !run_here; ++q) {
+      run_here = job_queue_remove(&pool->queues_[q], worker);
+    }
+    if (run_here) --pool->num_pending_;
+  }
+  if (!run_here) {
+    while (worker->status_ == AVX_WORKER_STATUS_WORKING) {
+      pthread_cond_wait(&pool->done_cond_, &pool->mutex_);
+    }
+  }
+  pthread_mutex_unlock(&pool->mutex_);
+  if (run_here) {
+    execute(worker);
+    finish_pool_job(pool, worker);
+  }
+}
+
+AVxThreadPool *aom_thread_pool_create(int num_threads) {
+  if (num_threads <= 0) return NULL;
+  int num_queues = 0;
+  AVxThreadPool *const pool = (AVxThreadPool *)aom_calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+  pool->queues_ =
+      (AVxJobQueue *)aom_calloc(num_threads, sizeof(*pool->queues_));
+  pool->threads_ =
+      (AVxPoolThread *)aom_calloc(num_threads, sizeof(*pool->threads_));
+  if (pool->queues_ == NULL || pool->threads_ == NULL) goto Error;
+  if (pthread_mutex_init(&pool->mutex_, NULL)) goto Error;
+  if (pthread_cond_init(&pool->work_cond_, NULL)) goto Error1;
+  if (pthread_cond_init(&pool->done_cond_, NULL)) goto Error2;
+  for (; num_queues < num_threads; ++num_queues) {
+    if (pthread_mutex_init(&pool->queues_[num_queues].mutex_, NULL)) break;
+  }
+  if (num_queues < num_threads) goto Error3;
+  pool->num_queues_ = num_queues;
+
+  pthread_attr_t attr;
+  if (!init_thread_attr(&attr)) goto Error3;
+  for (int i = 0; i < num_threads; ++i) {
+    AVxPoolThread *const thread = &pool->threads_[i];
+    thread->pool_ = pool;
+    thread->index_ = i;
+    if (pthread_create(&thread->thread_, &attr, pool_thread_loop, thread)) {
+      pthread_attr_destroy(&attr);
+      // Let the threads that did start exit, then release everything.
+      pool->num_threads_ = i;
+      aom_thread_pool_destroy(pool);
+      return NULL;
+    }
+  }
+  pthread_attr_destroy(&attr);
+  pool->num_threads_ = num_threads;
+  return pool;
+
+Error3:
+  for (int i = 0; i < num_queues; ++i) {
+    pthread_mutex_destroy(&pool->queues_[i].mutex_);
+  }
+  pthread_cond_destroy(&pool->done_cond_);
+Error2:
+  pthread_cond_destroy(&pool->work_cond_);
+Error1:
+  pthread_mutex_destroy(&pool->mutex_);
+Error:
+  aom_free(pool->queues_);
+  aom_free(pool->threads_);
+  aom_free(pool);
+  return NULL;
+}
+
+void aom_thread_pool_destroy(AVxThreadPool *pool) {
+  if (pool == NULL) return;
+  pthread_mutex_lock(&pool->mutex_);
+  assert(pool->num_pending_ == 0);
+  pool->shutdown_ = 1;
+  pthread_cond_broadcast(&pool->work_cond_);
+  pthread_mutex_unlock(&pool->mutex_);
+  for (int i = 0; i < pool->num_threads_; ++i) {
+    pthread_join(pool->threads_[i].thread_, NULL);
+  }
+  for (int i = 0; i < pool->num_queues_; ++i) {
+    pthread_mutex_destroy(&pool->queues_[i].mutex_);
+    aom_free(pool->queues_[i].jobs_);
+  }
+  pthread_cond_destroy(&pool->done_cond_);
+  pthread_cond_destroy(&pool->work_cond_);
+  pthread_mutex_destroy(&pool->mutex_);
+  aom_free(pool->queues_);
+  aom_free(pool->threads_);
+  aom_free(pool);
+}
+
+int aom_thread_pool_num_threads(const AVxThreadPool *pool) {
+  return pool->num_threads_;
+}
+
+#else  // !CONFIG_MULTITHREAD
+
+AVxThreadPool *aom_thread_pool_create(int num_threads) {
+  (void)num_threads;
+  return NULL;
+}
+
+void aom_thread_pool_destroy(AVxThreadPool *pool) { (void)pool; }
+
+int aom_thread_pool_num_threads(const AVxThreadPool *pool) {
+  (void)pool;
+  return 0;
+}
+
 #endif  // CONFIG_MULTITHREAD
 
 //------------------------------------------------------------------------------
@@ -129,7 +434,11 @@ static void init(AVxWorker *const worker) {
 
 static int sync(AVxWorker *const worker) {
 #if CONFIG_MULTITHREAD
-  change_state(worker, AVX_WORKER_STATUS_OK);
+  if (worker->pool != NULL) {
+    pool_sync(worker);
+  } else {
+    change_state(worker, AVX_WORKER_STATUS_OK);
+  }
 #endif
   assert(worker->status_ <= AVX_WORKER_STATUS_OK);
   return !worker->had_error;
@@ -140,6 +449,11 @@ static int reset(AVxWorker *const worker) {
   worker->had_error = 0;
   if (worker->status_ < AVX_WORKER_STATUS_OK) {
 #if CONFIG_MULTITHREAD
+    if (worker->pool != NULL) {
+      // The pool threads run the hook; there is nothing to start.
+      worker->status_ = AVX_WORKER_STATUS_OK;
+      return 1;
+    }
     worker->impl_ = (AVxWorkerImpl *)aom_calloc(1, sizeof(*worker->impl_));
     if (worker->impl_ == NULL) {
       return 0;
@@ -152,24 +466,7 @@ static int reset(AVxWorker *const worker) {
       goto Error;
     }
     pthread_attr_t attr;
-    if (pthread_attr_init(&attr)) goto Error2;
-    // Debug ASan builds require at least ~1MiB of stack; prevents
-    // failures on macOS arm64 where the default is 512KiB.
-    // See: https://crbug.com/aomedia/3379
-#if defined(AOM_ADDRESS_SANITIZER) && defined(__APPLE__) && AOM_ARCH_ARM && \
-    !defined(NDEBUG)
-    const size_t kMinStackSize = 1024 * 1024;
-#else
-    const size_t kMinStackSize = 256 * 1024;
-#endif
-    size_t stacksize;
-    if (!pthread_attr_getstacksize(&attr, &stacksize)) {
-      if (stacksize < kMinStackSize &&
-          pthread_attr_setstacksize(&attr, kMinStackSize)) {
-        pthread_attr_destroy(&attr);
-        goto Error2;
-      }
-    }
+    if (!init_thread_attr(&attr)) goto Error2;
     pthread_mutex_lock(&worker->impl_->mutex_);
     ok = !pthread_create(&worker->impl_->thread_, &attr, thread_loop, worker);
     if (ok) worker->status_ = AVX_WORKER_STATUS_OK;
@@ -202,7 +499,11 @@ static void execute(AVxWorker *const worker) {
 
 static void launch(AVxWorker *const worker) {
 #if CONFIG_MULTITHREAD
-  change_state(worker, AVX_WORKER_STATUS_WORKING);
+  if (worker->pool != NULL) {
+    pool_launch(worker);
+  } else {
+    change_state(worker, AVX_WORKER_STATUS_WORKING);
+  }
 #else
   execute(worker);
 #endif
@@ -210,7 +511,10 @@ static void launch(AVxWorker *const worker) {
 
 static void end(AVxWorker *const worker) {
 #if CONFIG_MULTITHREAD
-  if (worker->impl_ != NULL) {
+  if (worker->pool != NULL) {
+    sync(worker);
+    worker->status_ = AVX_WORKER_STATUS_NOT_OK;
+  } else if (worker->impl_ != NULL) {
     change_state(worker, AVX_WORKER_STATUS_NOT_OK);
     pthread_join(worker->impl_->thread_, NULL);
     pthread_mutex_destroy(&worker->impl_->mutex_);
@@ -17,6 +17,8 @@
 #ifndef AOM_AOM_UTIL_AOM_THREAD_H_
 #define AOM_AOM_UTIL_AOM_THREAD_H_
 
+#include "aom/aom_thread_pool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +38,9 @@ typedef int (*AVxWorkerHook)(void *, void *);
 // Platform-dependent implementation details for the worker.
 typedef struct AVxWorkerImpl AVxWorkerImpl;
 
+// A set of threads shared by several workers. See aom_thread_pool_create().
+typedef aom_thread_pool_t AVxThreadPool;
+
 // Synchronization object used to launch job in the worker thread
 typedef struct {
   AVxWorkerImpl *impl_;
@@ -48,6 +53,11 @@ typedef struct {
   void *data1;         // first argument passed to 'hook'
   void *data2;         // second argument passed to 'hook'
   int had_error;       // true if a call to 'hook' returned false
+  // If not NULL, the worker does not own a thread: launch() queues the hook on
+  // this pool and one of the pool threads runs it. Must be set after init()
+  // and before reset(), and the pool must outlive the worker. Only honored by
+  // the default worker interface.
+  AVxThreadPool *pool;
 } AVxWorker;
 
 // The interface for all thread-worker related functions. All these functions
@@ -85,6 +95,32 @@ int aom_set_worker_interface(const AVxWorkerInterface *const winterface);
 // Retrieve the currently set thread worker interface.
 const AVxWorkerInterface *aom_get_worker_interface(void);
 
+//------------------------------------------------------------------------------
+// Thread pool
+//
+// A pool runs the hooks of all the workers bound to it (see AVxWorker::pool)
+// on a fixed set of threads. Launched workers are spread over per-thread
+// queues, and every thread serves the oldest job of its own queue first, then
+// steals the oldest job from the other queues. Jobs are thus run roughly in
+// launch order, whichever codec instance sharing the pool (see
+// aom_thread_pool.h) launched them: the scheduling is first in, first out, not
+// fair between instances, so an instance launching many jobs delays the jobs
+// other instances launch after them. sync() on a worker whose job has not
+// been picked up yet runs the job on the calling thread, so a pool never
+// deadlocks even if it has fewer threads than bound workers.
+//
+// The pool only replaces the threads behind each launch/sync cycle: a codec
+// stage still syncs all of its workers before the next stage is launched, so
+// e.g. the CDEF of a superblock row never overlaps the encoding of the next
+// row.
+//
+// aom_thread_pool_create() and aom_thread_pool_destroy() are declared in
+// aom/aom_thread_pool.h. A pool must only be destroyed once all the workers
+// bound to it have been ended.
+
+// Returns the number of threads of the pool.
+int aom_thread_pool_num_threads(const AVxThreadPool *pool);
+
 //------------------------------------------------------------------------------
 
 #ifdef __cplusplus
@@ -321,6 +321,9 @@ const av1_codec_arg_definitions_t g_av1_codec_arg_defs = {
   .fpmtarg = ARG_DEF(
       NULL, "fp-mt", 1,
       "Enable frame parallel multi-threading (0: off (default), 1: on)"),
+  .row_mt_sync_mode = ARG_DEF(
+      NULL, "row-mt-sync-mode", 1,
+      "Row multi-threading synchronization (0: mutex (default), 1: atomic)"),
   .tile_cols =
       ARG_DEF(NULL, "tile-columns", 1, "Number of tile columns to use, log2"),
   .tile_rows =
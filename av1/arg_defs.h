@@ -123,6 +123,7 @@ typedef struct av1_codec_arg_definitions {
   arg_def_t cpu_used_av1;
   arg_def_t rowmtarg;
   arg_def_t fpmtarg;
+  arg_def_t row_mt_sync_mode;
   arg_def_t tile_cols;
   arg_def_t tile_rows;
   arg_def_t auto_tiles;
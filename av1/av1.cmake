@@ -111,6 +111,7 @@ list(APPEND AOM_AV1_DECODER_SOURCES
             "${AOM_ROOT}/av1/decoder/decodetxb.h"
             "${AOM_ROOT}/av1/decoder/detokenize.c"
             "${AOM_ROOT}/av1/decoder/detokenize.h"
+            "${AOM_ROOT}/av1/decoder/dthread.c"
             "${AOM_ROOT}/av1/decoder/dthread.h"
             "${AOM_ROOT}/av1/decoder/grain_synthesis.c"
             "${AOM_ROOT}/av1/decoder/grain_synthesis.h"
@@ -333,9 +334,14 @@ if(CONFIG_HIGHWAY)
   list(APPEND AOM_AV1_COMMON_INTRIN_AVX512
               "${AOM_ROOT}/av1/common/x86/selfguided_hwy_avx512.cc"
               "${AOM_ROOT}/av1/common/x86/warp_plane_hwy_avx512.cc"
-              "${AOM_ROOT}/av1/common/x86/convolve_2d_sr_hwy_avx512.cc")
+              "${AOM_ROOT}/av1/common/x86/convolve_2d_sr_hwy_avx512.cc"
+              "${AOM_ROOT}/av1/common/x86/av1_inv_txfm2d_hwy_avx512.cc"
+              "${AOM_ROOT}/av1/common/x86/cdef_block_hwy_avx512.cc")
 endif()
 
+list(APPEND AOM_AV1_DECODER_INTRIN_AVX2
+            "${AOM_ROOT}/av1/decoder/x86/grain_synthesis_avx2.c")
+
 list(APPEND AOM_AV1_ENCODER_ASM_SSE2 "${AOM_ROOT}/av1/encoder/x86/dct_sse2.asm"
             "${AOM_ROOT}/av1/encoder/x86/error_sse2.asm")
 
@@ -817,6 +823,11 @@ function(setup_av1_targets)
     add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_common"
                                   "AOM_AV1_COMMON_INTRIN_AVX2")
 
+    if(CONFIG_AV1_DECODER)
+      add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_decoder"
+                                    "AOM_AV1_DECODER_INTRIN_AVX2")
+    endif()
+
     if(CONFIG_AV1_ENCODER)
       add_intrinsics_object_library("-mavx2" "avx2" "aom_av1_encoder"
                                     "AOM_AV1_ENCODER_INTRIN_AVX2")
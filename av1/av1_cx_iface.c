@@ -35,6 +35,7 @@
 #include "av1/av1_iface_common.h"
 #include "av1/common/av1_common_int.h"
 #include "av1/common/enums.h"
+#include "av1/common/obu_util.h"
 #include "av1/common/quant_common.h"
 #include "av1/common/scale.h"
 #include "av1/encoder/av1_ext_ratectrl.h"
@@ -89,6 +90,7 @@ struct av1_extracfg {
   unsigned int static_thresh;
   unsigned int row_mt;
   unsigned int fp_mt;
+  unsigned int row_mt_sync_mode;
   unsigned int tile_columns;  // log2 number of tile columns
   unsigned int tile_rows;     // log2 number of tile rows
   unsigned int auto_tiles;
@@ -262,6 +264,7 @@ static const struct av1_extracfg default_extra_cfg = {
   0,              // static_thresh
   1,              // row_mt
   0,              // fp_mt
+  0,              // row_mt_sync_mode
   0,              // tile_columns
   0,              // tile_rows
   0,              // auto_tiles
@@ -421,6 +424,7 @@ static const struct av1_extracfg default_extra_cfg = {
   0,              // static_thresh
   1,              // row_mt
   0,              // fp_mt
+  0,              // row_mt_sync_mode
   0,              // tile_columns
   0,              // tile_rows
   0,              // auto_tiles
@@ -596,6 +600,16 @@ struct aom_codec_alg_priv {
   int num_lap_buffers;
   STATS_BUFFER_CTX stats_buf_context;
   bool monochrome_on_init;
+  // Zero-copy mode of the lookahead, see AV1E_SET_SOURCE_FRAME_CB.
+  aom_source_frame_cb_t source_frame_cb;
+  // External frame buffer functions, see AV1E_SET_FRAME_BUFFER_FUNCTIONS.
+  aom_frame_buffer_functions_t ext_fb_fns;
+  // Whether each tile group is output in its own packet, see
+  // AV1E_SET_TILE_GROUP_OUTPUT.
+  unsigned int tile_group_output;
+  // Wall time of the last call to encoder_encode(), see
+  // AV1E_GET_FRAME_STAGE_TIMES.
+  int64_t encode_time;
 };
 
 static inline int gcd(int64_t a, int b) {
@@ -789,6 +803,7 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
 
   RANGE_CHECK_HI(extra_cfg, row_mt, 1);
   RANGE_CHECK_HI(extra_cfg, fp_mt, 1);
+  RANGE_CHECK_HI(extra_cfg, row_mt_sync_mode, ROW_SYNC_MODES - 1);
 
   RANGE_CHECK_HI(extra_cfg, tile_columns, 6);
   RANGE_CHECK_HI(extra_cfg, tile_rows, 6);
@@ -1526,6 +1541,7 @@ static void set_encoder_config(AV1EncoderConfig *oxcf,
 
   oxcf->row_mt = extra_cfg->row_mt;
   oxcf->fp_mt = extra_cfg->fp_mt;
+  oxcf->row_mt_sync_mode = (ROW_SYNC_MODE)extra_cfg->row_mt_sync_mode;
 
   // Set motion mode related configuration.
   oxcf->motion_mode_cfg.enable_obmc = extra_cfg->enable_obmc;
@@ -1822,6 +1838,91 @@ static aom_codec_err_t ctrl_get_gop_info(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_get_scratch_mem_stats(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  aom_scratch_mem_stats_t *const stats =
+      va_arg(args, aom_scratch_mem_stats_t *);
+  if (stats == NULL) return AOM_CODEC_INVALID_PARAM;
+  av1_get_scratch_mem_stats(ctx->ppi, stats);
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_get_memory_usage(aom_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  aom_memory_usage_t *const usage = va_arg(args, aom_memory_usage_t *);
+  if (usage == NULL) return AOM_CODEC_INVALID_PARAM;
+  av1_get_memory_usage(ctx->ppi, usage);
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_get_frame_stage_times(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  aom_frame_stage_times_t *const times =
+      va_arg(args, aom_frame_stage_times_t *);
+  if (times == NULL) return AOM_CODEC_INVALID_PARAM;
+  av1_get_frame_stage_times(ctx->ppi, times);
+  times->encode_us = ctx->encode_time;
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_memory_budget(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  const unsigned int budget_mib = CAST(AV1E_SET_MEMORY_BUDGET, args);
+  AV1_PRIMARY *const ppi = ctx->ppi;
+  // The lookahead and the thread data are allocated on the first frame.
+  if (ppi->lookahead != NULL)
+    ERROR("Cannot set the memory budget after the first frame");
+  const uint64_t budget = (uint64_t)budget_mib << 20;
+
+  // Scale the configuration down until its estimated memory usage fits.
+  aom_codec_enc_cfg_t cfg = ctx->cfg;
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  while (budget > 0) {
+    AV1EncoderConfig oxcf = ctx->oxcf;
+    struct av1_extracfg tmp_extra_cfg = extra_cfg;
+    set_encoder_config(&oxcf, &cfg, &tmp_extra_cfg);
+    if (av1_estimate_memory_usage(&oxcf, ctx->num_lap_buffers) <= budget)
+      break;
+    if (cfg.g_threads > 1) {
+      cfg.g_threads--;
+    } else if (extra_cfg.enable_tpl_model) {
+      extra_cfg.enable_tpl_model = 0;
+    } else if (cfg.g_lag_in_frames > 0 && ctx->num_lap_buffers == 0) {
+      // The lag is fixed at initialization when LAP is enabled.
+      cfg.g_lag_in_frames--;
+    } else {
+      ERROR("Memory budget too small for the configuration");
+    }
+  }
+
+  if (cfg.g_threads != ctx->cfg.g_threads ||
+      cfg.g_lag_in_frames != ctx->cfg.g_lag_in_frames) {
+    const aom_codec_err_t res = encoder_set_config(ctx, &cfg);
+    if (res != AOM_CODEC_OK) return res;
+  }
+  if (extra_cfg.enable_tpl_model != ctx->extra_cfg.enable_tpl_model) {
+    const aom_codec_err_t res = update_extra_cfg(ctx, &extra_cfg);
+    if (res != AOM_CODEC_OK) return res;
+  }
+  ppi->mem_account.limit = (size_t)AOMMIN(budget, (uint64_t)SIZE_MAX);
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_tile_group_output(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  ctx->tile_group_output = CAST(AV1E_SET_TILE_GROUP_OUTPUT, args) != 0;
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_huge_pages(aom_codec_alg_priv_t *ctx,
+                                           va_list args) {
+  const int huge_pages = CAST(AV1E_SET_HUGE_PAGES, args);
+  if (huge_pages < AOM_HUGE_PAGES_OFF || huge_pages > AOM_HUGE_PAGES_EXPLICIT)
+    return AOM_CODEC_INVALID_PARAM;
+  ctx->ppi->mem_account.huge_pages = huge_pages;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_cpuused(aom_codec_alg_priv_t *ctx,
                                         va_list args) {
   struct av1_extracfg extra_cfg = ctx->extra_cfg;
@@ -1881,6 +1982,22 @@ static aom_codec_err_t ctrl_set_row_mt(aom_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static aom_codec_err_t ctrl_set_row_mt_sync_mode(aom_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.row_mt_sync_mode = CAST(AV1E_SET_ROW_MT_SYNC_MODE, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static aom_codec_err_t ctrl_set_thread_pool(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  PrimaryMultiThreadInfo *const p_mt_info = &ctx->ppi->p_mt_info;
+  // The workers are bound to their pool when they are created.
+  if (p_mt_info->num_workers > 0) return AOM_CODEC_ERROR;
+  p_mt_info->external_thread_pool = CAST(AV1E_SET_THREAD_POOL, args);
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_tile_columns(aom_codec_alg_priv_t *ctx,
                                              va_list args) {
   // If the control AUTO_TILES is used (set to 1) then don't override
@@ -3008,6 +3125,10 @@ aom_codec_err_t av1_create_context_and_bufferpool(AV1_PRIMARY *ppi,
       aom_free(buffer_pool);
       return AOM_CODEC_MEM_ERROR;
     }
+    for (int i = 0; i < buffer_pool->num_frame_bufs; i++) {
+      buffer_pool->frame_bufs[i].buf.mem_account = &ppi->mem_account;
+      buffer_pool->frame_bufs[i].buf.mem_tag = AV1_MEM_FRAME_BUFFERS;
+    }
 #if CONFIG_MULTITHREAD
     if (pthread_mutex_init(&buffer_pool->pool_mutex, NULL)) {
       aom_free(buffer_pool->frame_bufs);
@@ -3016,6 +3137,25 @@ aom_codec_err_t av1_create_context_and_bufferpool(AV1_PRIMARY *ppi,
       aom_free(buffer_pool);
       return AOM_CODEC_MEM_ERROR;
     }
+    // Only the decoder tracks frame progress, but every BufferPool has its
+    // progress mutex and condition initialized.
+    if (pthread_mutex_init(&buffer_pool->progress_mutex, NULL)) {
+      pthread_mutex_destroy(&buffer_pool->pool_mutex);
+      aom_free(buffer_pool->frame_bufs);
+      buffer_pool->frame_bufs = NULL;
+      buffer_pool->num_frame_bufs = 0;
+      aom_free(buffer_pool);
+      return AOM_CODEC_MEM_ERROR;
+    }
+    if (pthread_cond_init(&buffer_pool->progress_cond, NULL)) {
+      pthread_mutex_destroy(&buffer_pool->progress_mutex);
+      pthread_mutex_destroy(&buffer_pool->pool_mutex);
+      aom_free(buffer_pool->frame_bufs);
+      buffer_pool->frame_bufs = NULL;
+      buffer_pool->num_frame_bufs = 0;
+      aom_free(buffer_pool);
+      return AOM_CODEC_MEM_ERROR;
+    }
 #endif
     *p_buffer_pool = buffer_pool;
   }
@@ -3188,6 +3328,8 @@ void av1_destroy_context_and_bufferpool(AV1_COMP *cpi,
     av1_free_ref_frame_buffers(*p_buffer_pool);
 #if CONFIG_MULTITHREAD
     pthread_mutex_destroy(&(*p_buffer_pool)->pool_mutex);
+    pthread_mutex_destroy(&(*p_buffer_pool)->progress_mutex);
+    pthread_cond_destroy(&(*p_buffer_pool)->progress_cond);
 #endif
     aom_free(*p_buffer_pool);
     *p_buffer_pool = NULL;
@@ -3296,13 +3438,95 @@ static inline int get_src_border_in_pixels(AV1_COMP *cpi, BLOCK_SIZE sb_size) {
   return border_in_pixels;
 }
 
-// TODO(Mufaddal): Check feasibility of abstracting functions related to LAP
-// into a separate function.
-static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
-                                      const aom_image_t *img,
-                                      aom_codec_pts_t pts,
-                                      unsigned long duration,
-                                      aom_enc_frame_flags_t enc_flags) {
+// Sets the border of the frame buffers of the encoder from its configuration
+// and returns the border of the source frames in the lookahead.
+static int setup_border_in_pixels(AV1_PRIMARY *ppi) {
+  AV1_COMP *const cpi = ppi->cpi;
+  AV1EncoderConfig *oxcf = &cpi->oxcf;
+  const BLOCK_SIZE sb_size =
+      av1_select_sb_size(oxcf, oxcf->frm_dim_cfg.width,
+                         oxcf->frm_dim_cfg.height, ppi->number_spatial_layers);
+  oxcf->border_in_pixels =
+      av1_get_enc_border_size(av1_is_resize_needed(oxcf),
+                              oxcf->kf_cfg.key_freq_max == 0, sb_size);
+  for (int i = 0; i < ppi->num_fp_contexts; i++) {
+    ppi->parallel_cpi[i]->oxcf.border_in_pixels = oxcf->border_in_pixels;
+  }
+  return get_src_border_in_pixels(cpi, sb_size);
+}
+
+// Checks that an image meets the requirements of the zero-copy mode, see
+// AV1E_SET_SOURCE_FRAME_CB.
+static void check_external_source_frame(AV1_PRIMARY *ppi,
+                                        const aom_image_t *img,
+                                        const YV12_BUFFER_CONFIG *sd) {
+  if (img->fmt == AOM_IMG_FMT_NV12) {
+    aom_internal_error(&ppi->error, AOM_CODEC_INVALID_PARAM,
+                       "NV12 source images cannot be referenced");
+  }
+  const int num_planes = sd->monochrome ? 1 : MAX_MB_PLANE;
+  for (int plane = 0; plane < num_planes; ++plane) {
+    const int align_mask = plane == AOM_PLANE_Y ? 31 : 15;
+    if (((uintptr_t)img->planes[plane] & align_mask) ||
+        (img->stride[plane] & align_mask)) {
+      aom_internal_error(&ppi->error, AOM_CODEC_INVALID_PARAM,
+                         "Source image planes or strides misaligned");
+    }
+  }
+  if (sd->border < ppi->lookahead->border_in_pixels) {
+    aom_internal_error(&ppi->error, AOM_CODEC_INVALID_PARAM,
+                       "Source image border too small: %d, %d required",
+                       sd->border, ppi->lookahead->border_in_pixels);
+  }
+}
+
+// Adds the temporal unit held by 'pkt' to the packet list as several packets
+// split at tile group OBU boundaries, see AV1E_SET_TILE_GROUP_OUTPUT.
+static void add_tile_group_packets(aom_codec_alg_priv_t *ctx,
+                                   const aom_codec_cx_pkt_t *pkt) {
+  const uint8_t *const data = (const uint8_t *)pkt->data.frame.buf;
+  const size_t size = pkt->data.frame.sz;
+  struct aom_codec_pkt_list *const list = &ctx->pkt_list.head;
+  aom_codec_cx_pkt_t fragment = *pkt;
+  size_t start = 0;
+  size_t pos = 0;
+  int prev_is_tile_group = 0;
+  fragment.data.frame.partition_id = 0;
+  while (pos < size) {
+    ObuHeader obu_header;
+    size_t payload_size;
+    size_t bytes_read;
+    if (aom_read_obu_header_and_size(data + pos, size - pos, /*is_annexb=*/0,
+                                     &obu_header, &payload_size,
+                                     &bytes_read) != AOM_CODEC_OK ||
+        payload_size > size - pos - bytes_read) {
+      break;
+    }
+    const int is_tile_group = obu_header.type == OBU_TILE_GROUP;
+    // Keep the last free slot of the list for the rest of the unit.
+    if (pos > start && (is_tile_group || prev_is_tile_group) &&
+        list->cnt + 1 < list->max) {
+      fragment.data.frame.buf = (uint8_t *)data + start;
+      fragment.data.frame.sz = pos - start;
+      fragment.data.frame.flags = pkt->data.frame.flags | AOM_FRAME_IS_FRAGMENT;
+      aom_codec_pkt_list_add(list, &fragment);
+      fragment.data.frame.partition_id++;
+      start = pos;
+    }
+    prev_is_tile_group = is_tile_group;
+    pos += bytes_read + payload_size;
+  }
+  fragment.data.frame.buf = (uint8_t *)data + start;
+  fragment.data.frame.sz = size - start;
+  fragment.data.frame.flags = pkt->data.frame.flags;
+  aom_codec_pkt_list_add(list, &fragment);
+}
+
+static aom_codec_err_t encode_frames(aom_codec_alg_priv_t *ctx,
+                                     const aom_image_t *img,
+                                     aom_codec_pts_t pts,
+                                     unsigned long duration,
+                                     aom_enc_frame_flags_t enc_flags) {
   const size_t kMinCompressedSize = 8192;
   volatile aom_codec_err_t res = AOM_CODEC_OK;
   AV1_PRIMARY *const ppi = ctx->ppi;
@@ -3509,28 +3733,21 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       if (!ppi->lookahead) {
         int lag_in_frames = cpi_lap != NULL ? cpi_lap->oxcf.gf_cfg.lag_in_frames
                                             : cpi->oxcf.gf_cfg.lag_in_frames;
-        AV1EncoderConfig *oxcf = &cpi->oxcf;
-        const BLOCK_SIZE sb_size = av1_select_sb_size(
-            oxcf, oxcf->frm_dim_cfg.width, oxcf->frm_dim_cfg.height,
-            ppi->number_spatial_layers);
-        oxcf->border_in_pixels =
-            av1_get_enc_border_size(av1_is_resize_needed(oxcf),
-                                    oxcf->kf_cfg.key_freq_max == 0, sb_size);
-        for (int i = 0; i < ppi->num_fp_contexts; i++) {
-          ppi->parallel_cpi[i]->oxcf.border_in_pixels = oxcf->border_in_pixels;
-        }
-
-        const int src_border_in_pixels = get_src_border_in_pixels(cpi, sb_size);
+        const int src_border_in_pixels = setup_border_in_pixels(ppi);
         ppi->lookahead = av1_lookahead_init(
             cpi->oxcf.frm_dim_cfg.width, cpi->oxcf.frm_dim_cfg.height,
             subsampling_x, subsampling_y, use_highbitdepth, lag_in_frames,
             src_border_in_pixels, cpi->common.features.byte_alignment,
             ctx->num_lap_buffers, (cpi->oxcf.kf_cfg.key_freq_max == 0),
-            cpi->alloc_pyramid);
+            cpi->alloc_pyramid, &ppi->mem_account,
+            ctx->source_frame_cb.release_cb, ctx->source_frame_cb.cb_priv);
       }
       if (!ppi->lookahead)
         aom_internal_error(&ppi->error, AOM_CODEC_MEM_ERROR,
                            "Failed to allocate lag buffers");
+      if (ppi->lookahead->release_cb != NULL) {
+        check_external_source_frame(ppi, img, &sd);
+      }
       for (int i = 0; i < ppi->num_fp_contexts; i++) {
         aom_codec_err_t err =
             av1_check_initial_width(ppi->parallel_cpi[i], use_highbitdepth,
@@ -3552,7 +3769,8 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       // Store the original flags in to the frame buffer. Will extract the
       // key frame flag when we actually encode this frame.
       if (av1_receive_raw_frame(cpi, flags | ctx->next_frame_flags, &sd,
-                                src_time_stamp, src_end_time_stamp)) {
+                                src_time_stamp, src_end_time_stamp,
+                                img->user_priv)) {
         res = update_error_state(ctx, cpi->common.error);
       }
       ctx->next_frame_flags = 0;
@@ -3875,7 +4093,11 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       }
       pkt.data.frame.duration = (uint32_t)duration64;
 
-      aom_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      if (ctx->tile_group_output && !ctx->oxcf.save_as_annexb) {
+        add_tile_group_packets(ctx, &pkt);
+      } else {
+        aom_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      }
 
       ctx->pending_cx_data_sz = 0;
     }
@@ -3885,11 +4107,94 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
   return res;
 }
 
+// TODO(Mufaddal): Check feasibility of abstracting functions related to LAP
+// into a separate function.
+static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
+                                      const aom_image_t *img,
+                                      aom_codec_pts_t pts,
+                                      unsigned long duration,
+                                      aom_enc_frame_flags_t enc_flags) {
+  struct aom_usec_timer timer;
+  av1_reset_frame_stage_times(ctx->ppi);
+  aom_usec_timer_start(&timer);
+  const aom_codec_err_t res = encode_frames(ctx, img, pts, duration, enc_flags);
+  aom_usec_timer_mark(&timer);
+  ctx->encode_time = aom_usec_timer_elapsed(&timer);
+  return res;
+}
+
 static const aom_codec_cx_pkt_t *encoder_get_cxdata(aom_codec_alg_priv_t *ctx,
                                                     aom_codec_iter_t *iter) {
   return aom_codec_pkt_list_get(&ctx->pkt_list.head, iter);
 }
 
+static aom_codec_err_t ctrl_set_source_frame_cb(aom_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  const aom_source_frame_cb_t *const cb =
+      va_arg(args, const aom_source_frame_cb_t *);
+  if (cb == NULL) return AOM_CODEC_INVALID_PARAM;
+  // The mode of the lookahead is set when it is created.
+  if (ctx->ppi->lookahead != NULL) return AOM_CODEC_ERROR;
+  ctx->source_frame_cb = *cb;
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_get_source_border(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  int *const arg = va_arg(args, int *);
+  if (arg == NULL) return AOM_CODEC_INVALID_PARAM;
+  AV1_PRIMARY *const ppi = ctx->ppi;
+  *arg = ppi->lookahead != NULL ? ppi->lookahead->border_in_pixels
+                                : setup_border_in_pixels(ppi);
+  return AOM_CODEC_OK;
+}
+
+static int release_ext_frame_buffer(void *priv, aom_codec_frame_buffer_t *fb) {
+  const aom_frame_buffer_functions_t *const fns =
+      (const aom_frame_buffer_functions_t *)priv;
+  const int ret = fns->release_fb(fns->cb_priv, fb);
+  fb->data = NULL;
+  fb->size = 0;
+  fb->priv = NULL;
+  return ret;
+}
+
+// The encoder reallocates the frame buffers of its pool for every frame it
+// codes into them, but keeps their memory as long as it is large enough. Do
+// the same with the external frame buffers.
+static int get_ext_frame_buffer(void *priv, size_t min_size,
+                                aom_codec_frame_buffer_t *fb) {
+  const aom_frame_buffer_functions_t *const fns =
+      (const aom_frame_buffer_functions_t *)priv;
+  if (fb->data != NULL) {
+    if (fb->size >= min_size) return 0;
+    if (release_ext_frame_buffer(priv, fb) < 0) return -1;
+  }
+  return fns->get_fb(fns->cb_priv, min_size, fb);
+}
+
+static void set_ext_frame_buffer_functions(aom_codec_alg_priv_t *ctx,
+                                           BufferPool *pool) {
+  if (pool == NULL) return;
+  pool->get_fb_cb = get_ext_frame_buffer;
+  pool->release_fb_cb = release_ext_frame_buffer;
+  pool->cb_priv = &ctx->ext_fb_fns;
+}
+
+static aom_codec_err_t ctrl_set_frame_buffer_functions(
+    aom_codec_alg_priv_t *ctx, va_list args) {
+  const aom_frame_buffer_functions_t *const fns =
+      va_arg(args, const aom_frame_buffer_functions_t *);
+  if (fns == NULL || fns->get_fb == NULL || fns->release_fb == NULL)
+    return AOM_CODEC_INVALID_PARAM;
+  // Do not swap the allocator of frame buffers that may hold memory already.
+  if (ctx->ppi->lookahead != NULL) return AOM_CODEC_ERROR;
+  ctx->ext_fb_fns = *fns;
+  set_ext_frame_buffer_functions(ctx, ctx->buffer_pool);
+  set_ext_frame_buffer_functions(ctx, ctx->buffer_pool_lap);
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_reference(aom_codec_alg_priv_t *ctx,
                                           va_list args) {
   av1_ref_frame_t *const frame = va_arg(args, av1_ref_frame_t *);
@@ -4487,6 +4792,9 @@ static aom_codec_err_t encoder_set_option(aom_codec_alg_priv_t *ctx,
   } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.fpmtarg, argv,
                               err_string)) {
     extra_cfg.fp_mt = arg_parse_uint_helper(&arg, err_string);
+  } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.row_mt_sync_mode,
+                              argv, err_string)) {
+    extra_cfg.row_mt_sync_mode = arg_parse_uint_helper(&arg, err_string);
   } else if (arg_match_helper(&arg, &g_av1_codec_arg_defs.tile_cols, argv,
                               err_string)) {
     extra_cfg.tile_columns = arg_parse_uint_helper(&arg, err_string);
@@ -5110,6 +5418,8 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_SET_LOOPFILTER_CONTROL, ctrl_set_loopfilter_control },
   { AV1E_SET_SKIP_POSTPROC_FILTERING, ctrl_set_skip_postproc_filtering },
   { AV1E_SET_MODE_REF_DELTA_ENABLED, ctrl_set_mode_ref_delta_enabled },
+  { AV1E_SET_ROW_MT_SYNC_MODE, ctrl_set_row_mt_sync_mode },
+  { AV1E_SET_THREAD_POOL, ctrl_set_thread_pool },
   { AV1E_SET_AUTO_INTRA_TOOLS_OFF, ctrl_set_auto_intra_tools_off },
   { AV1E_SET_RTC_EXTERNAL_RC, ctrl_set_rtc_external_rc },
   { AV1E_SET_QUANTIZER_ONE_PASS, ctrl_set_quantizer_one_pass },
@@ -5146,6 +5456,15 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_GET_HIGH_MOTION_CONTENT_SCREEN_RTC,
     ctrl_get_high_motion_content_screen_rtc },
   { AV1E_GET_GOP_INFO, ctrl_get_gop_info },
+  { AV1E_GET_SCRATCH_MEM_STATS, ctrl_get_scratch_mem_stats },
+  { AV1E_GET_MEMORY_USAGE, ctrl_get_memory_usage },
+  { AV1E_SET_MEMORY_BUDGET, ctrl_set_memory_budget },
+  { AV1E_SET_HUGE_PAGES, ctrl_set_huge_pages },
+  { AV1E_SET_TILE_GROUP_OUTPUT, ctrl_set_tile_group_output },
+  { AV1E_GET_FRAME_STAGE_TIMES, ctrl_get_frame_stage_times },
+  { AV1E_SET_SOURCE_FRAME_CB, ctrl_set_source_frame_cb },
+  { AV1E_GET_SOURCE_BORDER, ctrl_get_source_border },
+  { AV1E_SET_FRAME_BUFFER_FUNCTIONS, ctrl_set_frame_buffer_functions },
 
   CTRL_MAP_END,
 };
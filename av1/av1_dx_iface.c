@@ -41,6 +41,12 @@
 
 #include "av1/av1_iface_common.h"
 
+// Number of frame workers in frame-parallel mode. The tiles of a temporal unit
+// are only decoded once those of the previous one are, so more workers would
+// only help when the in-loop filters of a frame take longer than the tiles of
+// the next one.
+#define FRAME_PARALLEL_WORKERS 2
+
 struct aom_codec_alg_priv {
   aom_codec_priv_t base;
   aom_codec_dec_cfg_t cfg;
@@ -53,6 +59,8 @@ struct aom_codec_alg_priv {
   int byte_alignment;
   int skip_loop_filter;
   int skip_film_grain;
+  int block_stage_timing;
+  int inplace_film_grain;
   int decode_tile_row;
   int decode_tile_col;
   unsigned int tile_mode;
@@ -63,8 +71,20 @@ struct aom_codec_alg_priv {
   int operating_point;
   int output_all_layers;
   unsigned int frame_size_limit;
+  aom_thread_pool_t *thread_pool;
+  aom_row_output_init row_output;
+  unsigned int frame_parallel;
 
+  // The worker whose output frames are returned by decoder_get_frame(), and
+  // whose decoder the controls refer to. This is one of 'frame_workers'.
   AVxWorker *frame_worker;
+  AVxWorker *frame_workers;
+  int num_frame_workers;
+  // Frame-parallel mode: the worker of the last temporal unit received (-1
+  // before the first one), which the next temporal unit starts from, and the
+  // number of temporal units received whose frames were not output yet.
+  int last_worker_id;
+  int num_pending_workers;
 
   aom_image_t image_with_grain;
   aom_codec_frame_buffer_t grain_image_frame_buffers[MAX_NUM_SPATIAL_LAYERS];
@@ -120,13 +140,19 @@ static aom_codec_err_t decoder_init(aom_codec_ctx_t *ctx) {
   return AOM_CODEC_OK;
 }
 
-static aom_codec_err_t decoder_destroy(aom_codec_alg_priv_t *ctx) {
-  if (ctx->frame_worker != NULL) {
-    AVxWorker *const worker = ctx->frame_worker;
-    aom_get_worker_interface()->end(worker);
-    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+static void destroy_frame_workers(aom_codec_alg_priv_t *ctx) {
+  // Stop all the workers first, as a worker may still hold references to the
+  // frames of the others.
+  for (int i = 0; i < ctx->num_frame_workers; ++i) {
+    aom_get_worker_interface()->end(&ctx->frame_workers[i]);
+  }
+  for (int i = 0; i < ctx->num_frame_workers; ++i) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[i].data1;
     if (frame_worker_data != NULL && frame_worker_data->pbi != NULL) {
       AV1Decoder *const pbi = frame_worker_data->pbi;
+      av1_frame_worker_release_state(ctx->buffer_pool,
+                                     &frame_worker_data->state);
       aom_free(pbi->common.tpl_mvs);
       pbi->common.tpl_mvs = NULL;
       av1_remove_common(&pbi->common);
@@ -135,8 +161,17 @@ static aom_codec_err_t decoder_destroy(aom_codec_alg_priv_t *ctx) {
       av1_free_restoration_buffers(&pbi->common);
       av1_decoder_remove(pbi);
     }
+    if (frame_worker_data != NULL) aom_free(frame_worker_data->scratch_buffer);
     aom_free(frame_worker_data);
   }
+  aom_free(ctx->frame_workers);
+  ctx->frame_workers = NULL;
+  ctx->num_frame_workers = 0;
+  ctx->frame_worker = NULL;
+}
+
+static aom_codec_err_t decoder_destroy(aom_codec_alg_priv_t *ctx) {
+  destroy_frame_workers(ctx);
 
   if (ctx->buffer_pool) {
     for (size_t i = 0; i < ctx->num_grain_image_frame_buffers; i++) {
@@ -147,10 +182,11 @@ static aom_codec_err_t decoder_destroy(aom_codec_alg_priv_t *ctx) {
     av1_free_internal_frame_buffers(&ctx->buffer_pool->int_frame_buffers);
 #if CONFIG_MULTITHREAD
     pthread_mutex_destroy(&ctx->buffer_pool->pool_mutex);
+    pthread_mutex_destroy(&ctx->buffer_pool->progress_mutex);
+    pthread_cond_destroy(&ctx->buffer_pool->progress_cond);
 #endif
   }
 
-  aom_free(ctx->frame_worker);
   aom_free(ctx->buffer_pool);
   assert(!ctx->img.self_allocd);
   aom_img_free(&ctx->img);
@@ -378,17 +414,51 @@ static aom_codec_err_t update_error_state(
   return error->error_code;
 }
 
+// Passes the rows reported by the decoder to the application's row output
+// callback.
+static void output_rows(void *priv, const YV12_BUFFER_CONFIG *frame,
+                        int rows) {
+  aom_codec_alg_priv_t *const ctx = (aom_codec_alg_priv_t *)priv;
+  FrameWorkerData *const frame_worker_data =
+      (FrameWorkerData *)ctx->frame_worker->data1;
+  const AV1_COMMON *const cm = &frame_worker_data->pbi->common;
+  aom_image_t img;
+  yuvconfig2image(&img, frame, frame_worker_data->user_priv);
+  img.fb_priv = cm->cur_frame->raw_frame_buffer.priv;
+  ctx->row_output.row_output_cb(ctx->row_output.row_output_priv, &img,
+                                (unsigned int)rows);
+}
+
+static void set_row_output_cb(aom_codec_alg_priv_t *ctx, AV1Decoder *pbi) {
+  // In frame-parallel mode the frames are decoded after aom_codec_decode()
+  // returns, so their rows are not reported.
+  pbi->row_output_cb = ctx->row_output.row_output_cb && !ctx->frame_parallel
+                           ? output_rows
+                           : NULL;
+  pbi->row_output_priv = ctx;
+}
+
+// Applies the options set with the controls to the decoder of a frame worker.
+static void set_decoder_options(aom_codec_alg_priv_t *ctx, AV1Decoder *pbi) {
+  pbi->common.features.byte_alignment = ctx->byte_alignment;
+  pbi->skip_loop_filter = ctx->skip_loop_filter;
+  pbi->skip_film_grain = ctx->skip_film_grain;
+  pbi->block_stage_timing = ctx->block_stage_timing;
+  set_row_output_cb(ctx, pbi);
+}
+
 static void init_buffer_callbacks(aom_codec_alg_priv_t *ctx) {
+  for (int i = 0; i < ctx->num_frame_workers; ++i) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[i].data1;
+    frame_worker_data->pbi->common.cur_frame = NULL;
+    set_decoder_options(ctx, frame_worker_data->pbi);
+  }
+
   AVxWorker *const worker = ctx->frame_worker;
   FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
   AV1Decoder *const pbi = frame_worker_data->pbi;
-  AV1_COMMON *const cm = &pbi->common;
-  BufferPool *const pool = cm->buffer_pool;
-
-  cm->cur_frame = NULL;
-  cm->features.byte_alignment = ctx->byte_alignment;
-  pbi->skip_loop_filter = ctx->skip_loop_filter;
-  pbi->skip_film_grain = ctx->skip_film_grain;
+  BufferPool *const pool = pbi->common.buffer_pool;
 
   if (ctx->get_ext_fb_cb != NULL && ctx->release_ext_fb_cb != NULL) {
     pool->get_fb_cb = ctx->get_ext_fb_cb;
@@ -422,61 +492,74 @@ static int frame_worker_hook(void *arg1, void *arg2) {
   return !result;
 }
 
-static aom_codec_err_t init_decoder(aom_codec_alg_priv_t *ctx) {
-  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+// Hands the state left by the temporal unit to the next one as soon as the
+// tiles of its last frame are decoded. The last frame is the one only
+// followed by zero bytes.
+static void frame_context_ready(void *priv, const uint8_t *frame_end) {
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)priv;
+  const uint8_t *const data_end =
+      frame_worker_data->data + frame_worker_data->data_size;
+  for (const uint8_t *p = frame_end; p < data_end; ++p) {
+    if (*p != 0) return;
+  }
+  av1_frame_worker_set_context_ready(frame_worker_data);
+}
 
-  ctx->last_show_frame = NULL;
-  ctx->need_resync = 1;
-  ctx->flushed = 0;
+// Decodes a whole temporal unit in frame-parallel mode.
+static int frame_parallel_worker_hook(void *arg1, void *arg2) {
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)arg1;
+  AV1Decoder *const pbi = frame_worker_data->pbi;
+  const uint8_t *data = frame_worker_data->data;
+  const uint8_t *const data_end = data + frame_worker_data->data_size;
+  int result = 0;
+  (void)arg2;
 
-  ctx->buffer_pool = (BufferPool *)aom_calloc(1, sizeof(BufferPool));
-  if (ctx->buffer_pool == NULL) return AOM_CODEC_MEM_ERROR;
-  ctx->buffer_pool->num_frame_bufs = FRAME_BUFFERS;
-  ctx->buffer_pool->frame_bufs = (RefCntBuffer *)aom_calloc(
-      ctx->buffer_pool->num_frame_bufs, sizeof(*ctx->buffer_pool->frame_bufs));
-  if (ctx->buffer_pool->frame_bufs == NULL) {
-    ctx->buffer_pool->num_frame_bufs = 0;
-    aom_free(ctx->buffer_pool);
-    ctx->buffer_pool = NULL;
-    return AOM_CODEC_MEM_ERROR;
-  }
+  while (data < data_end) {
+    size_t frame_size = (size_t)(data_end - data);
+    if (pbi->is_annexb) {
+      // read the size of this frame unit
+      size_t length_of_size;
+      uint64_t frame_unit_size;
+      if (aom_uleb_decode(data, frame_size, &frame_unit_size,
+                          &length_of_size) != 0 ||
+          frame_unit_size > frame_size - length_of_size) {
+        pbi->error.error_code = AOM_CODEC_CORRUPT_FRAME;
+        pbi->error.has_detail = 0;
+        result = 1;
+        break;
+      }
+      data += length_of_size;
+      frame_size = (size_t)frame_unit_size;
+    }
 
-#if CONFIG_MULTITHREAD
-  if (pthread_mutex_init(&ctx->buffer_pool->pool_mutex, NULL)) {
-    aom_free(ctx->buffer_pool->frame_bufs);
-    ctx->buffer_pool->frame_bufs = NULL;
-    ctx->buffer_pool->num_frame_bufs = 0;
-    aom_free(ctx->buffer_pool);
-    ctx->buffer_pool = NULL;
-    set_error_detail(ctx, "Failed to allocate buffer pool mutex");
-    return AOM_CODEC_MEM_ERROR;
-  }
-#endif
+    result = av1_receive_compressed_data(pbi, frame_size, &data);
+    if (result != 0) break;
 
-  ctx->frame_worker = (AVxWorker *)aom_malloc(sizeof(*ctx->frame_worker));
-  if (ctx->frame_worker == NULL) {
-    set_error_detail(ctx, "Failed to allocate frame_worker");
-    return AOM_CODEC_MEM_ERROR;
+    // Allow extra zero bytes after the frame end
+    while (data < data_end && *data == 0) ++data;
   }
 
-  AVxWorker *const worker = ctx->frame_worker;
+  if (result != 0) pbi->need_resync = 1;
+  // Hands the state over if the last frame could not do it before its in-loop
+  // filters.
+  av1_frame_worker_set_context_ready(frame_worker_data);
+  return !result;
+}
+
+static aom_codec_err_t init_frame_worker(aom_codec_alg_priv_t *ctx,
+                                         AVxWorker *worker) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   winterface->init(worker);
   worker->thread_name = "aom frameworker";
   worker->data1 = aom_memalign(32, sizeof(FrameWorkerData));
   if (worker->data1 == NULL) {
-    winterface->end(worker);
-    aom_free(worker);
-    ctx->frame_worker = NULL;
     set_error_detail(ctx, "Failed to allocate frame_worker_data");
     return AOM_CODEC_MEM_ERROR;
   }
   FrameWorkerData *frame_worker_data = (FrameWorkerData *)worker->data1;
+  memset(frame_worker_data, 0, sizeof(*frame_worker_data));
   frame_worker_data->pbi = av1_decoder_create(ctx->buffer_pool);
   if (frame_worker_data->pbi == NULL) {
-    winterface->end(worker);
-    aom_free(frame_worker_data);
-    aom_free(worker);
-    ctx->frame_worker = NULL;
     set_error_detail(ctx, "Failed to allocate frame_worker_data->pbi");
     return AOM_CODEC_MEM_ERROR;
   }
@@ -495,12 +578,95 @@ static aom_codec_err_t init_decoder(aom_codec_alg_priv_t *ctx) {
   frame_worker_data->pbi->operating_point = ctx->operating_point;
   frame_worker_data->pbi->output_all_layers = ctx->output_all_layers;
   frame_worker_data->pbi->frame_size_limit = ctx->frame_size_limit;
+  frame_worker_data->pbi->thread_pool = ctx->thread_pool;
   frame_worker_data->pbi->ext_tile_debug = ctx->ext_tile_debug;
   frame_worker_data->pbi->row_mt = ctx->row_mt;
   frame_worker_data->pbi->is_fwd_kf_present = 0;
   frame_worker_data->pbi->is_arf_frame_present = 0;
   worker->hook = frame_worker_hook;
 
+  if (ctx->frame_parallel) {
+    // The temporal units are decoded on the worker threads.
+    if (!winterface->reset(worker)) {
+      set_error_detail(ctx, "Frame worker thread creation failed");
+      return AOM_CODEC_MEM_ERROR;
+    }
+    worker->hook = frame_parallel_worker_hook;
+    frame_worker_data->pbi->frame_context_ready_cb = frame_context_ready;
+    frame_worker_data->pbi->frame_context_ready_priv = frame_worker_data;
+  }
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t init_decoder(aom_codec_alg_priv_t *ctx) {
+  ctx->last_show_frame = NULL;
+  ctx->need_resync = 1;
+  ctx->flushed = 0;
+
+  ctx->buffer_pool = (BufferPool *)aom_calloc(1, sizeof(BufferPool));
+  if (ctx->buffer_pool == NULL) return AOM_CODEC_MEM_ERROR;
+  ctx->buffer_pool->num_frame_bufs = FRAME_BUFFERS;
+  ctx->buffer_pool->frame_bufs = (RefCntBuffer *)aom_calloc(
+      ctx->buffer_pool->num_frame_bufs, sizeof(*ctx->buffer_pool->frame_bufs));
+  if (ctx->buffer_pool->frame_bufs == NULL) {
+    ctx->buffer_pool->num_frame_bufs = 0;
+    aom_free(ctx->buffer_pool);
+    ctx->buffer_pool = NULL;
+    return AOM_CODEC_MEM_ERROR;
+  }
+
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&ctx->buffer_pool->pool_mutex, NULL)) {
+    aom_free(ctx->buffer_pool->frame_bufs);
+    ctx->buffer_pool->frame_bufs = NULL;
+    ctx->buffer_pool->num_frame_bufs = 0;
+    aom_free(ctx->buffer_pool);
+    ctx->buffer_pool = NULL;
+    set_error_detail(ctx, "Failed to allocate buffer pool mutex");
+    return AOM_CODEC_MEM_ERROR;
+  }
+  if (pthread_mutex_init(&ctx->buffer_pool->progress_mutex, NULL)) {
+    pthread_mutex_destroy(&ctx->buffer_pool->pool_mutex);
+    aom_free(ctx->buffer_pool->frame_bufs);
+    ctx->buffer_pool->frame_bufs = NULL;
+    ctx->buffer_pool->num_frame_bufs = 0;
+    aom_free(ctx->buffer_pool);
+    ctx->buffer_pool = NULL;
+    set_error_detail(ctx, "Failed to allocate frame progress mutex");
+    return AOM_CODEC_MEM_ERROR;
+  }
+  if (pthread_cond_init(&ctx->buffer_pool->progress_cond, NULL)) {
+    pthread_mutex_destroy(&ctx->buffer_pool->progress_mutex);
+    pthread_mutex_destroy(&ctx->buffer_pool->pool_mutex);
+    aom_free(ctx->buffer_pool->frame_bufs);
+    ctx->buffer_pool->frame_bufs = NULL;
+    ctx->buffer_pool->num_frame_bufs = 0;
+    aom_free(ctx->buffer_pool);
+    ctx->buffer_pool = NULL;
+    set_error_detail(ctx, "Failed to allocate frame progress condition");
+    return AOM_CODEC_MEM_ERROR;
+  }
+#endif
+
+  ctx->num_frame_workers = ctx->frame_parallel ? FRAME_PARALLEL_WORKERS : 1;
+  ctx->frame_workers = (AVxWorker *)aom_calloc(ctx->num_frame_workers,
+                                               sizeof(*ctx->frame_workers));
+  if (ctx->frame_workers == NULL) {
+    ctx->num_frame_workers = 0;
+    set_error_detail(ctx, "Failed to allocate frame_workers");
+    return AOM_CODEC_MEM_ERROR;
+  }
+  for (int i = 0; i < ctx->num_frame_workers; ++i) {
+    const aom_codec_err_t res = init_frame_worker(ctx, &ctx->frame_workers[i]);
+    if (res != AOM_CODEC_OK) {
+      destroy_frame_workers(ctx);
+      return res;
+    }
+  }
+  ctx->frame_worker = &ctx->frame_workers[0];
+  ctx->last_worker_id = -1;
+  ctx->num_pending_workers = 0;
+
   init_buffer_callbacks(ctx);
 
   return AOM_CODEC_OK;
@@ -562,6 +728,118 @@ static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+// Waits for the oldest temporal unit being decoded in frame-parallel mode,
+// whose frames are then output.
+static aom_codec_err_t output_frame_worker(aom_codec_alg_priv_t *ctx) {
+  assert(ctx->num_pending_workers > 0);
+  const int worker_id = (ctx->last_worker_id + 1 + ctx->num_frame_workers -
+                         ctx->num_pending_workers) %
+                        ctx->num_frame_workers;
+  --ctx->num_pending_workers;
+  AVxWorker *const worker = &ctx->frame_workers[worker_id];
+  ctx->frame_worker = worker;
+  if (!aom_get_worker_interface()->sync(worker)) {
+    const FrameWorkerData *const frame_worker_data =
+        (const FrameWorkerData *)worker->data1;
+    return update_error_state(ctx, &frame_worker_data->pbi->error);
+  }
+  return AOM_CODEC_OK;
+}
+
+// Starts the decoding of a temporal unit by the next frame worker, once the
+// previous temporal unit has left the state to start from. The frames of a
+// temporal unit are output by the call that receives the next one, or by a
+// flush, so that the decoding of the two overlaps.
+static aom_codec_err_t decode_frame_parallel(aom_codec_alg_priv_t *ctx,
+                                             const uint8_t *data,
+                                             size_t data_sz, void *user_priv) {
+  if (ctx->tile_mode) return AOM_CODEC_INCAPABLE;
+
+  // Determine the stream parameters, as decode_one() does.
+  if (!ctx->si.h) {
+    const uint8_t *frame_data = data;
+    size_t frame_size = data_sz;
+    if (ctx->is_annexb) {
+      // read the size of the first frame unit
+      size_t length_of_size;
+      uint64_t frame_unit_size;
+      if (aom_uleb_decode(data, data_sz, &frame_unit_size, &length_of_size) !=
+              0 ||
+          frame_unit_size > data_sz - length_of_size) {
+        return AOM_CODEC_CORRUPT_FRAME;
+      }
+      frame_data += length_of_size;
+      frame_size = (size_t)frame_unit_size;
+    }
+    int is_intra_only = 0;
+    ctx->si.is_annexb = ctx->is_annexb;
+    const aom_codec_err_t res = decoder_peek_si_internal(
+        frame_data, frame_size, &ctx->si, &is_intra_only);
+    if (res != AOM_CODEC_OK) return res;
+
+    if (!ctx->si.is_kf && !is_intra_only) return AOM_CODEC_ERROR;
+  }
+
+  const int worker_id = (ctx->last_worker_id + 1) % ctx->num_frame_workers;
+  AVxWorker *const worker = &ctx->frame_workers[worker_id];
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+  AV1Decoder *const pbi = frame_worker_data->pbi;
+  // The last temporal unit of this worker was output by an earlier call.
+  assert(ctx->num_pending_workers < ctx->num_frame_workers);
+
+  // The application may free the data once this call returns.
+  if (frame_worker_data->scratch_buffer_size < data_sz) {
+    aom_free(frame_worker_data->scratch_buffer);
+    frame_worker_data->scratch_buffer_size = 0;
+    frame_worker_data->scratch_buffer = (uint8_t *)aom_malloc(data_sz);
+    if (frame_worker_data->scratch_buffer == NULL) {
+      set_error_detail(ctx, "Failed to allocate scratch buffer");
+      return AOM_CODEC_MEM_ERROR;
+    }
+    frame_worker_data->scratch_buffer_size = data_sz;
+  }
+  memcpy(frame_worker_data->scratch_buffer, data, data_sz);
+
+  // Continue from the state left by the previous temporal unit, if any.
+  if (ctx->last_worker_id >= 0) {
+    FrameWorkerData *const prev_frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[ctx->last_worker_id].data1;
+    av1_frame_worker_wait_context_ready(prev_frame_worker_data);
+    av1_frame_worker_load_state(pbi, &prev_frame_worker_data->state);
+  }
+
+  frame_worker_data->data = frame_worker_data->scratch_buffer;
+  frame_worker_data->data_size = data_sz;
+  frame_worker_data->user_priv = user_priv;
+  frame_worker_data->received_frame = 1;
+  frame_worker_data->frame_context_ready = 0;
+
+  set_decoder_options(ctx, pbi);
+  pbi->common.tiles.large_scale = ctx->tile_mode;
+  pbi->dec_tile_row = ctx->decode_tile_row;
+  pbi->dec_tile_col = ctx->decode_tile_col;
+  pbi->ext_tile_debug = ctx->ext_tile_debug;
+  pbi->row_mt = ctx->row_mt;
+  pbi->ext_refs = ctx->ext_refs;
+  pbi->is_annexb = ctx->is_annexb;
+  pbi->decode_time = 0;
+  pbi->tiles_decode_time = 0;
+  av1_zero(pbi->stage_stats);
+
+  worker->had_error = 0;
+  aom_get_worker_interface()->launch(worker);
+  ctx->last_worker_id = worker_id;
+  ++ctx->num_pending_workers;
+
+  if (ctx->num_pending_workers < ctx->num_frame_workers) {
+    // Nothing to output yet: point ctx->frame_worker at an idle worker.
+    ctx->frame_worker =
+        &ctx->frame_workers[(worker_id + 1) % ctx->num_frame_workers];
+    return AOM_CODEC_OK;
+  }
+  return output_frame_worker(ctx);
+}
+
 static void release_pending_output_frames(aom_codec_alg_priv_t *ctx) {
   // Release any pending output frames from the previous decoder_decode or
   // decoder_inspect call. We need to do this even if the decoder is being
@@ -635,6 +913,7 @@ static aom_codec_err_t decoder_inspect(aom_codec_alg_priv_t *ctx,
     frame_size = (uint64_t)(data_end - data_start);
   }
 
+  if (ctx->frame_parallel) return AOM_CODEC_INCAPABLE;
   if (ctx->frame_worker == NULL) {
     res = init_decoder(ctx);
     if (res != AOM_CODEC_OK) return res;
@@ -689,6 +968,8 @@ static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
   /* NULL data ptr allowed if data_sz is 0 too */
   if (data == NULL && data_sz == 0) {
     ctx->flushed = 1;
+    // Output the temporal units still being decoded in frame-parallel mode.
+    if (ctx->num_pending_workers > 0) return output_frame_worker(ctx);
     return AOM_CODEC_OK;
   }
   if (data == NULL || data_sz == 0) return AOM_CODEC_INVALID_PARAM;
@@ -719,6 +1000,16 @@ static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
     data_end = data_start + temporal_unit_size;
   }
 
+  if (ctx->frame_parallel) {
+    return decode_frame_parallel(ctx, data_start,
+                                 (size_t)(data_end - data_start), user_priv);
+  }
+
+  AV1Decoder *const pbi = ((FrameWorkerData *)ctx->frame_worker->data1)->pbi;
+  pbi->decode_time = 0;
+  pbi->tiles_decode_time = 0;
+  av1_zero(pbi->stage_stats);
+
   // Decode in serial mode.
   while (data_start < data_end) {
     uint64_t frame_size;
@@ -763,14 +1054,45 @@ static void *AllocWithGetFrameBufferCb(void *priv, size_t size) {
   return param->fb->data;
 }
 
+// Returns whether the grain of an output frame can be added to its frame
+// buffer directly: the buffer must not be referenced by anything but the
+// output queue, since later frames must predict from the frame without grain.
+static int can_add_grain_in_place(aom_codec_alg_priv_t *ctx,
+                                  const RefCntBuffer *output_frame_buf) {
+  if (!ctx->inplace_film_grain || ctx->ext_tile_debug) return 0;
+  BufferPool *const pool = ctx->buffer_pool;
+  lock_buffer_pool(pool);
+  const int unreferenced = output_frame_buf->ref_count == 1;
+  unlock_buffer_pool(pool);
+  return unreferenced;
+}
+
 // If grain_params->apply_grain is false, returns img. Otherwise, adds film
-// grain to img, saves the result in grain_img, and returns grain_img.
+// grain to img, saves the result in grain_img, and returns grain_img. If
+// in_place is set, the grain is added to img itself, which is returned.
 static aom_image_t *add_grain_if_needed(aom_codec_alg_priv_t *ctx,
                                         aom_image_t *img,
                                         aom_image_t *grain_img,
-                                        aom_film_grain_t *grain_params) {
+                                        aom_film_grain_t *grain_params,
+                                        int in_place) {
   if (!grain_params->apply_grain) return img;
 
+  // The tile workers are idle once the frame is decoded, so they also share
+  // the grain synthesis.
+  const AV1Decoder *const pbi =
+      ((FrameWorkerData *)ctx->frame_worker->data1)->pbi;
+  if (in_place) {
+    if (av1_add_film_grain_mt(grain_params, img, img, pbi->tile_workers,
+                              pbi->num_workers)) {
+      return NULL;
+    }
+    // The parameters belong to the frame buffer, which no later frame can
+    // refer to. Clearing apply_grain keeps the grain from being added twice
+    // if the frame is retrieved again.
+    grain_params->apply_grain = 0;
+    return img;
+  }
+
   const int w_even = ALIGN_POWER_OF_TWO_UNSIGNED(img->d_w, 1);
   const int h_even = ALIGN_POWER_OF_TWO_UNSIGNED(img->d_h, 1);
 
@@ -787,7 +1109,8 @@ static aom_image_t *add_grain_if_needed(aom_codec_alg_priv_t *ctx,
 
   grain_img->user_priv = img->user_priv;
   grain_img->fb_priv = fb->priv;
-  if (av1_add_film_grain(grain_params, img, grain_img)) {
+  if (av1_add_film_grain_mt(grain_params, img, grain_img, pbi->tile_workers,
+                            pbi->num_workers)) {
     pool->release_fb_cb(pool->cb_priv, fb);
     return NULL;
   }
@@ -911,8 +1234,16 @@ static aom_image_t *decoder_get_frame(aom_codec_alg_priv_t *ctx,
   img->temporal_id = output_frame_buf->temporal_id;
   img->spatial_id = output_frame_buf->spatial_id;
   if (pbi->skip_film_grain) grain_params->apply_grain = 0;
-  aom_image_t *res =
-      add_grain_if_needed(ctx, img, &ctx->image_with_grain, grain_params);
+  const int apply_grain = grain_params->apply_grain;
+  struct aom_usec_timer grain_timer;
+  aom_usec_timer_start(&grain_timer);
+  aom_image_t *res = add_grain_if_needed(
+      ctx, img, &ctx->image_with_grain, grain_params,
+      apply_grain && can_add_grain_in_place(ctx, output_frame_buf));
+  if (apply_grain) {
+    av1_dec_accumulate_time(
+        &grain_timer, &pbi->stage_stats.stage_time[AOM_DEC_STAGE_FILM_GRAIN]);
+  }
   if (!res) {
     pbi->error.error_code = AOM_CODEC_CORRUPT_FRAME;
     pbi->error.has_detail = 1;
@@ -951,6 +1282,8 @@ static aom_codec_err_t ctrl_set_reference(aom_codec_alg_priv_t *ctx,
     YV12_BUFFER_CONFIG sd;
     AVxWorker *const worker = ctx->frame_worker;
     if (worker == NULL) return AOM_CODEC_ERROR;
+    // The next temporal unit may already be decoded from the references.
+    if (ctx->frame_parallel) return AOM_CODEC_INCAPABLE;
     FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
     image2yuvconfig(&frame->img, &sd);
 
@@ -1074,6 +1407,34 @@ static aom_codec_err_t ctrl_get_last_quantizer(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_get_frame_decode_time(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  aom_frame_decode_time_t *const arg = va_arg(args, aom_frame_decode_time_t *);
+  if (arg == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_worker == NULL) return AOM_CODEC_ERROR;
+  const AV1Decoder *const pbi =
+      ((FrameWorkerData *)ctx->frame_worker->data1)->pbi;
+  arg->decode_us = pbi->decode_time;
+  arg->tiles_decode_us = pbi->tiles_decode_time;
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_get_frame_stage_stats(aom_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  aom_dec_stage_stats_t *const arg = va_arg(args, aom_dec_stage_stats_t *);
+  if (arg == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_worker == NULL) return AOM_CODEC_ERROR;
+  const AV1Decoder *const pbi =
+      ((FrameWorkerData *)ctx->frame_worker->data1)->pbi;
+  for (int i = 0; i < AOM_DEC_STAGE_COUNT; ++i) {
+    arg->stage_us[i] = pbi->stage_stats.stage_time[i];
+  }
+  arg->idle_us = pbi->stage_stats.idle_time;
+  arg->num_blocks = pbi->stage_stats.num_blocks;
+  arg->num_coded_tx_blocks = pbi->stage_stats.num_coded_tx_blocks;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_get_fwd_kf_value(aom_codec_alg_priv_t *ctx,
                                              va_list args) {
   int *const arg = va_arg(args, int *);
@@ -1585,6 +1946,19 @@ static aom_codec_err_t ctrl_set_skip_loop_filter(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_block_stage_timing(aom_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  ctx->block_stage_timing = va_arg(args, int);
+
+  if (ctx->frame_worker) {
+    AVxWorker *const worker = ctx->frame_worker;
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    frame_worker_data->pbi->block_stage_timing = ctx->block_stage_timing;
+  }
+
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_skip_film_grain(aom_codec_alg_priv_t *ctx,
                                                 va_list args) {
   ctx->skip_film_grain = va_arg(args, int);
@@ -1598,12 +1972,53 @@ static aom_codec_err_t ctrl_set_skip_film_grain(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_inplace_film_grain(aom_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  ctx->inplace_film_grain = va_arg(args, int);
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_frame_size_limit(aom_codec_alg_priv_t *ctx,
                                                  va_list args) {
   ctx->frame_size_limit = va_arg(args, unsigned int);
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_thread_pool(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  // The tile workers are bound to their pool when they are created.
+  if (ctx->frame_worker != NULL) return AOM_CODEC_ERROR;
+  ctx->thread_pool = va_arg(args, aom_thread_pool_t *);
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_frame_parallel(aom_codec_alg_priv_t *ctx,
+                                               va_list args) {
+  // The frame workers are created with the decoder.
+  if (ctx->frame_worker != NULL) return AOM_CODEC_ERROR;
+  ctx->frame_parallel = va_arg(args, unsigned int) != 0;
+  return AOM_CODEC_OK;
+}
+
+static aom_codec_err_t ctrl_set_row_output_cb(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  const aom_row_output_init *const init = va_arg(args, aom_row_output_init *);
+  if (init != NULL) {
+    ctx->row_output = *init;
+  } else {
+    ctx->row_output.row_output_cb = NULL;
+    ctx->row_output.row_output_priv = NULL;
+  }
+
+  if (ctx->frame_worker) {
+    AVxWorker *const worker = ctx->frame_worker;
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    set_row_output_cb(ctx, frame_worker_data->pbi);
+  }
+
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_get_accounting(aom_codec_alg_priv_t *ctx,
                                            va_list args) {
 #if !CONFIG_ACCOUNTING
@@ -1712,10 +2127,17 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1D_SET_EXT_REF_PTR, ctrl_set_ext_ref_ptr },
   { AV1D_SET_SKIP_FILM_GRAIN, ctrl_set_skip_film_grain },
   { AOMD_SET_FRAME_SIZE_LIMIT, ctrl_set_frame_size_limit },
+  { AV1D_SET_THREAD_POOL, ctrl_set_thread_pool },
+  { AV1D_SET_ROW_OUTPUT_CB, ctrl_set_row_output_cb },
+  { AV1D_SET_INPLACE_FILM_GRAIN, ctrl_set_inplace_film_grain },
+  { AV1D_SET_FRAME_PARALLEL, ctrl_set_frame_parallel },
 
   // Getters
   { AOMD_GET_FRAME_CORRUPTED, ctrl_get_frame_corrupted },
   { AOMD_GET_LAST_QUANTIZER, ctrl_get_last_quantizer },
+  { AV1D_GET_FRAME_DECODE_TIME, ctrl_get_frame_decode_time },
+  { AV1D_SET_BLOCK_STAGE_TIMING, ctrl_set_block_stage_timing },
+  { AV1D_GET_FRAME_STAGE_STATS, ctrl_get_frame_stage_stats },
   { AOMD_GET_LAST_REF_UPDATES, ctrl_get_last_ref_updates },
   { AV1D_GET_BIT_DEPTH, ctrl_get_bit_depth },
   { AV1D_GET_IMG_FORMAT, ctrl_get_img_format },
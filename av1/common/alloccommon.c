@@ -41,8 +41,9 @@ void av1_free_ref_frame_buffers(BufferPool *pool) {
   int i;
 
   for (i = 0; i < pool->num_frame_bufs; ++i) {
-    if (pool->frame_bufs[i].ref_count > 0 &&
-        pool->frame_bufs[i].raw_frame_buffer.data != NULL) {
+    // The encoder keeps the memory of unreferenced frame buffers, so release
+    // any buffer that holds some.
+    if (pool->frame_bufs[i].raw_frame_buffer.data != NULL) {
       pool->release_fb_cb(pool->cb_priv, &pool->frame_bufs[i].raw_frame_buffer);
       pool->frame_bufs[i].raw_frame_buffer.data = NULL;
       pool->frame_bufs[i].raw_frame_buffer.size = 0;
@@ -172,6 +172,12 @@ typedef struct RefCntBuffer {
   FRAME_CONTEXT frame_context;
 
   int filter_level[2];
+
+  // Decoder only: number of luma rows of 'buf' whose reconstruction, including
+  // all in-loop filtering, is final. Set to FRAME_PROGRESS_DONE once the whole
+  // frame has been decoded. Written under BufferPool::progress_mutex.
+  // See av1/decoder/dthread.h.
+  int progress_rows;
 } RefCntBuffer;
 
 typedef struct BufferPool {
@@ -193,6 +199,14 @@ typedef struct BufferPool {
   RefCntBuffer *frame_bufs;
   uint8_t num_frame_bufs;
 
+#if CONFIG_MULTITHREAD
+  // Protects RefCntBuffer::progress_rows of all the buffers in 'frame_bufs'
+  // and is signaled whenever one of them advances. Only used by the decoder,
+  // but initialized by the encoder as well.
+  pthread_mutex_t progress_mutex;
+  pthread_cond_t progress_cond;
+#endif
+
   // Frame buffers allocated internally by the codec.
   InternalFrameBufferList int_frame_buffers;
 } BufferPool;
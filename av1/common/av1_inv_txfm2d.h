@@ -32,6 +32,12 @@ void av1_lowbd_inv_txfm2d_add_avx2(const int32_t *input, uint8_t *output,
                                    int eob);
 #endif
 
+#if HAVE_AVX512 && CONFIG_HIGHWAY
+void av1_lowbd_inv_txfm2d_add_avx512(const int32_t *input, uint8_t *output,
+                                     int stride, TX_TYPE tx_type,
+                                     TX_SIZE tx_size, int eob);
+#endif
+
 #if HAVE_NEON
 // This function is used by av1_inv_txfm2d_test.cc.
 void av1_lowbd_inv_txfm2d_add_neon(const int32_t *input, uint8_t *output,
@@ -0,0 +1,2070 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AV1_COMMON_AV1_INV_TXFM2D_HWY_H_
+#define AOM_AV1_COMMON_AV1_INV_TXFM2D_HWY_H_
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "config/aom_config.h"
+#include "config/av1_rtcd.h"
+
+#include "aom_dsp/txfm_common.h"
+#include "av1/common/av1_inv_txfm1d_cfg.h"
+#include "av1/common/av1_inv_txfm2d.h"
+#include "av1/common/av1_txfm.h"
+#include "av1/common/enums.h"
+#include "third_party/highway/hwy/highway.h"
+
+#define FOR_EACH_INV_TXFM2D(X, suffix) \
+  X(4, 4, suffix)                      \
+  X(8, 8, suffix)                      \
+  X(16, 16, suffix)                    \
+  X(32, 32, suffix)                    \
+  X(64, 64, suffix)                    \
+  X(4, 8, suffix)                      \
+  X(8, 4, suffix)                      \
+  X(8, 16, suffix)                     \
+  X(16, 8, suffix)                     \
+  X(16, 32, suffix)                    \
+  X(32, 16, suffix)                    \
+  X(32, 64, suffix)                    \
+  X(64, 32, suffix)                    \
+  X(4, 16, suffix)                     \
+  X(16, 4, suffix)                     \
+  X(8, 32, suffix)                     \
+  X(32, 8, suffix)                     \
+  X(16, 64, suffix)                    \
+  X(64, 16, suffix)
+
+HWY_BEFORE_NAMESPACE();
+
+namespace {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// The 1D transforms below are lane-parallel ports of av1_inv_txfm1d.c: every
+// lane of a vector carries an independent row (or column), so the butterfly
+// network is a statement-for-statement copy of the C code and bit-exact with
+// it. As in the C code, every stage of a pass shares one clamping range, which
+// is passed in as the [lo, hi] vector pair.
+
+// half_btf(). The products are allowed to wrap in 32 bits; see the note in
+// av1_txfm.h for why this matches the C code on conformant input.
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> HalfBtf(D d, int32_t w0, hn::VFromD<D> in0,
+                                          int32_t w1, hn::VFromD<D> in1) {
+  const auto sum = hn::Add(hn::Mul(hn::Set(d, w0), in0),
+                           hn::Mul(hn::Set(d, w1), in1));
+  return hn::ShiftRight<INV_COS_BIT>(
+      hn::Add(sum, hn::Set(d, 1 << (INV_COS_BIT - 1))));
+}
+
+template <typename V>
+HWY_ATTR HWY_INLINE V AddClamp(V a, V b, V lo, V hi) {
+  return hn::Min(hn::Max(hn::Add(a, b), lo), hi);
+}
+
+template <typename V>
+HWY_ATTR HWY_INLINE V SubClamp(V a, V b, V lo, V hi) {
+  return hn::Min(hn::Max(hn::Sub(a, b), lo), hi);
+}
+
+// round_shift((int64_t)v * w, Bits) with the product kept in 64 bits.
+template <int Bits, typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> MulRoundShift(D d, hn::VFromD<D> v,
+                                                int32_t w) {
+  constexpr hn::RepartitionToWide<D> wide_tag;
+  const auto weight = hn::Set(d, w);
+  const auto round = hn::Set(wide_tag, int64_t{ 1 } << (Bits - 1));
+  const auto even =
+      hn::ShiftRight<Bits>(hn::Add(hn::MulEven(v, weight), round));
+  const auto odd = hn::ShiftRight<Bits>(hn::Add(hn::MulOdd(v, weight), round));
+  return hn::OddEven(hn::BitCast(d, hn::ShiftLeft<32>(odd)),
+                     hn::BitCast(d, even));
+}
+
+// Rounding right shift by a run-time amount, as av1_round_shift_array().
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> RoundShift(D d, hn::VFromD<D> v, int bit) {
+  if (bit == 0) return v;
+  return hn::ShiftRightSame(hn::Add(v, hn::Set(d, 1 << (bit - 1))), bit);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> ClampRangeLo(D d, int bits) {
+  return hn::Set(d, -(1 << (bits - 1)));
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> ClampRangeHi(D d, int bits) {
+  return hn::Set(d, (1 << (bits - 1)) - 1);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Idct4(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                               hn::VFromD<D> *HWY_RESTRICT output,
+                               const int32_t *cospi, hn::VFromD<D> lo,
+                               hn::VFromD<D> hi) {
+  hn::VFromD<D> step[4];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[0];
+  bf1[1] = input[2];
+  bf1[2] = input[1];
+  bf1[3] = input[3];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = HalfBtf(d, cospi[32], bf0[0], cospi[32], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[32], bf0[0], -cospi[32], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[48], bf0[2], -cospi[16], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[16], bf0[2], cospi[48], bf0[3]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[3], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[2], lo, hi);
+  bf1[2] = SubClamp(bf0[1], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[0], bf0[3], lo, hi);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Idct8(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                               hn::VFromD<D> *HWY_RESTRICT output,
+                               const int32_t *cospi, hn::VFromD<D> lo,
+                               hn::VFromD<D> hi) {
+  hn::VFromD<D> step[8];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[0];
+  bf1[1] = input[4];
+  bf1[2] = input[2];
+  bf1[3] = input[6];
+  bf1[4] = input[1];
+  bf1[5] = input[5];
+  bf1[6] = input[3];
+  bf1[7] = input[7];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[56], bf0[4], -cospi[8], bf0[7]);
+  bf1[5] = HalfBtf(d, cospi[24], bf0[5], -cospi[40], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[40], bf0[5], cospi[24], bf0[6]);
+  bf1[7] = HalfBtf(d, cospi[8], bf0[4], cospi[56], bf0[7]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = HalfBtf(d, cospi[32], bf0[0], cospi[32], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[32], bf0[0], -cospi[32], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[48], bf0[2], -cospi[16], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[16], bf0[2], cospi[48], bf0[3]);
+  bf1[4] = AddClamp(bf0[4], bf0[5], lo, hi);
+  bf1[5] = SubClamp(bf0[4], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[7], bf0[6], lo, hi);
+  bf1[7] = AddClamp(bf0[6], bf0[7], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[3], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[2], lo, hi);
+  bf1[2] = SubClamp(bf0[1], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[0], bf0[3], lo, hi);
+  bf1[4] = bf0[4];
+  bf1[5] = HalfBtf(d, -cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[7] = bf0[7];
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[7], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[6], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[5], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[4], lo, hi);
+  bf1[4] = SubClamp(bf0[3], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[2], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[1], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[0], bf0[7], lo, hi);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Idct16(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                                hn::VFromD<D> *HWY_RESTRICT output,
+                                const int32_t *cospi, hn::VFromD<D> lo,
+                                hn::VFromD<D> hi) {
+  hn::VFromD<D> step[16];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[0];
+  bf1[1] = input[8];
+  bf1[2] = input[4];
+  bf1[3] = input[12];
+  bf1[4] = input[2];
+  bf1[5] = input[10];
+  bf1[6] = input[6];
+  bf1[7] = input[14];
+  bf1[8] = input[1];
+  bf1[9] = input[9];
+  bf1[10] = input[5];
+  bf1[11] = input[13];
+  bf1[12] = input[3];
+  bf1[13] = input[11];
+  bf1[14] = input[7];
+  bf1[15] = input[15];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = HalfBtf(d, cospi[60], bf0[8], -cospi[4], bf0[15]);
+  bf1[9] = HalfBtf(d, cospi[28], bf0[9], -cospi[36], bf0[14]);
+  bf1[10] = HalfBtf(d, cospi[44], bf0[10], -cospi[20], bf0[13]);
+  bf1[11] = HalfBtf(d, cospi[12], bf0[11], -cospi[52], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[52], bf0[11], cospi[12], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[20], bf0[10], cospi[44], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[36], bf0[9], cospi[28], bf0[14]);
+  bf1[15] = HalfBtf(d, cospi[4], bf0[8], cospi[60], bf0[15]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[56], bf0[4], -cospi[8], bf0[7]);
+  bf1[5] = HalfBtf(d, cospi[24], bf0[5], -cospi[40], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[40], bf0[5], cospi[24], bf0[6]);
+  bf1[7] = HalfBtf(d, cospi[8], bf0[4], cospi[56], bf0[7]);
+  bf1[8] = AddClamp(bf0[8], bf0[9], lo, hi);
+  bf1[9] = SubClamp(bf0[8], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[11], bf0[10], lo, hi);
+  bf1[11] = AddClamp(bf0[10], bf0[11], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[13], lo, hi);
+  bf1[13] = SubClamp(bf0[12], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[15], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[14], bf0[15], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = HalfBtf(d, cospi[32], bf0[0], cospi[32], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[32], bf0[0], -cospi[32], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[48], bf0[2], -cospi[16], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[16], bf0[2], cospi[48], bf0[3]);
+  bf1[4] = AddClamp(bf0[4], bf0[5], lo, hi);
+  bf1[5] = SubClamp(bf0[4], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[7], bf0[6], lo, hi);
+  bf1[7] = AddClamp(bf0[6], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = HalfBtf(d, -cospi[16], bf0[9], cospi[48], bf0[14]);
+  bf1[10] = HalfBtf(d, -cospi[48], bf0[10], -cospi[16], bf0[13]);
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = HalfBtf(d, -cospi[16], bf0[10], cospi[48], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[48], bf0[9], cospi[16], bf0[14]);
+  bf1[15] = bf0[15];
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[3], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[2], lo, hi);
+  bf1[2] = SubClamp(bf0[1], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[0], bf0[3], lo, hi);
+  bf1[4] = bf0[4];
+  bf1[5] = HalfBtf(d, -cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[7] = bf0[7];
+  bf1[8] = AddClamp(bf0[8], bf0[11], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[10], lo, hi);
+  bf1[10] = SubClamp(bf0[9], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[8], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[15], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[14], bf0[13], lo, hi);
+  bf1[14] = AddClamp(bf0[13], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[12], bf0[15], lo, hi);
+
+  // stage 6
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[7], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[6], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[5], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[4], lo, hi);
+  bf1[4] = SubClamp(bf0[3], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[2], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[1], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[0], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = HalfBtf(d, -cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[11] = HalfBtf(d, -cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+
+  // stage 7
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[15], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[14], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[13], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[12], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[11], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[10], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[9], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[8], lo, hi);
+  bf1[8] = SubClamp(bf0[7], bf0[8], lo, hi);
+  bf1[9] = SubClamp(bf0[6], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[5], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[4], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[3], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[2], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[1], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[0], bf0[15], lo, hi);
+}
+
+template <typename D>
+HWY_ATTR void Idct32(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                     hn::VFromD<D> *HWY_RESTRICT output, const int32_t *cospi,
+                     hn::VFromD<D> lo, hn::VFromD<D> hi) {
+  hn::VFromD<D> step[32];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[0];
+  bf1[1] = input[16];
+  bf1[2] = input[8];
+  bf1[3] = input[24];
+  bf1[4] = input[4];
+  bf1[5] = input[20];
+  bf1[6] = input[12];
+  bf1[7] = input[28];
+  bf1[8] = input[2];
+  bf1[9] = input[18];
+  bf1[10] = input[10];
+  bf1[11] = input[26];
+  bf1[12] = input[6];
+  bf1[13] = input[22];
+  bf1[14] = input[14];
+  bf1[15] = input[30];
+  bf1[16] = input[1];
+  bf1[17] = input[17];
+  bf1[18] = input[9];
+  bf1[19] = input[25];
+  bf1[20] = input[5];
+  bf1[21] = input[21];
+  bf1[22] = input[13];
+  bf1[23] = input[29];
+  bf1[24] = input[3];
+  bf1[25] = input[19];
+  bf1[26] = input[11];
+  bf1[27] = input[27];
+  bf1[28] = input[7];
+  bf1[29] = input[23];
+  bf1[30] = input[15];
+  bf1[31] = input[31];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = bf0[10];
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = bf0[13];
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+  bf1[16] = HalfBtf(d, cospi[62], bf0[16], -cospi[2], bf0[31]);
+  bf1[17] = HalfBtf(d, cospi[30], bf0[17], -cospi[34], bf0[30]);
+  bf1[18] = HalfBtf(d, cospi[46], bf0[18], -cospi[18], bf0[29]);
+  bf1[19] = HalfBtf(d, cospi[14], bf0[19], -cospi[50], bf0[28]);
+  bf1[20] = HalfBtf(d, cospi[54], bf0[20], -cospi[10], bf0[27]);
+  bf1[21] = HalfBtf(d, cospi[22], bf0[21], -cospi[42], bf0[26]);
+  bf1[22] = HalfBtf(d, cospi[38], bf0[22], -cospi[26], bf0[25]);
+  bf1[23] = HalfBtf(d, cospi[6], bf0[23], -cospi[58], bf0[24]);
+  bf1[24] = HalfBtf(d, cospi[58], bf0[23], cospi[6], bf0[24]);
+  bf1[25] = HalfBtf(d, cospi[26], bf0[22], cospi[38], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[42], bf0[21], cospi[22], bf0[26]);
+  bf1[27] = HalfBtf(d, cospi[10], bf0[20], cospi[54], bf0[27]);
+  bf1[28] = HalfBtf(d, cospi[50], bf0[19], cospi[14], bf0[28]);
+  bf1[29] = HalfBtf(d, cospi[18], bf0[18], cospi[46], bf0[29]);
+  bf1[30] = HalfBtf(d, cospi[34], bf0[17], cospi[30], bf0[30]);
+  bf1[31] = HalfBtf(d, cospi[2], bf0[16], cospi[62], bf0[31]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = HalfBtf(d, cospi[60], bf0[8], -cospi[4], bf0[15]);
+  bf1[9] = HalfBtf(d, cospi[28], bf0[9], -cospi[36], bf0[14]);
+  bf1[10] = HalfBtf(d, cospi[44], bf0[10], -cospi[20], bf0[13]);
+  bf1[11] = HalfBtf(d, cospi[12], bf0[11], -cospi[52], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[52], bf0[11], cospi[12], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[20], bf0[10], cospi[44], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[36], bf0[9], cospi[28], bf0[14]);
+  bf1[15] = HalfBtf(d, cospi[4], bf0[8], cospi[60], bf0[15]);
+  bf1[16] = AddClamp(bf0[16], bf0[17], lo, hi);
+  bf1[17] = SubClamp(bf0[16], bf0[17], lo, hi);
+  bf1[18] = SubClamp(bf0[19], bf0[18], lo, hi);
+  bf1[19] = AddClamp(bf0[18], bf0[19], lo, hi);
+  bf1[20] = AddClamp(bf0[20], bf0[21], lo, hi);
+  bf1[21] = SubClamp(bf0[20], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[23], bf0[22], lo, hi);
+  bf1[23] = AddClamp(bf0[22], bf0[23], lo, hi);
+  bf1[24] = AddClamp(bf0[24], bf0[25], lo, hi);
+  bf1[25] = SubClamp(bf0[24], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[27], bf0[26], lo, hi);
+  bf1[27] = AddClamp(bf0[26], bf0[27], lo, hi);
+  bf1[28] = AddClamp(bf0[28], bf0[29], lo, hi);
+  bf1[29] = SubClamp(bf0[28], bf0[29], lo, hi);
+  bf1[30] = SubClamp(bf0[31], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[30], bf0[31], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[56], bf0[4], -cospi[8], bf0[7]);
+  bf1[5] = HalfBtf(d, cospi[24], bf0[5], -cospi[40], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[40], bf0[5], cospi[24], bf0[6]);
+  bf1[7] = HalfBtf(d, cospi[8], bf0[4], cospi[56], bf0[7]);
+  bf1[8] = AddClamp(bf0[8], bf0[9], lo, hi);
+  bf1[9] = SubClamp(bf0[8], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[11], bf0[10], lo, hi);
+  bf1[11] = AddClamp(bf0[10], bf0[11], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[13], lo, hi);
+  bf1[13] = SubClamp(bf0[12], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[15], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[14], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = HalfBtf(d, -cospi[8], bf0[17], cospi[56], bf0[30]);
+  bf1[18] = HalfBtf(d, -cospi[56], bf0[18], -cospi[8], bf0[29]);
+  bf1[19] = bf0[19];
+  bf1[20] = bf0[20];
+  bf1[21] = HalfBtf(d, -cospi[40], bf0[21], cospi[24], bf0[26]);
+  bf1[22] = HalfBtf(d, -cospi[24], bf0[22], -cospi[40], bf0[25]);
+  bf1[23] = bf0[23];
+  bf1[24] = bf0[24];
+  bf1[25] = HalfBtf(d, -cospi[40], bf0[22], cospi[24], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[24], bf0[21], cospi[40], bf0[26]);
+  bf1[27] = bf0[27];
+  bf1[28] = bf0[28];
+  bf1[29] = HalfBtf(d, -cospi[8], bf0[18], cospi[56], bf0[29]);
+  bf1[30] = HalfBtf(d, cospi[56], bf0[17], cospi[8], bf0[30]);
+  bf1[31] = bf0[31];
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = HalfBtf(d, cospi[32], bf0[0], cospi[32], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[32], bf0[0], -cospi[32], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[48], bf0[2], -cospi[16], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[16], bf0[2], cospi[48], bf0[3]);
+  bf1[4] = AddClamp(bf0[4], bf0[5], lo, hi);
+  bf1[5] = SubClamp(bf0[4], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[7], bf0[6], lo, hi);
+  bf1[7] = AddClamp(bf0[6], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = HalfBtf(d, -cospi[16], bf0[9], cospi[48], bf0[14]);
+  bf1[10] = HalfBtf(d, -cospi[48], bf0[10], -cospi[16], bf0[13]);
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = HalfBtf(d, -cospi[16], bf0[10], cospi[48], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[48], bf0[9], cospi[16], bf0[14]);
+  bf1[15] = bf0[15];
+  bf1[16] = AddClamp(bf0[16], bf0[19], lo, hi);
+  bf1[17] = AddClamp(bf0[17], bf0[18], lo, hi);
+  bf1[18] = SubClamp(bf0[17], bf0[18], lo, hi);
+  bf1[19] = SubClamp(bf0[16], bf0[19], lo, hi);
+  bf1[20] = SubClamp(bf0[23], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[22], bf0[21], lo, hi);
+  bf1[22] = AddClamp(bf0[21], bf0[22], lo, hi);
+  bf1[23] = AddClamp(bf0[20], bf0[23], lo, hi);
+  bf1[24] = AddClamp(bf0[24], bf0[27], lo, hi);
+  bf1[25] = AddClamp(bf0[25], bf0[26], lo, hi);
+  bf1[26] = SubClamp(bf0[25], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[24], bf0[27], lo, hi);
+  bf1[28] = SubClamp(bf0[31], bf0[28], lo, hi);
+  bf1[29] = SubClamp(bf0[30], bf0[29], lo, hi);
+  bf1[30] = AddClamp(bf0[29], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[28], bf0[31], lo, hi);
+
+  // stage 6
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[3], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[2], lo, hi);
+  bf1[2] = SubClamp(bf0[1], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[0], bf0[3], lo, hi);
+  bf1[4] = bf0[4];
+  bf1[5] = HalfBtf(d, -cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[7] = bf0[7];
+  bf1[8] = AddClamp(bf0[8], bf0[11], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[10], lo, hi);
+  bf1[10] = SubClamp(bf0[9], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[8], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[15], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[14], bf0[13], lo, hi);
+  bf1[14] = AddClamp(bf0[13], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[12], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = bf0[17];
+  bf1[18] = HalfBtf(d, -cospi[16], bf0[18], cospi[48], bf0[29]);
+  bf1[19] = HalfBtf(d, -cospi[16], bf0[19], cospi[48], bf0[28]);
+  bf1[20] = HalfBtf(d, -cospi[48], bf0[20], -cospi[16], bf0[27]);
+  bf1[21] = HalfBtf(d, -cospi[48], bf0[21], -cospi[16], bf0[26]);
+  bf1[22] = bf0[22];
+  bf1[23] = bf0[23];
+  bf1[24] = bf0[24];
+  bf1[25] = bf0[25];
+  bf1[26] = HalfBtf(d, -cospi[16], bf0[21], cospi[48], bf0[26]);
+  bf1[27] = HalfBtf(d, -cospi[16], bf0[20], cospi[48], bf0[27]);
+  bf1[28] = HalfBtf(d, cospi[48], bf0[19], cospi[16], bf0[28]);
+  bf1[29] = HalfBtf(d, cospi[48], bf0[18], cospi[16], bf0[29]);
+  bf1[30] = bf0[30];
+  bf1[31] = bf0[31];
+
+  // stage 7
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[7], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[6], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[5], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[4], lo, hi);
+  bf1[4] = SubClamp(bf0[3], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[2], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[1], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[0], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = HalfBtf(d, -cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[11] = HalfBtf(d, -cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+  bf1[16] = AddClamp(bf0[16], bf0[23], lo, hi);
+  bf1[17] = AddClamp(bf0[17], bf0[22], lo, hi);
+  bf1[18] = AddClamp(bf0[18], bf0[21], lo, hi);
+  bf1[19] = AddClamp(bf0[19], bf0[20], lo, hi);
+  bf1[20] = SubClamp(bf0[19], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[18], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[17], bf0[22], lo, hi);
+  bf1[23] = SubClamp(bf0[16], bf0[23], lo, hi);
+  bf1[24] = SubClamp(bf0[31], bf0[24], lo, hi);
+  bf1[25] = SubClamp(bf0[30], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[29], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[28], bf0[27], lo, hi);
+  bf1[28] = AddClamp(bf0[27], bf0[28], lo, hi);
+  bf1[29] = AddClamp(bf0[26], bf0[29], lo, hi);
+  bf1[30] = AddClamp(bf0[25], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[24], bf0[31], lo, hi);
+
+  // stage 8
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[15], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[14], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[13], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[12], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[11], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[10], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[9], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[8], lo, hi);
+  bf1[8] = SubClamp(bf0[7], bf0[8], lo, hi);
+  bf1[9] = SubClamp(bf0[6], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[5], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[4], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[3], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[2], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[1], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[0], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = bf0[17];
+  bf1[18] = bf0[18];
+  bf1[19] = bf0[19];
+  bf1[20] = HalfBtf(d, -cospi[32], bf0[20], cospi[32], bf0[27]);
+  bf1[21] = HalfBtf(d, -cospi[32], bf0[21], cospi[32], bf0[26]);
+  bf1[22] = HalfBtf(d, -cospi[32], bf0[22], cospi[32], bf0[25]);
+  bf1[23] = HalfBtf(d, -cospi[32], bf0[23], cospi[32], bf0[24]);
+  bf1[24] = HalfBtf(d, cospi[32], bf0[23], cospi[32], bf0[24]);
+  bf1[25] = HalfBtf(d, cospi[32], bf0[22], cospi[32], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[32], bf0[21], cospi[32], bf0[26]);
+  bf1[27] = HalfBtf(d, cospi[32], bf0[20], cospi[32], bf0[27]);
+  bf1[28] = bf0[28];
+  bf1[29] = bf0[29];
+  bf1[30] = bf0[30];
+  bf1[31] = bf0[31];
+
+  // stage 9
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[31], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[30], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[29], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[28], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[27], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[26], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[25], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[24], lo, hi);
+  bf1[8] = AddClamp(bf0[8], bf0[23], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[22], lo, hi);
+  bf1[10] = AddClamp(bf0[10], bf0[21], lo, hi);
+  bf1[11] = AddClamp(bf0[11], bf0[20], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[19], lo, hi);
+  bf1[13] = AddClamp(bf0[13], bf0[18], lo, hi);
+  bf1[14] = AddClamp(bf0[14], bf0[17], lo, hi);
+  bf1[15] = AddClamp(bf0[15], bf0[16], lo, hi);
+  bf1[16] = SubClamp(bf0[15], bf0[16], lo, hi);
+  bf1[17] = SubClamp(bf0[14], bf0[17], lo, hi);
+  bf1[18] = SubClamp(bf0[13], bf0[18], lo, hi);
+  bf1[19] = SubClamp(bf0[12], bf0[19], lo, hi);
+  bf1[20] = SubClamp(bf0[11], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[10], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[9], bf0[22], lo, hi);
+  bf1[23] = SubClamp(bf0[8], bf0[23], lo, hi);
+  bf1[24] = SubClamp(bf0[7], bf0[24], lo, hi);
+  bf1[25] = SubClamp(bf0[6], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[5], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[4], bf0[27], lo, hi);
+  bf1[28] = SubClamp(bf0[3], bf0[28], lo, hi);
+  bf1[29] = SubClamp(bf0[2], bf0[29], lo, hi);
+  bf1[30] = SubClamp(bf0[1], bf0[30], lo, hi);
+  bf1[31] = SubClamp(bf0[0], bf0[31], lo, hi);
+}
+
+template <typename D>
+HWY_ATTR void Idct64(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                     hn::VFromD<D> *HWY_RESTRICT output, const int32_t *cospi,
+                     hn::VFromD<D> lo, hn::VFromD<D> hi) {
+  hn::VFromD<D> step[64];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[0];
+  bf1[1] = input[32];
+  bf1[2] = input[16];
+  bf1[3] = input[48];
+  bf1[4] = input[8];
+  bf1[5] = input[40];
+  bf1[6] = input[24];
+  bf1[7] = input[56];
+  bf1[8] = input[4];
+  bf1[9] = input[36];
+  bf1[10] = input[20];
+  bf1[11] = input[52];
+  bf1[12] = input[12];
+  bf1[13] = input[44];
+  bf1[14] = input[28];
+  bf1[15] = input[60];
+  bf1[16] = input[2];
+  bf1[17] = input[34];
+  bf1[18] = input[18];
+  bf1[19] = input[50];
+  bf1[20] = input[10];
+  bf1[21] = input[42];
+  bf1[22] = input[26];
+  bf1[23] = input[58];
+  bf1[24] = input[6];
+  bf1[25] = input[38];
+  bf1[26] = input[22];
+  bf1[27] = input[54];
+  bf1[28] = input[14];
+  bf1[29] = input[46];
+  bf1[30] = input[30];
+  bf1[31] = input[62];
+  bf1[32] = input[1];
+  bf1[33] = input[33];
+  bf1[34] = input[17];
+  bf1[35] = input[49];
+  bf1[36] = input[9];
+  bf1[37] = input[41];
+  bf1[38] = input[25];
+  bf1[39] = input[57];
+  bf1[40] = input[5];
+  bf1[41] = input[37];
+  bf1[42] = input[21];
+  bf1[43] = input[53];
+  bf1[44] = input[13];
+  bf1[45] = input[45];
+  bf1[46] = input[29];
+  bf1[47] = input[61];
+  bf1[48] = input[3];
+  bf1[49] = input[35];
+  bf1[50] = input[19];
+  bf1[51] = input[51];
+  bf1[52] = input[11];
+  bf1[53] = input[43];
+  bf1[54] = input[27];
+  bf1[55] = input[59];
+  bf1[56] = input[7];
+  bf1[57] = input[39];
+  bf1[58] = input[23];
+  bf1[59] = input[55];
+  bf1[60] = input[15];
+  bf1[61] = input[47];
+  bf1[62] = input[31];
+  bf1[63] = input[63];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = bf0[10];
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = bf0[13];
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+  bf1[16] = bf0[16];
+  bf1[17] = bf0[17];
+  bf1[18] = bf0[18];
+  bf1[19] = bf0[19];
+  bf1[20] = bf0[20];
+  bf1[21] = bf0[21];
+  bf1[22] = bf0[22];
+  bf1[23] = bf0[23];
+  bf1[24] = bf0[24];
+  bf1[25] = bf0[25];
+  bf1[26] = bf0[26];
+  bf1[27] = bf0[27];
+  bf1[28] = bf0[28];
+  bf1[29] = bf0[29];
+  bf1[30] = bf0[30];
+  bf1[31] = bf0[31];
+  bf1[32] = HalfBtf(d, cospi[63], bf0[32], -cospi[1], bf0[63]);
+  bf1[33] = HalfBtf(d, cospi[31], bf0[33], -cospi[33], bf0[62]);
+  bf1[34] = HalfBtf(d, cospi[47], bf0[34], -cospi[17], bf0[61]);
+  bf1[35] = HalfBtf(d, cospi[15], bf0[35], -cospi[49], bf0[60]);
+  bf1[36] = HalfBtf(d, cospi[55], bf0[36], -cospi[9], bf0[59]);
+  bf1[37] = HalfBtf(d, cospi[23], bf0[37], -cospi[41], bf0[58]);
+  bf1[38] = HalfBtf(d, cospi[39], bf0[38], -cospi[25], bf0[57]);
+  bf1[39] = HalfBtf(d, cospi[7], bf0[39], -cospi[57], bf0[56]);
+  bf1[40] = HalfBtf(d, cospi[59], bf0[40], -cospi[5], bf0[55]);
+  bf1[41] = HalfBtf(d, cospi[27], bf0[41], -cospi[37], bf0[54]);
+  bf1[42] = HalfBtf(d, cospi[43], bf0[42], -cospi[21], bf0[53]);
+  bf1[43] = HalfBtf(d, cospi[11], bf0[43], -cospi[53], bf0[52]);
+  bf1[44] = HalfBtf(d, cospi[51], bf0[44], -cospi[13], bf0[51]);
+  bf1[45] = HalfBtf(d, cospi[19], bf0[45], -cospi[45], bf0[50]);
+  bf1[46] = HalfBtf(d, cospi[35], bf0[46], -cospi[29], bf0[49]);
+  bf1[47] = HalfBtf(d, cospi[3], bf0[47], -cospi[61], bf0[48]);
+  bf1[48] = HalfBtf(d, cospi[61], bf0[47], cospi[3], bf0[48]);
+  bf1[49] = HalfBtf(d, cospi[29], bf0[46], cospi[35], bf0[49]);
+  bf1[50] = HalfBtf(d, cospi[45], bf0[45], cospi[19], bf0[50]);
+  bf1[51] = HalfBtf(d, cospi[13], bf0[44], cospi[51], bf0[51]);
+  bf1[52] = HalfBtf(d, cospi[53], bf0[43], cospi[11], bf0[52]);
+  bf1[53] = HalfBtf(d, cospi[21], bf0[42], cospi[43], bf0[53]);
+  bf1[54] = HalfBtf(d, cospi[37], bf0[41], cospi[27], bf0[54]);
+  bf1[55] = HalfBtf(d, cospi[5], bf0[40], cospi[59], bf0[55]);
+  bf1[56] = HalfBtf(d, cospi[57], bf0[39], cospi[7], bf0[56]);
+  bf1[57] = HalfBtf(d, cospi[25], bf0[38], cospi[39], bf0[57]);
+  bf1[58] = HalfBtf(d, cospi[41], bf0[37], cospi[23], bf0[58]);
+  bf1[59] = HalfBtf(d, cospi[9], bf0[36], cospi[55], bf0[59]);
+  bf1[60] = HalfBtf(d, cospi[49], bf0[35], cospi[15], bf0[60]);
+  bf1[61] = HalfBtf(d, cospi[17], bf0[34], cospi[47], bf0[61]);
+  bf1[62] = HalfBtf(d, cospi[33], bf0[33], cospi[31], bf0[62]);
+  bf1[63] = HalfBtf(d, cospi[1], bf0[32], cospi[63], bf0[63]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = bf0[10];
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = bf0[13];
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+  bf1[16] = HalfBtf(d, cospi[62], bf0[16], -cospi[2], bf0[31]);
+  bf1[17] = HalfBtf(d, cospi[30], bf0[17], -cospi[34], bf0[30]);
+  bf1[18] = HalfBtf(d, cospi[46], bf0[18], -cospi[18], bf0[29]);
+  bf1[19] = HalfBtf(d, cospi[14], bf0[19], -cospi[50], bf0[28]);
+  bf1[20] = HalfBtf(d, cospi[54], bf0[20], -cospi[10], bf0[27]);
+  bf1[21] = HalfBtf(d, cospi[22], bf0[21], -cospi[42], bf0[26]);
+  bf1[22] = HalfBtf(d, cospi[38], bf0[22], -cospi[26], bf0[25]);
+  bf1[23] = HalfBtf(d, cospi[6], bf0[23], -cospi[58], bf0[24]);
+  bf1[24] = HalfBtf(d, cospi[58], bf0[23], cospi[6], bf0[24]);
+  bf1[25] = HalfBtf(d, cospi[26], bf0[22], cospi[38], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[42], bf0[21], cospi[22], bf0[26]);
+  bf1[27] = HalfBtf(d, cospi[10], bf0[20], cospi[54], bf0[27]);
+  bf1[28] = HalfBtf(d, cospi[50], bf0[19], cospi[14], bf0[28]);
+  bf1[29] = HalfBtf(d, cospi[18], bf0[18], cospi[46], bf0[29]);
+  bf1[30] = HalfBtf(d, cospi[34], bf0[17], cospi[30], bf0[30]);
+  bf1[31] = HalfBtf(d, cospi[2], bf0[16], cospi[62], bf0[31]);
+  bf1[32] = AddClamp(bf0[32], bf0[33], lo, hi);
+  bf1[33] = SubClamp(bf0[32], bf0[33], lo, hi);
+  bf1[34] = SubClamp(bf0[35], bf0[34], lo, hi);
+  bf1[35] = AddClamp(bf0[34], bf0[35], lo, hi);
+  bf1[36] = AddClamp(bf0[36], bf0[37], lo, hi);
+  bf1[37] = SubClamp(bf0[36], bf0[37], lo, hi);
+  bf1[38] = SubClamp(bf0[39], bf0[38], lo, hi);
+  bf1[39] = AddClamp(bf0[38], bf0[39], lo, hi);
+  bf1[40] = AddClamp(bf0[40], bf0[41], lo, hi);
+  bf1[41] = SubClamp(bf0[40], bf0[41], lo, hi);
+  bf1[42] = SubClamp(bf0[43], bf0[42], lo, hi);
+  bf1[43] = AddClamp(bf0[42], bf0[43], lo, hi);
+  bf1[44] = AddClamp(bf0[44], bf0[45], lo, hi);
+  bf1[45] = SubClamp(bf0[44], bf0[45], lo, hi);
+  bf1[46] = SubClamp(bf0[47], bf0[46], lo, hi);
+  bf1[47] = AddClamp(bf0[46], bf0[47], lo, hi);
+  bf1[48] = AddClamp(bf0[48], bf0[49], lo, hi);
+  bf1[49] = SubClamp(bf0[48], bf0[49], lo, hi);
+  bf1[50] = SubClamp(bf0[51], bf0[50], lo, hi);
+  bf1[51] = AddClamp(bf0[50], bf0[51], lo, hi);
+  bf1[52] = AddClamp(bf0[52], bf0[53], lo, hi);
+  bf1[53] = SubClamp(bf0[52], bf0[53], lo, hi);
+  bf1[54] = SubClamp(bf0[55], bf0[54], lo, hi);
+  bf1[55] = AddClamp(bf0[54], bf0[55], lo, hi);
+  bf1[56] = AddClamp(bf0[56], bf0[57], lo, hi);
+  bf1[57] = SubClamp(bf0[56], bf0[57], lo, hi);
+  bf1[58] = SubClamp(bf0[59], bf0[58], lo, hi);
+  bf1[59] = AddClamp(bf0[58], bf0[59], lo, hi);
+  bf1[60] = AddClamp(bf0[60], bf0[61], lo, hi);
+  bf1[61] = SubClamp(bf0[60], bf0[61], lo, hi);
+  bf1[62] = SubClamp(bf0[63], bf0[62], lo, hi);
+  bf1[63] = AddClamp(bf0[62], bf0[63], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = HalfBtf(d, cospi[60], bf0[8], -cospi[4], bf0[15]);
+  bf1[9] = HalfBtf(d, cospi[28], bf0[9], -cospi[36], bf0[14]);
+  bf1[10] = HalfBtf(d, cospi[44], bf0[10], -cospi[20], bf0[13]);
+  bf1[11] = HalfBtf(d, cospi[12], bf0[11], -cospi[52], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[52], bf0[11], cospi[12], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[20], bf0[10], cospi[44], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[36], bf0[9], cospi[28], bf0[14]);
+  bf1[15] = HalfBtf(d, cospi[4], bf0[8], cospi[60], bf0[15]);
+  bf1[16] = AddClamp(bf0[16], bf0[17], lo, hi);
+  bf1[17] = SubClamp(bf0[16], bf0[17], lo, hi);
+  bf1[18] = SubClamp(bf0[19], bf0[18], lo, hi);
+  bf1[19] = AddClamp(bf0[18], bf0[19], lo, hi);
+  bf1[20] = AddClamp(bf0[20], bf0[21], lo, hi);
+  bf1[21] = SubClamp(bf0[20], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[23], bf0[22], lo, hi);
+  bf1[23] = AddClamp(bf0[22], bf0[23], lo, hi);
+  bf1[24] = AddClamp(bf0[24], bf0[25], lo, hi);
+  bf1[25] = SubClamp(bf0[24], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[27], bf0[26], lo, hi);
+  bf1[27] = AddClamp(bf0[26], bf0[27], lo, hi);
+  bf1[28] = AddClamp(bf0[28], bf0[29], lo, hi);
+  bf1[29] = SubClamp(bf0[28], bf0[29], lo, hi);
+  bf1[30] = SubClamp(bf0[31], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[30], bf0[31], lo, hi);
+  bf1[32] = bf0[32];
+  bf1[33] = HalfBtf(d, -cospi[4], bf0[33], cospi[60], bf0[62]);
+  bf1[34] = HalfBtf(d, -cospi[60], bf0[34], -cospi[4], bf0[61]);
+  bf1[35] = bf0[35];
+  bf1[36] = bf0[36];
+  bf1[37] = HalfBtf(d, -cospi[36], bf0[37], cospi[28], bf0[58]);
+  bf1[38] = HalfBtf(d, -cospi[28], bf0[38], -cospi[36], bf0[57]);
+  bf1[39] = bf0[39];
+  bf1[40] = bf0[40];
+  bf1[41] = HalfBtf(d, -cospi[20], bf0[41], cospi[44], bf0[54]);
+  bf1[42] = HalfBtf(d, -cospi[44], bf0[42], -cospi[20], bf0[53]);
+  bf1[43] = bf0[43];
+  bf1[44] = bf0[44];
+  bf1[45] = HalfBtf(d, -cospi[52], bf0[45], cospi[12], bf0[50]);
+  bf1[46] = HalfBtf(d, -cospi[12], bf0[46], -cospi[52], bf0[49]);
+  bf1[47] = bf0[47];
+  bf1[48] = bf0[48];
+  bf1[49] = HalfBtf(d, -cospi[52], bf0[46], cospi[12], bf0[49]);
+  bf1[50] = HalfBtf(d, cospi[12], bf0[45], cospi[52], bf0[50]);
+  bf1[51] = bf0[51];
+  bf1[52] = bf0[52];
+  bf1[53] = HalfBtf(d, -cospi[20], bf0[42], cospi[44], bf0[53]);
+  bf1[54] = HalfBtf(d, cospi[44], bf0[41], cospi[20], bf0[54]);
+  bf1[55] = bf0[55];
+  bf1[56] = bf0[56];
+  bf1[57] = HalfBtf(d, -cospi[36], bf0[38], cospi[28], bf0[57]);
+  bf1[58] = HalfBtf(d, cospi[28], bf0[37], cospi[36], bf0[58]);
+  bf1[59] = bf0[59];
+  bf1[60] = bf0[60];
+  bf1[61] = HalfBtf(d, -cospi[4], bf0[34], cospi[60], bf0[61]);
+  bf1[62] = HalfBtf(d, cospi[60], bf0[33], cospi[4], bf0[62]);
+  bf1[63] = bf0[63];
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[56], bf0[4], -cospi[8], bf0[7]);
+  bf1[5] = HalfBtf(d, cospi[24], bf0[5], -cospi[40], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[40], bf0[5], cospi[24], bf0[6]);
+  bf1[7] = HalfBtf(d, cospi[8], bf0[4], cospi[56], bf0[7]);
+  bf1[8] = AddClamp(bf0[8], bf0[9], lo, hi);
+  bf1[9] = SubClamp(bf0[8], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[11], bf0[10], lo, hi);
+  bf1[11] = AddClamp(bf0[10], bf0[11], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[13], lo, hi);
+  bf1[13] = SubClamp(bf0[12], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[15], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[14], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = HalfBtf(d, -cospi[8], bf0[17], cospi[56], bf0[30]);
+  bf1[18] = HalfBtf(d, -cospi[56], bf0[18], -cospi[8], bf0[29]);
+  bf1[19] = bf0[19];
+  bf1[20] = bf0[20];
+  bf1[21] = HalfBtf(d, -cospi[40], bf0[21], cospi[24], bf0[26]);
+  bf1[22] = HalfBtf(d, -cospi[24], bf0[22], -cospi[40], bf0[25]);
+  bf1[23] = bf0[23];
+  bf1[24] = bf0[24];
+  bf1[25] = HalfBtf(d, -cospi[40], bf0[22], cospi[24], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[24], bf0[21], cospi[40], bf0[26]);
+  bf1[27] = bf0[27];
+  bf1[28] = bf0[28];
+  bf1[29] = HalfBtf(d, -cospi[8], bf0[18], cospi[56], bf0[29]);
+  bf1[30] = HalfBtf(d, cospi[56], bf0[17], cospi[8], bf0[30]);
+  bf1[31] = bf0[31];
+  bf1[32] = AddClamp(bf0[32], bf0[35], lo, hi);
+  bf1[33] = AddClamp(bf0[33], bf0[34], lo, hi);
+  bf1[34] = SubClamp(bf0[33], bf0[34], lo, hi);
+  bf1[35] = SubClamp(bf0[32], bf0[35], lo, hi);
+  bf1[36] = SubClamp(bf0[39], bf0[36], lo, hi);
+  bf1[37] = SubClamp(bf0[38], bf0[37], lo, hi);
+  bf1[38] = AddClamp(bf0[37], bf0[38], lo, hi);
+  bf1[39] = AddClamp(bf0[36], bf0[39], lo, hi);
+  bf1[40] = AddClamp(bf0[40], bf0[43], lo, hi);
+  bf1[41] = AddClamp(bf0[41], bf0[42], lo, hi);
+  bf1[42] = SubClamp(bf0[41], bf0[42], lo, hi);
+  bf1[43] = SubClamp(bf0[40], bf0[43], lo, hi);
+  bf1[44] = SubClamp(bf0[47], bf0[44], lo, hi);
+  bf1[45] = SubClamp(bf0[46], bf0[45], lo, hi);
+  bf1[46] = AddClamp(bf0[45], bf0[46], lo, hi);
+  bf1[47] = AddClamp(bf0[44], bf0[47], lo, hi);
+  bf1[48] = AddClamp(bf0[48], bf0[51], lo, hi);
+  bf1[49] = AddClamp(bf0[49], bf0[50], lo, hi);
+  bf1[50] = SubClamp(bf0[49], bf0[50], lo, hi);
+  bf1[51] = SubClamp(bf0[48], bf0[51], lo, hi);
+  bf1[52] = SubClamp(bf0[55], bf0[52], lo, hi);
+  bf1[53] = SubClamp(bf0[54], bf0[53], lo, hi);
+  bf1[54] = AddClamp(bf0[53], bf0[54], lo, hi);
+  bf1[55] = AddClamp(bf0[52], bf0[55], lo, hi);
+  bf1[56] = AddClamp(bf0[56], bf0[59], lo, hi);
+  bf1[57] = AddClamp(bf0[57], bf0[58], lo, hi);
+  bf1[58] = SubClamp(bf0[57], bf0[58], lo, hi);
+  bf1[59] = SubClamp(bf0[56], bf0[59], lo, hi);
+  bf1[60] = SubClamp(bf0[63], bf0[60], lo, hi);
+  bf1[61] = SubClamp(bf0[62], bf0[61], lo, hi);
+  bf1[62] = AddClamp(bf0[61], bf0[62], lo, hi);
+  bf1[63] = AddClamp(bf0[60], bf0[63], lo, hi);
+
+  // stage 6
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = HalfBtf(d, cospi[32], bf0[0], cospi[32], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[32], bf0[0], -cospi[32], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[48], bf0[2], -cospi[16], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[16], bf0[2], cospi[48], bf0[3]);
+  bf1[4] = AddClamp(bf0[4], bf0[5], lo, hi);
+  bf1[5] = SubClamp(bf0[4], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[7], bf0[6], lo, hi);
+  bf1[7] = AddClamp(bf0[6], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = HalfBtf(d, -cospi[16], bf0[9], cospi[48], bf0[14]);
+  bf1[10] = HalfBtf(d, -cospi[48], bf0[10], -cospi[16], bf0[13]);
+  bf1[11] = bf0[11];
+  bf1[12] = bf0[12];
+  bf1[13] = HalfBtf(d, -cospi[16], bf0[10], cospi[48], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[48], bf0[9], cospi[16], bf0[14]);
+  bf1[15] = bf0[15];
+  bf1[16] = AddClamp(bf0[16], bf0[19], lo, hi);
+  bf1[17] = AddClamp(bf0[17], bf0[18], lo, hi);
+  bf1[18] = SubClamp(bf0[17], bf0[18], lo, hi);
+  bf1[19] = SubClamp(bf0[16], bf0[19], lo, hi);
+  bf1[20] = SubClamp(bf0[23], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[22], bf0[21], lo, hi);
+  bf1[22] = AddClamp(bf0[21], bf0[22], lo, hi);
+  bf1[23] = AddClamp(bf0[20], bf0[23], lo, hi);
+  bf1[24] = AddClamp(bf0[24], bf0[27], lo, hi);
+  bf1[25] = AddClamp(bf0[25], bf0[26], lo, hi);
+  bf1[26] = SubClamp(bf0[25], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[24], bf0[27], lo, hi);
+  bf1[28] = SubClamp(bf0[31], bf0[28], lo, hi);
+  bf1[29] = SubClamp(bf0[30], bf0[29], lo, hi);
+  bf1[30] = AddClamp(bf0[29], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[28], bf0[31], lo, hi);
+  bf1[32] = bf0[32];
+  bf1[33] = bf0[33];
+  bf1[34] = HalfBtf(d, -cospi[8], bf0[34], cospi[56], bf0[61]);
+  bf1[35] = HalfBtf(d, -cospi[8], bf0[35], cospi[56], bf0[60]);
+  bf1[36] = HalfBtf(d, -cospi[56], bf0[36], -cospi[8], bf0[59]);
+  bf1[37] = HalfBtf(d, -cospi[56], bf0[37], -cospi[8], bf0[58]);
+  bf1[38] = bf0[38];
+  bf1[39] = bf0[39];
+  bf1[40] = bf0[40];
+  bf1[41] = bf0[41];
+  bf1[42] = HalfBtf(d, -cospi[40], bf0[42], cospi[24], bf0[53]);
+  bf1[43] = HalfBtf(d, -cospi[40], bf0[43], cospi[24], bf0[52]);
+  bf1[44] = HalfBtf(d, -cospi[24], bf0[44], -cospi[40], bf0[51]);
+  bf1[45] = HalfBtf(d, -cospi[24], bf0[45], -cospi[40], bf0[50]);
+  bf1[46] = bf0[46];
+  bf1[47] = bf0[47];
+  bf1[48] = bf0[48];
+  bf1[49] = bf0[49];
+  bf1[50] = HalfBtf(d, -cospi[40], bf0[45], cospi[24], bf0[50]);
+  bf1[51] = HalfBtf(d, -cospi[40], bf0[44], cospi[24], bf0[51]);
+  bf1[52] = HalfBtf(d, cospi[24], bf0[43], cospi[40], bf0[52]);
+  bf1[53] = HalfBtf(d, cospi[24], bf0[42], cospi[40], bf0[53]);
+  bf1[54] = bf0[54];
+  bf1[55] = bf0[55];
+  bf1[56] = bf0[56];
+  bf1[57] = bf0[57];
+  bf1[58] = HalfBtf(d, -cospi[8], bf0[37], cospi[56], bf0[58]);
+  bf1[59] = HalfBtf(d, -cospi[8], bf0[36], cospi[56], bf0[59]);
+  bf1[60] = HalfBtf(d, cospi[56], bf0[35], cospi[8], bf0[60]);
+  bf1[61] = HalfBtf(d, cospi[56], bf0[34], cospi[8], bf0[61]);
+  bf1[62] = bf0[62];
+  bf1[63] = bf0[63];
+
+  // stage 7
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[3], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[2], lo, hi);
+  bf1[2] = SubClamp(bf0[1], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[0], bf0[3], lo, hi);
+  bf1[4] = bf0[4];
+  bf1[5] = HalfBtf(d, -cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[6] = HalfBtf(d, cospi[32], bf0[5], cospi[32], bf0[6]);
+  bf1[7] = bf0[7];
+  bf1[8] = AddClamp(bf0[8], bf0[11], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[10], lo, hi);
+  bf1[10] = SubClamp(bf0[9], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[8], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[15], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[14], bf0[13], lo, hi);
+  bf1[14] = AddClamp(bf0[13], bf0[14], lo, hi);
+  bf1[15] = AddClamp(bf0[12], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = bf0[17];
+  bf1[18] = HalfBtf(d, -cospi[16], bf0[18], cospi[48], bf0[29]);
+  bf1[19] = HalfBtf(d, -cospi[16], bf0[19], cospi[48], bf0[28]);
+  bf1[20] = HalfBtf(d, -cospi[48], bf0[20], -cospi[16], bf0[27]);
+  bf1[21] = HalfBtf(d, -cospi[48], bf0[21], -cospi[16], bf0[26]);
+  bf1[22] = bf0[22];
+  bf1[23] = bf0[23];
+  bf1[24] = bf0[24];
+  bf1[25] = bf0[25];
+  bf1[26] = HalfBtf(d, -cospi[16], bf0[21], cospi[48], bf0[26]);
+  bf1[27] = HalfBtf(d, -cospi[16], bf0[20], cospi[48], bf0[27]);
+  bf1[28] = HalfBtf(d, cospi[48], bf0[19], cospi[16], bf0[28]);
+  bf1[29] = HalfBtf(d, cospi[48], bf0[18], cospi[16], bf0[29]);
+  bf1[30] = bf0[30];
+  bf1[31] = bf0[31];
+  bf1[32] = AddClamp(bf0[32], bf0[39], lo, hi);
+  bf1[33] = AddClamp(bf0[33], bf0[38], lo, hi);
+  bf1[34] = AddClamp(bf0[34], bf0[37], lo, hi);
+  bf1[35] = AddClamp(bf0[35], bf0[36], lo, hi);
+  bf1[36] = SubClamp(bf0[35], bf0[36], lo, hi);
+  bf1[37] = SubClamp(bf0[34], bf0[37], lo, hi);
+  bf1[38] = SubClamp(bf0[33], bf0[38], lo, hi);
+  bf1[39] = SubClamp(bf0[32], bf0[39], lo, hi);
+  bf1[40] = SubClamp(bf0[47], bf0[40], lo, hi);
+  bf1[41] = SubClamp(bf0[46], bf0[41], lo, hi);
+  bf1[42] = SubClamp(bf0[45], bf0[42], lo, hi);
+  bf1[43] = SubClamp(bf0[44], bf0[43], lo, hi);
+  bf1[44] = AddClamp(bf0[43], bf0[44], lo, hi);
+  bf1[45] = AddClamp(bf0[42], bf0[45], lo, hi);
+  bf1[46] = AddClamp(bf0[41], bf0[46], lo, hi);
+  bf1[47] = AddClamp(bf0[40], bf0[47], lo, hi);
+  bf1[48] = AddClamp(bf0[48], bf0[55], lo, hi);
+  bf1[49] = AddClamp(bf0[49], bf0[54], lo, hi);
+  bf1[50] = AddClamp(bf0[50], bf0[53], lo, hi);
+  bf1[51] = AddClamp(bf0[51], bf0[52], lo, hi);
+  bf1[52] = SubClamp(bf0[51], bf0[52], lo, hi);
+  bf1[53] = SubClamp(bf0[50], bf0[53], lo, hi);
+  bf1[54] = SubClamp(bf0[49], bf0[54], lo, hi);
+  bf1[55] = SubClamp(bf0[48], bf0[55], lo, hi);
+  bf1[56] = SubClamp(bf0[63], bf0[56], lo, hi);
+  bf1[57] = SubClamp(bf0[62], bf0[57], lo, hi);
+  bf1[58] = SubClamp(bf0[61], bf0[58], lo, hi);
+  bf1[59] = SubClamp(bf0[60], bf0[59], lo, hi);
+  bf1[60] = AddClamp(bf0[59], bf0[60], lo, hi);
+  bf1[61] = AddClamp(bf0[58], bf0[61], lo, hi);
+  bf1[62] = AddClamp(bf0[57], bf0[62], lo, hi);
+  bf1[63] = AddClamp(bf0[56], bf0[63], lo, hi);
+
+  // stage 8
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[7], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[6], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[5], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[4], lo, hi);
+  bf1[4] = SubClamp(bf0[3], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[2], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[1], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[0], bf0[7], lo, hi);
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = HalfBtf(d, -cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[11] = HalfBtf(d, -cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[12] = HalfBtf(d, cospi[32], bf0[11], cospi[32], bf0[12]);
+  bf1[13] = HalfBtf(d, cospi[32], bf0[10], cospi[32], bf0[13]);
+  bf1[14] = bf0[14];
+  bf1[15] = bf0[15];
+  bf1[16] = AddClamp(bf0[16], bf0[23], lo, hi);
+  bf1[17] = AddClamp(bf0[17], bf0[22], lo, hi);
+  bf1[18] = AddClamp(bf0[18], bf0[21], lo, hi);
+  bf1[19] = AddClamp(bf0[19], bf0[20], lo, hi);
+  bf1[20] = SubClamp(bf0[19], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[18], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[17], bf0[22], lo, hi);
+  bf1[23] = SubClamp(bf0[16], bf0[23], lo, hi);
+  bf1[24] = SubClamp(bf0[31], bf0[24], lo, hi);
+  bf1[25] = SubClamp(bf0[30], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[29], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[28], bf0[27], lo, hi);
+  bf1[28] = AddClamp(bf0[27], bf0[28], lo, hi);
+  bf1[29] = AddClamp(bf0[26], bf0[29], lo, hi);
+  bf1[30] = AddClamp(bf0[25], bf0[30], lo, hi);
+  bf1[31] = AddClamp(bf0[24], bf0[31], lo, hi);
+  bf1[32] = bf0[32];
+  bf1[33] = bf0[33];
+  bf1[34] = bf0[34];
+  bf1[35] = bf0[35];
+  bf1[36] = HalfBtf(d, -cospi[16], bf0[36], cospi[48], bf0[59]);
+  bf1[37] = HalfBtf(d, -cospi[16], bf0[37], cospi[48], bf0[58]);
+  bf1[38] = HalfBtf(d, -cospi[16], bf0[38], cospi[48], bf0[57]);
+  bf1[39] = HalfBtf(d, -cospi[16], bf0[39], cospi[48], bf0[56]);
+  bf1[40] = HalfBtf(d, -cospi[48], bf0[40], -cospi[16], bf0[55]);
+  bf1[41] = HalfBtf(d, -cospi[48], bf0[41], -cospi[16], bf0[54]);
+  bf1[42] = HalfBtf(d, -cospi[48], bf0[42], -cospi[16], bf0[53]);
+  bf1[43] = HalfBtf(d, -cospi[48], bf0[43], -cospi[16], bf0[52]);
+  bf1[44] = bf0[44];
+  bf1[45] = bf0[45];
+  bf1[46] = bf0[46];
+  bf1[47] = bf0[47];
+  bf1[48] = bf0[48];
+  bf1[49] = bf0[49];
+  bf1[50] = bf0[50];
+  bf1[51] = bf0[51];
+  bf1[52] = HalfBtf(d, -cospi[16], bf0[43], cospi[48], bf0[52]);
+  bf1[53] = HalfBtf(d, -cospi[16], bf0[42], cospi[48], bf0[53]);
+  bf1[54] = HalfBtf(d, -cospi[16], bf0[41], cospi[48], bf0[54]);
+  bf1[55] = HalfBtf(d, -cospi[16], bf0[40], cospi[48], bf0[55]);
+  bf1[56] = HalfBtf(d, cospi[48], bf0[39], cospi[16], bf0[56]);
+  bf1[57] = HalfBtf(d, cospi[48], bf0[38], cospi[16], bf0[57]);
+  bf1[58] = HalfBtf(d, cospi[48], bf0[37], cospi[16], bf0[58]);
+  bf1[59] = HalfBtf(d, cospi[48], bf0[36], cospi[16], bf0[59]);
+  bf1[60] = bf0[60];
+  bf1[61] = bf0[61];
+  bf1[62] = bf0[62];
+  bf1[63] = bf0[63];
+
+  // stage 9
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[15], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[14], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[13], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[12], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[11], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[10], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[9], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[8], lo, hi);
+  bf1[8] = SubClamp(bf0[7], bf0[8], lo, hi);
+  bf1[9] = SubClamp(bf0[6], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[5], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[4], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[3], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[2], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[1], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[0], bf0[15], lo, hi);
+  bf1[16] = bf0[16];
+  bf1[17] = bf0[17];
+  bf1[18] = bf0[18];
+  bf1[19] = bf0[19];
+  bf1[20] = HalfBtf(d, -cospi[32], bf0[20], cospi[32], bf0[27]);
+  bf1[21] = HalfBtf(d, -cospi[32], bf0[21], cospi[32], bf0[26]);
+  bf1[22] = HalfBtf(d, -cospi[32], bf0[22], cospi[32], bf0[25]);
+  bf1[23] = HalfBtf(d, -cospi[32], bf0[23], cospi[32], bf0[24]);
+  bf1[24] = HalfBtf(d, cospi[32], bf0[23], cospi[32], bf0[24]);
+  bf1[25] = HalfBtf(d, cospi[32], bf0[22], cospi[32], bf0[25]);
+  bf1[26] = HalfBtf(d, cospi[32], bf0[21], cospi[32], bf0[26]);
+  bf1[27] = HalfBtf(d, cospi[32], bf0[20], cospi[32], bf0[27]);
+  bf1[28] = bf0[28];
+  bf1[29] = bf0[29];
+  bf1[30] = bf0[30];
+  bf1[31] = bf0[31];
+  bf1[32] = AddClamp(bf0[32], bf0[47], lo, hi);
+  bf1[33] = AddClamp(bf0[33], bf0[46], lo, hi);
+  bf1[34] = AddClamp(bf0[34], bf0[45], lo, hi);
+  bf1[35] = AddClamp(bf0[35], bf0[44], lo, hi);
+  bf1[36] = AddClamp(bf0[36], bf0[43], lo, hi);
+  bf1[37] = AddClamp(bf0[37], bf0[42], lo, hi);
+  bf1[38] = AddClamp(bf0[38], bf0[41], lo, hi);
+  bf1[39] = AddClamp(bf0[39], bf0[40], lo, hi);
+  bf1[40] = SubClamp(bf0[39], bf0[40], lo, hi);
+  bf1[41] = SubClamp(bf0[38], bf0[41], lo, hi);
+  bf1[42] = SubClamp(bf0[37], bf0[42], lo, hi);
+  bf1[43] = SubClamp(bf0[36], bf0[43], lo, hi);
+  bf1[44] = SubClamp(bf0[35], bf0[44], lo, hi);
+  bf1[45] = SubClamp(bf0[34], bf0[45], lo, hi);
+  bf1[46] = SubClamp(bf0[33], bf0[46], lo, hi);
+  bf1[47] = SubClamp(bf0[32], bf0[47], lo, hi);
+  bf1[48] = SubClamp(bf0[63], bf0[48], lo, hi);
+  bf1[49] = SubClamp(bf0[62], bf0[49], lo, hi);
+  bf1[50] = SubClamp(bf0[61], bf0[50], lo, hi);
+  bf1[51] = SubClamp(bf0[60], bf0[51], lo, hi);
+  bf1[52] = SubClamp(bf0[59], bf0[52], lo, hi);
+  bf1[53] = SubClamp(bf0[58], bf0[53], lo, hi);
+  bf1[54] = SubClamp(bf0[57], bf0[54], lo, hi);
+  bf1[55] = SubClamp(bf0[56], bf0[55], lo, hi);
+  bf1[56] = AddClamp(bf0[55], bf0[56], lo, hi);
+  bf1[57] = AddClamp(bf0[54], bf0[57], lo, hi);
+  bf1[58] = AddClamp(bf0[53], bf0[58], lo, hi);
+  bf1[59] = AddClamp(bf0[52], bf0[59], lo, hi);
+  bf1[60] = AddClamp(bf0[51], bf0[60], lo, hi);
+  bf1[61] = AddClamp(bf0[50], bf0[61], lo, hi);
+  bf1[62] = AddClamp(bf0[49], bf0[62], lo, hi);
+  bf1[63] = AddClamp(bf0[48], bf0[63], lo, hi);
+
+  // stage 10
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = AddClamp(bf0[0], bf0[31], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[30], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[29], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[28], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[27], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[26], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[25], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[24], lo, hi);
+  bf1[8] = AddClamp(bf0[8], bf0[23], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[22], lo, hi);
+  bf1[10] = AddClamp(bf0[10], bf0[21], lo, hi);
+  bf1[11] = AddClamp(bf0[11], bf0[20], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[19], lo, hi);
+  bf1[13] = AddClamp(bf0[13], bf0[18], lo, hi);
+  bf1[14] = AddClamp(bf0[14], bf0[17], lo, hi);
+  bf1[15] = AddClamp(bf0[15], bf0[16], lo, hi);
+  bf1[16] = SubClamp(bf0[15], bf0[16], lo, hi);
+  bf1[17] = SubClamp(bf0[14], bf0[17], lo, hi);
+  bf1[18] = SubClamp(bf0[13], bf0[18], lo, hi);
+  bf1[19] = SubClamp(bf0[12], bf0[19], lo, hi);
+  bf1[20] = SubClamp(bf0[11], bf0[20], lo, hi);
+  bf1[21] = SubClamp(bf0[10], bf0[21], lo, hi);
+  bf1[22] = SubClamp(bf0[9], bf0[22], lo, hi);
+  bf1[23] = SubClamp(bf0[8], bf0[23], lo, hi);
+  bf1[24] = SubClamp(bf0[7], bf0[24], lo, hi);
+  bf1[25] = SubClamp(bf0[6], bf0[25], lo, hi);
+  bf1[26] = SubClamp(bf0[5], bf0[26], lo, hi);
+  bf1[27] = SubClamp(bf0[4], bf0[27], lo, hi);
+  bf1[28] = SubClamp(bf0[3], bf0[28], lo, hi);
+  bf1[29] = SubClamp(bf0[2], bf0[29], lo, hi);
+  bf1[30] = SubClamp(bf0[1], bf0[30], lo, hi);
+  bf1[31] = SubClamp(bf0[0], bf0[31], lo, hi);
+  bf1[32] = bf0[32];
+  bf1[33] = bf0[33];
+  bf1[34] = bf0[34];
+  bf1[35] = bf0[35];
+  bf1[36] = bf0[36];
+  bf1[37] = bf0[37];
+  bf1[38] = bf0[38];
+  bf1[39] = bf0[39];
+  bf1[40] = HalfBtf(d, -cospi[32], bf0[40], cospi[32], bf0[55]);
+  bf1[41] = HalfBtf(d, -cospi[32], bf0[41], cospi[32], bf0[54]);
+  bf1[42] = HalfBtf(d, -cospi[32], bf0[42], cospi[32], bf0[53]);
+  bf1[43] = HalfBtf(d, -cospi[32], bf0[43], cospi[32], bf0[52]);
+  bf1[44] = HalfBtf(d, -cospi[32], bf0[44], cospi[32], bf0[51]);
+  bf1[45] = HalfBtf(d, -cospi[32], bf0[45], cospi[32], bf0[50]);
+  bf1[46] = HalfBtf(d, -cospi[32], bf0[46], cospi[32], bf0[49]);
+  bf1[47] = HalfBtf(d, -cospi[32], bf0[47], cospi[32], bf0[48]);
+  bf1[48] = HalfBtf(d, cospi[32], bf0[47], cospi[32], bf0[48]);
+  bf1[49] = HalfBtf(d, cospi[32], bf0[46], cospi[32], bf0[49]);
+  bf1[50] = HalfBtf(d, cospi[32], bf0[45], cospi[32], bf0[50]);
+  bf1[51] = HalfBtf(d, cospi[32], bf0[44], cospi[32], bf0[51]);
+  bf1[52] = HalfBtf(d, cospi[32], bf0[43], cospi[32], bf0[52]);
+  bf1[53] = HalfBtf(d, cospi[32], bf0[42], cospi[32], bf0[53]);
+  bf1[54] = HalfBtf(d, cospi[32], bf0[41], cospi[32], bf0[54]);
+  bf1[55] = HalfBtf(d, cospi[32], bf0[40], cospi[32], bf0[55]);
+  bf1[56] = bf0[56];
+  bf1[57] = bf0[57];
+  bf1[58] = bf0[58];
+  bf1[59] = bf0[59];
+  bf1[60] = bf0[60];
+  bf1[61] = bf0[61];
+  bf1[62] = bf0[62];
+  bf1[63] = bf0[63];
+
+  // stage 11
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[63], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[62], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[61], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[60], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[59], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[58], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[57], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[56], lo, hi);
+  bf1[8] = AddClamp(bf0[8], bf0[55], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[54], lo, hi);
+  bf1[10] = AddClamp(bf0[10], bf0[53], lo, hi);
+  bf1[11] = AddClamp(bf0[11], bf0[52], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[51], lo, hi);
+  bf1[13] = AddClamp(bf0[13], bf0[50], lo, hi);
+  bf1[14] = AddClamp(bf0[14], bf0[49], lo, hi);
+  bf1[15] = AddClamp(bf0[15], bf0[48], lo, hi);
+  bf1[16] = AddClamp(bf0[16], bf0[47], lo, hi);
+  bf1[17] = AddClamp(bf0[17], bf0[46], lo, hi);
+  bf1[18] = AddClamp(bf0[18], bf0[45], lo, hi);
+  bf1[19] = AddClamp(bf0[19], bf0[44], lo, hi);
+  bf1[20] = AddClamp(bf0[20], bf0[43], lo, hi);
+  bf1[21] = AddClamp(bf0[21], bf0[42], lo, hi);
+  bf1[22] = AddClamp(bf0[22], bf0[41], lo, hi);
+  bf1[23] = AddClamp(bf0[23], bf0[40], lo, hi);
+  bf1[24] = AddClamp(bf0[24], bf0[39], lo, hi);
+  bf1[25] = AddClamp(bf0[25], bf0[38], lo, hi);
+  bf1[26] = AddClamp(bf0[26], bf0[37], lo, hi);
+  bf1[27] = AddClamp(bf0[27], bf0[36], lo, hi);
+  bf1[28] = AddClamp(bf0[28], bf0[35], lo, hi);
+  bf1[29] = AddClamp(bf0[29], bf0[34], lo, hi);
+  bf1[30] = AddClamp(bf0[30], bf0[33], lo, hi);
+  bf1[31] = AddClamp(bf0[31], bf0[32], lo, hi);
+  bf1[32] = SubClamp(bf0[31], bf0[32], lo, hi);
+  bf1[33] = SubClamp(bf0[30], bf0[33], lo, hi);
+  bf1[34] = SubClamp(bf0[29], bf0[34], lo, hi);
+  bf1[35] = SubClamp(bf0[28], bf0[35], lo, hi);
+  bf1[36] = SubClamp(bf0[27], bf0[36], lo, hi);
+  bf1[37] = SubClamp(bf0[26], bf0[37], lo, hi);
+  bf1[38] = SubClamp(bf0[25], bf0[38], lo, hi);
+  bf1[39] = SubClamp(bf0[24], bf0[39], lo, hi);
+  bf1[40] = SubClamp(bf0[23], bf0[40], lo, hi);
+  bf1[41] = SubClamp(bf0[22], bf0[41], lo, hi);
+  bf1[42] = SubClamp(bf0[21], bf0[42], lo, hi);
+  bf1[43] = SubClamp(bf0[20], bf0[43], lo, hi);
+  bf1[44] = SubClamp(bf0[19], bf0[44], lo, hi);
+  bf1[45] = SubClamp(bf0[18], bf0[45], lo, hi);
+  bf1[46] = SubClamp(bf0[17], bf0[46], lo, hi);
+  bf1[47] = SubClamp(bf0[16], bf0[47], lo, hi);
+  bf1[48] = SubClamp(bf0[15], bf0[48], lo, hi);
+  bf1[49] = SubClamp(bf0[14], bf0[49], lo, hi);
+  bf1[50] = SubClamp(bf0[13], bf0[50], lo, hi);
+  bf1[51] = SubClamp(bf0[12], bf0[51], lo, hi);
+  bf1[52] = SubClamp(bf0[11], bf0[52], lo, hi);
+  bf1[53] = SubClamp(bf0[10], bf0[53], lo, hi);
+  bf1[54] = SubClamp(bf0[9], bf0[54], lo, hi);
+  bf1[55] = SubClamp(bf0[8], bf0[55], lo, hi);
+  bf1[56] = SubClamp(bf0[7], bf0[56], lo, hi);
+  bf1[57] = SubClamp(bf0[6], bf0[57], lo, hi);
+  bf1[58] = SubClamp(bf0[5], bf0[58], lo, hi);
+  bf1[59] = SubClamp(bf0[4], bf0[59], lo, hi);
+  bf1[60] = SubClamp(bf0[3], bf0[60], lo, hi);
+  bf1[61] = SubClamp(bf0[2], bf0[61], lo, hi);
+  bf1[62] = SubClamp(bf0[1], bf0[62], lo, hi);
+  bf1[63] = SubClamp(bf0[0], bf0[63], lo, hi);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Iadst8(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                                hn::VFromD<D> *HWY_RESTRICT output,
+                                const int32_t *cospi, hn::VFromD<D> lo,
+                                hn::VFromD<D> hi) {
+  hn::VFromD<D> step[8];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[7];
+  bf1[1] = input[0];
+  bf1[2] = input[5];
+  bf1[3] = input[2];
+  bf1[4] = input[3];
+  bf1[5] = input[4];
+  bf1[6] = input[1];
+  bf1[7] = input[6];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = HalfBtf(d, cospi[4], bf0[0], cospi[60], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[60], bf0[0], -cospi[4], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[20], bf0[2], cospi[44], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[44], bf0[2], -cospi[20], bf0[3]);
+  bf1[4] = HalfBtf(d, cospi[36], bf0[4], cospi[28], bf0[5]);
+  bf1[5] = HalfBtf(d, cospi[28], bf0[4], -cospi[36], bf0[5]);
+  bf1[6] = HalfBtf(d, cospi[52], bf0[6], cospi[12], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[12], bf0[6], -cospi[52], bf0[7]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[4], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[5], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[6], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[7], lo, hi);
+  bf1[4] = SubClamp(bf0[0], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[1], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[2], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[3], bf0[7], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[16], bf0[4], cospi[48], bf0[5]);
+  bf1[5] = HalfBtf(d, cospi[48], bf0[4], -cospi[16], bf0[5]);
+  bf1[6] = HalfBtf(d, -cospi[48], bf0[6], cospi[16], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[16], bf0[6], cospi[48], bf0[7]);
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[2], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[3], lo, hi);
+  bf1[2] = SubClamp(bf0[0], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[1], bf0[3], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[6], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[7], lo, hi);
+  bf1[6] = SubClamp(bf0[4], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[5], bf0[7], lo, hi);
+
+  // stage 6
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = HalfBtf(d, cospi[32], bf0[2], cospi[32], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[32], bf0[2], -cospi[32], bf0[3]);
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = HalfBtf(d, cospi[32], bf0[6], cospi[32], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[32], bf0[6], -cospi[32], bf0[7]);
+
+  // stage 7
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = hn::Neg(bf0[4]);
+  bf1[2] = bf0[6];
+  bf1[3] = hn::Neg(bf0[2]);
+  bf1[4] = bf0[3];
+  bf1[5] = hn::Neg(bf0[7]);
+  bf1[6] = bf0[5];
+  bf1[7] = hn::Neg(bf0[1]);
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Iadst16(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                                 hn::VFromD<D> *HWY_RESTRICT output,
+                                 const int32_t *cospi, hn::VFromD<D> lo,
+                                 hn::VFromD<D> hi) {
+  hn::VFromD<D> step[16];
+  hn::VFromD<D> *bf0, *bf1;
+
+  // stage 1
+  bf1 = output;
+  bf1[0] = input[15];
+  bf1[1] = input[0];
+  bf1[2] = input[13];
+  bf1[3] = input[2];
+  bf1[4] = input[11];
+  bf1[5] = input[4];
+  bf1[6] = input[9];
+  bf1[7] = input[6];
+  bf1[8] = input[7];
+  bf1[9] = input[8];
+  bf1[10] = input[5];
+  bf1[11] = input[10];
+  bf1[12] = input[3];
+  bf1[13] = input[12];
+  bf1[14] = input[1];
+  bf1[15] = input[14];
+
+  // stage 2
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = HalfBtf(d, cospi[2], bf0[0], cospi[62], bf0[1]);
+  bf1[1] = HalfBtf(d, cospi[62], bf0[0], -cospi[2], bf0[1]);
+  bf1[2] = HalfBtf(d, cospi[10], bf0[2], cospi[54], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[54], bf0[2], -cospi[10], bf0[3]);
+  bf1[4] = HalfBtf(d, cospi[18], bf0[4], cospi[46], bf0[5]);
+  bf1[5] = HalfBtf(d, cospi[46], bf0[4], -cospi[18], bf0[5]);
+  bf1[6] = HalfBtf(d, cospi[26], bf0[6], cospi[38], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[38], bf0[6], -cospi[26], bf0[7]);
+  bf1[8] = HalfBtf(d, cospi[34], bf0[8], cospi[30], bf0[9]);
+  bf1[9] = HalfBtf(d, cospi[30], bf0[8], -cospi[34], bf0[9]);
+  bf1[10] = HalfBtf(d, cospi[42], bf0[10], cospi[22], bf0[11]);
+  bf1[11] = HalfBtf(d, cospi[22], bf0[10], -cospi[42], bf0[11]);
+  bf1[12] = HalfBtf(d, cospi[50], bf0[12], cospi[14], bf0[13]);
+  bf1[13] = HalfBtf(d, cospi[14], bf0[12], -cospi[50], bf0[13]);
+  bf1[14] = HalfBtf(d, cospi[58], bf0[14], cospi[6], bf0[15]);
+  bf1[15] = HalfBtf(d, cospi[6], bf0[14], -cospi[58], bf0[15]);
+
+  // stage 3
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[8], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[9], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[10], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[11], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[12], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[13], lo, hi);
+  bf1[6] = AddClamp(bf0[6], bf0[14], lo, hi);
+  bf1[7] = AddClamp(bf0[7], bf0[15], lo, hi);
+  bf1[8] = SubClamp(bf0[0], bf0[8], lo, hi);
+  bf1[9] = SubClamp(bf0[1], bf0[9], lo, hi);
+  bf1[10] = SubClamp(bf0[2], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[3], bf0[11], lo, hi);
+  bf1[12] = SubClamp(bf0[4], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[5], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[6], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[7], bf0[15], lo, hi);
+
+  // stage 4
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = bf0[6];
+  bf1[7] = bf0[7];
+  bf1[8] = HalfBtf(d, cospi[8], bf0[8], cospi[56], bf0[9]);
+  bf1[9] = HalfBtf(d, cospi[56], bf0[8], -cospi[8], bf0[9]);
+  bf1[10] = HalfBtf(d, cospi[40], bf0[10], cospi[24], bf0[11]);
+  bf1[11] = HalfBtf(d, cospi[24], bf0[10], -cospi[40], bf0[11]);
+  bf1[12] = HalfBtf(d, -cospi[56], bf0[12], cospi[8], bf0[13]);
+  bf1[13] = HalfBtf(d, cospi[8], bf0[12], cospi[56], bf0[13]);
+  bf1[14] = HalfBtf(d, -cospi[24], bf0[14], cospi[40], bf0[15]);
+  bf1[15] = HalfBtf(d, cospi[40], bf0[14], cospi[24], bf0[15]);
+
+  // stage 5
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[4], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[5], lo, hi);
+  bf1[2] = AddClamp(bf0[2], bf0[6], lo, hi);
+  bf1[3] = AddClamp(bf0[3], bf0[7], lo, hi);
+  bf1[4] = SubClamp(bf0[0], bf0[4], lo, hi);
+  bf1[5] = SubClamp(bf0[1], bf0[5], lo, hi);
+  bf1[6] = SubClamp(bf0[2], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[3], bf0[7], lo, hi);
+  bf1[8] = AddClamp(bf0[8], bf0[12], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[13], lo, hi);
+  bf1[10] = AddClamp(bf0[10], bf0[14], lo, hi);
+  bf1[11] = AddClamp(bf0[11], bf0[15], lo, hi);
+  bf1[12] = SubClamp(bf0[8], bf0[12], lo, hi);
+  bf1[13] = SubClamp(bf0[9], bf0[13], lo, hi);
+  bf1[14] = SubClamp(bf0[10], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[11], bf0[15], lo, hi);
+
+  // stage 6
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = bf0[2];
+  bf1[3] = bf0[3];
+  bf1[4] = HalfBtf(d, cospi[16], bf0[4], cospi[48], bf0[5]);
+  bf1[5] = HalfBtf(d, cospi[48], bf0[4], -cospi[16], bf0[5]);
+  bf1[6] = HalfBtf(d, -cospi[48], bf0[6], cospi[16], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[16], bf0[6], cospi[48], bf0[7]);
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = bf0[10];
+  bf1[11] = bf0[11];
+  bf1[12] = HalfBtf(d, cospi[16], bf0[12], cospi[48], bf0[13]);
+  bf1[13] = HalfBtf(d, cospi[48], bf0[12], -cospi[16], bf0[13]);
+  bf1[14] = HalfBtf(d, -cospi[48], bf0[14], cospi[16], bf0[15]);
+  bf1[15] = HalfBtf(d, cospi[16], bf0[14], cospi[48], bf0[15]);
+
+  // stage 7
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = AddClamp(bf0[0], bf0[2], lo, hi);
+  bf1[1] = AddClamp(bf0[1], bf0[3], lo, hi);
+  bf1[2] = SubClamp(bf0[0], bf0[2], lo, hi);
+  bf1[3] = SubClamp(bf0[1], bf0[3], lo, hi);
+  bf1[4] = AddClamp(bf0[4], bf0[6], lo, hi);
+  bf1[5] = AddClamp(bf0[5], bf0[7], lo, hi);
+  bf1[6] = SubClamp(bf0[4], bf0[6], lo, hi);
+  bf1[7] = SubClamp(bf0[5], bf0[7], lo, hi);
+  bf1[8] = AddClamp(bf0[8], bf0[10], lo, hi);
+  bf1[9] = AddClamp(bf0[9], bf0[11], lo, hi);
+  bf1[10] = SubClamp(bf0[8], bf0[10], lo, hi);
+  bf1[11] = SubClamp(bf0[9], bf0[11], lo, hi);
+  bf1[12] = AddClamp(bf0[12], bf0[14], lo, hi);
+  bf1[13] = AddClamp(bf0[13], bf0[15], lo, hi);
+  bf1[14] = SubClamp(bf0[12], bf0[14], lo, hi);
+  bf1[15] = SubClamp(bf0[13], bf0[15], lo, hi);
+
+  // stage 8
+  bf0 = output;
+  bf1 = step;
+  bf1[0] = bf0[0];
+  bf1[1] = bf0[1];
+  bf1[2] = HalfBtf(d, cospi[32], bf0[2], cospi[32], bf0[3]);
+  bf1[3] = HalfBtf(d, cospi[32], bf0[2], -cospi[32], bf0[3]);
+  bf1[4] = bf0[4];
+  bf1[5] = bf0[5];
+  bf1[6] = HalfBtf(d, cospi[32], bf0[6], cospi[32], bf0[7]);
+  bf1[7] = HalfBtf(d, cospi[32], bf0[6], -cospi[32], bf0[7]);
+  bf1[8] = bf0[8];
+  bf1[9] = bf0[9];
+  bf1[10] = HalfBtf(d, cospi[32], bf0[10], cospi[32], bf0[11]);
+  bf1[11] = HalfBtf(d, cospi[32], bf0[10], -cospi[32], bf0[11]);
+  bf1[12] = bf0[12];
+  bf1[13] = bf0[13];
+  bf1[14] = HalfBtf(d, cospi[32], bf0[14], cospi[32], bf0[15]);
+  bf1[15] = HalfBtf(d, cospi[32], bf0[14], -cospi[32], bf0[15]);
+
+  // stage 9
+  bf0 = step;
+  bf1 = output;
+  bf1[0] = bf0[0];
+  bf1[1] = hn::Neg(bf0[8]);
+  bf1[2] = bf0[12];
+  bf1[3] = hn::Neg(bf0[4]);
+  bf1[4] = bf0[6];
+  bf1[5] = hn::Neg(bf0[14]);
+  bf1[6] = bf0[10];
+  bf1[7] = hn::Neg(bf0[2]);
+  bf1[8] = bf0[3];
+  bf1[9] = hn::Neg(bf0[11]);
+  bf1[10] = bf0[15];
+  bf1[11] = hn::Neg(bf0[7]);
+  bf1[12] = bf0[5];
+  bf1[13] = hn::Neg(bf0[13]);
+  bf1[14] = bf0[9];
+  bf1[15] = hn::Neg(bf0[1]);
+}
+
+// av1_iadst4() needs its intermediate sums in 64 bits, so each half of the
+// vector is widened and the results are truncated back.
+template <typename D>
+HWY_ATTR HWY_INLINE void Iadst4Wide(D d, const hn::VFromD<D> *HWY_RESTRICT x,
+                                    hn::VFromD<D> *HWY_RESTRICT out) {
+  const int32_t *sinpi = sinpi_arr(INV_COS_BIT);
+  const auto s0 = hn::Mul(hn::Set(d, sinpi[1]), x[0]);
+  const auto s1 = hn::Mul(hn::Set(d, sinpi[2]), x[0]);
+  const auto s2 = hn::Mul(hn::Set(d, sinpi[3]), x[1]);
+  const auto s3 = hn::Mul(hn::Set(d, sinpi[4]), x[2]);
+  const auto s4 = hn::Mul(hn::Set(d, sinpi[1]), x[2]);
+  const auto s5 = hn::Mul(hn::Set(d, sinpi[2]), x[3]);
+  const auto s6 = hn::Mul(hn::Set(d, sinpi[4]), x[3]);
+  const auto s7 = hn::Add(hn::Sub(x[0], x[2]), x[3]);
+
+  const auto t0 = hn::Add(hn::Add(s0, s3), s5);
+  const auto t1 = hn::Sub(hn::Sub(s1, s4), s6);
+  const auto t2 = hn::Mul(hn::Set(d, sinpi[3]), s7);
+
+  const auto round = hn::Set(d, int64_t{ 1 } << (INV_COS_BIT - 1));
+  out[0] = hn::ShiftRight<INV_COS_BIT>(hn::Add(hn::Add(t0, s2), round));
+  out[1] = hn::ShiftRight<INV_COS_BIT>(hn::Add(hn::Add(t1, s2), round));
+  out[2] = hn::ShiftRight<INV_COS_BIT>(hn::Add(t2, round));
+  out[3] = hn::ShiftRight<INV_COS_BIT>(
+      hn::Add(hn::Sub(hn::Add(t0, t1), s2), round));
+}
+
+template <typename D>
+HWY_ATTR HWY_INLINE void Iadst4(D d, const hn::VFromD<D> *HWY_RESTRICT input,
+                                hn::VFromD<D> *HWY_RESTRICT output) {
+  constexpr hn::RepartitionToWide<D> wide_tag;
+  hn::VFromD<decltype(wide_tag)> lo[4], hi[4], lo_out[4], hi_out[4];
+  for (int i = 0; i < 4; ++i) {
+    lo[i] = hn::PromoteLowerTo(wide_tag, input[i]);
+    hi[i] = hn::PromoteUpperTo(wide_tag, input[i]);
+  }
+  Iadst4Wide(wide_tag, lo, lo_out);
+  Iadst4Wide(wide_tag, hi, hi_out);
+  constexpr hn::RebindToUnsigned<D> uint_tag;
+  constexpr hn::RebindToUnsigned<decltype(wide_tag)> wide_uint_tag;
+  for (int i = 0; i < 4; ++i) {
+    const auto lo_bits = hn::BitCast(wide_uint_tag, lo_out[i]);
+    const auto hi_bits = hn::BitCast(wide_uint_tag, hi_out[i]);
+    output[i] =
+        hn::BitCast(d, hn::OrderedTruncate2To(uint_tag, lo_bits, hi_bits));
+  }
+}
+
+template <int Size>
+struct InverseTransform1D {};
+
+template <>
+struct InverseTransform1D<4> {
+  template <typename D>
+  HWY_ATTR HWY_INLINE static void Apply(D d, TXFM_TYPE type,
+                                        const hn::VFromD<D> *input,
+                                        hn::VFromD<D> *output,
+                                        hn::VFromD<D> lo, hn::VFromD<D> hi) {
+    switch (type) {
+      case TXFM_TYPE_DCT4:
+        Idct4(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+        break;
+      case TXFM_TYPE_ADST4: Iadst4(d, input, output); break;
+      default:
+        assert(type == TXFM_TYPE_IDENTITY4);
+        for (int i = 0; i < 4; ++i) {
+          output[i] = MulRoundShift<NewSqrt2Bits>(d, input[i], NewSqrt2);
+        }
+        break;
+    }
+  }
+};
+
+template <>
+struct InverseTransform1D<8> {
+  template <typename D>
+  HWY_ATTR HWY_INLINE static void Apply(D d, TXFM_TYPE type,
+                                        const hn::VFromD<D> *input,
+                                        hn::VFromD<D> *output,
+                                        hn::VFromD<D> lo, hn::VFromD<D> hi) {
+    switch (type) {
+      case TXFM_TYPE_DCT8:
+        Idct8(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+        break;
+      case TXFM_TYPE_ADST8:
+        Iadst8(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+        break;
+      default:
+        assert(type == TXFM_TYPE_IDENTITY8);
+        for (int i = 0; i < 8; ++i) output[i] = hn::Add(input[i], input[i]);
+        break;
+    }
+  }
+};
+
+template <>
+struct InverseTransform1D<16> {
+  template <typename D>
+  HWY_ATTR HWY_INLINE static void Apply(D d, TXFM_TYPE type,
+                                        const hn::VFromD<D> *input,
+                                        hn::VFromD<D> *output,
+                                        hn::VFromD<D> lo, hn::VFromD<D> hi) {
+    switch (type) {
+      case TXFM_TYPE_DCT16:
+        Idct16(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+        break;
+      case TXFM_TYPE_ADST16:
+        Iadst16(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+        break;
+      default:
+        assert(type == TXFM_TYPE_IDENTITY16);
+        for (int i = 0; i < 16; ++i) {
+          output[i] = MulRoundShift<NewSqrt2Bits>(d, input[i], 2 * NewSqrt2);
+        }
+        break;
+    }
+  }
+};
+
+template <>
+struct InverseTransform1D<32> {
+  template <typename D>
+  HWY_ATTR HWY_INLINE static void Apply(D d, TXFM_TYPE type,
+                                        const hn::VFromD<D> *input,
+                                        hn::VFromD<D> *output,
+                                        hn::VFromD<D> lo, hn::VFromD<D> hi) {
+    if (type == TXFM_TYPE_DCT32) {
+      Idct32(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+    } else {
+      assert(type == TXFM_TYPE_IDENTITY32);
+      for (int i = 0; i < 32; ++i) output[i] = hn::ShiftLeft<2>(input[i]);
+    }
+  }
+};
+
+template <>
+struct InverseTransform1D<64> {
+  template <typename D>
+  HWY_ATTR HWY_INLINE static void Apply(D d, TXFM_TYPE type,
+                                        const hn::VFromD<D> *input,
+                                        hn::VFromD<D> *output,
+                                        hn::VFromD<D> lo, hn::VFromD<D> hi) {
+    assert(type == TXFM_TYPE_DCT64);
+    (void)type;
+    Idct64(d, input, output, cospi_arr(INV_COS_BIT), lo, hi);
+  }
+};
+
+// Adds one row of residuals to the destination and clips to the pixel range.
+template <typename D, typename Pixel>
+HWY_ATTR HWY_INLINE void AddClipStore(D d, hn::VFromD<D> res, Pixel *dst,
+                                      hn::VFromD<D> max_pixel) {
+  constexpr hn::Rebind<Pixel, D> pixel_tag;
+  const auto sum = hn::Add(hn::PromoteTo(d, hn::LoadU(pixel_tag, dst)), res);
+  const auto clipped = hn::Min(hn::Max(sum, hn::Zero(d)), max_pixel);
+  hn::StoreU(hn::DemoteTo(pixel_tag, clipped), pixel_tag, dst);
+}
+
+// Mirrors inv_txfm2d_add_c(). Only the top-left 32x32 coefficients of the
+// 64-point sizes are coded, and they are packed with a column stride of
+// min(Height, 32), so the rest of the block is treated as zero instead of
+// being materialized as the C code does.
+//
+// The row pass works on groups of rows (one row per lane) and writes its
+// output column-major, so that the column pass can gather a group of columns
+// (one column per lane) with a single index vector, which also absorbs the
+// left-right flip.
+template <int Width, int Height, typename Pixel>
+HWY_ATTR void InverseTransform2D(const int32_t *input, Pixel *output,
+                                 int stride, TX_TYPE tx_type, TX_SIZE tx_size,
+                                 int bd) {
+  constexpr int kInRows = Height < 32 ? Height : 32;
+  constexpr int kInCols = Width < 32 ? Width : 32;
+  constexpr hn::CappedTag<int32_t, (Height < 16 ? Height : 16)> row_tag;
+  constexpr hn::CappedTag<int32_t, (Width < 16 ? Width : 16)> col_tag;
+  constexpr int kRowLanes = static_cast<int>(hn::MaxLanes(row_tag));
+  constexpr int kColLanes = static_cast<int>(hn::MaxLanes(col_tag));
+  using RowVec = hn::VFromD<decltype(row_tag)>;
+  using ColVec = hn::VFromD<decltype(col_tag)>;
+
+  TXFM_2D_FLIP_CFG cfg;
+  av1_get_inv_txfm_cfg(tx_type, tx_size, &cfg);
+  assert(cfg.cos_bit_row == INV_COS_BIT && cfg.cos_bit_col == INV_COS_BIT);
+  int8_t stage_range_col[MAX_TXFM_STAGE_NUM];
+  int8_t stage_range_row[MAX_TXFM_STAGE_NUM];
+  av1_gen_inv_stage_range(stage_range_col, stage_range_row, &cfg, tx_size, bd);
+  const int rect_type = get_rect_tx_log_ratio(Width, Height);
+
+  DECLARE_ALIGNED(64, int32_t, buf[Width * Height]);
+
+  // Rows.
+  {
+    const RowVec in_lo = ClampRangeLo(row_tag, bd + 8);
+    const RowVec in_hi = ClampRangeHi(row_tag, bd + 8);
+    const RowVec lo = ClampRangeLo(row_tag, stage_range_row[0]);
+    const RowVec hi = ClampRangeHi(row_tag, stage_range_row[0]);
+    RowVec in[Width], out[Width];
+    for (int r = 0; r < kInRows; r += kRowLanes) {
+      RowVec any = hn::Zero(row_tag);
+      for (int c = 0; c < kInCols; ++c) {
+        RowVec v = hn::LoadU(row_tag, input + c * kInRows + r);
+        if (abs(rect_type) == 1) {
+          v = MulRoundShift<NewSqrt2Bits>(row_tag, v, NewInvSqrt2);
+        }
+        in[c] = hn::Min(hn::Max(v, in_lo), in_hi);
+        any = hn::Or(any, in[c]);
+      }
+      if (hn::AllTrue(row_tag, hn::Eq(any, hn::Zero(row_tag)))) {
+        // Every transform maps zero input to zero output.
+        for (int c = 0; c < Width; ++c) {
+          hn::Store(hn::Zero(row_tag), row_tag, buf + c * Height + r);
+        }
+        continue;
+      }
+      for (int c = kInCols; c < Width; ++c) in[c] = hn::Zero(row_tag);
+      InverseTransform1D<Width>::Apply(row_tag, cfg.txfm_type_row, in, out, lo,
+                                       hi);
+      for (int c = 0; c < Width; ++c) {
+        hn::Store(RoundShift(row_tag, out[c], -cfg.shift[0]), row_tag,
+                  buf + c * Height + r);
+      }
+    }
+  }
+
+  // Columns.
+  {
+    constexpr hn::RebindToSigned<decltype(col_tag)> index_tag;
+    const ColVec in_lo = ClampRangeLo(col_tag, AOMMAX(bd + 6, 16));
+    const ColVec in_hi = ClampRangeHi(col_tag, AOMMAX(bd + 6, 16));
+    const ColVec lo = ClampRangeLo(col_tag, stage_range_col[0]);
+    const ColVec hi = ClampRangeHi(col_tag, stage_range_col[0]);
+    const ColVec max_pixel = hn::Set(col_tag, (1 << bd) - 1);
+    const auto lane = hn::Iota(index_tag, 0);
+    ColVec in[Height], out[Height];
+    for (int c = 0; c < Width; c += kColLanes) {
+      const auto index =
+          cfg.lr_flip
+              ? hn::Mul(hn::Sub(hn::Set(index_tag, Width - 1 - c), lane),
+                        hn::Set(index_tag, Height))
+              : hn::Mul(hn::Add(hn::Set(index_tag, c), lane),
+                        hn::Set(index_tag, Height));
+      for (int r = 0; r < kInRows; ++r) {
+        const ColVec v = hn::GatherIndex(col_tag, buf + r, index);
+        in[r] = hn::Min(hn::Max(v, in_lo), in_hi);
+      }
+      for (int r = kInRows; r < Height; ++r) in[r] = hn::Zero(col_tag);
+      InverseTransform1D<Height>::Apply(col_tag, cfg.txfm_type_col, in, out,
+                                        lo, hi);
+      for (int r = 0; r < Height; ++r) {
+        const ColVec res = RoundShift(
+            col_tag, out[cfg.ud_flip ? Height - 1 - r : r], -cfg.shift[1]);
+        AddClipStore(col_tag, res, output + r * stride + c, max_pixel);
+      }
+    }
+  }
+}
+
+using HighbdInverseTransform2DFunc = void (*)(const int32_t *, uint16_t *, int,
+                                              TX_TYPE, TX_SIZE, int);
+using LowbdInverseTransform2DFunc = void (*)(const int32_t *, uint8_t *, int,
+                                             TX_TYPE, TX_SIZE, int);
+
+HWY_MAYBE_UNUSED void HighbdInverseTransformAdd(const tran_low_t *input,
+                                                uint8_t *dest, int stride,
+                                                const TxfmParam *txfm_param) {
+  if (txfm_param->lossless) {
+    av1_highbd_inv_txfm_add_c(input, dest, stride, txfm_param);
+    return;
+  }
+  constexpr HighbdInverseTransform2DFunc kTable[] = {
+#define POINTER(w, h, _) &InverseTransform2D<w, h, uint16_t>,
+    FOR_EACH_INV_TXFM2D(POINTER, _)
+#undef POINTER
+  };
+  kTable[txfm_param->tx_size](input, CONVERT_TO_SHORTPTR(dest), stride,
+                              txfm_param->tx_type, txfm_param->tx_size,
+                              txfm_param->bd);
+}
+
+HWY_MAYBE_UNUSED void LowbdInverseTransform2D(const int32_t *input,
+                                              uint8_t *output, int stride,
+                                              TX_TYPE tx_type,
+                                              TX_SIZE tx_size) {
+  constexpr LowbdInverseTransform2DFunc kTable[] = {
+#define POINTER(w, h, _) &InverseTransform2D<w, h, uint8_t>,
+    FOR_EACH_INV_TXFM2D(POINTER, _)
+#undef POINTER
+  };
+  kTable[tx_size](input, output, stride, tx_type, tx_size, /*bd=*/8);
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace
+
+HWY_AFTER_NAMESPACE();
+
+#define MAKE_INV_TXFM2D(w, h, suffix)                                         \
+  extern "C" void av1_inv_txfm2d_add_##w##x##h##_##suffix(                    \
+      const int32_t *input, uint16_t *output, int stride, TX_TYPE tx_type,    \
+      int bd);                                                                \
+  HWY_ATTR void av1_inv_txfm2d_add_##w##x##h##_##suffix(                      \
+      const int32_t *input, uint16_t *output, int stride, TX_TYPE tx_type,    \
+      int bd) {                                                               \
+    HWY_NAMESPACE::InverseTransform2D<w, h, uint16_t>(                        \
+        input, output, stride, tx_type, TX_##w##X##h, bd);                    \
+  }
+
+#define MAKE_INV_TXFM_ADD(suffix)                                             \
+  extern "C" void av1_highbd_inv_txfm_add_##suffix(                           \
+      const tran_low_t *input, uint8_t *dest, int stride,                     \
+      const TxfmParam *txfm_param);                                           \
+  HWY_ATTR void av1_highbd_inv_txfm_add_##suffix(                             \
+      const tran_low_t *input, uint8_t *dest, int stride,                     \
+      const TxfmParam *txfm_param) {                                          \
+    HWY_NAMESPACE::HighbdInverseTransformAdd(input, dest, stride,             \
+                                             txfm_param);                     \
+  }                                                                           \
+  extern "C" void av1_lowbd_inv_txfm2d_add_##suffix(                          \
+      const int32_t *input, uint8_t *output, int stride, TX_TYPE tx_type,     \
+      TX_SIZE tx_size, int eob);                                              \
+  HWY_ATTR void av1_lowbd_inv_txfm2d_add_##suffix(                            \
+      const int32_t *input, uint8_t *output, int stride, TX_TYPE tx_type,     \
+      TX_SIZE tx_size, int eob) {                                             \
+    (void)eob;                                                                \
+    HWY_NAMESPACE::LowbdInverseTransform2D(input, output, stride, tx_type,    \
+                                           tx_size);                          \
+  }                                                                           \
+  extern "C" void av1_inv_txfm_add_##suffix(const tran_low_t *dqcoeff,        \
+                                            uint8_t *dst, int stride,         \
+                                            const TxfmParam *txfm_param);     \
+  HWY_ATTR void av1_inv_txfm_add_##suffix(const tran_low_t *dqcoeff,          \
+                                          uint8_t *dst, int stride,           \
+                                          const TxfmParam *txfm_param) {      \
+    if (txfm_param->lossless) {                                               \
+      av1_inv_txfm_add_c(dqcoeff, dst, stride, txfm_param);                   \
+      return;                                                                 \
+    }                                                                         \
+    HWY_NAMESPACE::LowbdInverseTransform2D(dqcoeff, dst, stride,              \
+                                           txfm_param->tx_type,               \
+                                           txfm_param->tx_size);              \
+  }
+
+#endif  // AOM_AV1_COMMON_AV1_INV_TXFM2D_HWY_H_
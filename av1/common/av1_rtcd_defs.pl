@@ -116,6 +116,18 @@ if ((aom_config("CONFIG_REALTIME_ONLY") ne "yes") || (aom_config("CONFIG_AV1_DEC
   specialize qw/av1_wiener_convolve_add_src sse2 avx2 neon rvv/;
 }
 
+# Film grain synthesis
+if (aom_config("CONFIG_AV1_DECODER") eq "yes") {
+  add_proto qw/void av1_add_luma_grain/, "uint8_t *luma, int luma_stride, const int *grain, int grain_stride, int width, int height, const int *scaling_lut, int scaling_shift, int min_value, int max_value";
+  specialize qw/av1_add_luma_grain avx2/;
+  add_proto qw/void av1_add_chroma_grain/, "uint8_t *chroma, int chroma_stride, const uint8_t *luma, int luma_stride, const int *grain, int grain_stride, int width, int height, int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut, int luma_mult, int chroma_mult, int offset, int scaling_shift, int min_value, int max_value";
+  specialize qw/av1_add_chroma_grain avx2/;
+  add_proto qw/void av1_highbd_add_luma_grain/, "uint16_t *luma, int luma_stride, const int *grain, int grain_stride, int width, int height, const int *scaling_lut, int scaling_shift, int min_value, int max_value, int bit_depth";
+  specialize qw/av1_highbd_add_luma_grain avx2/;
+  add_proto qw/void av1_highbd_add_chroma_grain/, "uint16_t *chroma, int chroma_stride, const uint16_t *luma, int luma_stride, const int *grain, int grain_stride, int width, int height, int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut, int luma_mult, int chroma_mult, int offset, int scaling_shift, int min_value, int max_value, int bit_depth";
+  specialize qw/av1_highbd_add_chroma_grain avx2/;
+}
+
 # directional intra predictor functions
 add_proto qw/void av1_dr_prediction_z1/, "uint8_t *dst, ptrdiff_t stride, int bw, int bh, const uint8_t *above, const uint8_t *left, int upsample_above, int dx, int dy";
 specialize qw/av1_dr_prediction_z1 sse4_1 avx2 neon/;
@@ -155,6 +167,11 @@ specialize qw/av1_inv_txfm_add ssse3 avx2 neon/;
 add_proto qw/void av1_highbd_inv_txfm_add/, "const tran_low_t *input, uint8_t *dest, int stride, const TxfmParam *txfm_param";
 specialize qw/av1_highbd_inv_txfm_add sse4_1 avx2 neon/;
 
+if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+  specialize qw/av1_inv_txfm_add avx512/;
+  specialize qw/av1_highbd_inv_txfm_add avx512/;
+}
+
 add_proto qw/void av1_inv_txfm2d_add_4x4/,  "const tran_low_t *input, uint8_t *dest, int stride, TX_TYPE tx_type, const int bd";
 specialize qw/av1_inv_txfm2d_add_4x4 neon/;
 add_proto qw/void av1_inv_txfm2d_add_8x8/,  "const tran_low_t *input, uint8_t *dest, int stride, TX_TYPE tx_type, const int bd";
@@ -220,6 +237,28 @@ add_proto qw/void av1_inv_txfm2d_add_16x4/, "const int32_t *input, uint16_t *out
 add_proto qw/void av1_inv_txfm2d_add_8x32/, "const int32_t *input, uint16_t *output, int stride, TX_TYPE tx_type, int bd";
 add_proto qw/void av1_inv_txfm2d_add_32x8/, "const int32_t *input, uint16_t *output, int stride, TX_TYPE tx_type, int bd";
 
+if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+  specialize qw/av1_inv_txfm2d_add_4x4 avx512/;
+  specialize qw/av1_inv_txfm2d_add_8x8 avx512/;
+  specialize qw/av1_inv_txfm2d_add_16x16 avx512/;
+  specialize qw/av1_inv_txfm2d_add_32x32 avx512/;
+  specialize qw/av1_inv_txfm2d_add_64x64 avx512/;
+  specialize qw/av1_inv_txfm2d_add_4x8 avx512/;
+  specialize qw/av1_inv_txfm2d_add_8x4 avx512/;
+  specialize qw/av1_inv_txfm2d_add_8x16 avx512/;
+  specialize qw/av1_inv_txfm2d_add_16x8 avx512/;
+  specialize qw/av1_inv_txfm2d_add_16x32 avx512/;
+  specialize qw/av1_inv_txfm2d_add_32x16 avx512/;
+  specialize qw/av1_inv_txfm2d_add_32x64 avx512/;
+  specialize qw/av1_inv_txfm2d_add_64x32 avx512/;
+  specialize qw/av1_inv_txfm2d_add_4x16 avx512/;
+  specialize qw/av1_inv_txfm2d_add_16x4 avx512/;
+  specialize qw/av1_inv_txfm2d_add_8x32 avx512/;
+  specialize qw/av1_inv_txfm2d_add_32x8 avx512/;
+  specialize qw/av1_inv_txfm2d_add_16x64 avx512/;
+  specialize qw/av1_inv_txfm2d_add_64x16 avx512/;
+}
+
 if (aom_config("CONFIG_AV1_HIGHBITDEPTH") eq "yes") {
   # directional intra predictor functions
   add_proto qw/void av1_highbd_dr_prediction_z1/, "uint16_t *dst, ptrdiff_t stride, int bw, int bh, const uint16_t *above, const uint16_t *left, int upsample_above, int dx, int dy, int bd";
@@ -532,6 +571,18 @@ if ($opts{config} !~ /libs-x86-win32-vs.*/) {
   specialize qw/cdef_filter_16_2 sse4_1 avx2 neon rvv/, "$ssse3_x86";
   specialize qw/cdef_filter_16_3 sse4_1 avx2 neon rvv/, "$ssse3_x86";
 
+  if (aom_config("CONFIG_HIGHWAY") eq "yes") {
+    specialize qw/cdef_filter_8_0 avx512/;
+    specialize qw/cdef_filter_8_1 avx512/;
+    specialize qw/cdef_filter_8_2 avx512/;
+    specialize qw/cdef_filter_8_3 avx512/;
+
+    specialize qw/cdef_filter_16_0 avx512/;
+    specialize qw/cdef_filter_16_1 avx512/;
+    specialize qw/cdef_filter_16_2 avx512/;
+    specialize qw/cdef_filter_16_3 avx512/;
+  }
+
   specialize qw/cdef_copy_rect8_8bit_to_16bit sse4_1 avx2 neon rvv/, "$ssse3_x86";
   if (aom_config("CONFIG_AV1_HIGHBITDEPTH") eq "yes") {
     specialize qw/cdef_copy_rect8_16bit_to_16bit sse4_1 avx2 neon rvv/, "$ssse3_x86";
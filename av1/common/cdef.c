@@ -465,15 +465,21 @@ void av1_cdef_fb_row(const AV1_COMMON *const cm, MACROBLOCKD *xd,
 // Returns:
 //   Nothing will be returned.
 void av1_cdef_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *const cm,
-                    MACROBLOCKD *xd, cdef_init_fb_row_t cdef_init_fb_row_fn) {
+                    MACROBLOCKD *xd, cdef_init_fb_row_t cdef_init_fb_row_fn,
+                    struct AV1RowOutputSync *row_output) {
   const int num_planes = av1_num_planes(cm);
   const int nvfb = (cm->mi_params.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
   av1_setup_dst_planes(xd->plane, cm->seq_params->sb_size, frame, 0, 0, 0,
                        num_planes);
 
-  for (int fbr = 0; fbr < nvfb; fbr++)
+  if (row_output != NULL) {
+    av1_row_output_start(cm, row_output, 1, MI_SIZE_64X64 * MI_SIZE, 0);
+  }
+  for (int fbr = 0; fbr < nvfb; fbr++) {
     av1_cdef_fb_row(cm, xd, cm->cdef_info.linebuf, cm->cdef_info.colbuf,
                     cm->cdef_info.srcbuf, fbr, cdef_init_fb_row_fn, NULL,
                     xd->error_info);
+    if (row_output != NULL) av1_row_output_mark(row_output, fbr);
+  }
 }
@@ -26,6 +26,7 @@
 enum { TOP, LEFT, BOTTOM, RIGHT, BOUNDARIES } UENUM1BYTE(BOUNDARY);
 
 struct AV1CdefSyncData;
+struct AV1RowOutputSync;
 
 /*!\brief Parameters related to CDEF Block */
 typedef struct {
@@ -88,12 +89,15 @@ typedef void (*cdef_init_fb_row_t)(
  * \param[in, out]  cm        Pointer to top level common structure
  * \param[in]       xd        Pointer to common current coding block structure
  * \param[in]       cdef_init_fb_row_fn   Function Pointer
+ * \param[in, out]  row_output  If not NULL, the filtered rows are reported to
+ *                              it
  *
  * \remark Nothing is returned. Instead, the filtered frame is output in
  * \c frame.
  */
 void av1_cdef_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *const cm,
-                    MACROBLOCKD *xd, cdef_init_fb_row_t cdef_init_fb_row_fn);
+                    MACROBLOCKD *xd, cdef_init_fb_row_t cdef_init_fb_row_fn,
+                    struct AV1RowOutputSync *row_output);
 void av1_cdef_fb_row(const AV1_COMMON *const cm, MACROBLOCKD *xd,
                      uint16_t **const linebuf, uint16_t **const colbuf,
                      uint16_t *const src, int fbr,
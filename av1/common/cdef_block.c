@@ -280,22 +280,9 @@ void cdef_filter_16_3_c(void *dst16, int dstride, const uint16_t *in,
                              /*enable_primary=*/0, /*enable_secondary=*/0);
 }
 
-/* Compute the primary filter strength for an 8x8 block based on the
-   directional variance difference. A high variance difference means
-   that we have a highly directional pattern (e.g. a high contrast
-   edge), so we can apply more deringing. A low variance means that we
-   either have a low contrast edge, or a non-directional texture, so
-   we want to be careful not to blur. */
-static inline int adjust_strength(int strength, int32_t var) {
-  const int i = var >> 6 ? AOMMIN(get_msb(var >> 6), 12) : 0;
-  /* We use the variance of 8x8 blocks to adjust the strength. */
-  return var ? (strength * (4 + i) + 8) >> 4 : 0;
-}
-
-static inline void aom_cdef_find_dir(const uint16_t *in, cdef_list *dlist,
-                                     int var[CDEF_NBLOCKS][CDEF_NBLOCKS],
-                                     int cdef_count, int coeff_shift,
-                                     int dir[CDEF_NBLOCKS][CDEF_NBLOCKS]) {
+void av1_cdef_find_dirs(const uint16_t *in, cdef_list *dlist,
+                        int var[CDEF_NBLOCKS][CDEF_NBLOCKS], int cdef_count,
+                        int coeff_shift, int dir[CDEF_NBLOCKS][CDEF_NBLOCKS]) {
   int bi;
 
   // Find direction of two 8x8 blocks together.
@@ -320,6 +307,40 @@ static inline void aom_cdef_find_dir(const uint16_t *in, cdef_list *dlist,
   }
 }
 
+// Filters the blocks dlist[bi] to dlist[end - 1] of a filter block. dst16
+// holds the blocks packed one after the other when packed is set.
+static void cdef_filter_blocks(uint8_t *dst8, uint16_t *dst16, int dstride,
+                               const uint16_t *in, int xdec, int ydec,
+                               int dir[CDEF_NBLOCKS][CDEF_NBLOCKS],
+                               int var[CDEF_NBLOCKS][CDEF_NBLOCKS], int pli,
+                               const cdef_list *dlist, int bi, int end,
+                               int packed, int pri_strength, int sec_strength,
+                               int damping, int coeff_shift,
+                               const cdef_filter_block_func *cdef_filter_fn) {
+  const int bw_log2 = 3 - xdec;
+  const int bh_log2 = 3 - ydec;
+  const int block_width = 8 >> xdec;
+  const int block_height = 8 >> ydec;
+
+  for (; bi < end; bi++) {
+    const int by = dlist[bi].by;
+    const int bx = dlist[bi].bx;
+    const int t =
+        (pli ? pri_strength : cdef_adjust_strength(pri_strength, var[by][bx]));
+    const int strength_index = (sec_strength == 0) | ((t == 0) << 1);
+    const int offset = (by << bh_log2) * dstride + (bx << bw_log2);
+    void *const dst = dst8     ? (void *)&dst8[offset]
+                      : packed ? (void *)&dst16[bi << (bw_log2 + bh_log2)]
+                               : (void *)&dst16[offset];
+
+    cdef_filter_fn[strength_index](
+        dst, packed ? 1 << bw_log2 : dstride,
+        &in[(by * CDEF_BSTRIDE << bh_log2) + (bx << bw_log2)], t, sec_strength,
+        pri_strength ? dir[by][bx] : 0, damping, damping, coeff_shift,
+        block_width, block_height);
+  }
+}
+
 void av1_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int dstride,
                         const uint16_t *in, int xdec, int ydec,
                         int dir[CDEF_NBLOCKS][CDEF_NBLOCKS], int *dirinit,
@@ -352,12 +373,34 @@ void av1_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int dstride,
     return;
   }
 
-  if (pli == 0) {
-    if (!dirinit || !*dirinit) {
-      aom_cdef_find_dir(in, dlist, var, cdef_count, coeff_shift, dir);
-      if (dirinit) *dirinit = 1;
+  /*
+   * strength_index == 0 : enable_primary = 1, enable_secondary = 1
+   * strength_index == 1 : enable_primary = 1, enable_secondary = 0
+   * strength_index == 2 : enable_primary = 0, enable_secondary = 1
+   * strength_index == 3 : enable_primary = 0, enable_secondary = 0
+   */
+  const cdef_filter_block_func cdef_filter_fn[2][4] = {
+    { cdef_filter_8_0, cdef_filter_8_1, cdef_filter_8_2, cdef_filter_8_3 },
+    { cdef_filter_16_0, cdef_filter_16_1, cdef_filter_16_2, cdef_filter_16_3 }
+  };
+  const cdef_filter_block_func *const filter_fn = cdef_filter_fn[!dst8];
+  const int packed = !dst8 && dirinit;
+
+  if (pli == 0 && (!dirinit || !*dirinit)) {
+    // Search the directions of two blocks at a time, the width of
+    // cdef_find_dir_dual(), and filter them while their pixels are still in
+    // the L1 cache.
+    for (bi = 0; bi < cdef_count; bi += 2) {
+      const int end = AOMMIN(bi + 2, cdef_count);
+      av1_cdef_find_dirs(in, dlist + bi, var, end - bi, coeff_shift, dir);
+      cdef_filter_blocks(dst8, dst16, dstride, in, xdec, ydec, dir, var, pli,
+                         dlist, bi, end, packed, pri_strength, sec_strength,
+                         damping, coeff_shift, filter_fn);
     }
+    if (dirinit) *dirinit = 1;
+    return;
   }
+
   if (pli == 1 && xdec != ydec) {
     for (bi = 0; bi < cdef_count; bi++) {
       static const int conv422[8] = { 7, 0, 2, 4, 5, 6, 6, 6 };
@@ -368,59 +411,7 @@ void av1_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int dstride,
     }
   }
 
-  if (dst8) {
-    const int block_width = 8 >> xdec;
-    const int block_height = 8 >> ydec;
-    /*
-     * strength_index == 0 : enable_primary = 1, enable_secondary = 1
-     * strength_index == 1 : enable_primary = 1, enable_secondary = 0
-     * strength_index == 2 : enable_primary = 0, enable_secondary = 1
-     * strength_index == 3 : enable_primary = 0, enable_secondary = 0
-     */
-    const cdef_filter_block_func cdef_filter_fn[4] = {
-      cdef_filter_8_0, cdef_filter_8_1, cdef_filter_8_2, cdef_filter_8_3
-    };
-
-    for (bi = 0; bi < cdef_count; bi++) {
-      by = dlist[bi].by;
-      bx = dlist[bi].bx;
-      const int t =
-          (pli ? pri_strength : adjust_strength(pri_strength, var[by][bx]));
-      const int strength_index = (sec_strength == 0) | ((t == 0) << 1);
-
-      cdef_filter_fn[strength_index](
-          &dst8[(by << bh_log2) * dstride + (bx << bw_log2)], dstride,
-          &in[(by * CDEF_BSTRIDE << bh_log2) + (bx << bw_log2)], t,
-          sec_strength, pri_strength ? dir[by][bx] : 0, damping, damping,
-          coeff_shift, block_width, block_height);
-    }
-  } else {
-    const int block_width = 8 >> xdec;
-    const int block_height = 8 >> ydec;
-    /*
-     * strength_index == 0 : enable_primary = 1, enable_secondary = 1
-     * strength_index == 1 : enable_primary = 1, enable_secondary = 0
-     * strength_index == 2 : enable_primary = 0, enable_secondary = 1
-     * strength_index == 3 : enable_primary = 0, enable_secondary = 0
-     */
-    const cdef_filter_block_func cdef_filter_fn[4] = {
-      cdef_filter_16_0, cdef_filter_16_1, cdef_filter_16_2, cdef_filter_16_3
-    };
-
-    for (bi = 0; bi < cdef_count; bi++) {
-      by = dlist[bi].by;
-      bx = dlist[bi].bx;
-      const int t =
-          (pli ? pri_strength : adjust_strength(pri_strength, var[by][bx]));
-      const int strength_index = (sec_strength == 0) | ((t == 0) << 1);
-
-      cdef_filter_fn[strength_index](
-          &dst16[dirinit ? bi << (bw_log2 + bh_log2)
-                         : (by << bh_log2) * dstride + (bx << bw_log2)],
-          dirinit ? 1 << bw_log2 : dstride,
-          &in[(by * CDEF_BSTRIDE << bh_log2) + (bx << bw_log2)], t,
-          sec_strength, pri_strength ? dir[by][bx] : 0, damping, damping,
-          coeff_shift, block_width, block_height);
-    }
-  }
+  cdef_filter_blocks(dst8, dst16, dstride, in, xdec, ydec, dir, var, pli,
+                     dlist, 0, cdef_count, packed, pri_strength, sec_strength,
+                     damping, coeff_shift, filter_fn);
 }
@@ -31,6 +31,10 @@
 #define CDEF_INBUF_SIZE \
   (CDEF_BSTRIDE * ((1 << MAX_SB_SIZE_LOG2) + 2 * CDEF_VBORDER))
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern const int cdef_pri_taps[2][2];
 extern const int cdef_sec_taps[2];
 extern const int (*const cdef_directions)[2];
@@ -47,6 +51,12 @@ typedef void (*cdef_filter_block_func)(void *dest, int dstride,
                                        int coeff_shift, int block_width,
                                        int block_height);
 
+// Finds the direction and directional variance of the blocks dlist[0] to
+// dlist[cdef_count - 1] of a filter block.
+void av1_cdef_find_dirs(const uint16_t *in, cdef_list *dlist,
+                        int var[CDEF_NBLOCKS][CDEF_NBLOCKS], int cdef_count,
+                        int coeff_shift, int dir[CDEF_NBLOCKS][CDEF_NBLOCKS]);
+
 void av1_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int dstride,
                         const uint16_t *in, int xdec, int ydec,
                         int dir[CDEF_NBLOCKS][CDEF_NBLOCKS], int *dirinit,
@@ -54,6 +64,18 @@ void av1_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int dstride,
                         cdef_list *dlist, int cdef_count, int level,
                         int sec_strength, int damping, int coeff_shift);
 
+/* Compute the primary filter strength for an 8x8 block based on the
+   directional variance difference. A high variance difference means
+   that we have a highly directional pattern (e.g. a high contrast
+   edge), so we can apply more deringing. A low variance means that we
+   either have a low contrast edge, or a non-directional texture, so
+   we want to be careful not to blur. */
+static inline int cdef_adjust_strength(int strength, int32_t var) {
+  const int i = var >> 6 ? AOMMIN(get_msb(var >> 6), 12) : 0;
+  /* We use the variance of 8x8 blocks to adjust the strength. */
+  return var ? (strength * (4 + i) + 8) >> 4 : 0;
+}
+
 static inline void fill_rect(uint16_t *dst, int dstride, int v, int h,
                              uint16_t x) {
   for (int i = 0; i < v; i++) {
@@ -62,4 +84,9 @@ static inline void fill_rect(uint16_t *dst, int dstride, int v, int h,
     }
   }
 }
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // AOM_AV1_COMMON_CDEF_BLOCK_H_
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_AV1_COMMON_CDEF_BLOCK_HWY_H_
+#define AOM_AV1_COMMON_CDEF_BLOCK_HWY_H_
+
+#include "config/aom_config.h"
+#include "config/av1_rtcd.h"
+
+#include "aom_ports/bitops.h"
+#include "av1/common/cdef_block.h"
+#include "third_party/highway/hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+
+namespace {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Loads or stores Rows consecutive rows of a block as a single vector, the
+// first row in the lowest lanes.
+template <int Rows>
+struct BlockRows {
+  template <typename D, typename T>
+  HWY_ATTR HWY_INLINE static hn::VFromD<D> Load(D d, const T *src,
+                                                int stride) {
+    constexpr hn::Half<D> half_tag;
+    return hn::Combine(
+        d, BlockRows<Rows / 2>::Load(half_tag, src + Rows / 2 * stride, stride),
+        BlockRows<Rows / 2>::Load(half_tag, src, stride));
+  }
+
+  template <typename D, typename T>
+  HWY_ATTR HWY_INLINE static void Store(D d, hn::VFromD<D> v, T *dst,
+                                        int stride) {
+    (void)d;
+    constexpr hn::Half<D> half_tag;
+    BlockRows<Rows / 2>::Store(half_tag, hn::LowerHalf(half_tag, v), dst,
+                               stride);
+    BlockRows<Rows / 2>::Store(half_tag, hn::UpperHalf(half_tag, v),
+                               dst + Rows / 2 * stride, stride);
+  }
+};
+
+template <>
+struct BlockRows<1> {
+  template <typename D, typename T>
+  HWY_ATTR HWY_INLINE static hn::VFromD<D> Load(D d, const T *src,
+                                                int stride) {
+    (void)stride;
+    return hn::LoadU(d, src);
+  }
+
+  template <typename D, typename T>
+  HWY_ATTR HWY_INLINE static void Store(D d, hn::VFromD<D> v, T *dst,
+                                        int stride) {
+    (void)stride;
+    hn::StoreU(v, d, dst);
+  }
+};
+
+// sign(a - b) * min(abs(a - b), max(0, threshold - (abs(a - b) >> adjdamp)))
+template <typename D>
+HWY_ATTR HWY_INLINE hn::VFromD<D> Constrain(D d, hn::VFromD<D> a,
+                                            hn::VFromD<D> b,
+                                            hn::VFromD<D> threshold,
+                                            int adjdamp) {
+  constexpr hn::RebindToUnsigned<D> uint_tag;
+  const auto diff = hn::Sub(a, b);
+  const auto sign = hn::ShiftRight<15>(diff);
+  const auto abs_diff = hn::Abs(diff);
+  const auto s = hn::SaturatedSub(
+      hn::BitCast(uint_tag, threshold),
+      hn::ShiftRightSame(hn::BitCast(uint_tag, abs_diff), adjdamp));
+  return hn::Xor(hn::Add(sign, hn::Min(abs_diff, hn::BitCast(d, s))), sign);
+}
+
+template <typename D, typename Pixel>
+struct StorePixels {};
+
+template <typename D>
+struct StorePixels<D, uint16_t> {
+  template <int Rows>
+  HWY_ATTR HWY_INLINE static void Store(D d, hn::VFromD<D> v, uint16_t *dst,
+                                        int stride) {
+    (void)d;
+    constexpr hn::RebindToUnsigned<D> uint_tag;
+    BlockRows<Rows>::Store(uint_tag, hn::BitCast(uint_tag, v), dst, stride);
+  }
+};
+
+template <typename D>
+struct StorePixels<D, uint8_t> {
+  template <int Rows>
+  HWY_ATTR HWY_INLINE static void Store(D d, hn::VFromD<D> v, uint8_t *dst,
+                                        int stride) {
+    (void)d;
+    constexpr hn::Rebind<uint8_t, D> uint8_tag;
+    BlockRows<Rows>::Store(uint8_tag, hn::DemoteTo(uint8_tag, v), dst, stride);
+  }
+};
+
+// Mirrors cdef_filter_block_internal(), processing Rows rows of a Width wide
+// block per vector. As in the other SIMD versions, CDEF_VERY_LARGE taps are
+// masked to zero rather than skipped when tracking the clipping maximum.
+template <int Width, int Rows, bool Primary, bool Secondary, typename Pixel>
+HWY_ATTR void FilterBlock(Pixel *dst, int dstride, const uint16_t *in,
+                          int pri_strength, int sec_strength, int dir,
+                          int pri_damping, int sec_damping, int coeff_shift,
+                          int block_height) {
+  constexpr hn::FixedTag<int16_t, Width * Rows> int16_tag;
+  constexpr hn::RebindToUnsigned<decltype(int16_tag)> uint16_tag;
+  constexpr bool kClip = Primary && Secondary;
+  using V = hn::VFromD<decltype(int16_tag)>;
+
+  const int po1 = cdef_directions[dir][0];
+  const int po2 = cdef_directions[dir][1];
+  const int s1o1 = cdef_directions[dir + 2][0];
+  const int s1o2 = cdef_directions[dir + 2][1];
+  const int s2o1 = cdef_directions[dir - 2][0];
+  const int s2o2 = cdef_directions[dir - 2][1];
+  const int *pri_taps = cdef_pri_taps[(pri_strength >> coeff_shift) & 1];
+  if (Primary && pri_strength) {
+    pri_damping = AOMMAX(0, pri_damping - get_msb(pri_strength));
+  }
+  if (Secondary && sec_strength) {
+    sec_damping = AOMMAX(0, sec_damping - get_msb(sec_strength));
+  }
+  const V pri_threshold = hn::Set(int16_tag, pri_strength);
+  const V sec_threshold = hn::Set(int16_tag, sec_strength);
+  const V pri_tap0 = hn::Set(int16_tag, pri_taps[0]);
+  const V pri_tap1 = hn::Set(int16_tag, pri_taps[1]);
+  const V sec_tap0 = hn::Set(int16_tag, cdef_sec_taps[0]);
+  const V sec_tap1 = hn::Set(int16_tag, cdef_sec_taps[1]);
+  const V large_mask = hn::Set(int16_tag, ~CDEF_VERY_LARGE);
+
+  const auto load = [&](const uint16_t *src) HWY_ATTR {
+    return hn::BitCast(int16_tag,
+                       BlockRows<Rows>::Load(uint16_tag, src, CDEF_BSTRIDE));
+  };
+
+  for (int i = 0; i < block_height; i += Rows) {
+    const uint16_t *src = in + i * CDEF_BSTRIDE;
+    const V row = load(src);
+    V sum = hn::Zero(int16_tag);
+    V max = row;
+    V min = row;
+
+    if (Primary) {
+      const V tap0 = load(src + po1);
+      const V tap1 = load(src - po1);
+      const V tap2 = load(src + po2);
+      const V tap3 = load(src - po2);
+      const auto constrain = [&](V tap) HWY_ATTR {
+        return Constrain(int16_tag, tap, row, pri_threshold, pri_damping);
+      };
+      sum = hn::Add(sum, hn::Mul(pri_tap0,
+                                 hn::Add(constrain(tap0), constrain(tap1))));
+      sum = hn::Add(sum, hn::Mul(pri_tap1,
+                                 hn::Add(constrain(tap2), constrain(tap3))));
+      if (kClip) {
+        max = hn::Max(max, hn::Max(hn::And(tap0, large_mask),
+                                   hn::And(tap1, large_mask)));
+        max = hn::Max(max, hn::Max(hn::And(tap2, large_mask),
+                                   hn::And(tap3, large_mask)));
+        min = hn::Min(min, hn::Min(hn::Min(tap0, tap1), hn::Min(tap2, tap3)));
+      }
+    }
+
+    if (Secondary) {
+      const V tap0 = load(src + s1o1);
+      const V tap1 = load(src - s1o1);
+      const V tap2 = load(src + s2o1);
+      const V tap3 = load(src - s2o1);
+      const V tap4 = load(src + s1o2);
+      const V tap5 = load(src - s1o2);
+      const V tap6 = load(src + s2o2);
+      const V tap7 = load(src - s2o2);
+      const auto constrain = [&](V tap) HWY_ATTR {
+        return Constrain(int16_tag, tap, row, sec_threshold, sec_damping);
+      };
+      sum = hn::Add(sum, hn::Mul(sec_tap0,
+                                 hn::Add(hn::Add(constrain(tap0),
+                                                 constrain(tap1)),
+                                         hn::Add(constrain(tap2),
+                                                 constrain(tap3)))));
+      sum = hn::Add(sum, hn::Mul(sec_tap1,
+                                 hn::Add(hn::Add(constrain(tap4),
+                                                 constrain(tap5)),
+                                         hn::Add(constrain(tap6),
+                                                 constrain(tap7)))));
+      if (kClip) {
+        // A CDEF_VERY_LARGE tap has its flag bit set and is otherwise zero,
+        // so the flag can be masked off after taking the maximum.
+        const V max01 = hn::Max(hn::And(tap0, large_mask),
+                                hn::And(tap1, large_mask));
+        const V max23 = hn::Max(hn::And(tap2, large_mask),
+                                hn::And(tap3, large_mask));
+        const V max45 = hn::Max(hn::And(tap4, large_mask),
+                                hn::And(tap5, large_mask));
+        const V max67 = hn::Max(hn::And(tap6, large_mask),
+                                hn::And(tap7, large_mask));
+        max = hn::Max(max, hn::Max(hn::Max(max01, max23),
+                                   hn::Max(max45, max67)));
+        min = hn::Min(min, hn::Min(hn::Min(hn::Min(tap0, tap1),
+                                           hn::Min(tap2, tap3)),
+                                   hn::Min(hn::Min(tap4, tap5),
+                                           hn::Min(tap6, tap7))));
+      }
+    }
+
+    // res = row + ((sum - (sum < 0) + 8) >> 4)
+    sum = hn::Add(sum, hn::ShiftRight<15>(sum));
+    V res = hn::Add(
+        row, hn::ShiftRight<4>(hn::Add(sum, hn::Set(int16_tag, 8))));
+    if (kClip) res = hn::Min(hn::Max(res, min), max);
+
+    StorePixels<decltype(int16_tag), Pixel>::template Store<Rows>(
+        int16_tag, res, dst + i * dstride, dstride);
+  }
+}
+
+template <bool Primary, bool Secondary, typename Pixel>
+HWY_ATTR HWY_INLINE void CdefFilter(void *dest, int dstride,
+                                    const uint16_t *in, int pri_strength,
+                                    int sec_strength, int dir, int pri_damping,
+                                    int sec_damping, int coeff_shift,
+                                    int block_width, int block_height) {
+  // Fill a whole vector with rows of the block: 8 wide blocks are always a
+  // multiple of 4 rows high, 4 wide blocks are 4 or 8 rows high.
+  constexpr int kLanes = HWY_MAX_BYTES / sizeof(int16_t);
+  constexpr int kRows8 = kLanes / 8 < 4 ? kLanes / 8 : 4;
+  constexpr int kRows4 = kLanes / 4 < 8 ? kLanes / 4 : 8;
+  Pixel *dst = static_cast<Pixel *>(dest);
+  if (block_width == 8) {
+    FilterBlock<8, kRows8, Primary, Secondary>(
+        dst, dstride, in, pri_strength, sec_strength, dir, pri_damping,
+        sec_damping, coeff_shift, block_height);
+  } else if (block_height % kRows4 == 0) {
+    FilterBlock<4, kRows4, Primary, Secondary>(
+        dst, dstride, in, pri_strength, sec_strength, dir, pri_damping,
+        sec_damping, coeff_shift, block_height);
+  } else {
+    FilterBlock<4, 4, Primary, Secondary>(
+        dst, dstride, in, pri_strength, sec_strength, dir, pri_damping,
+        sec_damping, coeff_shift, block_height);
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace
+
+HWY_AFTER_NAMESPACE();
+
+#define MAKE_CDEF_FILTER(bits, variant, primary, secondary, pixel, suffix)    \
+  extern "C" void cdef_filter_##bits##_##variant##_##suffix(                  \
+      void *dest, int dstride, const uint16_t *in, int pri_strength,          \
+      int sec_strength, int dir, int pri_damping, int sec_damping,            \
+      int coeff_shift, int block_width, int block_height);                    \
+  HWY_ATTR void cdef_filter_##bits##_##variant##_##suffix(                    \
+      void *dest, int dstride, const uint16_t *in, int pri_strength,          \
+      int sec_strength, int dir, int pri_damping, int sec_damping,            \
+      int coeff_shift, int block_width, int block_height) {                   \
+    HWY_NAMESPACE::CdefFilter<primary, secondary, pixel>(                     \
+        dest, dstride, in, pri_strength, sec_strength, dir, pri_damping,      \
+        sec_damping, coeff_shift, block_width, block_height);                 \
+  }
+
+#define MAKE_CDEF_FILTERS(suffix)                              \
+  MAKE_CDEF_FILTER(8, 0, true, true, uint8_t, suffix)          \
+  MAKE_CDEF_FILTER(8, 1, true, false, uint8_t, suffix)         \
+  MAKE_CDEF_FILTER(8, 2, false, true, uint8_t, suffix)         \
+  MAKE_CDEF_FILTER(8, 3, false, false, uint8_t, suffix)        \
+  MAKE_CDEF_FILTER(16, 0, true, true, uint16_t, suffix)        \
+  MAKE_CDEF_FILTER(16, 1, true, false, uint16_t, suffix)       \
+  MAKE_CDEF_FILTER(16, 2, false, true, uint16_t, suffix)       \
+  MAKE_CDEF_FILTER(16, 3, false, false, uint16_t, suffix)
+
+#endif  // AOM_AV1_COMMON_CDEF_BLOCK_HWY_H_
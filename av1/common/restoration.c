@@ -10,6 +10,7 @@
  *
  */
 
+#include <limits.h>
 #include <math.h>
 #include <stddef.h>
 
@@ -1439,8 +1440,11 @@ static void save_cdef_boundary_lines(const YV12_BUFFER_CONFIG *frame,
                RESTORATION_EXTRA_HORZ, use_highbd);
 }
 
+// Saves the lines of the stripe boundaries of 'plane' that start within rows
+// [row_start, row_end) of the plane.
 static void save_boundary_lines(const YV12_BUFFER_CONFIG *frame, int use_highbd,
-                                int plane, AV1_COMMON *cm, int after_cdef) {
+                                int plane, AV1_COMMON *cm, int after_cdef,
+                                int row_start, int row_end) {
   const int is_uv = plane > 0;
   const int ss_y = is_uv && cm->seq_params->subsampling_y;
   const int stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
@@ -1467,24 +1471,29 @@ static void save_boundary_lines(const YV12_BUFFER_CONFIG *frame, int use_highbd,
     const int use_deblock_above = (stripe_idx > 0);
     const int use_deblock_below = (y1 < plane_height);
 
+    const int above_row = use_deblock_above ? y0 - RESTORATION_CTX_VERT : y0;
+    const int below_row = use_deblock_below ? y1 : y1 - 1;
+    const int save_above = above_row >= row_start && above_row < row_end;
+    const int save_below = below_row >= row_start && below_row < row_end;
+
     if (!after_cdef) {
       // Save deblocked context at internal stripe boundaries
-      if (use_deblock_above) {
-        save_deblock_boundary_lines(frame, cm, plane, y0 - RESTORATION_CTX_VERT,
-                                    stripe_idx, use_highbd, 1, boundaries);
+      if (use_deblock_above && save_above) {
+        save_deblock_boundary_lines(frame, cm, plane, above_row, stripe_idx,
+                                    use_highbd, 1, boundaries);
       }
-      if (use_deblock_below) {
-        save_deblock_boundary_lines(frame, cm, plane, y1, stripe_idx,
+      if (use_deblock_below && save_below) {
+        save_deblock_boundary_lines(frame, cm, plane, below_row, stripe_idx,
                                     use_highbd, 0, boundaries);
       }
     } else {
       // Save CDEF context at frame boundaries
-      if (!use_deblock_above) {
-        save_cdef_boundary_lines(frame, cm, plane, y0, stripe_idx, use_highbd,
-                                 1, boundaries);
+      if (!use_deblock_above && save_above) {
+        save_cdef_boundary_lines(frame, cm, plane, above_row, stripe_idx,
+                                 use_highbd, 1, boundaries);
       }
-      if (!use_deblock_below) {
-        save_cdef_boundary_lines(frame, cm, plane, y1 - 1, stripe_idx,
+      if (!use_deblock_below && save_below) {
+        save_cdef_boundary_lines(frame, cm, plane, below_row, stripe_idx,
                                  use_highbd, 0, boundaries);
       }
     }
@@ -1499,6 +1508,18 @@ void av1_loop_restoration_save_boundary_lines(const YV12_BUFFER_CONFIG *frame,
   const int num_planes = av1_num_planes(cm);
   const int use_highbd = cm->seq_params->use_highbitdepth;
   for (int p = 0; p < num_planes; ++p) {
-    save_boundary_lines(frame, use_highbd, p, cm, after_cdef);
+    save_boundary_lines(frame, use_highbd, p, cm, after_cdef, 0, INT_MAX);
+  }
+}
+
+void av1_loop_restoration_save_deblock_lines_rows(
+    const YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm, int row_start,
+    int row_end) {
+  const int num_planes = av1_num_planes(cm);
+  const int use_highbd = cm->seq_params->use_highbitdepth;
+  for (int p = 0; p < num_planes; ++p) {
+    const int ss_y = p > 0 && cm->seq_params->subsampling_y;
+    save_boundary_lines(frame, use_highbd, p, cm, /*after_cdef=*/0,
+                        row_start >> ss_y, row_end >> ss_y);
   }
 }
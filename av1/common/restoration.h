@@ -435,6 +435,13 @@ int av1_loop_restoration_corners_in_sb(const struct AV1Common *cm, int plane,
 void av1_loop_restoration_save_boundary_lines(const YV12_BUFFER_CONFIG *frame,
                                               struct AV1Common *cm,
                                               int after_cdef);
+// Same as av1_loop_restoration_save_boundary_lines() with after_cdef == 0, but
+// only saves the lines that start within luma rows [row_start, row_end) and
+// the corresponding chroma rows. The saved lines must be final after
+// deblocking and not yet filtered by CDEF.
+void av1_loop_restoration_save_deblock_lines_rows(
+    const YV12_BUFFER_CONFIG *frame, struct AV1Common *cm, int row_start,
+    int row_end);
 void av1_loop_restoration_filter_frame_init(AV1LrStruct *lr_ctxt,
                                             YV12_BUFFER_CONFIG *frame,
                                             struct AV1Common *cm,
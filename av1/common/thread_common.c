@@ -10,6 +10,7 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 
 #include "aom/aom_image.h"
 #include "config/aom_config.h"
@@ -18,6 +19,8 @@
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_dsp/txfm_common.h"
 #include "aom_mem/aom_mem.h"
+#include "aom_ports/aom_atomics.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_util/aom_pthread.h"
 #include "aom_util/aom_thread.h"
 #include "av1/common/av1_loopfilter.h"
@@ -88,6 +91,9 @@ void av1_loop_filter_alloc(AV1LfSync *lf_sync, AV1_COMMON *cm, int rows,
           pthread_cond_init(&lf_sync->cond_[j][i], NULL);
         }
       }
+
+      CHECK_MEM_ERROR(cm, lf_sync->num_waiters[j],
+                      aom_calloc(rows, sizeof(*(lf_sync->num_waiters[j]))));
     }
 
     CHECK_MEM_ERROR(cm, lf_sync->job_mutex,
@@ -112,6 +118,60 @@ void av1_loop_filter_alloc(AV1LfSync *lf_sync, AV1_COMMON *cm, int rows,
   lf_sync->sync_range = get_sync_range(width);
 }
 
+#if CONFIG_MULTITHREAD
+// Number of polls of a progress counter before a waiting thread blocks on the
+// condition variable. This covers the common case where the row above is only
+// a few blocks ahead, without a system call on either side.
+#define ROW_SYNC_SPIN_COUNT 1024
+
+void av1_row_sync_wait(pthread_mutex_t *mutex, pthread_cond_t *cond,
+                       int *num_waiters, const int *progress, int target) {
+#if AOM_HAVE_ATOMICS
+  if (aom_atomic_load_acquire(progress) >= target) return;
+  for (int i = 0; i < ROW_SYNC_SPIN_COUNT; ++i) {
+    aom_cpu_relax();
+    if (aom_atomic_load_acquire(progress) >= target) return;
+  }
+  pthread_mutex_lock(mutex);
+  // The waiter count must be visible before progress is re-read, so that
+  // av1_row_sync_update() either sees the waiter or the waiter sees the new
+  // progress.
+  aom_atomic_fetch_add(num_waiters, 1);
+  while (aom_atomic_load(progress) < target) pthread_cond_wait(cond, mutex);
+  aom_atomic_fetch_add(num_waiters, -1);
+  pthread_mutex_unlock(mutex);
+#else
+  (void)num_waiters;
+  pthread_mutex_lock(mutex);
+  while (*progress < target) pthread_cond_wait(cond, mutex);
+  pthread_mutex_unlock(mutex);
+#endif  // AOM_HAVE_ATOMICS
+}
+
+void av1_row_sync_update(pthread_mutex_t *mutex, pthread_cond_t *cond,
+                         const int *num_waiters, int *progress, int value) {
+#if AOM_HAVE_ATOMICS
+  // A thread that encounters an error publishes the maximum column number,
+  // which must not be overwritten with a smaller value.
+  int cur = aom_atomic_load(progress);
+  while (cur < value && !aom_atomic_compare_exchange(progress, &cur, value)) {
+  }
+  if (aom_atomic_load(num_waiters) > 0) {
+    // Taking the mutex orders the broadcast after the waiter has blocked.
+    pthread_mutex_lock(mutex);
+    pthread_cond_broadcast(cond);
+    pthread_mutex_unlock(mutex);
+  }
+#else
+  (void)num_waiters;
+  pthread_mutex_lock(mutex);
+  *progress = AOMMAX(*progress, value);
+  pthread_cond_broadcast(cond);
+  pthread_mutex_unlock(mutex);
+#endif  // AOM_HAVE_ATOMICS
+}
+#endif  // CONFIG_MULTITHREAD
+
 // Deallocate lf synchronization related mutex and data
 void av1_loop_filter_dealloc(AV1LfSync *lf_sync) {
   if (lf_sync != NULL) {
@@ -131,6 +191,7 @@ void av1_loop_filter_dealloc(AV1LfSync *lf_sync) {
         }
         aom_free(lf_sync->cond_[j]);
       }
+      aom_free(lf_sync->num_waiters[j]);
     }
     if (lf_sync->job_mutex != NULL) {
       pthread_mutex_destroy(lf_sync->job_mutex);
@@ -174,6 +235,72 @@ void av1_free_cdef_sync(AV1CdefSync *cdef_sync) {
 #endif  // CONFIG_MULTITHREAD
 }
 
+void av1_row_output_start(AV1_COMMON *cm, AV1RowOutputSync *row_output,
+                          int jobs_per_row, int unit_height, int margin) {
+  const int rows =
+      (cm->mi_params.mi_rows * MI_SIZE + unit_height - 1) / unit_height;
+#if CONFIG_MULTITHREAD
+  if (row_output->mutex_ == NULL) {
+    CHECK_MEM_ERROR(cm, row_output->mutex_,
+                    aom_malloc(sizeof(*(row_output->mutex_))));
+    if (row_output->mutex_) pthread_mutex_init(row_output->mutex_, NULL);
+  }
+#endif  // CONFIG_MULTITHREAD
+  if (rows > row_output->alloc_rows) {
+    aom_free(row_output->jobs_done);
+    row_output->alloc_rows = 0;
+    CHECK_MEM_ERROR(cm, row_output->jobs_done,
+                    aom_malloc(sizeof(*(row_output->jobs_done)) * rows));
+    row_output->alloc_rows = rows;
+  }
+  memset(row_output->jobs_done, 0, sizeof(*(row_output->jobs_done)) * rows);
+  row_output->rows = rows;
+  row_output->jobs_per_row = jobs_per_row;
+  row_output->unit_height = unit_height;
+  row_output->margin = margin;
+  row_output->frame_height = cm->height;
+  row_output->rows_done = 0;
+}
+
+void av1_row_output_mark(AV1RowOutputSync *row_output, int row) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(row_output->mutex_);
+#endif  // CONFIG_MULTITHREAD
+  const int prev_rows_done = row_output->rows_done;
+  row_output->jobs_done[row]++;
+  while (row_output->rows_done < row_output->rows &&
+         row_output->jobs_done[row_output->rows_done] ==
+             row_output->jobs_per_row) {
+    row_output->rows_done++;
+  }
+  if (row_output->rows_done > prev_rows_done) {
+    // The rows of the last unit row can no longer be modified.
+    const int rows =
+        row_output->rows_done == row_output->rows
+            ? row_output->frame_height
+            : AOMMIN(row_output->rows_done * row_output->unit_height -
+                         row_output->margin,
+                     row_output->frame_height);
+    // The callback is made with the mutex held so that the reports of a frame
+    // are made in order.
+    if (rows > 0) row_output->output_fn(row_output->output_priv, rows);
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(row_output->mutex_);
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_row_output_dealloc(AV1RowOutputSync *row_output) {
+#if CONFIG_MULTITHREAD
+  if (row_output->mutex_ != NULL) {
+    pthread_mutex_destroy(row_output->mutex_);
+    aom_free(row_output->mutex_);
+  }
+#endif  // CONFIG_MULTITHREAD
+  aom_free(row_output->jobs_done);
+  av1_zero(*row_output);
+}
+
 static inline void cdef_row_mt_sync_read(AV1CdefSync *const cdef_sync,
                                          int row) {
   if (!row) return;
@@ -210,6 +337,13 @@ static inline void sync_read(AV1LfSync *const lf_sync, int r, int c,
   const int nsync = lf_sync->sync_range;
 
   if (r && !(c & (nsync - 1))) {
+    if (lf_sync->sync_mode == ROW_SYNC_ATOMIC) {
+      av1_row_sync_wait(&lf_sync->mutex_[plane][r - 1],
+                        &lf_sync->cond_[plane][r - 1],
+                        &lf_sync->num_waiters[plane][r - 1],
+                        &lf_sync->cur_sb_col[plane][r - 1], c + nsync);
+      return;
+    }
     pthread_mutex_t *const mutex = &lf_sync->mutex_[plane][r - 1];
     pthread_mutex_lock(mutex);
 
@@ -242,6 +376,12 @@ static inline void sync_write(AV1LfSync *const lf_sync, int r, int c,
   }
 
   if (sig) {
+    if (lf_sync->sync_mode == ROW_SYNC_ATOMIC) {
+      av1_row_sync_update(&lf_sync->mutex_[plane][r], &lf_sync->cond_[plane][r],
+                          &lf_sync->num_waiters[plane][r],
+                          &lf_sync->cur_sb_col[plane][r], cur);
+      return;
+    }
     pthread_mutex_lock(&lf_sync->mutex_[plane][r]);
 
     // When a thread encounters an error, cur_sb_col[plane][r] is set to maximum
@@ -425,6 +565,11 @@ static int loop_filter_row_worker(void *arg1, void *arg2) {
         cur_job_info->mi_row, cur_job_info->plane, cur_job_info->dir,
         lpf_opt_level, lf_sync, error_info, lf_data->params_buf,
         lf_data->tx_buf, MAX_MIB_SIZE_LOG2);
+    // A superblock row of a plane is done once its horizontal edges are.
+    if (cur_job_info->dir == 1 && lf_sync->row_output != NULL) {
+      av1_row_output_mark(lf_sync->row_output,
+                          cur_job_info->mi_row >> MAX_MIB_SIZE_LOG2);
+    }
   }
   error_info->setjmp = 0;
   return 1;
@@ -434,11 +579,13 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                                 MACROBLOCKD *xd, int start, int stop,
                                 const int planes_to_lf[MAX_MB_PLANE],
                                 AVxWorker *workers, int num_workers,
-                                AV1LfSync *lf_sync, int lpf_opt_level) {
+                                AV1LfSync *lf_sync, int lpf_opt_level,
+                                AV1RowOutputSync *row_output) {
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   int i;
   loop_filter_frame_mt_init(cm, start, stop, planes_to_lf, num_workers, lf_sync,
                             lpf_opt_level, MAX_MIB_SIZE_LOG2);
+  lf_sync->row_output = row_output;
 
   // Set up loopfilter thread data.
   for (i = num_workers - 1; i >= 0; --i) {
@@ -467,7 +614,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
 static void loop_filter_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                              MACROBLOCKD *xd, int start, int stop,
                              const int planes_to_lf[MAX_MB_PLANE],
-                             int lpf_opt_level) {
+                             int lpf_opt_level, AV1RowOutputSync *row_output) {
   // Filter top rows of all planes first, in case the output can be partially
   // reconstructed row by row.
   int mi_row, plane, dir;
@@ -486,15 +633,39 @@ static void loop_filter_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                                     xd->error_info, params_buf, tx_buf,
                                     MAX_MIB_SIZE_LOG2);
       }
+      if (row_output != NULL && planes_to_lf[plane]) {
+        av1_row_output_mark(row_output, mi_row >> MAX_MIB_SIZE_LOG2);
+      }
     }
   }
 }
 
+// Number of luma rows at the bottom of a superblock row that the filtering of
+// the horizontal edges at the top of the next superblock row may modify.
+#define LF_ROW_OUTPUT_MARGIN 8
+
+// Prepares 'row_output' to track the superblock rows completed by the loop
+// filter. Returns the number of jobs per superblock row.
+static int start_lf_row_output(AV1_COMMON *cm, AV1RowOutputSync *row_output,
+                               const int planes_to_lf[MAX_MB_PLANE],
+                               int lpf_opt_level) {
+  // One job per plane and superblock row, counted as enqueue_lf_jobs() does.
+  int jobs_per_row = 0;
+  for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    jobs_per_row +=
+        !skip_loop_filter_plane(planes_to_lf, plane, lpf_opt_level) &&
+        planes_to_lf[plane];
+  }
+  av1_row_output_start(cm, row_output, jobs_per_row,
+                       MI_SIZE << MAX_MIB_SIZE_LOG2, LF_ROW_OUTPUT_MARGIN);
+  return jobs_per_row;
+}
+
 void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                               MACROBLOCKD *xd, int plane_start, int plane_end,
                               int partial_frame, AVxWorker *workers,
                               int num_workers, AV1LfSync *lf_sync,
-                              int lpf_opt_level) {
+                              int lpf_opt_level, AV1RowOutputSync *row_output) {
   int start_mi_row, end_mi_row, mi_rows_to_filter;
   int planes_to_lf[MAX_MB_PLANE];
 
@@ -512,14 +683,19 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
   end_mi_row = start_mi_row + mi_rows_to_filter;
   av1_loop_filter_frame_init(cm, plane_start, plane_end);
 
+  if (row_output != NULL) {
+    start_lf_row_output(cm, row_output, planes_to_lf, lpf_opt_level);
+  }
+
   if (num_workers > 1) {
     // Enqueue and execute loopfiltering jobs.
     loop_filter_rows_mt(frame, cm, xd, start_mi_row, end_mi_row, planes_to_lf,
-                        workers, num_workers, lf_sync, lpf_opt_level);
+                        workers, num_workers, lf_sync, lpf_opt_level,
+                        row_output);
   } else {
     // Directly filter in the main thread.
     loop_filter_rows(frame, cm, xd, start_mi_row, end_mi_row, planes_to_lf,
-                     lpf_opt_level);
+                     lpf_opt_level, row_output);
   }
 }
 
@@ -1128,6 +1304,9 @@ static int cdef_sb_row_worker_hook(void *arg1, void *arg2) {
         aom_extend_frame_borders_plane_row(ybf, plane, v_start, v_end);
       }
     }
+    if (cdef_worker->row_output != NULL) {
+      av1_row_output_mark(cdef_worker->row_output, cur_fbr);
+    }
   }
   error_info->setjmp = 0;
   return 1;
@@ -1138,7 +1317,7 @@ static void prepare_cdef_frame_workers(
     AV1_COMMON *const cm, MACROBLOCKD *xd, AV1CdefWorkerData *const cdef_worker,
     AVxWorkerHook hook, AVxWorker *const workers, AV1CdefSync *const cdef_sync,
     int num_workers, cdef_init_fb_row_t cdef_init_fb_row_fn,
-    int do_extend_border) {
+    int do_extend_border, AV1RowOutputSync *row_output) {
   const int num_planes = av1_num_planes(cm);
 
   cdef_worker[0].srcbuf = cm->cdef_info.srcbuf;
@@ -1150,6 +1329,7 @@ static void prepare_cdef_frame_workers(
     cdef_worker[i].xd = xd;
     cdef_worker[i].cdef_init_fb_row_fn = cdef_init_fb_row_fn;
     cdef_worker[i].do_extend_border = do_extend_border;
+    cdef_worker[i].row_output = row_output;
     for (int plane = 0; plane < num_planes; plane++)
       cdef_worker[i].linebuf[plane] = cm->cdef_info.linebuf[plane];
 
@@ -1234,21 +1414,338 @@ void av1_cdef_frame_mt(AV1_COMMON *const cm, MACROBLOCKD *const xd,
                        AV1CdefWorkerData *const cdef_worker,
                        AVxWorker *const workers, AV1CdefSync *const cdef_sync,
                        int num_workers, cdef_init_fb_row_t cdef_init_fb_row_fn,
-                       int do_extend_border) {
+                       int do_extend_border, AV1RowOutputSync *row_output) {
   YV12_BUFFER_CONFIG *frame = &cm->cur_frame->buf;
   const int num_planes = av1_num_planes(cm);
 
   av1_setup_dst_planes(xd->plane, cm->seq_params->sb_size, frame, 0, 0, 0,
                        num_planes);
 
+  // CDEF only writes to the filter block row being processed; the rows it
+  // reads from the neighboring rows are saved beforehand in the line buffers.
+  if (row_output != NULL) {
+    av1_row_output_start(cm, row_output, 1, MI_SIZE_64X64 * MI_SIZE, 0);
+  }
   reset_cdef_job_info(cdef_sync);
   prepare_cdef_frame_workers(cm, xd, cdef_worker, cdef_sb_row_worker_hook,
                              workers, cdef_sync, num_workers,
-                             cdef_init_fb_row_fn, do_extend_border);
+                             cdef_init_fb_row_fn, do_extend_border,
+                             row_output);
   launch_cdef_workers(workers, num_workers);
   sync_cdef_workers(workers, cm, num_workers);
 }
 
+// Number of luma rows that must be final after deblocking before CDEF can
+// filter the filter block row 'fbr': CDEF reads CDEF_VBORDER rows of the
+// filter block row below, in units of the chroma rows with 4:2:0 subsampling.
+static inline int cdef_lf_rows_needed(const AV1_COMMON *const cm, int fbr) {
+  return AOMMIN((fbr + 1) * MI_SIZE_64X64 * MI_SIZE + (CDEF_VBORDER << 1),
+                cm->height);
+}
+
+// Number of luma rows that are final once the first 'lf_rows' superblock rows
+// are deblocked.
+static inline int lf_rows_final(const AV1_COMMON *const cm, int lf_rows,
+                                int total_lf_rows) {
+  if (lf_rows == total_lf_rows) return cm->height;
+  return AOMMIN(lf_rows * (MI_SIZE << MAX_MIB_SIZE_LOG2) - LF_ROW_OUTPUT_MARGIN,
+                cm->height);
+}
+
+// Fills the job queue of the combined deblocking and CDEF pass. The jobs of a
+// superblock row are queued in the order in which enqueue_lf_jobs() would
+// queue them, and each CDEF row is queued right after the deblocking jobs
+// that complete the rows it reads.
+static void enqueue_lf_cdef_jobs(const AV1_COMMON *const cm,
+                                 AV1LfCdefSync *const lf_cdef_sync,
+                                 const int planes_to_lf[MAX_MB_PLANE]) {
+  const int lf_rows =
+      CEIL_POWER_OF_TWO(cm->mi_params.mi_rows, MAX_MIB_SIZE_LOG2);
+  const int nvfb = (cm->mi_params.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+  AV1LfCdefJob *job = lf_cdef_sync->job_queue;
+  int fbr = 0;
+
+  for (int r = 0; r < lf_rows; ++r) {
+    for (int dir = 0; dir < 2; ++dir) {
+      for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+        if (skip_loop_filter_plane(planes_to_lf, plane, 0)) continue;
+        if (!planes_to_lf[plane]) continue;
+        job->fbr = -1;
+        job->lf.mi_row = r << MAX_MIB_SIZE_LOG2;
+        job->lf.plane = plane;
+        job->lf.dir = dir;
+        job->lf.lpf_opt_level = 0;
+        job++;
+      }
+    }
+    const int rows_final = lf_rows_final(cm, r + 1, lf_rows);
+    for (; fbr < nvfb && cdef_lf_rows_needed(cm, fbr) <= rows_final; ++fbr) {
+      job->fbr = fbr;
+      job++;
+    }
+  }
+  for (; fbr < nvfb; ++fbr) {
+    job->fbr = fbr;
+    job++;
+  }
+  lf_cdef_sync->jobs_enqueued = (int)(job - lf_cdef_sync->job_queue);
+  lf_cdef_sync->jobs_dequeued = 0;
+  assert(lf_cdef_sync->jobs_enqueued <= lf_cdef_sync->jobs_alloc);
+}
+
+static AV1LfCdefJob *get_lf_cdef_job(AV1LfCdefSync *const lf_cdef_sync) {
+  AV1LfCdefJob *job = NULL;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(lf_cdef_sync->mutex_);
+#endif  // CONFIG_MULTITHREAD
+  if (!lf_cdef_sync->mt_exit &&
+      lf_cdef_sync->jobs_dequeued < lf_cdef_sync->jobs_enqueued) {
+    job = lf_cdef_sync->job_queue + lf_cdef_sync->jobs_dequeued;
+    lf_cdef_sync->jobs_dequeued++;
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(lf_cdef_sync->mutex_);
+#endif  // CONFIG_MULTITHREAD
+  return job;
+}
+
+// Output function of lf_row_output: records the luma rows that are final
+// after deblocking.
+static void set_lf_rows_done(void *priv, int rows) {
+  AV1LfCdefSync *const lf_cdef_sync = (AV1LfCdefSync *)priv;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(lf_cdef_sync->mutex_);
+#endif  // CONFIG_MULTITHREAD
+  lf_cdef_sync->lf_rows_done = AOMMAX(lf_cdef_sync->lf_rows_done, rows);
+#if CONFIG_MULTITHREAD
+  pthread_cond_broadcast(lf_cdef_sync->cond_);
+  pthread_mutex_unlock(lf_cdef_sync->mutex_);
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Waits until the first 'rows' luma rows are final after deblocking. Returns
+// 0 if a worker encountered an error meanwhile.
+static int wait_lf_rows_done(AV1LfCdefSync *const lf_cdef_sync, int rows) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(lf_cdef_sync->mutex_);
+  while (lf_cdef_sync->lf_rows_done < rows && !lf_cdef_sync->mt_exit)
+    pthread_cond_wait(lf_cdef_sync->cond_, lf_cdef_sync->mutex_);
+  const int ok = !lf_cdef_sync->mt_exit;
+  pthread_mutex_unlock(lf_cdef_sync->mutex_);
+  return ok;
+#else
+  return lf_cdef_sync->lf_rows_done >= rows;
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Hook function for each thread of the combined deblocking and CDEF pass.
+static int lf_cdef_row_worker(void *arg1, void *arg2) {
+  AV1LfCdefSync *const lf_cdef_sync = (AV1LfCdefSync *)arg1;
+  AV1LfCdefWorkerData *const worker_data = (AV1LfCdefWorkerData *)arg2;
+  LFWorkerData *const lf_data = worker_data->lf_data;
+  AV1CdefWorkerData *const cdef_data = worker_data->cdef_data;
+  AV1LfSync *const lf_sync = lf_cdef_sync->lf_sync;
+  AV1CdefSync *const cdef_sync = lf_cdef_sync->cdef_sync;
+  AV1_COMMON *const cm = lf_data->cm;
+  const int nvfb = (cm->mi_params.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+  struct aom_internal_error_info *const error_info = &lf_data->error_info;
+
+  // The jmp_buf is valid only for the duration of the function that calls
+  // setjmp(). Therefore, this function must reset the 'setjmp' field to 0
+  // before it returns.
+  if (setjmp(error_info->jmp)) {
+    error_info->setjmp = 0;
+#if CONFIG_MULTITHREAD
+    pthread_mutex_lock(lf_cdef_sync->mutex_);
+    lf_cdef_sync->mt_exit = true;
+    pthread_cond_broadcast(lf_cdef_sync->cond_);
+    pthread_mutex_unlock(lf_cdef_sync->mutex_);
+    pthread_mutex_lock(lf_sync->job_mutex);
+    lf_sync->lf_mt_exit = true;
+    pthread_mutex_unlock(lf_sync->job_mutex);
+    pthread_mutex_lock(cdef_sync->mutex_);
+    cdef_sync->cdef_mt_exit = true;
+    pthread_mutex_unlock(cdef_sync->mutex_);
+#endif  // CONFIG_MULTITHREAD
+    // Release the workers waiting for the rows of the other workers, as
+    // loop_filter_row_worker() and cdef_sb_row_worker_hook() do.
+    av1_set_vert_loop_filter_done(cm, lf_sync, MAX_MIB_SIZE_LOG2);
+    set_cdef_init_fb_row_done(cdef_sync, nvfb);
+    return 0;
+  }
+  error_info->setjmp = 1;
+
+  AV1LfCdefJob *job;
+  struct aom_usec_timer timer;
+  while ((job = get_lf_cdef_job(lf_cdef_sync)) != NULL) {
+    aom_usec_timer_start(&timer);
+    if (job->fbr < 0) {
+      av1_thread_loop_filter_rows(
+          lf_data->frame_buffer, cm, lf_data->planes, lf_data->xd,
+          job->lf.mi_row, job->lf.plane, job->lf.dir, job->lf.lpf_opt_level,
+          lf_sync, error_info, lf_data->params_buf, lf_data->tx_buf,
+          MAX_MIB_SIZE_LOG2);
+      if (job->lf.dir == 1) {
+        av1_row_output_mark(&lf_cdef_sync->lf_row_output,
+                            job->lf.mi_row >> MAX_MIB_SIZE_LOG2);
+      }
+      aom_usec_timer_mark(&timer);
+      worker_data->lf_time += aom_usec_timer_elapsed(&timer);
+      continue;
+    }
+
+    const int fbr = job->fbr;
+    const int ok =
+        wait_lf_rows_done(lf_cdef_sync, cdef_lf_rows_needed(cm, fbr));
+    aom_usec_timer_mark(&timer);
+    worker_data->idle_time += aom_usec_timer_elapsed(&timer);
+    if (!ok) break;
+    aom_usec_timer_start(&timer);
+    if (lf_cdef_sync->save_lr_lines) {
+      const int fb_height = MI_SIZE_64X64 * MI_SIZE;
+      av1_loop_restoration_save_deblock_lines_rows(
+          lf_data->frame_buffer, cm, fbr * fb_height, (fbr + 1) * fb_height);
+    }
+    av1_cdef_fb_row(cm, cdef_data->xd, cdef_data->linebuf, cdef_data->colbuf,
+                    cdef_data->srcbuf, fbr, cdef_data->cdef_init_fb_row_fn,
+                    cdef_sync, error_info);
+    if (lf_cdef_sync->row_output != NULL) {
+      av1_row_output_mark(lf_cdef_sync->row_output, fbr);
+    }
+    aom_usec_timer_mark(&timer);
+    worker_data->cdef_time += aom_usec_timer_elapsed(&timer);
+  }
+  error_info->setjmp = 0;
+  return 1;
+}
+
+static void lf_cdef_sync_alloc(AV1_COMMON *const cm,
+                               AV1LfCdefSync *const lf_cdef_sync,
+                               int num_jobs, int num_workers) {
+#if CONFIG_MULTITHREAD
+  if (lf_cdef_sync->mutex_ == NULL) {
+    CHECK_MEM_ERROR(cm, lf_cdef_sync->mutex_,
+                    aom_malloc(sizeof(*(lf_cdef_sync->mutex_))));
+    if (lf_cdef_sync->mutex_) pthread_mutex_init(lf_cdef_sync->mutex_, NULL);
+  }
+  if (lf_cdef_sync->cond_ == NULL) {
+    CHECK_MEM_ERROR(cm, lf_cdef_sync->cond_,
+                    aom_malloc(sizeof(*(lf_cdef_sync->cond_))));
+    if (lf_cdef_sync->cond_) pthread_cond_init(lf_cdef_sync->cond_, NULL);
+  }
+#endif  // CONFIG_MULTITHREAD
+  if (num_jobs > lf_cdef_sync->jobs_alloc) {
+    aom_free(lf_cdef_sync->job_queue);
+    lf_cdef_sync->jobs_alloc = 0;
+    CHECK_MEM_ERROR(cm, lf_cdef_sync->job_queue,
+                    aom_malloc(sizeof(*(lf_cdef_sync->job_queue)) * num_jobs));
+    lf_cdef_sync->jobs_alloc = num_jobs;
+  }
+  if (num_workers > lf_cdef_sync->num_workers_alloc) {
+    aom_free(lf_cdef_sync->worker_data);
+    lf_cdef_sync->num_workers_alloc = 0;
+    CHECK_MEM_ERROR(
+        cm, lf_cdef_sync->worker_data,
+        aom_malloc(sizeof(*(lf_cdef_sync->worker_data)) * num_workers));
+    lf_cdef_sync->num_workers_alloc = num_workers;
+  }
+}
+
+void av1_lf_cdef_sync_dealloc(AV1LfCdefSync *lf_cdef_sync) {
+#if CONFIG_MULTITHREAD
+  if (lf_cdef_sync->mutex_ != NULL) {
+    pthread_mutex_destroy(lf_cdef_sync->mutex_);
+    aom_free(lf_cdef_sync->mutex_);
+  }
+  if (lf_cdef_sync->cond_ != NULL) {
+    pthread_cond_destroy(lf_cdef_sync->cond_);
+    aom_free(lf_cdef_sync->cond_);
+  }
+#endif  // CONFIG_MULTITHREAD
+  aom_free(lf_cdef_sync->job_queue);
+  aom_free(lf_cdef_sync->worker_data);
+  av1_row_output_dealloc(&lf_cdef_sync->lf_row_output);
+  av1_zero(*lf_cdef_sync);
+}
+
+void av1_loop_filter_cdef_frame_mt(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                                   AVxWorker *const workers, int num_workers,
+                                   AV1LfSync *const lf_sync,
+                                   AV1CdefWorkerData *const cdef_worker,
+                                   AV1CdefSync *const cdef_sync,
+                                   AV1LfCdefSync *const lf_cdef_sync,
+                                   int save_lr_lines,
+                                   AV1RowOutputSync *row_output) {
+  YV12_BUFFER_CONFIG *const frame = &cm->cur_frame->buf;
+  const int num_planes = av1_num_planes(cm);
+  const int mi_rows = cm->mi_params.mi_rows;
+  const int lf_rows = CEIL_POWER_OF_TWO(mi_rows, MAX_MIB_SIZE_LOG2);
+  const int nvfb = (mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+  int planes_to_lf[MAX_MB_PLANE];
+
+  check_planes_to_loop_filter(&cm->lf, planes_to_lf, 0, num_planes);
+  av1_loop_filter_frame_init(cm, 0, num_planes);
+  // The deblocking jobs are taken from the queue of lf_cdef_sync, but
+  // av1_thread_loop_filter_rows() synchronizes the rows with lf_sync.
+  loop_filter_frame_mt_init(cm, 0, mi_rows, planes_to_lf, num_workers, lf_sync,
+                            0, MAX_MIB_SIZE_LOG2);
+  lf_sync->row_output = NULL;
+
+  lf_cdef_sync_alloc(cm, lf_cdef_sync, lf_rows * 2 * MAX_MB_PLANE + nvfb,
+                     num_workers);
+  lf_cdef_sync->lf_sync = lf_sync;
+  lf_cdef_sync->cdef_sync = cdef_sync;
+  lf_cdef_sync->save_lr_lines = save_lr_lines;
+  lf_cdef_sync->row_output = row_output;
+  lf_cdef_sync->mt_exit = false;
+  lf_cdef_sync->lf_rows_done = 0;
+  lf_cdef_sync->lf_row_output.output_fn = set_lf_rows_done;
+  lf_cdef_sync->lf_row_output.output_priv = lf_cdef_sync;
+  if (start_lf_row_output(cm, &lf_cdef_sync->lf_row_output, planes_to_lf, 0) ==
+      0) {
+    lf_cdef_sync->lf_rows_done = INT_MAX;
+  }
+  enqueue_lf_cdef_jobs(cm, lf_cdef_sync, planes_to_lf);
+
+  av1_setup_dst_planes(xd->plane, cm->seq_params->sb_size, frame, 0, 0, 0,
+                       num_planes);
+  if (row_output != NULL) {
+    av1_row_output_start(cm, row_output, 1, MI_SIZE_64X64 * MI_SIZE, 0);
+  }
+  reset_cdef_job_info(cdef_sync);
+  prepare_cdef_frame_workers(cm, xd, cdef_worker, lf_cdef_row_worker, workers,
+                             cdef_sync, num_workers, av1_cdef_init_fb_row_mt,
+                             /*do_extend_border=*/0, row_output);
+
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  for (int i = num_workers - 1; i >= 0; --i) {
+    AVxWorker *const worker = &workers[i];
+    AV1LfCdefWorkerData *const worker_data = &lf_cdef_sync->worker_data[i];
+    worker_data->lf_cdef_sync = lf_cdef_sync;
+    worker_data->lf_data = &lf_sync->lfdata[i];
+    worker_data->cdef_data = &cdef_worker[i];
+    worker_data->lf_time = 0;
+    worker_data->cdef_time = 0;
+    worker_data->idle_time = 0;
+    loop_filter_data_reset(worker_data->lf_data, frame, cm, xd);
+    worker->hook = lf_cdef_row_worker;
+    worker->data1 = lf_cdef_sync;
+    worker->data2 = worker_data;
+  }
+  launch_cdef_workers(workers, num_workers);
+
+  int had_error = workers[0].had_error;
+  struct aom_internal_error_info error_info;
+  if (had_error) error_info = lf_cdef_sync->worker_data[0].lf_data->error_info;
+  for (int i = num_workers - 1; i > 0; --i) {
+    if (!winterface->sync(&workers[i])) {
+      had_error = 1;
+      error_info = lf_cdef_sync->worker_data[i].lf_data->error_info;
+    }
+  }
+  if (had_error) aom_internal_error_copy(cm->error, &error_info);
+}
+
 int av1_get_intrabc_extra_top_right_sb_delay(const AV1_COMMON *cm) {
   // No additional top-right delay when intraBC tool is not enabled.
   if (!av1_allow_intrabc(cm)) return 0;
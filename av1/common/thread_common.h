@@ -25,6 +25,43 @@ extern "C" {
 
 struct AV1Common;
 
+// Row synchronization strategy of the multi-threaded row loops.
+typedef enum {
+  // Progress counters are read and written under the per-row mutex.
+  ROW_SYNC_MUTEX,
+  // Progress counters are published atomically; readers poll them briefly
+  // before blocking, and writers only take the mutex when a reader blocked.
+  ROW_SYNC_ATOMIC,
+  ROW_SYNC_MODES
+} ROW_SYNC_MODE;
+
+// Reports the rows of a frame that are final once the last in-loop filter
+// stage applied to it has processed them. The filter stage marks each of its
+// jobs done with av1_row_output_mark(); whenever this completes a run of unit
+// rows at the top of the frame, the number of final luma rows is passed to
+// 'output_fn', from the thread that completed them. The calls are serialized
+// and the row count never decreases.
+typedef struct AV1RowOutputSync {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+#endif
+  void (*output_fn)(void *priv, int rows);
+  void *output_priv;
+  // Number of jobs done in each unit row.
+  int *jobs_done;
+  int alloc_rows;
+  // Set by av1_row_output_start() for the current filter stage.
+  int rows;
+  int jobs_per_row;
+  int unit_height;
+  // Number of luma rows at the bottom of a completed unit row that the next
+  // unit row may still modify.
+  int margin;
+  int frame_height;
+  // Number of unit rows completed at the top of the frame.
+  int rows_done;
+} AV1RowOutputSync;
+
 typedef struct AV1LfMTInfo {
   int mi_row;
   int plane;
@@ -37,9 +74,15 @@ typedef struct AV1LfSyncData {
 #if CONFIG_MULTITHREAD
   pthread_mutex_t *mutex_[MAX_MB_PLANE];
   pthread_cond_t *cond_[MAX_MB_PLANE];
+  // Number of threads blocked on cond_[plane][r], used in ROW_SYNC_ATOMIC
+  // mode.
+  int *num_waiters[MAX_MB_PLANE];
 #endif
   // Allocate memory to store the loop-filtered superblock index in each row.
   int *cur_sb_col[MAX_MB_PLANE];
+  // Synchronization mode of cur_sb_col. Reset to ROW_SYNC_MUTEX by
+  // av1_loop_filter_dealloc().
+  ROW_SYNC_MODE sync_mode;
   // The optimal sync_range for different resolution and platform should be
   // determined by testing. Currently, it is chosen to be a power-of-2 number.
   int sync_range;
@@ -59,6 +102,9 @@ typedef struct AV1LfSyncData {
   // Initialized to false, set to true by the worker thread that encounters an
   // error in order to abort the processing of other worker threads.
   bool lf_mt_exit;
+
+  // If not NULL, the rows completed by the loop filter are reported to it.
+  AV1RowOutputSync *row_output;
 } AV1LfSync;
 
 typedef struct AV1LrMTInfo {
@@ -117,6 +163,7 @@ typedef struct AV1CdefWorker {
   uint16_t *linebuf[MAX_MB_PLANE];
   cdef_init_fb_row_t cdef_init_fb_row_fn;
   int do_extend_border;
+  AV1RowOutputSync *row_output;
   struct aom_internal_error_info error_info;
 } AV1CdefWorkerData;
 
@@ -151,7 +198,74 @@ void av1_cdef_frame_mt(AV1_COMMON *const cm, MACROBLOCKD *const xd,
                        AV1CdefWorkerData *const cdef_worker,
                        AVxWorker *const workers, AV1CdefSync *const cdef_sync,
                        int num_workers, cdef_init_fb_row_t cdef_init_fb_row_fn,
-                       int do_extend_border);
+                       int do_extend_border, AV1RowOutputSync *row_output);
+
+// Job of the combined deblocking and CDEF pass.
+typedef struct AV1LfCdefJob {
+  // Filter block row of a CDEF job, or -1 for a deblocking job.
+  int fbr;
+  AV1LfMTInfo lf;
+} AV1LfCdefJob;
+
+typedef struct AV1LfCdefWorkerData {
+  struct AV1LfCdefSyncData *lf_cdef_sync;
+  LFWorkerData *lf_data;
+  AV1CdefWorkerData *cdef_data;
+  // Time in microseconds the worker spent in deblocking jobs, in CDEF jobs
+  // and waiting for deblocked rows during the last pass.
+  int64_t lf_time;
+  int64_t cdef_time;
+  int64_t idle_time;
+} AV1LfCdefWorkerData;
+
+// Synchronization of the pass that runs the deblocking filter and CDEF on a
+// frame together. The jobs of both filters are dequeued from a single queue,
+// in which each CDEF row follows the deblocking jobs it depends on, so that
+// the workers take the superblock rows through CDEF right after deblocking
+// while the following rows are still being deblocked.
+typedef struct AV1LfCdefSyncData {
+#if CONFIG_MULTITHREAD
+  // Guards the job queue and lf_rows_done.
+  pthread_mutex_t *mutex_;
+  // Signaled when lf_rows_done increases.
+  pthread_cond_t *cond_;
+#endif  // CONFIG_MULTITHREAD
+  AV1LfCdefJob *job_queue;
+  int jobs_alloc;
+  int jobs_enqueued;
+  int jobs_dequeued;
+  AV1LfCdefWorkerData *worker_data;
+  int num_workers_alloc;
+  AV1LfSync *lf_sync;
+  AV1CdefSync *cdef_sync;
+  // Tracks the rows completed by the deblocking filter.
+  AV1RowOutputSync lf_row_output;
+  // Number of luma rows that are final after deblocking.
+  int lf_rows_done;
+  // If nonzero, the deblocked lines needed by loop restoration are saved
+  // before CDEF filters them.
+  int save_lr_lines;
+  AV1RowOutputSync *row_output;
+  // Set to true by the worker thread that encounters an error.
+  bool mt_exit;
+} AV1LfCdefSync;
+
+// Runs the deblocking filter and CDEF on the current frame with the row
+// pipelined pass described in AV1LfCdefSync. Produces the same output as
+// av1_loop_filter_frame_mt() followed by av1_cdef_frame_mt(), preceded by
+// av1_loop_restoration_save_boundary_lines() with after_cdef == 0 if
+// 'save_lr_lines' is nonzero. The rows completed by CDEF are reported to
+// 'row_output' if it is not NULL.
+void av1_loop_filter_cdef_frame_mt(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                                   AVxWorker *const workers, int num_workers,
+                                   AV1LfSync *const lf_sync,
+                                   AV1CdefWorkerData *const cdef_worker,
+                                   AV1CdefSync *const cdef_sync,
+                                   AV1LfCdefSync *const lf_cdef_sync,
+                                   int save_lr_lines,
+                                   AV1RowOutputSync *row_output);
+void av1_lf_cdef_sync_dealloc(AV1LfCdefSync *lf_cdef_sync);
+
 void av1_cdef_init_fb_row_mt(const AV1_COMMON *const cm,
                              const MACROBLOCKD *const xd,
                              CdefBlockInfo *const fb_info,
@@ -174,6 +288,28 @@ void av1_alloc_cdef_sync(AV1_COMMON *const cm, AV1CdefSync *cdef_sync,
                          int num_workers);
 void av1_free_cdef_sync(AV1CdefSync *cdef_sync);
 
+#if CONFIG_MULTITHREAD
+// Waits until *progress >= target, in ROW_SYNC_ATOMIC mode. The caller spins
+// for a short while and then blocks on 'cond', counting itself in
+// *num_waiters.
+void av1_row_sync_wait(pthread_mutex_t *mutex, pthread_cond_t *cond,
+                       int *num_waiters, const int *progress, int target);
+// Raises *progress to 'value' (it is never lowered) and wakes up the threads
+// blocked in av1_row_sync_wait(), in ROW_SYNC_ATOMIC mode.
+void av1_row_sync_update(pthread_mutex_t *mutex, pthread_cond_t *cond,
+                         const int *num_waiters, int *progress, int value);
+#endif  // CONFIG_MULTITHREAD
+
+// Prepares 'row_output' for a filter stage that runs 'jobs_per_row' jobs on
+// each row of 'unit_height' luma rows of the current frame, and whose jobs on
+// a unit row may modify the last 'margin' luma rows of the unit row above.
+void av1_row_output_start(AV1_COMMON *cm, AV1RowOutputSync *row_output,
+                          int jobs_per_row, int unit_height, int margin);
+// Marks one job of unit row 'row' done, and reports the rows that became
+// final, if any.
+void av1_row_output_mark(AV1RowOutputSync *row_output, int row);
+void av1_row_output_dealloc(AV1RowOutputSync *row_output);
+
 // Deallocate loopfilter synchronization related mutex and data.
 void av1_loop_filter_dealloc(AV1LfSync *lf_sync);
 void av1_loop_filter_alloc(AV1LfSync *lf_sync, AV1_COMMON *cm, int rows,
@@ -186,7 +322,8 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
                               struct macroblockd *xd, int plane_start,
                               int plane_end, int partial_frame,
                               AVxWorker *workers, int num_workers,
-                              AV1LfSync *lf_sync, int lpf_opt_level);
+                              AV1LfSync *lf_sync, int lpf_opt_level,
+                              AV1RowOutputSync *row_output);
 
 #if !CONFIG_REALTIME_ONLY || CONFIG_AV1_DECODER
 void av1_loop_restoration_filter_frame_mt(YV12_BUFFER_CONFIG *frame,
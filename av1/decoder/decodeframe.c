@@ -10,6 +10,7 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -159,6 +160,7 @@ static inline void inverse_transform_block(DecoderCodingBlock *dcb, int plane,
   eob_info *eob_data = dcb->eob_data[plane] + dcb->txb_offset[plane];
   uint16_t scan_line = eob_data->max_scan_line;
   uint16_t eob = eob_data->eob;
+  dcb->stage_stats.num_coded_tx_blocks += eob > 0;
   av1_inverse_transform_block(&dcb->xd, dqcoeff, plane, tx_type, tx_size, dst,
                               stride, eob, reduced_tx_set);
   memset(dqcoeff, 0, (scan_line + 1) * sizeof(dqcoeff[0]));
@@ -211,16 +213,15 @@ static inline void cfl_store_inter_block_void(AV1_COMMON *const cm,
   (void)xd;
 }
 
-static inline void predict_and_reconstruct_intra_block(
-    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
-    const int plane, const int row, const int col, const TX_SIZE tx_size) {
-  (void)r;
+static inline void reconstruct_intra_block(const AV1_COMMON *const cm,
+                                           DecoderCodingBlock *dcb,
+                                           const int plane, const int row,
+                                           const int col,
+                                           const TX_SIZE tx_size) {
   MACROBLOCKD *const xd = &dcb->xd;
   MB_MODE_INFO *mbmi = xd->mi[0];
   PLANE_TYPE plane_type = get_plane_type(plane);
 
-  av1_predict_intra_block_facade(cm, xd, plane, col, row, tx_size);
-
   if (!mbmi->skip_txfm) {
     eob_info *eob_data = dcb->eob_data[plane] + dcb->txb_offset[plane];
     if (eob_data->eob) {
@@ -239,6 +240,14 @@ static inline void predict_and_reconstruct_intra_block(
   }
 }
 
+static inline void predict_and_reconstruct_intra_block(
+    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
+    const int plane, const int row, const int col, const TX_SIZE tx_size) {
+  (void)r;
+  av1_predict_intra_block_facade(cm, &dcb->xd, plane, col, row, tx_size);
+  reconstruct_intra_block(cm, dcb, plane, row, col, tx_size);
+}
+
 static inline void inverse_transform_inter_block(
     const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
     const int plane, const int blk_row, const int blk_col,
@@ -648,9 +657,55 @@ static inline void dec_calc_subpel_params(
   *src_stride = pre_buf->stride;
 }
 
+// Returns the last row of the reference plane that the warped prediction of
+// the block reads. av1_warp_affine_c() reads the 7 rows above and below the
+// projection of the center of each 8x8 block, and since the projection is
+// affine, the lowest one is that of a corner block.
+static int get_warp_ref_last_row(const InterPredParams *inter_pred_params) {
+  const int32_t *const mat = inter_pred_params->warp_params.wmmat;
+  const int ss_x = inter_pred_params->subsampling_x;
+  const int ss_y = inter_pred_params->subsampling_y;
+  const int rows[2] = { inter_pred_params->pix_row,
+                        inter_pred_params->pix_row +
+                            ((inter_pred_params->block_height - 1) & ~7) };
+  const int cols[2] = { inter_pred_params->pix_col,
+                        inter_pred_params->pix_col +
+                            ((inter_pred_params->block_width - 1) & ~7) };
+  int last_row = INT_MIN;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      const int32_t src_x = (cols[j] + 4) << ss_x;
+      const int32_t src_y = (rows[i] + 4) << ss_y;
+      const int64_t dst_y =
+          (int64_t)mat[4] * src_x + (int64_t)mat[5] * src_y + (int64_t)mat[1];
+      const int32_t iy4 = (int32_t)((dst_y >> ss_y) >> WARPEDMODEL_PREC_BITS);
+      last_row = AOMMAX(last_row, iy4 + 7);
+    }
+  }
+  return last_row;
+}
+
+// Waits until the rows of the reference frame that the prediction of the
+// block reads are decoded. This only blocks in frame-parallel mode, where the
+// reference frame may still be decoded by another frame worker.
+static inline void wait_for_ref_rows(const AV1_COMMON *cm,
+                                     const RefCntBuffer *ref_buf,
+                                     const InterPredParams *inter_pred_params,
+                                     const PadBlock *block) {
+  const int last_row = inter_pred_params->mode == WARP_PRED
+                           ? get_warp_ref_last_row(inter_pred_params)
+                           : block->y1 - 1 + AOM_INTERP_EXTEND;
+  if (last_row < 0) return;
+  const int ss_y = inter_pred_params->subsampling_y;
+  const int last_luma_row =
+      AOMMIN(((last_row + 1) << ss_y) - 1, ref_buf->buf.y_crop_height - 1);
+  av1_frame_progress_wait(cm->buffer_pool, ref_buf, last_luma_row);
+}
+
 static inline void dec_calc_subpel_params_and_extend(
-    const MV *const src_mv, InterPredParams *const inter_pred_params,
-    MACROBLOCKD *const xd, int mi_x, int mi_y, int ref, uint8_t **mc_buf,
+    const AV1_COMMON *cm, const MV *const src_mv,
+    InterPredParams *const inter_pred_params, MACROBLOCKD *const xd, int mi_x,
+    int mi_y, int ref, const RefCntBuffer *ref_buf, uint8_t **mc_buf,
     uint8_t **pre, SubpelParams *subpel_params, int *src_stride) {
   PadBlock block;
   MV32 scaled_mv;
@@ -658,6 +713,11 @@ static inline void dec_calc_subpel_params_and_extend(
   dec_calc_subpel_params(src_mv, inter_pred_params, xd, mi_x, mi_y, pre,
                          subpel_params, src_stride, &block, &scaled_mv,
                          &subpel_x_mv, &subpel_y_mv);
+  // ref_buf is NULL for intra block copy, which predicts from the current
+  // frame.
+  if (ref_buf != NULL) {
+    wait_for_ref_rows(cm, ref_buf, inter_pred_params, &block);
+  }
   extend_mc_border(
       inter_pred_params->scale_factors, &inter_pred_params->ref_frame_buf,
       scaled_mv, block, subpel_x_mv, subpel_y_mv,
@@ -1169,7 +1229,10 @@ static inline void parse_decode_block(AV1Decoder *const pbi,
 #endif
   DecoderCodingBlock *const dcb = &td->dcb;
   MACROBLOCKD *const xd = &dcb->xd;
+  struct aom_usec_timer timer;
+  if (pbi->block_stage_timing) aom_usec_timer_start(&timer);
   decode_mbmi_block(pbi, dcb, mi_row, mi_col, r, partition, bsize);
+  dcb->stage_stats.num_blocks++;
 
   av1_visit_palette(pbi, xd, r, av1_decode_palette_tokens);
 
@@ -1217,6 +1280,10 @@ static inline void parse_decode_block(AV1Decoder *const pbi,
     }
   }
   if (mbmi->skip_txfm) av1_reset_entropy_context(xd, bsize, num_planes);
+  if (pbi->block_stage_timing) {
+    av1_dec_accumulate_time(
+        &timer, &dcb->stage_stats.stage_time[AOM_DEC_STAGE_ENTROPY_DECODE]);
+  }
 
   decode_token_recon_block(pbi, td, r, bsize);
 #if CONFIG_COLLECT_COMPONENT_TIMING
@@ -2613,8 +2680,10 @@ void av1_dec_row_mt_dealloc(AV1DecRowMTSync *dec_row_mt_sync) {
   }
 }
 
+// Waits until the superblocks above the current one are decoded. The time
+// spent blocked is added to '*idle_time'.
 static inline void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
-                             int c) {
+                             int c, int64_t *idle_time) {
 #if CONFIG_MULTITHREAD
   const int nsync = dec_row_mt_sync->sync_range;
 
@@ -2622,9 +2691,15 @@ static inline void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
     pthread_mutex_t *const mutex = &dec_row_mt_sync->mutex_[r - 1];
     pthread_mutex_lock(mutex);
 
-    while (c > dec_row_mt_sync->cur_sb_col[r - 1] - nsync -
-                   dec_row_mt_sync->intrabc_extra_top_right_sb_delay) {
-      pthread_cond_wait(&dec_row_mt_sync->cond_[r - 1], mutex);
+    const int target = c + nsync +
+                       dec_row_mt_sync->intrabc_extra_top_right_sb_delay;
+    if (dec_row_mt_sync->cur_sb_col[r - 1] < target) {
+      struct aom_usec_timer timer;
+      aom_usec_timer_start(&timer);
+      while (dec_row_mt_sync->cur_sb_col[r - 1] < target) {
+        pthread_cond_wait(&dec_row_mt_sync->cond_[r - 1], mutex);
+      }
+      av1_dec_accumulate_time(&timer, idle_time);
     }
     pthread_mutex_unlock(mutex);
   }
@@ -2632,6 +2707,7 @@ static inline void sync_read(AV1DecRowMTSync *const dec_row_mt_sync, int r,
   (void)dec_row_mt_sync;
   (void)r;
   (void)c;
+  (void)idle_time;
 #endif  // CONFIG_MULTITHREAD
 }
 
@@ -2699,7 +2775,8 @@ static inline void decode_tile_sb_row(AV1Decoder *pbi, ThreadData *const td,
     set_cb_buffer(pbi, &td->dcb, pbi->cb_buffer_base, num_planes, mi_row,
                   mi_col);
 
-    sync_read(&tile_data->dec_row_mt_sync, sb_row_in_tile, sb_col_in_tile);
+    sync_read(&tile_data->dec_row_mt_sync, sb_row_in_tile, sb_col_in_tile,
+              &td->dcb.stage_stats.idle_time);
 
 #if CONFIG_MULTITHREAD
     pthread_mutex_lock(pbi->row_mt_mutex_);
@@ -2743,8 +2820,69 @@ static int check_trailing_bits_after_symbol_coder(aom_reader *r) {
   return 0;
 }
 
+// Variants of the block visitors that also time their decoding stage, see
+// AV1D_SET_BLOCK_STAGE_TIMING.
+static void read_coeffs_tx_intra_block_timed(
+    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
+    const int plane, const int row, const int col, const TX_SIZE tx_size) {
+  if (dcb->xd.mi[0]->skip_txfm) return;
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  read_coeffs_tx_intra_block(cm, dcb, r, plane, row, col, tx_size);
+  av1_dec_accumulate_time(
+      &timer, &dcb->stage_stats.stage_time[AOM_DEC_STAGE_ENTROPY_DECODE]);
+}
+
+static void read_coeffs_tx_inter_block_timed(
+    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
+    const int plane, const int row, const int col, const TX_SIZE tx_size) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  av1_read_coeffs_txb(cm, dcb, r, plane, row, col, tx_size);
+  av1_dec_accumulate_time(
+      &timer, &dcb->stage_stats.stage_time[AOM_DEC_STAGE_ENTROPY_DECODE]);
+}
+
+static void predict_and_reconstruct_intra_block_timed(
+    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
+    const int plane, const int row, const int col, const TX_SIZE tx_size) {
+  (void)r;
+  DecStageStats *const stats = &dcb->stage_stats;
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  av1_predict_intra_block_facade(cm, &dcb->xd, plane, col, row, tx_size);
+  av1_dec_accumulate_time(&timer,
+                          &stats->stage_time[AOM_DEC_STAGE_PREDICTION]);
+  aom_usec_timer_start(&timer);
+  reconstruct_intra_block(cm, dcb, plane, row, col, tx_size);
+  av1_dec_accumulate_time(&timer,
+                          &stats->stage_time[AOM_DEC_STAGE_INVERSE_TRANSFORM]);
+}
+
+static void inverse_transform_inter_block_timed(
+    const AV1_COMMON *const cm, DecoderCodingBlock *dcb, aom_reader *const r,
+    const int plane, const int blk_row, const int blk_col,
+    const TX_SIZE tx_size) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  inverse_transform_inter_block(cm, dcb, r, plane, blk_row, blk_col, tx_size);
+  av1_dec_accumulate_time(
+      &timer, &dcb->stage_stats.stage_time[AOM_DEC_STAGE_INVERSE_TRANSFORM]);
+}
+
+static void predict_inter_block_timed(AV1_COMMON *const cm,
+                                      DecoderCodingBlock *dcb,
+                                      BLOCK_SIZE bsize) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  predict_inter_block(cm, dcb, bsize);
+  av1_dec_accumulate_time(
+      &timer, &dcb->stage_stats.stage_time[AOM_DEC_STAGE_PREDICTION]);
+}
+
 static inline void set_decode_func_pointers(ThreadData *td,
-                                            int parse_decode_flag) {
+                                            int parse_decode_flag,
+                                            int block_stage_timing) {
   td->read_coeffs_tx_intra_block_visit = decode_block_void;
   td->predict_and_recon_intra_block_visit = decode_block_void;
   td->read_coeffs_tx_inter_block_visit = decode_block_void;
@@ -2763,6 +2901,18 @@ static inline void set_decode_func_pointers(ThreadData *td,
     td->predict_inter_block_visit = predict_inter_block;
     td->cfl_store_inter_block_visit = cfl_store_inter_block;
   }
+  if (block_stage_timing) {
+    if (parse_decode_flag & 0x1) {
+      td->read_coeffs_tx_intra_block_visit = read_coeffs_tx_intra_block_timed;
+      td->read_coeffs_tx_inter_block_visit = read_coeffs_tx_inter_block_timed;
+    }
+    if (parse_decode_flag & 0x2) {
+      td->predict_and_recon_intra_block_visit =
+          predict_and_reconstruct_intra_block_timed;
+      td->inverse_tx_inter_block_visit = inverse_transform_inter_block_timed;
+      td->predict_inter_block_visit = predict_inter_block_timed;
+    }
+  }
 }
 
 static inline void decode_tile(AV1Decoder *pbi, ThreadData *const td,
@@ -2917,7 +3067,7 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
   }
 #endif
 
-  set_decode_func_pointers(&pbi->td, 0x3);
+  set_decode_func_pointers(&pbi->td, 0x3, pbi->block_stage_timing);
 
   // Load all tile information into thread_data.
   td->dcb = pbi->dcb;
@@ -3069,7 +3219,7 @@ static int tile_worker_hook(void *arg1, void *arg2) {
   allow_update_cdf = cm->tiles.large_scale ? 0 : 1;
   allow_update_cdf = allow_update_cdf && !cm->features.disable_cdf_update;
 
-  set_decode_func_pointers(td, 0x3);
+  set_decode_func_pointers(td, 0x3, pbi->block_stage_timing);
 
   assert(cm->tiles.cols > 0);
   while (!td->dcb.corrupted) {
@@ -3106,6 +3256,30 @@ static inline int get_max_row_mt_workers_per_tile(AV1_COMMON *cm,
   return max_workers;
 }
 
+// Returns the estimated time needed to decode the superblock rows of a tile
+// that are not started yet, from the time taken by the rows decoded so far.
+static double estimate_decode_time_left(
+    const AV1DecRowMTInfo *frame_row_mt_info,
+    const AV1DecRowMTSync *dec_row_mt_sync, int sb_mi_size) {
+  const int sb_rows_left =
+      (dec_row_mt_sync->mi_rows - dec_row_mt_sync->mi_rows_decode_started) /
+      sb_mi_size;
+  double sb_row_time;
+  if (dec_row_mt_sync->sb_rows_decoded > 0) {
+    sb_row_time = (double)dec_row_mt_sync->sb_rows_decode_time /
+                  dec_row_mt_sync->sb_rows_decoded;
+  } else if (frame_row_mt_info->mi_cols_decoded > 0) {
+    // Use the average time per superblock of the rows decoded in the other
+    // tiles.
+    sb_row_time = (double)frame_row_mt_info->sb_rows_decode_time *
+                  dec_row_mt_sync->mi_cols / frame_row_mt_info->mi_cols_decoded;
+  } else {
+    // No row is decoded yet: assume the time is proportional to the area.
+    sb_row_time = dec_row_mt_sync->mi_cols;
+  }
+  return sb_rows_left * sb_row_time;
+}
+
 // The caller must hold pbi->row_mt_mutex_ when calling this function.
 // Returns 1 if either the next job is stored in *next_job_info or 1 is stored
 // in *end_of_frame.
@@ -3130,10 +3304,9 @@ static int get_next_job_info(AV1Decoder *const pbi,
   const int start_tile = frame_row_mt_info->start_tile;
   const int end_tile = frame_row_mt_info->end_tile;
   const int sb_mi_size = mi_size_wide[cm->seq_params->sb_size];
-  int num_mis_to_decode, num_threads_working;
+  int num_threads_working;
   int num_mis_waiting_for_decode;
-  int min_threads_working = INT_MAX;
-  int max_mis_to_decode = 0;
+  double max_priority = -1.0;
   int tile_row_idx, tile_col_idx;
   int tile_row = -1;
   int tile_col = -1;
@@ -3155,7 +3328,10 @@ static int get_next_job_info(AV1Decoder *const pbi,
       frame_row_mt_info->mi_rows_decode_started)
     return 0;
 
-  // Choose the tile to decode.
+  // Choose the tile to decode. The in-loop filtering of the frame can only
+  // start once its last tile is decoded, so the tile on the critical path is
+  // the one with the most decode time left per thread working on it: its rows
+  // are picked first.
   for (tile_row_idx = tile_rows_start; tile_row_idx < tile_rows_end;
        ++tile_row_idx) {
     for (tile_col_idx = tile_cols_start; tile_col_idx < tile_cols_end;
@@ -3171,23 +3347,17 @@ static int get_next_job_info(AV1Decoder *const pbi,
       num_mis_waiting_for_decode = (dec_row_mt_sync->mi_rows_parse_done -
                                     dec_row_mt_sync->mi_rows_decode_started) *
                                    dec_row_mt_sync->mi_cols;
-      num_mis_to_decode =
-          (dec_row_mt_sync->mi_rows - dec_row_mt_sync->mi_rows_decode_started) *
-          dec_row_mt_sync->mi_cols;
-
-      assert(num_mis_to_decode >= num_mis_waiting_for_decode);
-
-      // Pick the tile which has minimum number of threads working on it.
-      if (num_mis_waiting_for_decode > 0) {
-        if (num_threads_working < min_threads_working) {
-          min_threads_working = num_threads_working;
-          max_mis_to_decode = 0;
-        }
-        if (num_threads_working == min_threads_working &&
-            num_mis_to_decode > max_mis_to_decode &&
-            num_threads_working <
-                get_max_row_mt_workers_per_tile(cm, &tile_data->tile_info)) {
-          max_mis_to_decode = num_mis_to_decode;
+      assert(dec_row_mt_sync->mi_rows >= dec_row_mt_sync->mi_rows_parse_done);
+
+      if (num_mis_waiting_for_decode > 0 &&
+          num_threads_working <
+              get_max_row_mt_workers_per_tile(cm, &tile_data->tile_info)) {
+        const double priority =
+            estimate_decode_time_left(frame_row_mt_info, dec_row_mt_sync,
+                                      sb_mi_size) /
+            (num_threads_working + 1);
+        if (priority > max_priority) {
+          max_priority = priority;
           tile_row = tile_row_idx;
           tile_col = tile_col_idx;
         }
@@ -3319,7 +3489,7 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
   allow_update_cdf = cm->tiles.large_scale ? 0 : 1;
   allow_update_cdf = allow_update_cdf && !cm->features.disable_cdf_update;
 
-  set_decode_func_pointers(td, 0x1);
+  set_decode_func_pointers(td, 0x1, pbi->block_stage_timing);
 
   assert(cm->tiles.cols > 0);
   while (!td->dcb.corrupted) {
@@ -3364,7 +3534,7 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
     return 0;
   }
 
-  set_decode_func_pointers(td, 0x2);
+  set_decode_func_pointers(td, 0x2, pbi->block_stage_timing);
 
   while (1) {
     AV1DecRowMTJobInfo next_job_info;
@@ -3373,10 +3543,15 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
 #if CONFIG_MULTITHREAD
     pthread_mutex_lock(pbi->row_mt_mutex_);
 #endif
-    while (!get_next_job_info(pbi, &next_job_info, &end_of_frame)) {
+    if (!get_next_job_info(pbi, &next_job_info, &end_of_frame)) {
+      struct aom_usec_timer timer;
+      aom_usec_timer_start(&timer);
+      do {
 #if CONFIG_MULTITHREAD
-      pthread_cond_wait(pbi->row_mt_cond_, pbi->row_mt_mutex_);
+        pthread_cond_wait(pbi->row_mt_cond_, pbi->row_mt_mutex_);
 #endif
+      } while (!get_next_job_info(pbi, &next_job_info, &end_of_frame));
+      av1_dec_accumulate_time(&timer, &td->dcb.stage_stats.idle_time);
     }
 #if CONFIG_MULTITHREAD
     pthread_mutex_unlock(pbi->row_mt_mutex_);
@@ -3396,11 +3571,19 @@ static int row_mt_worker_hook(void *arg1, void *arg2) {
     av1_init_macroblockd(cm, &td->dcb.xd);
     td->dcb.xd.error_info = &thread_data->error_info;
 
+    struct aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
     decode_tile_sb_row(pbi, td, &tile_data->tile_info, mi_row);
+    aom_usec_timer_mark(&timer);
+    const int64_t sb_row_time = aom_usec_timer_elapsed(&timer);
 
 #if CONFIG_MULTITHREAD
     pthread_mutex_lock(pbi->row_mt_mutex_);
 #endif
+    dec_row_mt_sync->sb_rows_decoded++;
+    dec_row_mt_sync->sb_rows_decode_time += sb_row_time;
+    frame_row_mt_info->mi_cols_decoded += dec_row_mt_sync->mi_cols;
+    frame_row_mt_info->sb_rows_decode_time += sb_row_time;
     dec_row_mt_sync->num_threads_working--;
 #if CONFIG_MULTITHREAD
     pthread_mutex_unlock(pbi->row_mt_mutex_);
@@ -3600,6 +3783,7 @@ static inline void decode_mt_init(AV1Decoder *pbi) {
 
       winterface->init(worker);
       worker->thread_name = "aom tile worker";
+      if (worker_idx != 0) worker->pool = pbi->thread_pool;
       if (worker_idx != 0 && !winterface->reset(worker)) {
         aom_internal_error(&pbi->error, AOM_CODEC_ERROR,
                            "Tile decoder thread creation failed");
@@ -3777,6 +3961,8 @@ static inline void row_mt_frame_init(AV1Decoder *pbi, int tile_rows_start,
   frame_row_mt_info->mi_rows_parse_done = 0;
   frame_row_mt_info->mi_rows_decode_started = 0;
   frame_row_mt_info->row_mt_exit = 0;
+  frame_row_mt_info->mi_cols_decoded = 0;
+  frame_row_mt_info->sb_rows_decode_time = 0;
 
   for (int tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
     for (int tile_col = tile_cols_start; tile_col < tile_cols_end; ++tile_col) {
@@ -3791,6 +3977,8 @@ static inline void row_mt_frame_init(AV1Decoder *pbi, int tile_rows_start,
       tile_data->dec_row_mt_sync.mi_rows_parse_done = 0;
       tile_data->dec_row_mt_sync.mi_rows_decode_started = 0;
       tile_data->dec_row_mt_sync.num_threads_working = 0;
+      tile_data->dec_row_mt_sync.sb_rows_decoded = 0;
+      tile_data->dec_row_mt_sync.sb_rows_decode_time = 0;
       tile_data->dec_row_mt_sync.mi_rows =
           ALIGN_POWER_OF_TWO(tile_info->mi_row_end - tile_info->mi_row_start,
                              cm->seq_params->mib_size_log2);
@@ -4913,6 +5101,7 @@ static int read_uncompressed_header(AV1Decoder *pbi,
           // buffer in place of missing frames, i.e.
           //
           set_planes_to_neutral_grey(seq_params, &buf->buf, 0);
+          av1_frame_progress_update(pool, buf, FRAME_PROGRESS_DONE);
           //
           // and allows the frames to be used for referencing, i.e.
           //
@@ -5356,6 +5545,59 @@ static inline void setup_frame_info(AV1Decoder *pbi) {
   }
 }
 
+// Publishes that the first 'rows' luma rows of the current frame are final.
+static void output_frame_rows(void *priv, int rows) {
+  AV1Decoder *const pbi = (AV1Decoder *)priv;
+  AV1_COMMON *const cm = &pbi->common;
+  if (rows <= pbi->output_rows) return;
+  pbi->output_rows = rows;
+  av1_frame_progress_update(cm->buffer_pool, cm->cur_frame, rows);
+  if (pbi->row_output_cb != NULL && cm->show_frame && !cm->tiles.large_scale) {
+    pbi->row_output_cb(pbi->row_output_priv, &cm->cur_frame->buf, rows);
+  }
+}
+
+static void add_stage_stats(DecStageStats *dst, DecStageStats *src) {
+  for (int i = 0; i < AOM_DEC_STAGE_COUNT; ++i) {
+    dst->stage_time[i] += src->stage_time[i];
+  }
+  dst->idle_time += src->idle_time;
+  dst->num_blocks += src->num_blocks;
+  dst->num_coded_tx_blocks += src->num_coded_tx_blocks;
+  av1_zero(*src);
+}
+
+// Moves the block stage statistics gathered by the tile workers to
+// pbi->stage_stats.
+static void collect_tile_stage_stats(AV1Decoder *pbi) {
+  add_stage_stats(&pbi->stage_stats, &pbi->td.dcb.stage_stats);
+  if (pbi->thread_data == NULL) return;
+  for (int i = 1; i < pbi->num_workers; ++i) {
+    ThreadData *const td = pbi->thread_data[i].td;
+    if (td != NULL) add_stage_stats(&pbi->stage_stats, &td->dcb.stage_stats);
+  }
+}
+
+// Splits the time of the combined deblocking and CDEF pass between the two
+// stages, in proportion to the time the workers spent in each of them.
+static void collect_lf_cdef_stage_stats(AV1Decoder *pbi, int64_t pass_time) {
+  const AV1LfCdefSync *const lf_cdef_sync = &pbi->lf_cdef_sync;
+  int64_t lf_time = 0;
+  int64_t cdef_time = 0;
+  for (int i = 0; i < pbi->num_workers; ++i) {
+    const AV1LfCdefWorkerData *const worker_data =
+        &lf_cdef_sync->worker_data[i];
+    lf_time += worker_data->lf_time;
+    cdef_time += worker_data->cdef_time;
+    pbi->stage_stats.idle_time += worker_data->idle_time;
+  }
+  const int64_t lf_share =
+      lf_time + cdef_time > 0 ? pass_time * lf_time / (lf_time + cdef_time)
+                              : pass_time;
+  pbi->stage_stats.stage_time[AOM_DEC_STAGE_DEBLOCK] += lf_share;
+  pbi->stage_stats.stage_time[AOM_DEC_STAGE_CDEF] += pass_time - lf_share;
+}
+
 void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                     const uint8_t *data_end,
                                     const uint8_t **p_data_end, int start_tile,
@@ -5375,6 +5617,8 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
 #if CONFIG_COLLECT_COMPONENT_TIMING
   start_timing(pbi, decode_tiles_time);
 #endif
+  struct aom_usec_timer tiles_timer;
+  aom_usec_timer_start(&tiles_timer);
   if (pbi->max_threads > 1 && !(tiles->large_scale && !pbi->ext_tile_debug) &&
       pbi->row_mt)
     *p_data_end =
@@ -5384,6 +5628,9 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     *p_data_end = decode_tiles_mt(pbi, data, data_end, start_tile, end_tile);
   else
     *p_data_end = decode_tiles(pbi, data, data_end, start_tile, end_tile);
+  aom_usec_timer_mark(&tiles_timer);
+  pbi->tiles_decode_time += aom_usec_timer_elapsed(&tiles_timer);
+  collect_tile_stage_stats(pbi);
 #if CONFIG_COLLECT_COMPONENT_TIMING
   end_timing(pbi, decode_tiles_time);
 #endif
@@ -5397,23 +5644,29 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     return;
   }
 
+  // The entropy context of the frame only depends on its tiles, so it is
+  // saved before the in-loop filters run. In frame-parallel mode the next
+  // frame can then start while this one is filtered.
+  if (!pbi->dcb.corrupted) {
+    if (cm->features.refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
+      assert(pbi->context_update_tile_id < pbi->allocated_tiles);
+      *cm->fc = pbi->tile_data[pbi->context_update_tile_id].tctx;
+      av1_reset_cdf_symbol_counters(cm->fc);
+    }
+    if (!tiles->large_scale) {
+      cm->cur_frame->frame_context = *cm->fc;
+    }
+    if (pbi->frame_context_ready_cb != NULL && !av1_superres_scaled(cm)) {
+      pbi->frame_context_ready_cb(pbi->frame_context_ready_priv, *p_data_end);
+    }
+  }
+
   av1_alloc_cdef_buffers(cm, &pbi->cdef_worker, &pbi->cdef_sync,
                          pbi->num_workers, 1);
   av1_alloc_cdef_sync(cm, &pbi->cdef_sync, pbi->num_workers);
 
+  pbi->output_rows = 0;
   if (!cm->features.allow_intrabc && !tiles->single_tile_decoding) {
-#if CONFIG_COLLECT_COMPONENT_TIMING
-    start_timing(pbi, av1_loop_filter_frame_time);
-#endif
-    if (cm->lf.filter_level[0] || cm->lf.filter_level[1]) {
-      av1_loop_filter_frame_mt(&cm->cur_frame->buf, cm, &pbi->dcb.xd, 0,
-                               num_planes, 0, pbi->tile_workers,
-                               pbi->num_workers, &pbi->lf_row_sync, 0);
-    }
-#if CONFIG_COLLECT_COMPONENT_TIMING
-    end_timing(pbi, av1_loop_filter_frame_time);
-#endif
-
     const int do_cdef =
         !pbi->skip_loop_filter && !cm->features.coded_lossless &&
         (cm->cdef_info.cdef_bits || cm->cdef_info.cdef_strengths[0] ||
@@ -5424,6 +5677,51 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
         cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
         cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
         cm->rst_info[2].frame_restoration_type != RESTORE_NONE;
+    // The rows of the frame are reported as the last of the deblocking filter
+    // and CDEF completes them. Superres upscaling and loop restoration do not
+    // report their progress, so with them the whole frame is reported once it
+    // is done.
+    AV1RowOutputSync *row_output = NULL;
+    if (!pbi->dcb.corrupted && !do_superres && !do_loop_restoration) {
+      row_output = &pbi->row_output_sync;
+      row_output->output_fn = output_frame_rows;
+      row_output->output_priv = pbi;
+    }
+    const int do_loop_filter = cm->lf.filter_level[0] || cm->lf.filter_level[1];
+    // With several workers, deblocking and CDEF run as a single pass in which
+    // the rows are filtered by CDEF as soon as they are deblocked. The lines
+    // that loop restoration needs from the deblocked frame are saved in that
+    // pass too. Loop restoration itself is not part of the pass, and a single
+    // threaded decoder still runs each filter over the whole frame in turn.
+    const int do_loop_filter_cdef_mt =
+        pbi->num_workers > 1 && do_loop_filter && do_cdef;
+
+    int64_t *const stage_time = pbi->stage_stats.stage_time;
+    struct aom_usec_timer timer;
+
+#if CONFIG_COLLECT_COMPONENT_TIMING
+    start_timing(pbi, av1_loop_filter_frame_time);
+#endif
+    if (do_loop_filter_cdef_mt) {
+      aom_usec_timer_start(&timer);
+      av1_loop_filter_cdef_frame_mt(
+          cm, &pbi->dcb.xd, pbi->tile_workers, pbi->num_workers,
+          &pbi->lf_row_sync, pbi->cdef_worker, &pbi->cdef_sync,
+          &pbi->lf_cdef_sync, do_loop_restoration, row_output);
+      aom_usec_timer_mark(&timer);
+      collect_lf_cdef_stage_stats(pbi, aom_usec_timer_elapsed(&timer));
+    } else if (do_loop_filter) {
+      aom_usec_timer_start(&timer);
+      av1_loop_filter_frame_mt(&cm->cur_frame->buf, cm, &pbi->dcb.xd, 0,
+                               num_planes, 0, pbi->tile_workers,
+                               pbi->num_workers, &pbi->lf_row_sync, 0,
+                               do_cdef ? NULL : row_output);
+      av1_dec_accumulate_time(&timer, &stage_time[AOM_DEC_STAGE_DEBLOCK]);
+    }
+#if CONFIG_COLLECT_COMPONENT_TIMING
+    end_timing(pbi, av1_loop_filter_frame_time);
+#endif
+
     // Frame border extension is not required in the decoder
     // as it happens in extend_mc_border().
     int do_extend_border_mt = 0;
@@ -5432,25 +5730,32 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     start_timing(pbi, cdef_and_lr_time);
 #endif
     if (!optimized_loop_restoration) {
-      if (do_loop_restoration)
+      if (do_loop_restoration && !do_loop_filter_cdef_mt) {
+        aom_usec_timer_start(&timer);
         av1_loop_restoration_save_boundary_lines(&pbi->common.cur_frame->buf,
                                                  cm, 0);
+        av1_dec_accumulate_time(&timer,
+                                &stage_time[AOM_DEC_STAGE_LOOP_RESTORATION]);
+      }
 
-      if (do_cdef) {
+      if (do_cdef && !do_loop_filter_cdef_mt) {
+        aom_usec_timer_start(&timer);
         if (pbi->num_workers > 1) {
           av1_cdef_frame_mt(cm, &pbi->dcb.xd, pbi->cdef_worker,
                             pbi->tile_workers, &pbi->cdef_sync,
                             pbi->num_workers, av1_cdef_init_fb_row_mt,
-                            do_extend_border_mt);
+                            do_extend_border_mt, row_output);
         } else {
           av1_cdef_frame(&pbi->common.cur_frame->buf, cm, &pbi->dcb.xd,
-                         av1_cdef_init_fb_row);
+                         av1_cdef_init_fb_row, row_output);
         }
+        av1_dec_accumulate_time(&timer, &stage_time[AOM_DEC_STAGE_CDEF]);
       }
 
       superres_post_decode(pbi);
 
       if (do_loop_restoration) {
+        aom_usec_timer_start(&timer);
         av1_loop_restoration_save_boundary_lines(&pbi->common.cur_frame->buf,
                                                  cm, 1);
         if (pbi->num_workers > 1) {
@@ -5463,11 +5768,14 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                             cm, optimized_loop_restoration,
                                             &pbi->lr_ctxt);
         }
+        av1_dec_accumulate_time(&timer,
+                                &stage_time[AOM_DEC_STAGE_LOOP_RESTORATION]);
       }
     } else {
       // In no cdef and no superres case. Provide an optimized version of
       // loop_restoration_filter.
       if (do_loop_restoration) {
+        aom_usec_timer_start(&timer);
         if (pbi->num_workers > 1) {
           av1_loop_restoration_filter_frame_mt(
               (YV12_BUFFER_CONFIG *)xd->cur_buf, cm, optimized_loop_restoration,
@@ -5478,6 +5786,8 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                             cm, optimized_loop_restoration,
                                             &pbi->lr_ctxt);
         }
+        av1_dec_accumulate_time(&timer,
+                                &stage_time[AOM_DEC_STAGE_LOOP_RESTORATION]);
       }
     }
 #if CONFIG_COLLECT_COMPONENT_TIMING
@@ -5486,11 +5796,7 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
   }
 
   if (!pbi->dcb.corrupted) {
-    if (cm->features.refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
-      assert(pbi->context_update_tile_id < pbi->allocated_tiles);
-      *cm->fc = pbi->tile_data[pbi->context_update_tile_id].tctx;
-      av1_reset_cdf_symbol_counters(cm->fc);
-    }
+    output_frame_rows(pbi, cm->height);
   } else {
     aom_internal_error(&pbi->error, AOM_CODEC_CORRUPT_FRAME,
                        "Decode failed. Frame data is corrupted.");
@@ -5502,11 +5808,6 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
   }
 #endif
 
-  // Non frame parallel update frame context here.
-  if (!tiles->large_scale) {
-    cm->cur_frame->frame_context = *cm->fc;
-  }
-
   if (cm->show_frame && !cm->seq_params->order_hint_info.enable_order_hint) {
     ++cm->current_frame.frame_number;
   }
@@ -221,6 +221,8 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   aom_free(pbi->tile_data);
   aom_free(pbi->tile_workers);
 
+  av1_row_output_dealloc(&pbi->row_output_sync);
+  av1_lf_cdef_sync_dealloc(&pbi->lf_cdef_sync);
   if (pbi->num_workers > 0) {
     av1_loop_filter_dealloc(&pbi->lf_row_sync);
     av1_loop_restoration_dealloc(&pbi->lr_row_sync);
@@ -351,6 +353,8 @@ static void release_current_frame(AV1Decoder *pbi) {
   BufferPool *const pool = cm->buffer_pool;
 
   cm->cur_frame->buf.corrupted = 1;
+  // Unblock anyone waiting on rows that will never be decoded.
+  av1_frame_progress_update(pool, cm->cur_frame, FRAME_PROGRESS_DONE);
   lock_buffer_pool(pool);
   decrease_ref_count(cm->cur_frame, pool);
   unlock_buffer_pool(pool);
@@ -453,6 +457,7 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
     pbi->error.error_code = AOM_CODEC_MEM_ERROR;
     return 1;
   }
+  av1_frame_progress_reset(cm->buffer_pool, cm->cur_frame);
 
   // The jmp_buf is valid only for the duration of the function that calls
   // setjmp(). Therefore, this function must reset the 'setjmp' field to 0
@@ -476,8 +481,12 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
 
   pbi->error.setjmp = 1;
 
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
   int frame_decoded =
       aom_decode_frame_from_obus(pbi, source, source + size, psource);
+  aom_usec_timer_mark(&timer);
+  pbi->decode_time += aom_usec_timer_elapsed(&timer);
 
   if (frame_decoded < 0) {
     assert(pbi->error.error_code != AOM_CODEC_OK);
@@ -495,6 +504,11 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
   cm->txb_count = 0;
 #endif
 
+  // All in-loop filtering of cm->cur_frame is done (or it is an existing frame
+  // being shown), so all of its rows are final.
+  av1_frame_progress_update(cm->buffer_pool, cm->cur_frame,
+                            FRAME_PROGRESS_DONE);
+
   // Note: At this point, this function holds a reference to cm->cur_frame
   // in the buffer pool. This reference is consumed by update_frame_buffers().
   update_frame_buffers(pbi, frame_decoded);
@@ -15,7 +15,9 @@
 #include "config/aom_config.h"
 
 #include "aom/aom_codec.h"
+#include "aom/aomdx.h"
 #include "aom_dsp/bitreader.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_scale/yv12config.h"
 #include "aom_util/aom_thread.h"
 
@@ -33,6 +35,29 @@
 extern "C" {
 #endif
 
+/*!
+ * \brief Time spent in the decoding stages and number of blocks decoded, see
+ * AV1D_GET_FRAME_STAGE_STATS.
+ */
+typedef struct DecStageStats {
+  /*!
+   * Time spent in each stage, indexed by aom_dec_stage_t, in microseconds.
+   */
+  int64_t stage_time[AOM_DEC_STAGE_COUNT];
+  /*!
+   * Time spent waiting for other threads, in microseconds.
+   */
+  int64_t idle_time;
+  /*!
+   * Number of coding blocks decoded.
+   */
+  uint64_t num_blocks;
+  /*!
+   * Number of transform blocks with nonzero coefficients.
+   */
+  uint64_t num_coded_tx_blocks;
+} DecStageStats;
+
 /*!
  * \brief Contains coding block data required by the decoder.
  *
@@ -81,6 +106,11 @@ typedef struct DecoderCodingBlock {
    * in xd->ref_mv_stack[i].
    */
   uint8_t ref_mv_count[MODE_CTX_REF_FRAMES];
+  /*!
+   * Statistics of the blocks decoded with this structure since they were last
+   * added to the frame statistics in 'pbi->stage_stats'.
+   */
+  DecStageStats stage_stats;
 } DecoderCodingBlock;
 
 /*!\cond */
@@ -159,6 +189,10 @@ typedef struct AV1DecRowMTSyncData {
   int mi_rows_parse_done;
   int mi_rows_decode_started;
   int num_threads_working;
+  // Number of superblock rows of the tile decoded so far in the frame, and
+  // the time spent decoding them, in microseconds.
+  int sb_rows_decoded;
+  int64_t sb_rows_decode_time;
 } AV1DecRowMTSync;
 
 typedef struct AV1DecRowMTInfo {
@@ -189,6 +223,11 @@ typedef struct AV1DecRowMTInfo {
   // Boolean: Initialized to 0 (false). Set to 1 (true) on error to abort
   // decoding.
   int row_mt_exit;
+  // Sum of the mi_cols of the superblock rows decoded so far in the frame, and
+  // the time spent decoding them, in microseconds. Used to estimate the decode
+  // time of the tiles that have no decoded row yet.
+  int64_t mi_cols_decoded;
+  int64_t sb_rows_decode_time;
 } AV1DecRowMTInfo;
 
 typedef struct TileDataDec {
@@ -230,7 +269,6 @@ typedef struct AV1DecTileMTData {
 } AV1DecTileMT;
 
 #if CONFIG_COLLECT_COMPONENT_TIMING
-#include "aom_ports/aom_timer.h"
 // Adjust the following to add new components.
 enum {
   decode_mbmi_block_time,
@@ -287,8 +325,12 @@ typedef struct AV1Decoder {
   AV1LrStruct lr_ctxt;
   AV1CdefSync cdef_sync;
   AV1CdefWorkerData *cdef_worker;
+  AV1LfCdefSync lf_cdef_sync;
   AVxWorker *tile_workers;
   int num_workers;
+  // If not NULL, runs the jobs of tile_workers[1..] instead of threads owned
+  // by the decoder. Set with AV1D_SET_THREAD_POOL.
+  AVxThreadPool *thread_pool;
   DecWorkerData *thread_data;
   ThreadData td;
   TileDataDec *tile_data;
@@ -388,6 +430,32 @@ typedef struct AV1Decoder {
   int context_update_tile_id;
   int skip_loop_filter;
   int skip_film_grain;
+  // If not NULL, called with the number of luma rows of a shown frame being
+  // decoded that are final. Set with AV1D_SET_ROW_OUTPUT_CB.
+  void (*row_output_cb)(void *priv, const YV12_BUFFER_CONFIG *frame, int rows);
+  void *row_output_priv;
+  // Frame-parallel decoding: if not NULL, called once the tiles of a frame
+  // are decoded, before its in-loop filters run, with the end of the data of
+  // the frame. Everything the following frames need apart from the pixels of
+  // the frame is known at that point. Not called for frames that use superres,
+  // which changes the size of the frame after the tiles are decoded.
+  void (*frame_context_ready_cb)(void *priv, const uint8_t *frame_end);
+  void *frame_context_ready_priv;
+  // Reports the rows completed by the in-loop filters of the current frame.
+  AV1RowOutputSync row_output_sync;
+  // Number of luma rows of the current frame reported so far.
+  int output_rows;
+  // Wall time spent in the frames decoded by the last call to
+  // aom_codec_decode(), in microseconds: in total and in the decoding of the
+  // tiles, i.e. before the in-loop filters.
+  int64_t decode_time;
+  int64_t tiles_decode_time;
+  // Statistics of the frames decoded by the last call to aom_codec_decode(),
+  // see AV1D_GET_FRAME_STAGE_STATS.
+  DecStageStats stage_stats;
+  // If nonzero, the entropy decode, prediction and inverse transform stages
+  // are timed, see AV1D_SET_BLOCK_STAGE_TIMING.
+  int block_stage_timing;
   int is_annexb;
   int valid_for_referencing[REF_FRAMES];
   int is_fwd_kf_present;
@@ -506,6 +574,13 @@ typedef void (*block_visitor_fn_t)(AV1Decoder *const pbi, ThreadData *const td,
                                    int mi_row, int mi_col, aom_reader *r,
                                    PARTITION_TYPE partition, BLOCK_SIZE bsize);
 
+// Adds the time elapsed since 'timer' was started to '*time'.
+static inline void av1_dec_accumulate_time(struct aom_usec_timer *timer,
+                                           int64_t *time) {
+  aom_usec_timer_mark(timer);
+  *time += aom_usec_timer_elapsed(timer);
+}
+
 /*!\endcond */
 
 #if CONFIG_COLLECT_COMPONENT_TIMING
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "config/aom_config.h"
+
+#include "aom_ports/aom_atomics.h"
+#include "aom_util/aom_pthread.h"
+#include "av1/common/av1_common_int.h"
+#include "av1/decoder/decoder.h"
+#include "av1/decoder/dthread.h"
+
+void av1_frame_progress_reset(BufferPool *pool, RefCntBuffer *buf) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->progress_mutex);
+  buf->progress_rows = 0;
+  pthread_mutex_unlock(&pool->progress_mutex);
+#else
+  (void)pool;
+  buf->progress_rows = 0;
+#endif
+}
+
+void av1_frame_progress_update(BufferPool *pool, RefCntBuffer *buf,
+                               int rows) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->progress_mutex);
+  if (rows > buf->progress_rows) {
+#if AOM_HAVE_ATOMICS
+    aom_atomic_store(&buf->progress_rows, rows);
+#else
+    buf->progress_rows = rows;
+#endif
+    pthread_cond_broadcast(&pool->progress_cond);
+  }
+  pthread_mutex_unlock(&pool->progress_mutex);
+#else
+  (void)pool;
+  if (rows > buf->progress_rows) buf->progress_rows = rows;
+#endif
+}
+
+void av1_frame_progress_wait(BufferPool *pool, const RefCntBuffer *buf,
+                             int row) {
+#if CONFIG_MULTITHREAD
+#if AOM_HAVE_ATOMICS
+  // Reference frames are usually complete already, which is cheap to check.
+  if (aom_atomic_load_acquire(&buf->progress_rows) > row) return;
+#endif
+  pthread_mutex_lock(&pool->progress_mutex);
+  while (buf->progress_rows <= row) {
+    pthread_cond_wait(&pool->progress_cond, &pool->progress_mutex);
+  }
+  pthread_mutex_unlock(&pool->progress_mutex);
+#else
+  // Without threads a frame is always decoded to completion before the next
+  // one starts.
+  (void)pool;
+  (void)buf;
+  (void)row;
+  assert(buf->progress_rows > row);
+#endif
+}
+
+static void save_state(const AV1Decoder *pbi, FrameWorkerState *state) {
+  const AV1_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  // cm->cur_frame is set while the last frame is still being decoded, and
+  // what av1_receive_compressed_data() does at the end of the frame is yet
+  // to be applied.
+  const RefCntBuffer *const cur_frame = cm->cur_frame;
+  const int refresh_frame_flags =
+      cur_frame != NULL ? cm->current_frame.refresh_frame_flags : 0;
+
+  lock_buffer_pool(pool);
+  for (int i = 0; i < REF_FRAMES; ++i) {
+    RefCntBuffer *const buf = ((refresh_frame_flags >> i) & 1)
+                                  ? cm->cur_frame
+                                  : cm->ref_frame_map[i];
+    if (buf != NULL) ++buf->ref_count;
+    state->ref_frame_map[i] = buf;
+  }
+  unlock_buffer_pool(pool);
+
+  memcpy(state->ref_frame_id, cm->ref_frame_id, sizeof(state->ref_frame_id));
+  memcpy(state->valid_for_referencing, pbi->valid_for_referencing,
+         sizeof(state->valid_for_referencing));
+  state->current_frame_id = cm->current_frame_id;
+  state->frame_number = cm->current_frame.frame_number;
+  state->decoding_first_frame = pbi->decoding_first_frame;
+  if (cur_frame != NULL) {
+    if (cm->show_frame && !cm->seq_params->order_hint_info.enable_order_hint)
+      ++state->frame_number;
+    state->decoding_first_frame = 0;
+  }
+  state->seq_params = pbi->seq_params;
+  state->sequence_header_ready = pbi->sequence_header_ready;
+  state->sequence_header_changed = pbi->sequence_header_changed;
+  state->current_operating_point = pbi->current_operating_point;
+  state->number_spatial_layers = pbi->number_spatial_layers;
+  state->number_temporal_layers = pbi->number_temporal_layers;
+  state->need_resync = pbi->need_resync;
+  state->is_fwd_kf_present = pbi->is_fwd_kf_present;
+  state->is_arf_frame_present = pbi->is_arf_frame_present;
+  state->default_frame_context = *cm->default_frame_context;
+}
+
+void av1_frame_worker_set_context_ready(FrameWorkerData *frame_worker_data) {
+  // Only the worker itself sets the flag, so it can read it without the lock.
+  if (frame_worker_data->frame_context_ready) return;
+  const AV1Decoder *const pbi = frame_worker_data->pbi;
+  save_state(pbi, &frame_worker_data->state);
+#if CONFIG_MULTITHREAD
+  BufferPool *const pool = pbi->common.buffer_pool;
+  pthread_mutex_lock(&pool->progress_mutex);
+  frame_worker_data->frame_context_ready = 1;
+  pthread_cond_broadcast(&pool->progress_cond);
+  pthread_mutex_unlock(&pool->progress_mutex);
+#else
+  frame_worker_data->frame_context_ready = 1;
+#endif
+}
+
+void av1_frame_worker_wait_context_ready(FrameWorkerData *frame_worker_data) {
+#if CONFIG_MULTITHREAD
+  BufferPool *const pool = frame_worker_data->pbi->common.buffer_pool;
+  pthread_mutex_lock(&pool->progress_mutex);
+  while (!frame_worker_data->frame_context_ready) {
+    pthread_cond_wait(&pool->progress_cond, &pool->progress_mutex);
+  }
+  pthread_mutex_unlock(&pool->progress_mutex);
+#else
+  assert(frame_worker_data->frame_context_ready);
+#endif
+}
+
+void av1_frame_worker_load_state(AV1Decoder *pbi, FrameWorkerState *state) {
+  AV1_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+
+  lock_buffer_pool(pool);
+  for (int i = 0; i < REF_FRAMES; ++i) {
+    decrease_ref_count(cm->ref_frame_map[i], pool);
+    cm->ref_frame_map[i] = state->ref_frame_map[i];
+    state->ref_frame_map[i] = NULL;
+  }
+  unlock_buffer_pool(pool);
+
+  memcpy(cm->ref_frame_id, state->ref_frame_id, sizeof(cm->ref_frame_id));
+  memcpy(pbi->valid_for_referencing, state->valid_for_referencing,
+         sizeof(pbi->valid_for_referencing));
+  cm->current_frame_id = state->current_frame_id;
+  cm->current_frame.frame_number = state->frame_number;
+  pbi->decoding_first_frame = state->decoding_first_frame;
+  pbi->seq_params = state->seq_params;
+  pbi->sequence_header_ready = state->sequence_header_ready;
+  pbi->sequence_header_changed = state->sequence_header_changed;
+  pbi->current_operating_point = state->current_operating_point;
+  pbi->number_spatial_layers = state->number_spatial_layers;
+  pbi->number_temporal_layers = state->number_temporal_layers;
+  pbi->need_resync = state->need_resync;
+  pbi->is_fwd_kf_present = state->is_fwd_kf_present;
+  pbi->is_arf_frame_present = state->is_arf_frame_present;
+  *cm->default_frame_context = state->default_frame_context;
+}
+
+void av1_frame_worker_release_state(BufferPool *pool,
+                                    FrameWorkerState *state) {
+  lock_buffer_pool(pool);
+  for (int i = 0; i < REF_FRAMES; ++i) {
+    decrease_ref_count(state->ref_frame_map[i], pool);
+    state->ref_frame_map[i] = NULL;
+  }
+  unlock_buffer_pool(pool);
+}
@@ -14,7 +14,10 @@
 
 #include "config/aom_config.h"
 
+#include <limits.h>
+
 #include "aom/internal/aom_codec_internal.h"
+#include "av1/common/av1_common_int.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,14 +25,43 @@ extern "C" {
 
 struct AV1Common;
 struct AV1Decoder;
+struct BufferPool;
+struct RefCntBuffer;
 struct ThreadData;
 
+// Value of RefCntBuffer::progress_rows once the frame is fully decoded.
+#define FRAME_PROGRESS_DONE INT_MAX
+
 typedef struct DecWorkerData {
   struct ThreadData *td;
   const uint8_t *data_end;
   struct aom_internal_error_info error_info;
 } DecWorkerData;
 
+// The decoder state that a temporal unit leaves to the next one, apart from
+// the contents of the reference frames. In frame-parallel mode each frame
+// worker has its own AV1Decoder, and this is what the worker of a temporal
+// unit hands over to the worker of the next one.
+typedef struct FrameWorkerState {
+  // Holds a reference to each of its buffers.
+  RefCntBuffer *ref_frame_map[REF_FRAMES];
+  int ref_frame_id[REF_FRAMES];
+  int valid_for_referencing[REF_FRAMES];
+  int current_frame_id;
+  unsigned int frame_number;
+  SequenceHeader seq_params;
+  int sequence_header_ready;
+  int sequence_header_changed;
+  int current_operating_point;
+  unsigned int number_spatial_layers;
+  unsigned int number_temporal_layers;
+  int decoding_first_frame;
+  int need_resync;
+  int is_fwd_kf_present;
+  int is_arf_frame_present;
+  FRAME_CONTEXT default_frame_context;
+} FrameWorkerState;
+
 // WorkerData for the FrameWorker thread. It contains all the information of
 // the worker and decode structures for decoding a frame.
 typedef struct FrameWorkerData {
@@ -41,8 +73,61 @@ typedef struct FrameWorkerData {
   int received_frame;
   int frame_context_ready;  // Current frame's context is ready to read.
   int frame_decoded;        // Finished decoding current frame.
+
+  // Frame-parallel decoding only.
+  // Copy of the temporal unit being decoded, which the application may free
+  // as soon as aom_codec_decode() returns.
+  uint8_t *scratch_buffer;
+  size_t scratch_buffer_size;
+  // State left to the next temporal unit, valid once frame_context_ready is
+  // set. frame_context_ready is then protected by BufferPool::progress_mutex.
+  FrameWorkerState state;
 } FrameWorkerData;
 
+// Per-frame decode progress.
+//
+// Each RefCntBuffer records how many of its luma rows are final, so that a
+// frame which references it only has to wait for the rows its prediction
+// actually reads rather than for the whole reference frame. Progress only
+// moves forward between av1_frame_progress_reset() and the point where it
+// reaches FRAME_PROGRESS_DONE.
+
+// Marks all rows of 'buf' as not yet decoded. Must be called before 'buf'
+// starts receiving the reconstruction of a new frame.
+void av1_frame_progress_reset(struct BufferPool *pool,
+                              struct RefCntBuffer *buf);
+
+// Publishes that the first 'rows' luma rows of 'buf' are final and wakes up
+// any thread waiting on them. Pass FRAME_PROGRESS_DONE once the whole frame
+// is done, including when decoding stops because of an error.
+void av1_frame_progress_update(struct BufferPool *pool,
+                               struct RefCntBuffer *buf, int rows);
+
+// Blocks until luma row 'row' of 'buf' (and every row above it) is final.
+void av1_frame_progress_wait(struct BufferPool *pool,
+                             const struct RefCntBuffer *buf, int row);
+
+// Frame-parallel decoding.
+//
+// Called by the worker of a temporal unit once the tiles of its last frame
+// are decoded, or once the temporal unit is decoded: saves the state left to
+// the next temporal unit in frame_worker_data->state and sets
+// frame_context_ready. When the last frame is still being filtered, the
+// refresh of the reference frames by that frame is included. Does nothing if
+// frame_context_ready is already set.
+void av1_frame_worker_set_context_ready(FrameWorkerData *frame_worker_data);
+
+// Blocks until frame_worker_data->frame_context_ready is set.
+void av1_frame_worker_wait_context_ready(FrameWorkerData *frame_worker_data);
+
+// Makes 'pbi' continue from 'state', which is left empty.
+void av1_frame_worker_load_state(struct AV1Decoder *pbi,
+                                 FrameWorkerState *state);
+
+// Releases the references held by 'state'.
+void av1_frame_worker_release_state(struct BufferPool *pool,
+                                    FrameWorkerState *state);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -19,8 +19,12 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+
+#include "config/av1_rtcd.h"
+
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_mem/aom_mem.h"
+#include "aom_util/aom_thread.h"
 #include "av1/decoder/grain_synthesis.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
@@ -237,12 +241,20 @@ typedef struct {
   uint16_t random_register;  // random number generator register
 } aom_grain_rng_t;
 
+// Buffers holding the grain of the block boundaries that are blended with the
+// neighboring blocks when overlap_flag is set.
+typedef struct {
+  int *y_line_buf;
+  int *cb_line_buf;
+  int *cr_line_buf;
+  int *y_col_buf;
+  int *cb_col_buf;
+  int *cr_col_buf;
+} aom_grain_overlap_bufs_t;
+
 static void dealloc_arrays(const aom_film_grain_t *params, int ***pred_pos_luma,
                            int ***pred_pos_chroma, int **luma_grain_block,
-                           int **cb_grain_block, int **cr_grain_block,
-                           int **y_line_buf, int **cb_line_buf,
-                           int **cr_line_buf, int **y_col_buf, int **cb_col_buf,
-                           int **cr_col_buf) {
+                           int **cb_grain_block, int **cr_grain_block) {
   int num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
   int num_pos_chroma = num_pos_luma;
   if (params->num_y_points > 0) ++num_pos_chroma;
@@ -263,24 +275,6 @@ static void dealloc_arrays(const aom_film_grain_t *params, int ***pred_pos_luma,
     *pred_pos_chroma = NULL;
   }
 
-  aom_free(*y_line_buf);
-  *y_line_buf = NULL;
-
-  aom_free(*cb_line_buf);
-  *cb_line_buf = NULL;
-
-  aom_free(*cr_line_buf);
-  *cr_line_buf = NULL;
-
-  aom_free(*y_col_buf);
-  *y_col_buf = NULL;
-
-  aom_free(*cb_col_buf);
-  *cb_col_buf = NULL;
-
-  aom_free(*cr_col_buf);
-  *cr_col_buf = NULL;
-
   aom_free(*luma_grain_block);
   *luma_grain_block = NULL;
 
@@ -291,27 +285,15 @@ static void dealloc_arrays(const aom_film_grain_t *params, int ***pred_pos_luma,
   *cr_grain_block = NULL;
 }
 
-static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
-                        int chroma_stride, int ***pred_pos_luma_p,
+static bool init_arrays(const aom_film_grain_t *params, int ***pred_pos_luma_p,
                         int ***pred_pos_chroma_p, int **luma_grain_block,
                         int **cb_grain_block, int **cr_grain_block,
-                        int **y_line_buf, int **cb_line_buf, int **cr_line_buf,
-                        int **y_col_buf, int **cb_col_buf, int **cr_col_buf,
-                        int luma_grain_samples, int chroma_grain_samples,
-                        int chroma_subsamp_y, int chroma_subsamp_x) {
+                        int luma_grain_samples, int chroma_grain_samples) {
   *pred_pos_luma_p = NULL;
   *pred_pos_chroma_p = NULL;
   *luma_grain_block = NULL;
   *cb_grain_block = NULL;
   *cr_grain_block = NULL;
-  *y_line_buf = NULL;
-  *cb_line_buf = NULL;
-  *cr_line_buf = NULL;
-  *y_col_buf = NULL;
-  *cb_col_buf = NULL;
-  *cr_col_buf = NULL;
-
-  const int chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
 
   int num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
   int num_pos_chroma = num_pos_luma;
@@ -327,9 +309,7 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
     pred_pos_luma[row] = (int *)aom_malloc(sizeof(**pred_pos_luma) * 3);
     if (!pred_pos_luma[row]) {
       dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p,
-                     luma_grain_block, cb_grain_block, cr_grain_block,
-                     y_line_buf, cb_line_buf, cr_line_buf, y_col_buf,
-                     cb_col_buf, cr_col_buf);
+                     luma_grain_block, cb_grain_block, cr_grain_block);
       return false;
     }
   }
@@ -338,8 +318,7 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
       (int **)aom_calloc(num_pos_chroma, sizeof(*pred_pos_chroma));
   if (!pred_pos_chroma) {
     dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p, luma_grain_block,
-                   cb_grain_block, cr_grain_block, y_line_buf, cb_line_buf,
-                   cr_line_buf, y_col_buf, cb_col_buf, cr_col_buf);
+                   cb_grain_block, cr_grain_block);
     return false;
   }
 
@@ -347,9 +326,7 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
     pred_pos_chroma[row] = (int *)aom_malloc(sizeof(**pred_pos_chroma) * 3);
     if (!pred_pos_chroma[row]) {
       dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p,
-                     luma_grain_block, cb_grain_block, cr_grain_block,
-                     y_line_buf, cb_line_buf, cr_line_buf, y_col_buf,
-                     cb_col_buf, cr_col_buf);
+                     luma_grain_block, cb_grain_block, cr_grain_block);
       return false;
     }
   }
@@ -391,35 +368,58 @@ static bool init_arrays(const aom_film_grain_t *params, int luma_stride,
   *pred_pos_luma_p = pred_pos_luma;
   *pred_pos_chroma_p = pred_pos_chroma;
 
-  *y_line_buf = (int *)aom_malloc(sizeof(**y_line_buf) * luma_stride * 2);
-  *cb_line_buf = (int *)aom_malloc(sizeof(**cb_line_buf) * chroma_stride *
-                                   (2 >> chroma_subsamp_y));
-  *cr_line_buf = (int *)aom_malloc(sizeof(**cr_line_buf) * chroma_stride *
-                                   (2 >> chroma_subsamp_y));
-
-  *y_col_buf =
-      (int *)aom_malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-  *cb_col_buf =
-      (int *)aom_malloc(sizeof(**cb_col_buf) *
-                        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                        (2 >> chroma_subsamp_x));
-  *cr_col_buf =
-      (int *)aom_malloc(sizeof(**cr_col_buf) *
-                        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                        (2 >> chroma_subsamp_x));
-
   *luma_grain_block =
       (int *)aom_malloc(sizeof(**luma_grain_block) * luma_grain_samples);
   *cb_grain_block =
       (int *)aom_malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
   *cr_grain_block =
       (int *)aom_malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
-  if (!(*pred_pos_luma_p && *pred_pos_chroma_p && *y_line_buf && *cb_line_buf &&
-        *cr_line_buf && *y_col_buf && *cb_col_buf && *cr_col_buf &&
-        *luma_grain_block && *cb_grain_block && *cr_grain_block)) {
+  if (!(*pred_pos_luma_p && *pred_pos_chroma_p && *luma_grain_block &&
+        *cb_grain_block && *cr_grain_block)) {
     dealloc_arrays(params, pred_pos_luma_p, pred_pos_chroma_p, luma_grain_block,
-                   cb_grain_block, cr_grain_block, y_line_buf, cb_line_buf,
-                   cr_line_buf, y_col_buf, cb_col_buf, cr_col_buf);
+                   cb_grain_block, cr_grain_block);
+    return false;
+  }
+  return true;
+}
+
+static void dealloc_overlap_bufs(aom_grain_overlap_bufs_t *bufs) {
+  aom_free(bufs->y_line_buf);
+  aom_free(bufs->cb_line_buf);
+  aom_free(bufs->cr_line_buf);
+  aom_free(bufs->y_col_buf);
+  aom_free(bufs->cb_col_buf);
+  aom_free(bufs->cr_col_buf);
+  memset(bufs, 0, sizeof(*bufs));
+}
+
+static bool alloc_overlap_bufs(aom_grain_overlap_bufs_t *bufs, int luma_stride,
+                               int chroma_stride, int chroma_subsamp_y,
+                               int chroma_subsamp_x) {
+  const int chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+
+  bufs->y_line_buf =
+      (int *)aom_malloc(sizeof(*bufs->y_line_buf) * luma_stride * 2);
+  bufs->cb_line_buf =
+      (int *)aom_malloc(sizeof(*bufs->cb_line_buf) * chroma_stride *
+                        (2 >> chroma_subsamp_y));
+  bufs->cr_line_buf =
+      (int *)aom_malloc(sizeof(*bufs->cr_line_buf) * chroma_stride *
+                        (2 >> chroma_subsamp_y));
+
+  bufs->y_col_buf = (int *)aom_malloc(sizeof(*bufs->y_col_buf) *
+                                      (luma_subblock_size_y + 2) * 2);
+  bufs->cb_col_buf =
+      (int *)aom_malloc(sizeof(*bufs->cb_col_buf) *
+                        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                        (2 >> chroma_subsamp_x));
+  bufs->cr_col_buf =
+      (int *)aom_malloc(sizeof(*bufs->cr_col_buf) *
+                        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                        (2 >> chroma_subsamp_x));
+  if (!(bufs->y_line_buf && bufs->cb_line_buf && bufs->cr_line_buf &&
+        bufs->y_col_buf && bufs->cb_col_buf && bufs->cr_col_buf)) {
+    dealloc_overlap_bufs(bufs);
     return false;
   }
   return true;
@@ -629,6 +629,103 @@ static int scale_LUT(const int *scaling_lut, int index, int bit_depth) {
                              (bit_depth - 8));
 }
 
+void av1_add_luma_grain_c(uint8_t *luma, int luma_stride, const int *grain,
+                          int grain_stride, int width, int height,
+                          const int *scaling_lut, int scaling_shift,
+                          int min_value, int max_value) {
+  const int rounding_offset = (1 << (scaling_shift - 1));
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      luma[j] = clamp(luma[j] + ((scaling_lut[luma[j]] * grain[j] +
+                                  rounding_offset) >>
+                                 scaling_shift),
+                      min_value, max_value);
+    }
+    luma += luma_stride;
+    grain += grain_stride;
+  }
+}
+
+void av1_add_chroma_grain_c(uint8_t *chroma, int chroma_stride,
+                            const uint8_t *luma, int luma_stride,
+                            const int *grain, int grain_stride, int width,
+                            int height, int chroma_subsamp_x,
+                            int chroma_subsamp_y, const int *scaling_lut,
+                            int luma_mult, int chroma_mult, int offset,
+                            int scaling_shift, int min_value, int max_value) {
+  const int rounding_offset = (1 << (scaling_shift - 1));
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      int average_luma;
+      if (chroma_subsamp_x) {
+        average_luma = (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1;
+      } else {
+        average_luma = luma[j];
+      }
+      const int index = clamp(
+          ((average_luma * luma_mult + chroma_mult * chroma[j]) >> 6) + offset,
+          0, 255);
+      chroma[j] = clamp(chroma[j] + ((scaling_lut[index] * grain[j] +
+                                      rounding_offset) >>
+                                     scaling_shift),
+                        min_value, max_value);
+    }
+    chroma += chroma_stride;
+    luma += luma_stride << chroma_subsamp_y;
+    grain += grain_stride;
+  }
+}
+
+void av1_highbd_add_luma_grain_c(uint16_t *luma, int luma_stride,
+                                 const int *grain, int grain_stride, int width,
+                                 int height, const int *scaling_lut,
+                                 int scaling_shift, int min_value,
+                                 int max_value, int bit_depth) {
+  const int rounding_offset = (1 << (scaling_shift - 1));
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      luma[j] = clamp(
+          luma[j] + ((scale_LUT(scaling_lut, luma[j], bit_depth) * grain[j] +
+                      rounding_offset) >>
+                     scaling_shift),
+          min_value, max_value);
+    }
+    luma += luma_stride;
+    grain += grain_stride;
+  }
+}
+
+void av1_highbd_add_chroma_grain_c(
+    uint16_t *chroma, int chroma_stride, const uint16_t *luma, int luma_stride,
+    const int *grain, int grain_stride, int width, int height,
+    int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut,
+    int luma_mult, int chroma_mult, int offset, int scaling_shift,
+    int min_value, int max_value, int bit_depth) {
+  const int rounding_offset = (1 << (scaling_shift - 1));
+  const int max_index = (256 << (bit_depth - 8)) - 1;
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      int average_luma;
+      if (chroma_subsamp_x) {
+        average_luma = (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1;
+      } else {
+        average_luma = luma[j];
+      }
+      const int index = clamp(
+          ((average_luma * luma_mult + chroma_mult * chroma[j]) >> 6) + offset,
+          0, max_index);
+      chroma[j] = clamp(
+          chroma[j] + ((scale_LUT(scaling_lut, index, bit_depth) * grain[j] +
+                        rounding_offset) >>
+                       scaling_shift),
+          min_value, max_value);
+    }
+    chroma += chroma_stride;
+    luma += luma_stride << chroma_subsamp_y;
+    grain += grain_stride;
+  }
+}
+
 static void add_noise_to_block(const aom_film_grain_t *params,
                                const aom_grain_scaling_lut_t *scaling_lut,
                                uint8_t *luma, uint8_t *cb, uint8_t *cr,
@@ -638,6 +735,7 @@ static void add_noise_to_block(const aom_film_grain_t *params,
                                int half_luma_height, int half_luma_width,
                                int bit_depth, int chroma_subsamp_y,
                                int chroma_subsamp_x, int mc_identity) {
+  (void)bit_depth;
   int cb_mult = params->cb_mult - 128;            // fixed scale
   int cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
   int cb_offset = params->cb_offset - 256;
@@ -646,8 +744,6 @@ static void add_noise_to_block(const aom_film_grain_t *params,
   int cr_luma_mult = params->cr_luma_mult - 128;  // fixed scale
   int cr_offset = params->cr_offset - 256;
 
-  int rounding_offset = (1 << (params->scaling_shift - 1));
-
   int apply_y = params->num_y_points > 0 ? 1 : 0;
   int apply_cb =
       (params->num_cb_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
@@ -682,66 +778,32 @@ static void add_noise_to_block(const aom_film_grain_t *params,
     max_luma = max_chroma = 255;
   }
 
-  for (int i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-    for (int j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-      int average_luma = 0;
-      if (chroma_subsamp_x) {
-        average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                             (j << chroma_subsamp_x)] +
-                        luma[(i << chroma_subsamp_y) * luma_stride +
-                             (j << chroma_subsamp_x) + 1] +
-                        1) >>
-                       1;
-      } else {
-        average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-      }
-
-      if (apply_cb) {
-        cb[i * chroma_stride + j] = clamp(
-            cb[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut->cb,
-                            clamp(((average_luma * cb_luma_mult +
-                                    cb_mult * cb[i * chroma_stride + j]) >>
-                                   6) +
-                                      cb_offset,
-                                  0, (256 << (bit_depth - 8)) - 1),
-                            8) *
-                      cb_grain[i * chroma_grain_stride + j] +
-                  rounding_offset) >>
-                 params->scaling_shift),
-            min_chroma, max_chroma);
-      }
+  const int chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+  const int chroma_width = half_luma_width << (1 - chroma_subsamp_x);
+
+  // The grain of the chroma samples depends on the luma samples without
+  // grain, so it is added first.
+  if (apply_cb) {
+    av1_add_chroma_grain(cb, chroma_stride, luma, luma_stride, cb_grain,
+                         chroma_grain_stride, chroma_width, chroma_height,
+                         chroma_subsamp_x, chroma_subsamp_y, scaling_lut->cb,
+                         cb_luma_mult, cb_mult, cb_offset,
+                         params->scaling_shift, min_chroma, max_chroma);
+  }
 
-      if (apply_cr) {
-        cr[i * chroma_stride + j] = clamp(
-            cr[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut->cr,
-                            clamp(((average_luma * cr_luma_mult +
-                                    cr_mult * cr[i * chroma_stride + j]) >>
-                                   6) +
-                                      cr_offset,
-                                  0, (256 << (bit_depth - 8)) - 1),
-                            8) *
-                      cr_grain[i * chroma_grain_stride + j] +
-                  rounding_offset) >>
-                 params->scaling_shift),
-            min_chroma, max_chroma);
-      }
-    }
+  if (apply_cr) {
+    av1_add_chroma_grain(cr, chroma_stride, luma, luma_stride, cr_grain,
+                         chroma_grain_stride, chroma_width, chroma_height,
+                         chroma_subsamp_x, chroma_subsamp_y, scaling_lut->cr,
+                         cr_luma_mult, cr_mult, cr_offset,
+                         params->scaling_shift, min_chroma, max_chroma);
   }
 
   if (apply_y) {
-    for (int i = 0; i < (half_luma_height << 1); i++) {
-      for (int j = 0; j < (half_luma_width << 1); j++) {
-        luma[i * luma_stride + j] = clamp(
-            luma[i * luma_stride + j] +
-                ((scale_LUT(scaling_lut->y, luma[i * luma_stride + j], 8) *
-                      luma_grain[i * luma_grain_stride + j] +
-                  rounding_offset) >>
-                 params->scaling_shift),
-            min_luma, max_luma);
-      }
-    }
+    av1_add_luma_grain(luma, luma_stride, luma_grain, luma_grain_stride,
+                       half_luma_width << 1, half_luma_height << 1,
+                       scaling_lut->y, params->scaling_shift, min_luma,
+                       max_luma);
   }
 }
 
@@ -762,8 +824,6 @@ static void add_noise_to_block_hbd(
   // offset value depends on the bit depth
   int cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-  int rounding_offset = (1 << (params->scaling_shift - 1));
-
   int apply_y = params->num_y_points > 0 ? 1 : 0;
   int apply_cb =
       (params->num_cb_points > 0 || params->chroma_scaling_from_luma) > 0 ? 1
@@ -800,66 +860,32 @@ static void add_noise_to_block_hbd(
     max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
   }
 
-  for (int i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-    for (int j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-      int average_luma = 0;
-      if (chroma_subsamp_x) {
-        average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                             (j << chroma_subsamp_x)] +
-                        luma[(i << chroma_subsamp_y) * luma_stride +
-                             (j << chroma_subsamp_x) + 1] +
-                        1) >>
-                       1;
-      } else {
-        average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-      }
+  const int chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+  const int chroma_width = half_luma_width << (1 - chroma_subsamp_x);
+
+  // The grain of the chroma samples depends on the luma samples without
+  // grain, so it is added first.
+  if (apply_cb) {
+    av1_highbd_add_chroma_grain(
+        cb, chroma_stride, luma, luma_stride, cb_grain, chroma_grain_stride,
+        chroma_width, chroma_height, chroma_subsamp_x, chroma_subsamp_y,
+        scaling_lut->cb, cb_luma_mult, cb_mult, cb_offset,
+        params->scaling_shift, min_chroma, max_chroma, bit_depth);
+  }
 
-      if (apply_cb) {
-        cb[i * chroma_stride + j] = clamp(
-            cb[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut->cb,
-                            clamp(((average_luma * cb_luma_mult +
-                                    cb_mult * cb[i * chroma_stride + j]) >>
-                                   6) +
-                                      cb_offset,
-                                  0, (256 << (bit_depth - 8)) - 1),
-                            bit_depth) *
-                      cb_grain[i * chroma_grain_stride + j] +
-                  rounding_offset) >>
-                 params->scaling_shift),
-            min_chroma, max_chroma);
-      }
-      if (apply_cr) {
-        cr[i * chroma_stride + j] = clamp(
-            cr[i * chroma_stride + j] +
-                ((scale_LUT(scaling_lut->cr,
-                            clamp(((average_luma * cr_luma_mult +
-                                    cr_mult * cr[i * chroma_stride + j]) >>
-                                   6) +
-                                      cr_offset,
-                                  0, (256 << (bit_depth - 8)) - 1),
-                            bit_depth) *
-                      cr_grain[i * chroma_grain_stride + j] +
-                  rounding_offset) >>
-                 params->scaling_shift),
-            min_chroma, max_chroma);
-      }
-    }
+  if (apply_cr) {
+    av1_highbd_add_chroma_grain(
+        cr, chroma_stride, luma, luma_stride, cr_grain, chroma_grain_stride,
+        chroma_width, chroma_height, chroma_subsamp_x, chroma_subsamp_y,
+        scaling_lut->cr, cr_luma_mult, cr_mult, cr_offset,
+        params->scaling_shift, min_chroma, max_chroma, bit_depth);
   }
 
   if (apply_y) {
-    for (int i = 0; i < (half_luma_height << 1); i++) {
-      for (int j = 0; j < (half_luma_width << 1); j++) {
-        luma[i * luma_stride + j] =
-            clamp(luma[i * luma_stride + j] +
-                      ((scale_LUT(scaling_lut->y, luma[i * luma_stride + j],
-                                  bit_depth) *
-                            luma_grain[i * luma_grain_stride + j] +
-                        rounding_offset) >>
-                       params->scaling_shift),
-                  min_luma, max_luma);
-      }
-    }
+    av1_highbd_add_luma_grain(luma, luma_stride, luma_grain, luma_grain_stride,
+                              half_luma_width << 1, half_luma_height << 1,
+                              scaling_lut->y, params->scaling_shift, min_luma,
+                              max_luma, bit_depth);
   }
 }
 
@@ -975,117 +1001,92 @@ static void hor_boundary_overlap(int *top_block, int top_stride,
   }
 }
 
-/*!\brief Add film grain
- *
- * Add film grain to an image
- *
- * Returns 0 for success, -1 for failure
- *
- * \param[in]    grain_params     Grain parameters
- * \param[in]    luma             luma plane
- * \param[in]    cb               cb plane
- * \param[in]    cr               cr plane
- * \param[in]    height           luma plane height
- * \param[in]    width            luma plane width
- * \param[in]    luma_stride      luma plane stride
- * \param[in]    chroma_stride    chroma plane stride
- */
-static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
-                              uint8_t *cb, uint8_t *cr, int height, int width,
-                              int luma_stride, int chroma_stride,
-                              int use_high_bit_depth, int chroma_subsamp_y,
-                              int chroma_subsamp_x, int mc_identity) {
-  int **pred_pos_luma;
-  int **pred_pos_chroma;
+// State shared by the jobs that add the grain to the rows of a frame.
+typedef struct {
+  const aom_film_grain_t *params;
+  const aom_image_t *src;
+  aom_image_t *dst;
+  aom_grain_scaling_lut_t scaling_lut;
   int *luma_grain_block;
   int *cb_grain_block;
   int *cr_grain_block;
-
-  int *y_line_buf;
-  int *cb_line_buf;
-  int *cr_line_buf;
-
-  int *y_col_buf;
-  int *cb_col_buf;
-  int *cr_col_buf;
-
-  aom_grain_scaling_lut_t scaling_lut;
-  memset(&scaling_lut, 0, sizeof(scaling_lut));
-
-  aom_grain_rng_t rng;
-  rng.random_register = params->random_seed;
-
-  int left_pad = 3;
-  int right_pad = 3;  // padding to offset for AR coefficients
-  int top_pad = 3;
-  int bottom_pad = 0;
-
-  int ar_padding = 3;  // maximum lag used for stabilization of AR coefficients
+  int luma_grain_stride;
+  int chroma_grain_stride;
+  int left_pad;
+  int top_pad;
+  int ar_padding;
+  uint8_t *luma;
+  uint8_t *cb;
+  uint8_t *cr;
+  // Luma plane dimensions, rounded up to even values.
+  int height;
+  int width;
+  // Strides in samples.
+  int luma_stride;
+  int chroma_stride;
+  int use_high_bit_depth;
+  int chroma_subsamp_y;
+  int chroma_subsamp_x;
+  int mc_identity;
+} aom_grain_frame_t;
+
+// Rows of a frame processed by one job, as the stripe range passed to
+// add_grain_to_stripes().
+typedef struct {
+  int y_start;
+  int y_end;
+} aom_grain_job_t;
+
+// Adds the grain to the stripes of 32 luma rows that start at luma rows
+// (y << 1) for y in [y_start, y_end), along with the matching chroma rows.
+// The overlap buffers must hold the grain of the bottom of the stripe above
+// y_start. If 'apply' is 0, no grain is added and only the overlap buffers are
+// updated, so that they are ready for the stripe that follows.
+static void add_grain_to_stripes(const aom_grain_frame_t *frame,
+                                 const aom_grain_overlap_bufs_t *bufs,
+                                 int y_start, int y_end, int apply) {
+  const aom_film_grain_t *params = frame->params;
+  const aom_grain_scaling_lut_t *scaling_lut = &frame->scaling_lut;
+  uint8_t *luma = frame->luma;
+  uint8_t *cb = frame->cb;
+  uint8_t *cr = frame->cr;
+  const int height = frame->height;
+  const int width = frame->width;
+  const int luma_stride = frame->luma_stride;
+  const int chroma_stride = frame->chroma_stride;
+  const int use_high_bit_depth = frame->use_high_bit_depth;
+  const int chroma_subsamp_y = frame->chroma_subsamp_y;
+  const int chroma_subsamp_x = frame->chroma_subsamp_x;
+  const int mc_identity = frame->mc_identity;
+
+  int *luma_grain_block = frame->luma_grain_block;
+  int *cb_grain_block = frame->cb_grain_block;
+  int *cr_grain_block = frame->cr_grain_block;
+  const int luma_grain_stride = frame->luma_grain_stride;
+  const int chroma_grain_stride = frame->chroma_grain_stride;
+  const int left_pad = frame->left_pad;
+  const int top_pad = frame->top_pad;
+  const int ar_padding = frame->ar_padding;
+
+  int *y_line_buf = bufs->y_line_buf;
+  int *cb_line_buf = bufs->cb_line_buf;
+  int *cr_line_buf = bufs->cr_line_buf;
+  int *y_col_buf = bufs->y_col_buf;
+  int *cb_col_buf = bufs->cb_col_buf;
+  int *cr_col_buf = bufs->cr_col_buf;
 
   const int chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
   const int chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
 
-  // Initial padding is only needed for generation of
-  // film grain templates (to stabilize the AR process)
-  // Only a 64x64 luma and 32x32 chroma part of a template
-  // is used later for adding grain, padding can be discarded
-
-  int luma_block_size_y =
-      top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
-  int luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 +
-                          2 * ar_padding + right_pad;
-
-  int chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-                            chroma_subblock_size_y * 2 + bottom_pad;
-  int chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                            chroma_subblock_size_x * 2 +
-                            (2 >> chroma_subsamp_x) * ar_padding + right_pad;
-
-  int luma_grain_stride = luma_block_size_x;
-  int chroma_grain_stride = chroma_block_size_x;
-
-  int overlap = params->overlap_flag;
-  int bit_depth = params->bit_depth;
-
-  int grain_min = -(1 << (bit_depth - 1));
-  int grain_max = (1 << (bit_depth - 1)) - 1;
-
-  if (!init_arrays(params, luma_stride, chroma_stride, &pred_pos_luma,
-                   &pred_pos_chroma, &luma_grain_block, &cb_grain_block,
-                   &cr_grain_block, &y_line_buf, &cb_line_buf, &cr_line_buf,
-                   &y_col_buf, &cb_col_buf, &cr_col_buf,
-                   luma_block_size_y * luma_block_size_x,
-                   chroma_block_size_y * chroma_block_size_x, chroma_subsamp_y,
-                   chroma_subsamp_x))
-    return -1;
-
-  generate_luma_grain_block(params, &rng, pred_pos_luma, luma_grain_block,
-                            luma_block_size_y, luma_block_size_x,
-                            luma_grain_stride, left_pad, top_pad, right_pad,
-                            bottom_pad);
+  const int overlap = params->overlap_flag;
+  const int bit_depth = params->bit_depth;
 
-  if (!generate_chroma_grain_blocks(
-          params, &rng, pred_pos_chroma, luma_grain_block, cb_grain_block,
-          cr_grain_block, luma_grain_stride, chroma_block_size_y,
-          chroma_block_size_x, chroma_grain_stride, left_pad, top_pad,
-          right_pad, bottom_pad, chroma_subsamp_y, chroma_subsamp_x))
-    return -1;
+  const int grain_min = -(1 << (bit_depth - 1));
+  const int grain_max = (1 << (bit_depth - 1)) - 1;
 
-  init_scaling_function(params->scaling_points_y, params->num_y_points,
-                        scaling_lut.y);
+  aom_grain_rng_t rng;
 
-  if (params->chroma_scaling_from_luma) {
-    static_assert(sizeof(scaling_lut.cb) == sizeof(scaling_lut.y), "");
-    static_assert(sizeof(scaling_lut.cr) == sizeof(scaling_lut.y), "");
-    memcpy(scaling_lut.cb, scaling_lut.y, sizeof(scaling_lut.y));
-    memcpy(scaling_lut.cr, scaling_lut.y, sizeof(scaling_lut.y));
-  } else {
-    init_scaling_function(params->scaling_points_cb, params->num_cb_points,
-                          scaling_lut.cb);
-    init_scaling_function(params->scaling_points_cr, params->num_cr_points,
-                          scaling_lut.cr);
-  }
-  for (int y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
+  for (int y = y_start; y < y_end; y += (luma_subblock_size_y >> 1)) {
     init_random_generator(&rng, y * 2, params->random_seed);
 
     for (int x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
@@ -1132,9 +1133,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
 
         int i = y ? 1 : 0;
 
-        if (use_high_bit_depth) {
+        if (apply && use_high_bit_depth) {
           add_noise_to_block_hbd(
-              params, &scaling_lut,
+              params, scaling_lut,
               (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
               (uint16_t *)cb +
                   ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1148,9 +1149,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
               2, (2 - chroma_subsamp_x),
               AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
               bit_depth, chroma_subsamp_y, chroma_subsamp_x, mc_identity);
-        } else {
+        } else if (apply) {
           add_noise_to_block(
-              params, &scaling_lut,
+              params, scaling_lut,
               luma + ((y + i) << 1) * luma_stride + (x << 1),
               cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
                   (x << (1 - chroma_subsamp_x)),
@@ -1165,7 +1166,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
         }
       }
 
-      if (overlap && y) {
+      // The rows blended with the stripe above are only needed to add the
+      // grain. The line buffers they are written to are overwritten below.
+      if (overlap && y && apply) {
         if (x) {
           hor_boundary_overlap(y_line_buf + (x << 1), luma_stride, y_col_buf, 2,
                                y_line_buf + (x << 1), luma_stride, 2, 2,
@@ -1219,9 +1222,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
                    (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
             2 >> chroma_subsamp_y, grain_min, grain_max);
 
-        if (use_high_bit_depth) {
+        if (apply && use_high_bit_depth) {
           add_noise_to_block_hbd(
-              params, &scaling_lut,
+              params, scaling_lut,
               (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
               (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
                   (x << ((1 - chroma_subsamp_x))),
@@ -1233,9 +1236,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
               chroma_stride, 1,
               AOMMIN(luma_subblock_size_x >> 1, width / 2 - x), bit_depth,
               chroma_subsamp_y, chroma_subsamp_x, mc_identity);
-        } else {
+        } else if (apply) {
           add_noise_to_block(
-              params, &scaling_lut, luma + (y << 1) * luma_stride + (x << 1),
+              params, scaling_lut, luma + (y << 1) * luma_stride + (x << 1),
               cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
                   (x << ((1 - chroma_subsamp_x))),
               cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1252,9 +1255,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
       int i = overlap && y ? 1 : 0;
       int j = overlap && x ? 1 : 0;
 
-      if (use_high_bit_depth) {
+      if (apply && use_high_bit_depth) {
         add_noise_to_block_hbd(
-            params, &scaling_lut,
+            params, scaling_lut,
             (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
             (uint16_t *)cb +
                 ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
@@ -1277,9 +1280,9 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
             AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
             AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
             chroma_subsamp_y, chroma_subsamp_x, mc_identity);
-      } else {
+      } else if (apply) {
         add_noise_to_block(
-            params, &scaling_lut,
+            params, scaling_lut,
             luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
             cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
                 ((x + j) << (1 - chroma_subsamp_x)),
@@ -1377,22 +1380,261 @@ static int add_film_grain_run(const aom_film_grain_t *params, uint8_t *luma,
       }
     }
   }
+}
+
+// Copies the luma rows [row_start, row_end) of the source image, and the
+// matching chroma rows, to the destination image.
+static void copy_rows(const aom_grain_frame_t *frame, int row_start,
+                      int row_end) {
+  const aom_image_t *src = frame->src;
+  aom_image_t *dst = frame->dst;
+  const int use_high_bit_depth = frame->use_high_bit_depth;
+  const int luma_rows = AOMMIN(row_end, (int)src->d_h) - row_start;
+  uint8_t *const luma = dst->planes[AOM_PLANE_Y] +
+                        (size_t)row_start * dst->stride[AOM_PLANE_Y];
+  // When the grain is added in place there is nothing to copy, but the luma
+  // plane still needs to be extended to even dimensions.
+  const int in_place = src->planes[AOM_PLANE_Y] == dst->planes[AOM_PLANE_Y];
+
+  if (!in_place) {
+    copy_rect(src->planes[AOM_PLANE_Y] +
+                  (size_t)row_start * src->stride[AOM_PLANE_Y],
+              src->stride[AOM_PLANE_Y], luma, dst->stride[AOM_PLANE_Y],
+              src->d_w, luma_rows, use_high_bit_depth);
+  }
+  // Note that dst is already assumed to be aligned to even. Only the last
+  // rows of the frame can have an odd count.
+  extend_even(luma, dst->stride[AOM_PLANE_Y], src->d_w, luma_rows,
+              use_high_bit_depth);
+
+  if (!src->monochrome && !in_place) {
+    const int chroma_start = row_start >> frame->chroma_subsamp_y;
+    const int chroma_rows =
+        (AOMMIN(row_end, frame->height) >> frame->chroma_subsamp_y) -
+        chroma_start;
+    const int chroma_width = frame->width >> frame->chroma_subsamp_x;
+    for (int plane = AOM_PLANE_U; plane <= AOM_PLANE_V; ++plane) {
+      copy_rect(src->planes[plane] + (size_t)chroma_start * src->stride[plane],
+                src->stride[plane],
+                dst->planes[plane] + (size_t)chroma_start * dst->stride[plane],
+                dst->stride[plane], chroma_width, chroma_rows,
+                use_high_bit_depth);
+    }
+  }
+}
+
+// Hook function of the jobs that add the grain to the rows of a frame. Copies
+// the rows of the job from the source image, then adds the grain to them.
+static int add_grain_rows_worker(void *arg1, void *arg2) {
+  const aom_grain_frame_t *const frame = (const aom_grain_frame_t *)arg1;
+  const aom_grain_job_t *const job = (const aom_grain_job_t *)arg2;
+
+  copy_rows(frame, job->y_start << 1, job->y_end << 1);
+
+  aom_grain_overlap_bufs_t bufs;
+  if (!alloc_overlap_bufs(&bufs, frame->luma_stride, frame->chroma_stride,
+                          frame->chroma_subsamp_y, frame->chroma_subsamp_x)) {
+    return 0;
+  }
+  // The overlap buffers carry the grain of the bottom of the stripe above,
+  // which only depends on the random offsets of its blocks. A job that starts
+  // below the top of the frame rebuilds them with a pass over that stripe.
+  if (frame->params->overlap_flag && job->y_start > 0) {
+    add_grain_to_stripes(frame, &bufs,
+                         job->y_start - (luma_subblock_size_y >> 1),
+                         job->y_start, /*apply=*/0);
+  }
+  add_grain_to_stripes(frame, &bufs, job->y_start, job->y_end, /*apply=*/1);
+  dealloc_overlap_bufs(&bufs);
+  return 1;
+}
+
+// Splits the frame into stripes of 32 luma rows and runs
+// add_grain_rows_worker() on contiguous ranges of stripes, one per worker.
+static int add_grain_rows_mt(aom_grain_frame_t *frame, AVxWorker *workers,
+                             int num_workers) {
+  const int half_height = frame->height / 2;
+  const int stripe_size = luma_subblock_size_y >> 1;
+  const int num_stripes = (half_height + stripe_size - 1) / stripe_size;
+  const int num_jobs =
+      workers != NULL ? AOMMAX(AOMMIN(num_workers, num_stripes), 1) : 1;
+
+  aom_grain_job_t *const jobs =
+      (aom_grain_job_t *)aom_malloc(sizeof(*jobs) * num_jobs);
+  if (!jobs) return 0;
+  for (int i = 0; i < num_jobs; ++i) {
+    jobs[i].y_start = i * num_stripes / num_jobs * stripe_size;
+    jobs[i].y_end =
+        AOMMIN((i + 1) * num_stripes / num_jobs * stripe_size, half_height);
+  }
+
+  int ok;
+  if (num_jobs == 1) {
+    ok = add_grain_rows_worker(frame, &jobs[0]);
+  } else {
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (int i = num_jobs - 1; i >= 0; --i) {
+      AVxWorker *const worker = &workers[i];
+      worker->hook = add_grain_rows_worker;
+      worker->data1 = frame;
+      worker->data2 = &jobs[i];
+      worker->had_error = 0;
+      if (i == 0)
+        winterface->execute(worker);
+      else
+        winterface->launch(worker);
+    }
+    ok = !workers[0].had_error;
+    for (int i = num_jobs - 1; i > 0; --i) {
+      if (!winterface->sync(&workers[i])) ok = 0;
+    }
+  }
+  aom_free(jobs);
+  return ok;
+}
+
+/*!\brief Add film grain
+ *
+ * Add film grain to an image
+ *
+ * Returns 0 for success, -1 for failure
+ *
+ * \param[in]    params             Grain parameters
+ * \param[in]    src                Source image
+ * \param[out]   dst                Resulting image with grain
+ * \param[in]    use_high_bit_depth Whether the images use 16-bit samples
+ * \param[in]    chroma_subsamp_y   Vertical chroma subsampling
+ * \param[in]    chroma_subsamp_x   Horizontal chroma subsampling
+ * \param[in]    mc_identity        Whether the matrix coefficients are identity
+ * \param[in]    workers            Workers to add the grain with, or NULL
+ * \param[in]    num_workers        Number of workers
+ */
+static int add_film_grain_run(const aom_film_grain_t *params,
+                              const aom_image_t *src, aom_image_t *dst,
+                              int use_high_bit_depth, int chroma_subsamp_y,
+                              int chroma_subsamp_x, int mc_identity,
+                              AVxWorker *workers, int num_workers) {
+  int **pred_pos_luma;
+  int **pred_pos_chroma;
+  int *luma_grain_block;
+  int *cb_grain_block;
+  int *cr_grain_block;
+
+  aom_grain_frame_t frame;
+  memset(&frame, 0, sizeof(frame));
+
+  aom_grain_rng_t rng;
+  rng.random_register = params->random_seed;
+
+  int left_pad = 3;
+  int right_pad = 3;  // padding to offset for AR coefficients
+  int top_pad = 3;
+  int bottom_pad = 0;
+
+  int ar_padding = 3;  // maximum lag used for stabilization of AR coefficients
+
+  const int chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+  const int chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+
+  // Initial padding is only needed for generation of
+  // film grain templates (to stabilize the AR process)
+  // Only a 64x64 luma and 32x32 chroma part of a template
+  // is used later for adding grain, padding can be discarded
+
+  int luma_block_size_y =
+      top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
+  int luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 +
+                          2 * ar_padding + right_pad;
+
+  int chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
+                            chroma_subblock_size_y * 2 + bottom_pad;
+  int chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
+                            chroma_subblock_size_x * 2 +
+                            (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+
+  int luma_grain_stride = luma_block_size_x;
+  int chroma_grain_stride = chroma_block_size_x;
+
+  if (!init_arrays(params, &pred_pos_luma, &pred_pos_chroma, &luma_grain_block,
+                   &cb_grain_block, &cr_grain_block,
+                   luma_block_size_y * luma_block_size_x,
+                   chroma_block_size_y * chroma_block_size_x))
+    return -1;
+
+  // The grain templates are generated by a causal autoregressive filter fed by
+  // a serial random number generator. Their size does not depend on the frame
+  // size, so this is cheap compared to adding the grain to the frame.
+  generate_luma_grain_block(params, &rng, pred_pos_luma, luma_grain_block,
+                            luma_block_size_y, luma_block_size_x,
+                            luma_grain_stride, left_pad, top_pad, right_pad,
+                            bottom_pad);
+
+  if (!generate_chroma_grain_blocks(
+          params, &rng, pred_pos_chroma, luma_grain_block, cb_grain_block,
+          cr_grain_block, luma_grain_stride, chroma_block_size_y,
+          chroma_block_size_x, chroma_grain_stride, left_pad, top_pad,
+          right_pad, bottom_pad, chroma_subsamp_y, chroma_subsamp_x)) {
+    dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma, &luma_grain_block,
+                   &cb_grain_block, &cr_grain_block);
+    return -1;
+  }
+
+  aom_grain_scaling_lut_t *const scaling_lut = &frame.scaling_lut;
+  init_scaling_function(params->scaling_points_y, params->num_y_points,
+                        scaling_lut->y);
+
+  if (params->chroma_scaling_from_luma) {
+    static_assert(sizeof(scaling_lut->cb) == sizeof(scaling_lut->y), "");
+    static_assert(sizeof(scaling_lut->cr) == sizeof(scaling_lut->y), "");
+    memcpy(scaling_lut->cb, scaling_lut->y, sizeof(scaling_lut->y));
+    memcpy(scaling_lut->cr, scaling_lut->y, sizeof(scaling_lut->y));
+  } else {
+    init_scaling_function(params->scaling_points_cb, params->num_cb_points,
+                          scaling_lut->cb);
+    init_scaling_function(params->scaling_points_cr, params->num_cr_points,
+                          scaling_lut->cr);
+  }
+
+  frame.params = params;
+  frame.src = src;
+  frame.dst = dst;
+  frame.luma_grain_block = luma_grain_block;
+  frame.cb_grain_block = cb_grain_block;
+  frame.cr_grain_block = cr_grain_block;
+  frame.luma_grain_stride = luma_grain_stride;
+  frame.chroma_grain_stride = chroma_grain_stride;
+  frame.left_pad = left_pad;
+  frame.top_pad = top_pad;
+  frame.ar_padding = ar_padding;
+  frame.luma = dst->planes[AOM_PLANE_Y];
+  frame.cb = dst->planes[AOM_PLANE_U];
+  frame.cr = dst->planes[AOM_PLANE_V];
+  frame.width = src->d_w % 2 ? src->d_w + 1 : src->d_w;
+  frame.height = src->d_h % 2 ? src->d_h + 1 : src->d_h;
+  // luma and chroma strides in samples
+  frame.luma_stride = dst->stride[AOM_PLANE_Y] >> use_high_bit_depth;
+  frame.chroma_stride = dst->stride[AOM_PLANE_U] >> use_high_bit_depth;
+  frame.use_high_bit_depth = use_high_bit_depth;
+  frame.chroma_subsamp_y = chroma_subsamp_y;
+  frame.chroma_subsamp_x = chroma_subsamp_x;
+  frame.mc_identity = mc_identity;
+
+  const int ok = add_grain_rows_mt(&frame, workers, num_workers);
 
   dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma, &luma_grain_block,
-                 &cb_grain_block, &cr_grain_block, &y_line_buf, &cb_line_buf,
-                 &cr_line_buf, &y_col_buf, &cb_col_buf, &cr_col_buf);
-  return 0;
+                 &cb_grain_block, &cr_grain_block);
+  return ok ? 0 : -1;
 }
 
-int av1_add_film_grain(const aom_film_grain_t *params, const aom_image_t *src,
-                       aom_image_t *dst) {
-  uint8_t *luma, *cb, *cr;
-  int height, width, luma_stride, chroma_stride;
+int av1_add_film_grain_mt(const aom_film_grain_t *params,
+                          const aom_image_t *src, aom_image_t *dst,
+                          AVxWorker *workers, int num_workers) {
   int use_high_bit_depth = 0;
   int chroma_subsamp_x = 0;
   int chroma_subsamp_y = 0;
   int mc_identity = src->mc == AOM_CICP_MC_IDENTITY ? 1 : 0;
 
+  av1_rtcd();
   switch (src->fmt) {
     case AOM_IMG_FMT_I420:
       use_high_bit_depth = 0;
@@ -1454,37 +1696,12 @@ int av1_add_film_grain(const aom_film_grain_t *params, const aom_image_t *src,
   dst->temporal_id = src->temporal_id;
   dst->spatial_id = src->spatial_id;
 
-  width = src->d_w % 2 ? src->d_w + 1 : src->d_w;
-  height = src->d_h % 2 ? src->d_h + 1 : src->d_h;
-
-  copy_rect(src->planes[AOM_PLANE_Y], src->stride[AOM_PLANE_Y],
-            dst->planes[AOM_PLANE_Y], dst->stride[AOM_PLANE_Y], src->d_w,
-            src->d_h, use_high_bit_depth);
-  // Note that dst is already assumed to be aligned to even.
-  extend_even(dst->planes[AOM_PLANE_Y], dst->stride[AOM_PLANE_Y], src->d_w,
-              src->d_h, use_high_bit_depth);
-
-  if (!src->monochrome) {
-    copy_rect(src->planes[AOM_PLANE_U], src->stride[AOM_PLANE_U],
-              dst->planes[AOM_PLANE_U], dst->stride[AOM_PLANE_U],
-              width >> chroma_subsamp_x, height >> chroma_subsamp_y,
-              use_high_bit_depth);
-
-    copy_rect(src->planes[AOM_PLANE_V], src->stride[AOM_PLANE_V],
-              dst->planes[AOM_PLANE_V], dst->stride[AOM_PLANE_V],
-              width >> chroma_subsamp_x, height >> chroma_subsamp_y,
-              use_high_bit_depth);
-  }
-
-  luma = dst->planes[AOM_PLANE_Y];
-  cb = dst->planes[AOM_PLANE_U];
-  cr = dst->planes[AOM_PLANE_V];
-
-  // luma and chroma strides in samples
-  luma_stride = dst->stride[AOM_PLANE_Y] >> use_high_bit_depth;
-  chroma_stride = dst->stride[AOM_PLANE_U] >> use_high_bit_depth;
+  return add_film_grain_run(params, src, dst, use_high_bit_depth,
+                            chroma_subsamp_y, chroma_subsamp_x, mc_identity,
+                            workers, num_workers);
+}
 
-  return add_film_grain_run(params, luma, cb, cr, height, width, luma_stride,
-                            chroma_stride, use_high_bit_depth, chroma_subsamp_y,
-                            chroma_subsamp_x, mc_identity);
+int av1_add_film_grain(const aom_film_grain_t *params, const aom_image_t *src,
+                       aom_image_t *dst) {
+  return av1_add_film_grain_mt(params, src, dst, NULL, 0);
 }
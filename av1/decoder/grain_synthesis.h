@@ -24,11 +24,16 @@ extern "C" {
 
 #include "aom_dsp/grain_params.h"
 #include "aom/aom_image.h"
+#include "aom_util/aom_thread.h"
 
 /*!\brief Add film grain
  *
  * Add film grain to an image
  *
+ * 'dst' may be 'src' itself, in which case the grain is added in place. The
+ * planes of 'src' must then be large enough to hold the image extended to
+ * even dimensions.
+ *
  * Returns 0 for success, -1 for failure
  *
  * \param[in]    grain_params     Grain parameters
@@ -38,6 +43,24 @@ extern "C" {
 int av1_add_film_grain(const aom_film_grain_t *grain_params,
                        const aom_image_t *src, aom_image_t *dst);
 
+/*!\brief Add film grain using several workers
+ *
+ * Same as av1_add_film_grain(), but the rows of the image are split between
+ * the first 'num_workers' workers of 'workers'. The workers must not be busy.
+ * If 'workers' is NULL, the grain is added by the calling thread.
+ *
+ * Returns 0 for success, -1 for failure
+ *
+ * \param[in]    grain_params     Grain parameters
+ * \param[in]    src              Source image
+ * \param[out]   dst              Resulting image with grain
+ * \param[in]    workers          Workers to add the grain with
+ * \param[in]    num_workers      Number of workers
+ */
+int av1_add_film_grain_mt(const aom_film_grain_t *grain_params,
+                          const aom_image_t *src, aom_image_t *dst,
+                          AVxWorker *workers, int num_workers);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "config/aom_config.h"
+#include "config/av1_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+
+// Returns clamp(x + ((scale * grain + round) >> shift), min, max) for 8
+// samples.
+static inline __m256i add_grain_8(__m256i x, __m256i scale, const int *grain,
+                                  __m256i round, __m128i shift, __m256i min,
+                                  __m256i max) {
+  const __m256i g = _mm256_loadu_si256((const __m256i *)grain);
+  __m256i noise = _mm256_add_epi32(_mm256_mullo_epi32(scale, g), round);
+  noise = _mm256_sra_epi32(noise, shift);
+  return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(x, noise), min),
+                          max);
+}
+
+static inline int add_grain_1(int x, int scale, int grain, int scaling_shift,
+                              int min_value, int max_value) {
+  const int round = 1 << (scaling_shift - 1);
+  return clamp(x + ((scale * grain + round) >> scaling_shift), min_value,
+               max_value);
+}
+
+static inline void store_8_u8(uint8_t *dst, __m256i v) {
+  const __m128i w = _mm_packus_epi32(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+  _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(w, w));
+}
+
+static inline void store_8_u16(uint16_t *dst, __m256i v) {
+  _mm_storeu_si128((__m128i *)dst,
+                   _mm_packus_epi32(_mm256_castsi256_si128(v),
+                                    _mm256_extracti128_si256(v, 1)));
+}
+
+static inline __m256i load_8_u8(const uint8_t *src) {
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static inline __m256i load_8_u16(const uint16_t *src) {
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+// Average of the 8 horizontal pairs of luma samples starting at src.
+static inline __m256i load_8_u8_pair_avg(const uint8_t *src) {
+  const __m128i sum = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)src),
+                                        _mm_set1_epi8(1));
+  const __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(1)), 1);
+  return _mm256_cvtepu16_epi32(avg);
+}
+
+static inline __m256i load_8_u16_pair_avg(const uint16_t *src) {
+  const __m128i ones = _mm_set1_epi16(1);
+  const __m128i lo =
+      _mm_madd_epi16(_mm_loadu_si128((const __m128i *)src), ones);
+  const __m128i hi =
+      _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(src + 8)), ones);
+  const __m256i sum =
+      _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+  return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+// Vector version of scale_LUT() in grain_synthesis.c.
+static inline __m256i scale_lut_hbd(const int *scaling_lut, __m256i index,
+                                    int bit_depth) {
+  if (bit_depth == 8) return _mm256_i32gather_epi32(scaling_lut, index, 4);
+  const int shift = bit_depth - 8;
+  const __m256i x = _mm256_srli_epi32(index, shift);
+  const __m256i x1 = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)),
+                                      _mm256_set1_epi32(255));
+  const __m256i start = _mm256_i32gather_epi32(scaling_lut, x, 4);
+  const __m256i end = _mm256_i32gather_epi32(scaling_lut, x1, 4);
+  const __m256i frac =
+      _mm256_and_si256(index, _mm256_set1_epi32((1 << shift) - 1));
+  __m256i delta = _mm256_mullo_epi32(_mm256_sub_epi32(end, start), frac);
+  delta = _mm256_add_epi32(delta, _mm256_set1_epi32(1 << (shift - 1)));
+  return _mm256_add_epi32(start, _mm256_srai_epi32(delta, shift));
+}
+
+static inline int scale_lut_hbd_1(const int *scaling_lut, int index,
+                                  int bit_depth) {
+  const int x = index >> (bit_depth - 8);
+  if (!(bit_depth - 8) || x == 255) return scaling_lut[x];
+  return scaling_lut[x] + (((scaling_lut[x + 1] - scaling_lut[x]) *
+                                (index & ((1 << (bit_depth - 8)) - 1)) +
+                            (1 << (bit_depth - 9))) >>
+                           (bit_depth - 8));
+}
+
+void av1_add_luma_grain_avx2(uint8_t *luma, int luma_stride, const int *grain,
+                             int grain_stride, int width, int height,
+                             const int *scaling_lut, int scaling_shift,
+                             int min_value, int max_value) {
+  const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+  const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+  const __m256i min = _mm256_set1_epi32(min_value);
+  const __m256i max = _mm256_set1_epi32(max_value);
+  for (int i = 0; i < height; i++) {
+    int j = 0;
+    for (; j + 8 <= width; j += 8) {
+      const __m256i x = load_8_u8(luma + j);
+      const __m256i scale = _mm256_i32gather_epi32(scaling_lut, x, 4);
+      store_8_u8(luma + j,
+                 add_grain_8(x, scale, grain + j, round, shift, min, max));
+    }
+    for (; j < width; j++) {
+      luma[j] = add_grain_1(luma[j], scaling_lut[luma[j]], grain[j],
+                            scaling_shift, min_value, max_value);
+    }
+    luma += luma_stride;
+    grain += grain_stride;
+  }
+}
+
+void av1_add_chroma_grain_avx2(uint8_t *chroma, int chroma_stride,
+                               const uint8_t *luma, int luma_stride,
+                               const int *grain, int grain_stride, int width,
+                               int height, int chroma_subsamp_x,
+                               int chroma_subsamp_y, const int *scaling_lut,
+                               int luma_mult, int chroma_mult, int offset,
+                               int scaling_shift, int min_value,
+                               int max_value) {
+  const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+  const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+  const __m256i min = _mm256_set1_epi32(min_value);
+  const __m256i max = _mm256_set1_epi32(max_value);
+  const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+  const __m256i chroma_mult_v = _mm256_set1_epi32(chroma_mult);
+  const __m256i offset_v = _mm256_set1_epi32(offset);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max_index_v = _mm256_set1_epi32(255);
+  for (int i = 0; i < height; i++) {
+    int j = 0;
+    for (; j + 8 <= width; j += 8) {
+      const __m256i average = chroma_subsamp_x
+                                  ? load_8_u8_pair_avg(luma + (j << 1))
+                                  : load_8_u8(luma + j);
+      const __m256i c = load_8_u8(chroma + j);
+      __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(average, luma_mult_v),
+                                       _mm256_mullo_epi32(c, chroma_mult_v));
+      index = _mm256_add_epi32(_mm256_srai_epi32(index, 6), offset_v);
+      index = _mm256_min_epi32(_mm256_max_epi32(index, zero), max_index_v);
+      const __m256i scale = _mm256_i32gather_epi32(scaling_lut, index, 4);
+      store_8_u8(chroma + j,
+                 add_grain_8(c, scale, grain + j, round, shift, min, max));
+    }
+    for (; j < width; j++) {
+      const int average =
+          chroma_subsamp_x
+              ? (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1
+              : luma[j];
+      const int index = clamp(
+          ((average * luma_mult + chroma_mult * chroma[j]) >> 6) + offset, 0,
+          255);
+      chroma[j] = add_grain_1(chroma[j], scaling_lut[index], grain[j],
+                              scaling_shift, min_value, max_value);
+    }
+    chroma += chroma_stride;
+    luma += luma_stride << chroma_subsamp_y;
+    grain += grain_stride;
+  }
+}
+
+void av1_highbd_add_luma_grain_avx2(uint16_t *luma, int luma_stride,
+                                    const int *grain, int grain_stride,
+                                    int width, int height,
+                                    const int *scaling_lut, int scaling_shift,
+                                    int min_value, int max_value,
+                                    int bit_depth) {
+  const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+  const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+  const __m256i min = _mm256_set1_epi32(min_value);
+  const __m256i max = _mm256_set1_epi32(max_value);
+  for (int i = 0; i < height; i++) {
+    int j = 0;
+    for (; j + 8 <= width; j += 8) {
+      const __m256i x = load_8_u16(luma + j);
+      const __m256i scale = scale_lut_hbd(scaling_lut, x, bit_depth);
+      store_8_u16(luma + j,
+                  add_grain_8(x, scale, grain + j, round, shift, min, max));
+    }
+    for (; j < width; j++) {
+      luma[j] = add_grain_1(luma[j],
+                            scale_lut_hbd_1(scaling_lut, luma[j], bit_depth),
+                            grain[j], scaling_shift, min_value, max_value);
+    }
+    luma += luma_stride;
+    grain += grain_stride;
+  }
+}
+
+void av1_highbd_add_chroma_grain_avx2(
+    uint16_t *chroma, int chroma_stride, const uint16_t *luma, int luma_stride,
+    const int *grain, int grain_stride, int width, int height,
+    int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut,
+    int luma_mult, int chroma_mult, int offset, int scaling_shift,
+    int min_value, int max_value, int bit_depth) {
+  const int max_index = (256 << (bit_depth - 8)) - 1;
+  const __m256i round = _mm256_set1_epi32(1 << (scaling_shift - 1));
+  const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+  const __m256i min = _mm256_set1_epi32(min_value);
+  const __m256i max = _mm256_set1_epi32(max_value);
+  const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+  const __m256i chroma_mult_v = _mm256_set1_epi32(chroma_mult);
+  const __m256i offset_v = _mm256_set1_epi32(offset);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max_index_v = _mm256_set1_epi32(max_index);
+  for (int i = 0; i < height; i++) {
+    int j = 0;
+    for (; j + 8 <= width; j += 8) {
+      const __m256i average = chroma_subsamp_x
+                                  ? load_8_u16_pair_avg(luma + (j << 1))
+                                  : load_8_u16(luma + j);
+      const __m256i c = load_8_u16(chroma + j);
+      __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(average, luma_mult_v),
+                                       _mm256_mullo_epi32(c, chroma_mult_v));
+      index = _mm256_add_epi32(_mm256_srai_epi32(index, 6), offset_v);
+      index = _mm256_min_epi32(_mm256_max_epi32(index, zero), max_index_v);
+      const __m256i scale = scale_lut_hbd(scaling_lut, index, bit_depth);
+      store_8_u16(chroma + j,
+                  add_grain_8(c, scale, grain + j, round, shift, min, max));
+    }
+    for (; j < width; j++) {
+      const int average =
+          chroma_subsamp_x
+              ? (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1
+              : luma[j];
+      const int index = clamp(
+          ((average * luma_mult + chroma_mult * chroma[j]) >> 6) + offset, 0,
+          max_index);
+      chroma[j] = add_grain_1(chroma[j],
+                              scale_lut_hbd_1(scaling_lut, index, bit_depth),
+                              grain[j], scaling_shift, min_value, max_value);
+    }
+    chroma += chroma_stride;
+    luma += luma_stride << chroma_subsamp_y;
+    grain += grain_stride;
+  }
+}
@@ -629,8 +629,11 @@ void av1_set_mb_wiener_variance(AV1_COMP *cpi) {
   // av1_calc_mb_wiener_var_mt(). Until then, call calc_mb_wiener_var() if
   // auto_intra_tools_off is true.
   if (num_workers > 1 && !cpi->oxcf.intra_mode_cfg.auto_intra_tools_off) {
-    intra_mt->intra_sync_read_ptr = av1_row_mt_sync_read;
-    intra_mt->intra_sync_write_ptr = av1_row_mt_sync_write;
+    const int atomic_sync = cpi->oxcf.row_mt_sync_mode == ROW_SYNC_ATOMIC;
+    intra_mt->intra_sync_read_ptr =
+        atomic_sync ? av1_row_mt_sync_read_atomic : av1_row_mt_sync_read;
+    intra_mt->intra_sync_write_ptr =
+        atomic_sync ? av1_row_mt_sync_write_atomic : av1_row_mt_sync_write;
     av1_calc_mb_wiener_var_mt(cpi, num_workers, &sum_rec_distortion,
                               &sum_est_rate);
   } else {
@@ -4299,8 +4299,8 @@ static size_t av1_write_metadata_array(AV1_COMP *const cpi, uint8_t *dst,
   return total_bytes_written;
 }
 
-int av1_pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t dst_size,
-                       size_t *size, int *const largest_tile_id) {
+static int pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t dst_size,
+                          size_t *size, int *const largest_tile_id) {
   uint8_t *data = dst;
   size_t data_size = dst_size;
   AV1_COMMON *const cm = &cpi->common;
@@ -4421,3 +4421,11 @@ int av1_pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t dst_size,
   (void)data_size;
   return AOM_CODEC_OK;
 }
+
+int av1_pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t dst_size,
+                       size_t *size, int *const largest_tile_id) {
+  av1_start_stage_timing(cpi, AOM_ENC_STAGE_BITSTREAM_PACKING);
+  const int ret = pack_bitstream(cpi, dst, dst_size, size, largest_tile_id);
+  av1_end_stage_timing(cpi, AOM_ENC_STAGE_BITSTREAM_PACKING);
+  return ret;
+}
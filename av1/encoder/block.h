@@ -1415,6 +1415,15 @@ typedef struct macroblock {
    */
   int palette_pixels;
 
+  /*!\brief Time spent in motion search by the current thread in the current
+   * frame, in microseconds.
+   */
+  int64_t motion_search_time;
+  /*!\brief Time spent in partition and mode search by the current thread in
+   * the current frame, in microseconds.
+   */
+  int64_t rd_search_time;
+
   /*! \brief Keep records of top no-split RD Costs of transform size search. */
   int64_t top_inter_tx_no_split_rd[MAX_TX_BLOCKS_IN_MAX_SB]
                                   [TOP_INTER_TX_NO_SPLIT_COUNT];
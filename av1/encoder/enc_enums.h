@@ -276,6 +276,16 @@ enum {
   ALLINTRA
 } UENUM1BYTE(MODE);
 
+// Subsystems the memory of an encoder instance is accounted to, see
+// AV1_PRIMARY::mem_account. Must not exceed AOM_MEM_MAX_TAGS entries.
+enum {
+  AV1_MEM_LOOKAHEAD,
+  AV1_MEM_TPL,
+  AV1_MEM_FRAME_BUFFERS,
+  AV1_MEM_THREAD_DATA,
+  AV1_MEM_TAGS
+} UENUM1BYTE(AV1_MEM_TAG);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
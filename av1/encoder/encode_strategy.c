@@ -1354,9 +1354,13 @@ int av1_encode_strategy(AV1_COMP *const cpi, size_t *const size,
   if (oxcf->pass != AOM_RC_FIRST_PASS) {
     TplParams *const tpl_data = &cpi->ppi->tpl_data;
     if (tpl_data->tpl_stats_pool[0] == NULL) {
+      // The TPL buffers are only needed once the TPL model is enabled, which
+      // is checked again on every frame while they are not allocated.
+      const int use_tpl = oxcf->algo_cfg.enable_tpl_model ||
+                          av1_use_tpl_for_extrc(&cpi->ext_ratectrl);
       av1_setup_tpl_buffers(cpi->ppi, &cm->mi_params, oxcf->frm_dim_cfg.width,
                             oxcf->frm_dim_cfg.height, 0,
-                            oxcf->gf_cfg.lag_in_frames);
+                            use_tpl ? oxcf->gf_cfg.lag_in_frames : 0);
     }
   }
   cpi->twopass_frame.this_frame = NULL;
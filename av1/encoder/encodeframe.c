@@ -1337,11 +1337,14 @@ static inline void encode_sb_row(AV1_COMP *cpi, ThreadData *td,
     if (!seg_skip) grade_source_content_sb(cpi, x, tile_data, mi_row, mi_col);
 
     // encode the superblock
+    struct aom_usec_timer sb_timer;
+    aom_usec_timer_start(&sb_timer);
     if (use_nonrd_mode) {
       encode_nonrd_sb(cpi, td, tile_data, tp, mi_row, mi_col, seg_skip);
     } else {
       encode_rd_sb(cpi, td, tile_data, tp, mi_row, mi_col, seg_skip);
     }
+    av1_accumulate_stage_time(&sb_timer, &x->rd_search_time);
 
     // Update the top-right context in row_mt coding
     if (update_cdf && (tile_info->mi_row_end > (mi_row + mib_size))) {
@@ -1578,7 +1581,7 @@ static inline void encode_tiles(AV1_COMP *cpi) {
   if (cpi->allocated_tiles != tile_cols * tile_rows) av1_alloc_tile_data(cpi);
 
   av1_init_tile_data(cpi);
-  av1_alloc_mb_data(cpi, mb);
+  av1_alloc_mb_data(cpi, mb, av1_get_scratch_pool(cpi, &cpi->td));
 
   for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
     for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
@@ -2402,12 +2405,16 @@ static inline void encode_frame_internal(AV1_COMP *cpi) {
 #if CONFIG_SPEED_STATS
   x->txfm_search_info.tx_search_count = 0;
 #endif  // CONFIG_SPEED_STATS
+  x->motion_search_time = 0;
+  x->rd_search_time = 0;
 
 #if !CONFIG_REALTIME_ONLY
 #if CONFIG_COLLECT_COMPONENT_TIMING
   start_timing(cpi, av1_compute_global_motion_time);
 #endif
+  av1_start_stage_timing(cpi, AOM_ENC_STAGE_GLOBAL_MOTION);
   av1_compute_global_motion_facade(cpi);
+  av1_end_stage_timing(cpi, AOM_ENC_STAGE_GLOBAL_MOTION);
 #if CONFIG_COLLECT_COMPONENT_TIMING
   end_timing(cpi, av1_compute_global_motion_time);
 #endif
@@ -2447,9 +2454,12 @@ static inline void encode_frame_internal(AV1_COMP *cpi) {
                                        cm->tiles.cols * cm->tiles.rows) > 1;
 
   if (oxcf->row_mt && (mt_info->num_workers > 1)) {
+    const int atomic_sync = oxcf->row_mt_sync_mode == ROW_SYNC_ATOMIC;
     mt_info->row_mt_enabled = 1;
-    enc_row_mt->sync_read_ptr = av1_row_mt_sync_read;
-    enc_row_mt->sync_write_ptr = av1_row_mt_sync_write;
+    enc_row_mt->sync_read_ptr =
+        atomic_sync ? av1_row_mt_sync_read_atomic : av1_row_mt_sync_read;
+    enc_row_mt->sync_write_ptr =
+        atomic_sync ? av1_row_mt_sync_write_atomic : av1_row_mt_sync_write;
     av1_encode_tiles_row_mt(cpi);
   } else {
     if (AOMMIN(mt_info->num_workers, cm->tiles.cols * cm->tiles.rows) > 1) {
@@ -2473,6 +2483,8 @@ static inline void encode_frame_internal(AV1_COMP *cpi) {
       td->pc_root = NULL;
     }
   }
+  cpi->stage_time[AOM_ENC_STAGE_MOTION_SEARCH] += x->motion_search_time;
+  cpi->stage_time[AOM_ENC_STAGE_RD_SEARCH] += x->rd_search_time;
 
   // If intrabc is allowed but never selected, reset the allow_intrabc flag.
   if (features->allow_intrabc && !cpi->intrabc_used) {
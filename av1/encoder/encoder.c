@@ -1387,6 +1387,34 @@ AV1_PRIMARY *av1_create_primary_compressor(
 #endif
 #undef SDSFP
 
+#define SDX8DFP(BT, SDX8DF) ppi->fn_ptr[BT].sdx8df = SDX8DF;
+
+  SDX8DFP(BLOCK_128X128, aom_sad128x128x8d)
+  SDX8DFP(BLOCK_128X64, aom_sad128x64x8d)
+  SDX8DFP(BLOCK_64X128, aom_sad64x128x8d)
+  SDX8DFP(BLOCK_64X64, aom_sad64x64x8d)
+  SDX8DFP(BLOCK_64X32, aom_sad64x32x8d)
+  SDX8DFP(BLOCK_32X64, aom_sad32x64x8d)
+  SDX8DFP(BLOCK_32X32, aom_sad32x32x8d)
+  SDX8DFP(BLOCK_32X16, aom_sad32x16x8d)
+  SDX8DFP(BLOCK_16X32, aom_sad16x32x8d)
+  SDX8DFP(BLOCK_16X16, aom_sad16x16x8d)
+  SDX8DFP(BLOCK_16X8, aom_sad16x8x8d)
+  SDX8DFP(BLOCK_8X16, aom_sad8x16x8d)
+  SDX8DFP(BLOCK_8X8, aom_sad8x8x8d)
+  SDX8DFP(BLOCK_8X4, aom_sad8x4x8d)
+  SDX8DFP(BLOCK_4X8, aom_sad4x8x8d)
+  SDX8DFP(BLOCK_4X4, aom_sad4x4x8d)
+#if !CONFIG_REALTIME_ONLY
+  SDX8DFP(BLOCK_4X16, aom_sad4x16x8d)
+  SDX8DFP(BLOCK_16X4, aom_sad16x4x8d)
+  SDX8DFP(BLOCK_8X32, aom_sad8x32x8d)
+  SDX8DFP(BLOCK_32X8, aom_sad32x8x8d)
+  SDX8DFP(BLOCK_16X64, aom_sad16x64x8d)
+  SDX8DFP(BLOCK_64X16, aom_sad64x16x8d)
+#endif
+#undef SDX8DFP
+
 #if CONFIG_AV1_HIGHBITDEPTH
   highbd_set_var_fns(ppi);
 #endif
@@ -1782,6 +1810,144 @@ void av1_remove_primary_compressor(AV1_PRIMARY *ppi) {
   aom_free(ppi);
 }
 
+static void accumulate_scratch_mem_stats(const AomMemPool *pool,
+                                         aom_scratch_mem_stats_t *stats) {
+  stats->peak_bytes += pool->peak_bytes;
+  stats->num_allocs += pool->num_allocs;
+  stats->num_heap_allocs += pool->num_heap_allocs;
+}
+
+void av1_get_scratch_mem_stats(const AV1_PRIMARY *ppi,
+                               aom_scratch_mem_stats_t *stats) {
+  memset(stats, 0, sizeof(*stats));
+  for (int i = 0; i < MAX_PARALLEL_FRAMES; i++) {
+    if (ppi->parallel_cpi[i] != NULL)
+      accumulate_scratch_mem_stats(&ppi->parallel_cpi[i]->td.scratch_pool,
+                                   stats);
+  }
+  if (ppi->cpi_lap != NULL)
+    accumulate_scratch_mem_stats(&ppi->cpi_lap->td.scratch_pool, stats);
+  // The data of thread 0 is the td of the frame being encoded.
+  for (int t = 1; t < ppi->p_mt_info.num_workers; t++) {
+    const ThreadData *const td = ppi->p_mt_info.tile_thr_data[t].original_td;
+    if (td != NULL) accumulate_scratch_mem_stats(&td->scratch_pool, stats);
+  }
+}
+
+void av1_get_memory_usage(const AV1_PRIMARY *ppi, aom_memory_usage_t *usage) {
+  const AomMemAccount *const account = &ppi->mem_account;
+  usage->total_bytes = account->total;
+  usage->peak_total_bytes = account->peak_total;
+  usage->lookahead_bytes = account->bytes[AV1_MEM_LOOKAHEAD];
+  usage->tpl_bytes = account->bytes[AV1_MEM_TPL];
+  usage->frame_buffer_bytes = account->bytes[AV1_MEM_FRAME_BUFFERS];
+  usage->thread_data_bytes = account->bytes[AV1_MEM_THREAD_DATA];
+}
+
+void av1_get_frame_stage_times(const AV1_PRIMARY *ppi,
+                               aom_frame_stage_times_t *times) {
+  memset(times->stage_us, 0, sizeof(times->stage_us));
+  for (int i = 0; i < MAX_PARALLEL_FRAMES; i++) {
+    const AV1_COMP *const cpi = ppi->parallel_cpi[i];
+    if (cpi == NULL) continue;
+    for (int stage = 0; stage < AOM_ENC_STAGE_COUNT; stage++)
+      times->stage_us[stage] += cpi->stage_time[stage];
+  }
+}
+
+void av1_reset_frame_stage_times(AV1_PRIMARY *ppi) {
+  for (int i = 0; i < MAX_PARALLEL_FRAMES; i++) {
+    AV1_COMP *const cpi = ppi->parallel_cpi[i];
+    if (cpi != NULL) av1_zero(cpi->stage_time);
+  }
+}
+
+// Upper bound of the size of a frame buffer allocated by
+// aom_alloc_frame_buffer().
+static uint64_t estimate_frame_buffer_bytes(int width, int height, int ss_x,
+                                            int ss_y, int use_highbitdepth,
+                                            int border) {
+  const uint64_t y_stride =
+      ALIGN_POWER_OF_TWO(ALIGN_POWER_OF_TWO(width, 3) + 2 * border, 5);
+  const uint64_t y_size =
+      (ALIGN_POWER_OF_TWO(height, 3) + 2 * border) * y_stride;
+  const uint64_t uv_size = y_size >> (ss_x + ss_y);
+  return (1 + use_highbitdepth) * (y_size + 2 * uv_size);
+}
+
+// Upper bound of the buffers allocated for each worker by
+// av1_init_tile_thread_data().
+static uint64_t estimate_thread_data_bytes(int use_highbitdepth,
+                                           int is_allintra) {
+  uint64_t bytes = sizeof(ThreadData) + sizeof(FRAME_CONTEXT);
+  bytes += MAX_SB_SIZE * MAX_SB_SIZE * sizeof(CONV_BUF_TYPE);
+  bytes += (1 + use_highbitdepth) * ((MAX_SB_SIZE + 16) + 16) * MAX_SB_SIZE;
+  bytes += 2 * AOM_BUFFER_SIZE_FOR_BLOCK_HASH * sizeof(uint32_t);
+  bytes += sizeof(FRAME_COUNTS) + sizeof(PALETTE_BUFFER);
+  if (!is_allintra) bytes += 2 * 2 * MAX_MB_PLANE * MAX_SB_SQUARE;
+  return bytes;
+}
+
+uint64_t av1_estimate_memory_usage(const AV1EncoderConfig *oxcf,
+                                   int num_lap_buffers) {
+  const int width = oxcf->frm_dim_cfg.width;
+  const int height = oxcf->frm_dim_cfg.height;
+  const int is_allintra = oxcf->kf_cfg.key_freq_max == 0;
+  // The chroma format is only known once the first frame is received. Profile
+  // 0 only allows 4:2:0 (or monochrome), otherwise assume 4:4:4.
+  const int ss = oxcf->profile == PROFILE_0;
+  const BLOCK_SIZE sb_size = av1_select_sb_size(oxcf, width, height, 1);
+  const int border = av1_get_enc_border_size(av1_is_resize_needed(oxcf),
+                                             is_allintra, sb_size);
+  uint64_t frame_bytes = estimate_frame_buffer_bytes(
+      width, height, ss, ss, oxcf->use_highbitdepth, border);
+#if !CONFIG_REALTIME_ONLY
+  // With global motion, every frame buffer also holds an image pyramid and a
+  // corner list, see aom_realloc_frame_buffer().
+  if (oxcf->tool_cfg.enable_global_motion) {
+    frame_bytes +=
+        aom_get_pyramid_alloc_size(width, height, oxcf->use_highbitdepth) +
+        av1_get_corner_list_size();
+  }
+#endif  // !CONFIG_REALTIME_ONLY
+  const int lag_in_frames = oxcf->gf_cfg.lag_in_frames;
+
+  uint64_t bytes = 0;
+  // Lookahead. With LAP it is sized by the LAP stage, see encoder_init().
+  int lookahead_depth = lag_in_frames;
+  if (num_lap_buffers > 0) {
+    lookahead_depth = num_lap_buffers;
+    if (lag_in_frames - num_lap_buffers >= LAP_LAG_IN_FRAMES)
+      lookahead_depth += LAP_LAG_IN_FRAMES;
+  }
+  lookahead_depth = clamp(lookahead_depth, 1, MAX_TOTAL_BUFFERS);
+  if (!is_allintra) lookahead_depth += MAX_PRE_FRAMES;
+  bytes += lookahead_depth * frame_bytes;
+  // Frame buffer pool of the encoder.
+  bytes += (is_allintra ? FRAME_BUFFERS_ALLINTRA : FRAME_BUFFERS) * frame_bytes;
+  // The LAP stage only runs the first pass, which holds the new frame and at
+  // most three references.
+  if (num_lap_buffers > 0) bytes += 4 * frame_bytes;
+  // TPL.
+  if (oxcf->algo_cfg.enable_tpl_model && lag_in_frames > 1) {
+    const uint64_t mi_count =
+        (uint64_t)ALIGN_POWER_OF_TWO(width, 7) *
+        ALIGN_POWER_OF_TWO(height, 7) / (MI_SIZE * MI_SIZE);
+    const uint64_t stats_bytes = (mi_count >> 4) * sizeof(TplDepStats);
+    // The TPL frames have a 32-pixel border.
+    const uint64_t tpl_frame_bytes = estimate_frame_buffer_bytes(
+        width, height, ss, ss, oxcf->use_highbitdepth, 32);
+    bytes += MAX_LENGTH_TPL_FRAME_STATS * sizeof(TplTxfmStats);
+    bytes += lag_in_frames * (stats_bytes + tpl_frame_bytes) + tpl_frame_bytes;
+  }
+  // Thread data, the data of the first thread excepted.
+  const int num_threads = AOMMAX(1, oxcf->max_threads);
+  bytes += (num_threads - 1) *
+               estimate_thread_data_bytes(oxcf->use_highbitdepth, is_allintra) +
+           sizeof(FRAME_CONTEXT);
+  return bytes;
+}
+
 void av1_remove_compressor(AV1_COMP *cpi) {
   if (!cpi) return;
 #if CONFIG_RATECTRL_LOG
@@ -2683,13 +2849,19 @@ void av1_set_frame_size(AV1_COMP *cpi, int width, int height) {
       cm->seq_params->sb_size);
 
   // Reset the frame pointers to the current frame size.
+  BufferPool *const pool = cm->buffer_pool;
+  lock_buffer_pool(pool);
   if (aom_realloc_frame_buffer(
           &cm->cur_frame->buf, cm->width, cm->height, seq_params->subsampling_x,
           seq_params->subsampling_y, seq_params->use_highbitdepth,
-          cpi->oxcf.border_in_pixels, cm->features.byte_alignment, NULL, NULL,
-          NULL, cpi->alloc_pyramid, 0))
+          cpi->oxcf.border_in_pixels, cm->features.byte_alignment,
+          &cm->cur_frame->raw_frame_buffer, pool->get_fb_cb, pool->cb_priv,
+          cpi->alloc_pyramid, 0)) {
+    unlock_buffer_pool(pool);
     aom_internal_error(cm->error, AOM_CODEC_MEM_ERROR,
                        "Failed to allocate frame buffer");
+  }
+  unlock_buffer_pool(pool);
 
   if (!is_stat_generation_stage(cpi)) av1_init_cdef_worker(cpi);
 
@@ -2781,7 +2953,9 @@ static void cdef_restoration_frame(AV1_COMP *cpi, AV1_COMMON *cm,
 #endif
     const int num_workers = cpi->mt_info.num_mod_workers[MOD_CDEF];
     // Find CDEF parameters
+    av1_start_stage_timing(cpi, AOM_ENC_STAGE_CDEF_PICK);
     av1_cdef_search(cpi);
+    av1_end_stage_timing(cpi, AOM_ENC_STAGE_CDEF_PICK);
 
     // Apply the filter
     if ((skip_apply_postproc_filters & SKIP_APPLY_CDEF) == 0) {
@@ -2793,9 +2967,10 @@ static void cdef_restoration_frame(AV1_COMP *cpi, AV1_COMMON *cm,
         av1_cdef_frame_mt(cm, xd, cpi->mt_info.cdef_worker,
                           cpi->mt_info.workers, &cpi->mt_info.cdef_sync,
                           num_workers, av1_cdef_init_fb_row_mt,
-                          do_extend_border);
+                          do_extend_border, /*row_output=*/NULL);
       } else {
-        av1_cdef_frame(&cm->cur_frame->buf, cm, xd, av1_cdef_init_fb_row);
+        av1_cdef_frame(&cm->cur_frame->buf, cm, xd, av1_cdef_init_fb_row,
+                       /*row_output=*/NULL);
       }
     }
 #if CONFIG_COLLECT_COMPONENT_TIMING
@@ -2818,7 +2993,9 @@ static void cdef_restoration_frame(AV1_COMP *cpi, AV1_COMMON *cm,
     MultiThreadInfo *const mt_info = &cpi->mt_info;
     const int num_workers = mt_info->num_mod_workers[MOD_LR];
     av1_loop_restoration_save_boundary_lines(&cm->cur_frame->buf, cm, 1);
+    av1_start_stage_timing(cpi, AOM_ENC_STAGE_LR_PICK);
     av1_pick_filter_restoration(cpi->source, cpi);
+    av1_end_stage_timing(cpi, AOM_ENC_STAGE_LR_PICK);
     if ((skip_apply_postproc_filters & SKIP_APPLY_RESTORATION) == 0 &&
         (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
          cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
@@ -2885,7 +3062,9 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   start_timing(cpi, loop_filter_time);
 #endif
   if (use_loopfilter) {
+    av1_start_stage_timing(cpi, AOM_ENC_STAGE_LOOP_FILTER_PICK);
     av1_pick_filter_level(cpi->source, cpi, cpi->sf.lpf_sf.lpf_pick);
+    av1_end_stage_timing(cpi, AOM_ENC_STAGE_LOOP_FILTER_PICK);
     struct loopfilter *lf = &cm->lf;
     if ((lf->filter_level[0] || lf->filter_level[1]) &&
         (skip_apply_postproc_filters & SKIP_APPLY_LOOPFILTER) == 0) {
@@ -2901,7 +3080,8 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
       int lpf_opt_level = get_lpf_opt_level(&cpi->sf);
       av1_loop_filter_frame_mt(&cm->cur_frame->buf, cm, xd, 0, num_planes, 0,
                                mt_info->workers, num_workers,
-                               &mt_info->lf_row_sync, lpf_opt_level);
+                               &mt_info->lf_row_sync, lpf_opt_level,
+                               /*row_output=*/NULL);
     }
   }
 
@@ -4733,7 +4913,7 @@ static int apply_denoise_2d(AV1_COMP *cpi, const YV12_BUFFER_CONFIG *sd,
 
 int av1_receive_raw_frame(AV1_COMP *cpi, aom_enc_frame_flags_t frame_flags,
                           const YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time) {
+                          int64_t end_time, void *frame_priv) {
   AV1_COMMON *const cm = &cpi->common;
   const SequenceHeader *const seq_params = cm->seq_params;
   int res = 0;
@@ -4821,7 +5001,8 @@ int av1_receive_raw_frame(AV1_COMP *cpi, aom_enc_frame_flags_t frame_flags,
 #endif  //  CONFIG_DENOISE
 
   if (av1_lookahead_push(cpi->ppi->lookahead, sd, time_stamp, end_time,
-                         use_highbitdepth, cpi->alloc_pyramid, frame_flags)) {
+                         use_highbitdepth, cpi->alloc_pyramid, frame_flags,
+                         frame_priv)) {
     aom_set_error(cm->error, AOM_CODEC_ERROR, "av1_lookahead_push() failed");
     res = -1;
   }
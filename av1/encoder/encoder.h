@@ -21,6 +21,7 @@
 #include "config/aom_config.h"
 
 #include "aom/aomcx.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_util/aom_pthread.h"
 
 #include "av1/common/alloccommon.h"
@@ -1087,6 +1088,9 @@ typedef struct AV1EncoderConfig {
   // Indicates if row-based multi-threading should be enabled or not.
   bool row_mt;
 
+  // Synchronization mode between the rows processed by different threads.
+  ROW_SYNC_MODE row_mt_sync_mode;
+
   // Indicates if frame parallel multi-threading should be enabled or not.
   bool fp_mt;
 
@@ -1413,6 +1417,11 @@ typedef struct {
   pthread_mutex_t *mutex_; /*!< Mutex lock object */
   pthread_cond_t *cond_;   /*!< Condition variable */
   /**@}*/
+  /*!
+   * num_waiters[i] stores the number of threads blocked on cond_[i]. Only used
+   * in ROW_SYNC_ATOMIC mode.
+   */
+  int *num_waiters;
 #endif  // CONFIG_MULTITHREAD
   /*!
    * Buffer to store the superblock whose encoding is complete.
@@ -1504,6 +1513,10 @@ typedef struct ThreadData {
   TplBuffers tpl_tmp_buffers;
   TplTxfmStats tpl_txfm_stats;
   GlobalMotionData gm_data;
+  // Pool the per-frame scratch buffers of this thread (tf_data,
+  // tpl_tmp_buffers, gm_data and the src_diff buffers of mb) are allocated
+  // from, so that they are recycled instead of going back to the heap.
+  AomMemPool scratch_pool;
   // Pointer to the array of structures to store gradient information of each
   // pixel in a superblock. The buffer constitutes of MAX_SB_SQUARE pixel level
   // structures for each of the plane types (PLANE_TYPE_Y and PLANE_TYPE_UV).
@@ -1735,6 +1748,18 @@ typedef struct PrimaryMultiThreadInfo {
    */
   AVxWorker *workers;
 
+  /*!
+   * Threads that run the jobs launched on workers[1..num_workers - 1]. Either
+   * owned by the encoder or equal to external_thread_pool.
+   */
+  AVxThreadPool *thread_pool;
+
+  /*!
+   * Pool attached by the application with AV1E_SET_THREAD_POOL, shared with
+   * other codec instances. NULL if the encoder creates its own pool.
+   */
+  AVxThreadPool *external_thread_pool;
+
   /*!
    * Data specific to each worker in encoder multi-threading.
    * tile_thr_data[i] stores the worker data of the ith thread.
@@ -1950,7 +1975,6 @@ typedef struct FramePartitionTimingStats {
 #endif  // CONFIG_COLLECT_PARTITION_STATS
 
 #if CONFIG_COLLECT_COMPONENT_TIMING
-#include "aom_ports/aom_timer.h"
 // Adjust the following to add new components.
 enum {
   av1_encode_strategy_time,
@@ -2899,6 +2923,13 @@ typedef struct AV1_PRIMARY {
    * tables or RC state.
    */
   int b_freeze_internal_state;
+
+  /*!
+   * Memory held by the lookahead, TPL, frame buffer pool and thread data
+   * allocations of the encoder, by AV1_MEM_TAG. Its limit is the memory
+   * budget set with AV1E_SET_MEMORY_BUDGET.
+   */
+  AomMemAccount mem_account;
 } AV1_PRIMARY;
 
 /*!
@@ -3717,6 +3748,17 @@ typedef struct AV1_COMP {
    */
   int palette_pixel_num;
 
+  /*!
+   * Time spent in each stage of the encoder, indexed by aom_enc_stage_t, in
+   * microseconds. Reset at the beginning of each call to aom_codec_encode().
+   */
+  int64_t stage_time[AOM_ENC_STAGE_COUNT];
+  /*!
+   * Timers of the stages between calls of av1_start_stage_timing() and
+   * av1_end_stage_timing().
+   */
+  struct aom_usec_timer stage_timer[AOM_ENC_STAGE_COUNT];
+
   /*!
    * Flag to indicate scaled_last_source is available,
    * so scaling is not needed for last_source.
@@ -3826,6 +3868,24 @@ void av1_remove_compressor(AV1_COMP *cpi);
 
 void av1_remove_primary_compressor(AV1_PRIMARY *ppi);
 
+void av1_get_scratch_mem_stats(const AV1_PRIMARY *ppi,
+                               aom_scratch_mem_stats_t *stats);
+
+void av1_get_memory_usage(const AV1_PRIMARY *ppi, aom_memory_usage_t *usage);
+
+// Sums the stage times of the frames coded since the last call to
+// av1_reset_frame_stage_times().
+void av1_get_frame_stage_times(const AV1_PRIMARY *ppi,
+                               aom_frame_stage_times_t *times);
+
+void av1_reset_frame_stage_times(AV1_PRIMARY *ppi);
+
+// Returns an upper bound of the memory reported by av1_get_memory_usage() for
+// an encoder with configuration 'oxcf', plus the image pyramids of its frame
+// buffers, which are allocated outside of the memory account.
+uint64_t av1_estimate_memory_usage(const AV1EncoderConfig *oxcf,
+                                   int num_lap_buffers);
+
 #if CONFIG_ENTROPY_STATS
 void print_entropy_stats(AV1_PRIMARY *const ppi);
 #endif
@@ -3871,15 +3931,17 @@ int av1_init_parallel_frame_context(const AV1_COMP_DATA *const first_cpi_data,
  * \param[in,out] sd             Contain raw frame data
  * \param[in]     time_stamp     Time stamp of the frame
  * \param[in]     end_time_stamp End time stamp
+ * \param[in]     frame_priv     Identifies the frame to the release callback
+ *                               of the lookahead in zero-copy mode
  *
  * \return Returns a value to indicate if the frame data is received
  * successfully.
  * \note The caller can assume that a copy of this frame is made and not just a
- * copy of the pointer.
+ * copy of the pointer, unless the lookahead is in zero-copy mode.
  */
 int av1_receive_raw_frame(AV1_COMP *cpi, aom_enc_frame_flags_t frame_flags,
                           const YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time_stamp);
+                          int64_t end_time_stamp, void *frame_priv);
 
 /*!\brief Encode a frame
  *
@@ -3982,6 +4044,16 @@ void av1_update_frame_size(AV1_COMP *cpi);
 
 void av1_set_svc_seq_params(AV1_PRIMARY *const ppi);
 
+// Returns the scratch pool of 'td', tagged with the frame size of 'cpi' so that
+// the buffers sized for an earlier frame size are dropped after a resize.
+static inline AomMemPool *av1_get_scratch_pool(const AV1_COMP *cpi,
+                                               ThreadData *td) {
+  const AV1_COMMON *const cm = &cpi->common;
+  aom_mem_pool_set_tag(&td->scratch_pool,
+                       ((uint32_t)cm->width << 16) ^ (uint32_t)cm->height);
+  return &td->scratch_pool;
+}
+
 typedef struct {
   int pyr_level;
   int disp_order;
@@ -4622,6 +4694,22 @@ static inline int av1_get_bsize_idx_for_part_stats(BLOCK_SIZE bsize) {
 }
 #endif  // CONFIG_COLLECT_PARTITION_STATS
 
+// Adds the time elapsed since 'timer' was started to '*time'.
+static inline void av1_accumulate_stage_time(struct aom_usec_timer *timer,
+                                             int64_t *time) {
+  aom_usec_timer_mark(timer);
+  *time += aom_usec_timer_elapsed(timer);
+}
+
+static inline void av1_start_stage_timing(AV1_COMP *cpi,
+                                          aom_enc_stage_t stage) {
+  aom_usec_timer_start(&cpi->stage_timer[stage]);
+}
+
+static inline void av1_end_stage_timing(AV1_COMP *cpi, aom_enc_stage_t stage) {
+  av1_accumulate_stage_time(&cpi->stage_timer[stage], &cpi->stage_time[stage]);
+}
+
 #if CONFIG_COLLECT_COMPONENT_TIMING
 static inline void start_timing(AV1_COMP *cpi, int component) {
   aom_usec_timer_start(&cpi->component_timer[component]);
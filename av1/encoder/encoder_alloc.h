@@ -296,6 +296,9 @@ static inline void dealloc_compressor_data(AV1_COMP *cpi) {
 
   av1_dealloc_mb_data(&cpi->td.mb, num_planes);
 
+  // All the scratch buffers have been returned by now.
+  aom_mem_pool_trim(&cpi->td.scratch_pool);
+
   av1_dealloc_mb_wiener_var_pred_buf(&cpi->td);
 
   av1_free_txb_buf(cpi);
@@ -523,6 +526,7 @@ static inline void free_thread_data(AV1_PRIMARY *ppi) {
     av1_free_pc_tree_recursive(td->pc_root, num_planes, 0, 0, SEARCH_PARTITION);
     td->pc_root = NULL;
     av1_dealloc_mb_wiener_var_pred_buf(td);
+    aom_mem_pool_trim(&td->scratch_pool);
     aom_free(td);
     thread_data->td = NULL;
     thread_data->original_td = NULL;
@@ -896,19 +896,23 @@ void av1_scale_references(AV1_COMP *cpi, const InterpFilter filter,
 
         if (force_scaling || new_fb->buf.y_crop_width != cm->width ||
             new_fb->buf.y_crop_height != cm->height) {
+          lock_buffer_pool(pool);
           if (aom_realloc_frame_buffer(
                   &new_fb->buf, cm->width, cm->height,
                   cm->seq_params->subsampling_x, cm->seq_params->subsampling_y,
                   cm->seq_params->use_highbitdepth, AOM_BORDER_IN_PIXELS,
-                  cm->features.byte_alignment, NULL, NULL, NULL, false, 0)) {
+                  cm->features.byte_alignment, &new_fb->raw_frame_buffer,
+                  pool->get_fb_cb, pool->cb_priv, false, 0)) {
             if (force_scaling) {
               // Release the reference acquired in the get_free_fb() call
               // above.
               --new_fb->ref_count;
             }
+            unlock_buffer_pool(pool);
             aom_internal_error(cm->error, AOM_CODEC_MEM_ERROR,
                                "Failed to allocate frame buffer");
           }
+          unlock_buffer_pool(pool);
           bool has_optimized_scaler = av1_has_optimized_scaler(
               ref->y_crop_width, ref->y_crop_height, new_fb->buf.y_crop_width,
               new_fb->buf.y_crop_height);
@@ -514,6 +514,9 @@ MAKE_OBFP_SAD_WRAPPER(aom_highbd_obmc_sad64x16)
 static inline void highbd_set_var_fns(AV1_PRIMARY *const ppi) {
   SequenceHeader *const seq_params = &ppi->seq_params;
   if (seq_params->use_highbitdepth) {
+    // There are no high bitdepth sadx8 kernels. Motion search falls back to
+    // sdx4df instead.
+    for (int i = 0; i < BLOCK_SIZES_ALL; ++i) ppi->fn_ptr[i].sdx8df = NULL;
     switch (seq_params->bit_depth) {
       case AOM_BITS_8:
 #if !CONFIG_REALTIME_ONLY
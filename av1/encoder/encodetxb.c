@@ -378,20 +378,34 @@ void av1_write_coeffs_txb(const AV1_COMMON *const cm, MACROBLOCK *const x,
   av1_get_nz_map_contexts(levels, scan, eob, tx_size, tx_class, coeff_contexts);
 
   const int bhl = get_txb_bhl(tx_size);
+  // The base and range symbols of the coefficients are collected with their
+  // CDFs and written in runs. Each coefficient adds at most
+  // 1 + COEFF_BASE_RANGE / (BR_CDF_SIZE - 1) symbols.
+  enum { kMaxCoeffSymbols = 1 + COEFF_BASE_RANGE / (BR_CDF_SIZE - 1) };
+  enum { kSymbolRunSize = 64 };
+  uint8_t symbs[kSymbolRunSize];
+  aom_cdf_prob *cdfs[kSymbolRunSize];
+  uint8_t nsymbs[kSymbolRunSize];
+  int num_symbs = 0;
   for (int c = eob - 1; c >= 0; --c) {
     const int pos = scan[c];
     const int coeff_ctx = coeff_contexts[pos];
     const tran_low_t v = tcoeff[pos];
     const tran_low_t level = abs(v);
 
+    if (num_symbs > kSymbolRunSize - kMaxCoeffSymbols) {
+      aom_write_symbols(w, symbs, cdfs, nsymbs, num_symbs);
+      num_symbs = 0;
+    }
     if (c == eob - 1) {
-      aom_write_symbol(
-          w, AOMMIN(level, 3) - 1,
-          ec_ctx->coeff_base_eob_cdf[txs_ctx][plane_type][coeff_ctx], 3);
+      symbs[num_symbs] = AOMMIN(level, 3) - 1;
+      cdfs[num_symbs] =
+          ec_ctx->coeff_base_eob_cdf[txs_ctx][plane_type][coeff_ctx];
+      nsymbs[num_symbs++] = 3;
     } else {
-      aom_write_symbol(w, AOMMIN(level, 3),
-                       ec_ctx->coeff_base_cdf[txs_ctx][plane_type][coeff_ctx],
-                       4);
+      symbs[num_symbs] = AOMMIN(level, 3);
+      cdfs[num_symbs] = ec_ctx->coeff_base_cdf[txs_ctx][plane_type][coeff_ctx];
+      nsymbs[num_symbs++] = 4;
     }
     if (level > NUM_BASE_LEVELS) {
       // level is above 1.
@@ -401,11 +415,14 @@ void av1_write_coeffs_txb(const AV1_COMMON *const cm, MACROBLOCK *const x,
           ec_ctx->coeff_br_cdf[AOMMIN(txs_ctx, TX_32X32)][plane_type][br_ctx];
       for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
         const int k = AOMMIN(base_range - idx, BR_CDF_SIZE - 1);
-        aom_write_symbol(w, k, cdf, BR_CDF_SIZE);
+        symbs[num_symbs] = k;
+        cdfs[num_symbs] = cdf;
+        nsymbs[num_symbs++] = BR_CDF_SIZE;
         if (k < BR_CDF_SIZE - 1) break;
       }
     }
   }
+  aom_write_symbols(w, symbs, cdfs, nsymbs, num_symbs);
 
   // Loop to code all signs in the transform block,
   // starting with the sign of DC (if applicable)
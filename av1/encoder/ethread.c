@@ -174,6 +174,45 @@ void av1_row_mt_sync_write(AV1EncRowMultiThreadSync *row_mt_sync, int r, int c,
 #endif  // CONFIG_MULTITHREAD
 }
 
+void av1_row_mt_sync_read_atomic(AV1EncRowMultiThreadSync *row_mt_sync, int r,
+                                 int c) {
+#if CONFIG_MULTITHREAD
+  if (r) {
+    av1_row_sync_wait(&row_mt_sync->mutex_[r - 1], &row_mt_sync->cond_[r - 1],
+                      &row_mt_sync->num_waiters[r - 1],
+                      &row_mt_sync->num_finished_cols[r - 1],
+                      c + row_mt_sync->sync_range +
+                          row_mt_sync->intrabc_extra_top_right_sb_delay);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_row_mt_sync_write_atomic(AV1EncRowMultiThreadSync *row_mt_sync, int r,
+                                  int c, int cols) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_mt_sync->sync_range;
+
+  // Publish progress at the same granularity as av1_row_mt_sync_write().
+  if (c < cols - 1 && c % nsync) return;
+  const int cur =
+      c < cols - 1
+          ? c
+          : cols + nsync + row_mt_sync->intrabc_extra_top_right_sb_delay;
+  av1_row_sync_update(&row_mt_sync->mutex_[r], &row_mt_sync->cond_[r],
+                      &row_mt_sync->num_waiters[r],
+                      &row_mt_sync->num_finished_cols[r], cur);
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+  (void)cols;
+#endif  // CONFIG_MULTITHREAD
+}
+
 // Allocate memory for row synchronization
 static void row_mt_sync_mem_alloc(AV1EncRowMultiThreadSync *row_mt_sync,
                                   AV1_COMMON *cm, int rows) {
@@ -195,6 +234,9 @@ static void row_mt_sync_mem_alloc(AV1EncRowMultiThreadSync *row_mt_sync,
       pthread_cond_init(&row_mt_sync->cond_[i], NULL);
     }
   }
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->num_waiters,
+                  aom_calloc(rows, sizeof(*row_mt_sync->num_waiters)));
 #endif  // CONFIG_MULTITHREAD
 
   CHECK_MEM_ERROR(cm, row_mt_sync->num_finished_cols,
@@ -223,6 +265,7 @@ void av1_row_mt_sync_mem_dealloc(AV1EncRowMultiThreadSync *row_mt_sync) {
       }
       aom_free(row_mt_sync->cond_);
     }
+    aom_free(row_mt_sync->num_waiters);
 #endif  // CONFIG_MULTITHREAD
     aom_free(row_mt_sync->num_finished_cols);
 
@@ -904,6 +947,7 @@ void av1_init_mt_sync(AV1_COMP *cpi, int is_first_pass) {
       av1_loop_filter_dealloc(lf_sync);
       av1_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width, num_lf_workers);
     }
+    lf_sync->sync_mode = cpi->oxcf.row_mt_sync_mode;
 
     // Initialize tpl MT object.
     AV1TplRowMultiThreadInfo *tpl_row_mt = &mt_info->tpl_row_mt;
@@ -968,22 +1012,28 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
   int num_workers = p_mt_info->num_workers;
   int num_enc_workers = av1_get_num_mod_workers_for_alloc(p_mt_info, MOD_ENC);
   assert(num_enc_workers <= num_workers);
+  // The largest per-thread buffers are accounted to AV1_MEM_THREAD_DATA.
+  AomMemAccount *const mem_account = &ppi->mem_account;
   for (int i = num_workers - 1; i >= 0; i--) {
     EncWorkerData *const thread_data = &p_mt_info->tile_thr_data[i];
 
     if (i > 0) {
       // Allocate thread data.
       ThreadData *td;
-      AOM_CHECK_MEM_ERROR(&ppi->error, td, aom_memalign(32, sizeof(*td)));
+      AOM_CHECK_MEM_ERROR(&ppi->error, td,
+                          aom_memalign_tagged(mem_account, AV1_MEM_THREAD_DATA,
+                                              32, sizeof(*td)));
       av1_zero(*td);
       thread_data->original_td = thread_data->td = td;
 
       // Set up shared coeff buffers.
       av1_setup_shared_coeff_buffer(&ppi->seq_params, &td->shared_coeff_buf,
                                     &ppi->error);
-      AOM_CHECK_MEM_ERROR(&ppi->error, td->tmp_conv_dst,
-                          aom_memalign(32, MAX_SB_SIZE * MAX_SB_SIZE *
-                                               sizeof(*td->tmp_conv_dst)));
+      AOM_CHECK_MEM_ERROR(
+          &ppi->error, td->tmp_conv_dst,
+          aom_memalign_tagged(
+              mem_account, AV1_MEM_THREAD_DATA, 32,
+              MAX_SB_SIZE * MAX_SB_SIZE * sizeof(*td->tmp_conv_dst)));
 
       if (i < p_mt_info->num_mod_workers[MOD_FP]) {
         // Set up firstpass PICK_MODE_CONTEXT.
@@ -996,8 +1046,10 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
 
       AOM_CHECK_MEM_ERROR(
           &ppi->error, td->upsample_pred,
-          aom_memalign(16, (1 + is_highbitdepth) * ((MAX_SB_SIZE + 16) + 16) *
-                               MAX_SB_SIZE * sizeof(*td->upsample_pred)));
+          aom_memalign_tagged(mem_account, AV1_MEM_THREAD_DATA, 16,
+                              (1 + is_highbitdepth) *
+                                  ((MAX_SB_SIZE + 16) + 16) * MAX_SB_SIZE *
+                                  sizeof(*td->upsample_pred)));
 
       if (!is_first_pass && i < num_enc_workers) {
         // Set up sms_tree.
@@ -1009,17 +1061,22 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
         for (int x = 0; x < 2; x++) {
           AOM_CHECK_MEM_ERROR(
               &ppi->error, td->hash_value_buffer[x],
-              (uint32_t *)aom_malloc(AOM_BUFFER_SIZE_FOR_BLOCK_HASH *
-                                     sizeof(*td->hash_value_buffer[x])));
+              (uint32_t *)aom_malloc_tagged(
+                  mem_account, AV1_MEM_THREAD_DATA,
+                  AOM_BUFFER_SIZE_FOR_BLOCK_HASH *
+                      sizeof(*td->hash_value_buffer[x])));
         }
 
         // Allocate frame counters in thread data.
         AOM_CHECK_MEM_ERROR(&ppi->error, td->counts,
-                            aom_calloc(1, sizeof(*td->counts)));
+                            aom_calloc_tagged(mem_account, AV1_MEM_THREAD_DATA,
+                                              1, sizeof(*td->counts)));
 
         // Allocate buffers used by palette coding mode.
-        AOM_CHECK_MEM_ERROR(&ppi->error, td->palette_buffer,
-                            aom_memalign(16, sizeof(*td->palette_buffer)));
+        AOM_CHECK_MEM_ERROR(
+            &ppi->error, td->palette_buffer,
+            aom_memalign_tagged(mem_account, AV1_MEM_THREAD_DATA, 16,
+                                sizeof(*td->palette_buffer)));
 
         // The buffers 'tmp_pred_bufs[]', 'comp_rd_buffer' and 'obmc_buffer' are
         // used in inter frames to store intermediate inter mode prediction
@@ -1034,8 +1091,9 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
           for (int j = 0; j < 2; ++j) {
             AOM_CHECK_MEM_ERROR(
                 &ppi->error, td->tmp_pred_bufs[j],
-                aom_memalign(32, 2 * MAX_MB_PLANE * MAX_SB_SQUARE *
-                                     sizeof(*td->tmp_pred_bufs[j])));
+                aom_memalign_tagged(mem_account, AV1_MEM_THREAD_DATA, 32,
+                                    2 * MAX_MB_PLANE * MAX_SB_SQUARE *
+                                        sizeof(*td->tmp_pred_bufs[j])));
           }
         }
 
@@ -1070,14 +1128,18 @@ void av1_init_tile_thread_data(AV1_PRIMARY *ppi, int is_first_pass) {
     if (!is_first_pass && ppi->cpi->oxcf.row_mt == 1 && i < num_enc_workers) {
       if (i == 0) {
         for (int j = 0; j < ppi->num_fp_contexts; j++) {
-          AOM_CHECK_MEM_ERROR(&ppi->error, ppi->parallel_cpi[j]->td.tctx,
-                              (FRAME_CONTEXT *)aom_memalign(
-                                  16, sizeof(*ppi->parallel_cpi[j]->td.tctx)));
+          AOM_CHECK_MEM_ERROR(
+              &ppi->error, ppi->parallel_cpi[j]->td.tctx,
+              (FRAME_CONTEXT *)aom_memalign_tagged(
+                  mem_account, AV1_MEM_THREAD_DATA, 16,
+                  sizeof(*ppi->parallel_cpi[j]->td.tctx)));
         }
       } else {
         AOM_CHECK_MEM_ERROR(
             &ppi->error, thread_data->td->tctx,
-            (FRAME_CONTEXT *)aom_memalign(16, sizeof(*thread_data->td->tctx)));
+            (FRAME_CONTEXT *)aom_memalign_tagged(
+                mem_account, AV1_MEM_THREAD_DATA, 16,
+                sizeof(*thread_data->td->tctx)));
       }
     }
   }
@@ -1099,12 +1161,27 @@ void av1_create_workers(AV1_PRIMARY *ppi, int num_workers) {
       &ppi->error, p_mt_info->tile_thr_data,
       aom_calloc(num_workers, sizeof(*p_mt_info->tile_thr_data)));
 
+  // The main thread runs workers[0] itself, so the pool needs one thread less
+  // than the number of workers.
+  assert(p_mt_info->thread_pool == NULL);
+  if (p_mt_info->external_thread_pool != NULL) {
+    p_mt_info->thread_pool = p_mt_info->external_thread_pool;
+  } else if (num_workers > 1) {
+    p_mt_info->thread_pool = aom_thread_pool_create(num_workers - 1);
+#if CONFIG_MULTITHREAD
+    if (p_mt_info->thread_pool == NULL)
+      aom_internal_error(&ppi->error, AOM_CODEC_ERROR,
+                         "Encoder thread pool creation failed");
+#endif
+  }
+
   for (int i = 0; i < num_workers; ++i) {
     AVxWorker *const worker = &p_mt_info->workers[i];
     EncWorkerData *const thread_data = &p_mt_info->tile_thr_data[i];
 
     winterface->init(worker);
     worker->thread_name = "aom enc worker";
+    if (i > 0) worker->pool = p_mt_info->thread_pool;
 
     thread_data->thread_id = i;
     // Set the starting tile for each thread.
@@ -1133,6 +1210,10 @@ void av1_terminate_workers(AV1_PRIMARY *ppi) {
     AVxWorker *const worker = &p_mt_info->workers[t];
     aom_get_worker_interface()->end(worker);
   }
+  if (p_mt_info->thread_pool != p_mt_info->external_thread_pool) {
+    aom_thread_pool_destroy(p_mt_info->thread_pool);
+  }
+  p_mt_info->thread_pool = NULL;
 }
 
 // This function returns 1 if frame parallel encode is supported for
@@ -1557,6 +1638,8 @@ static inline void accumulate_counters_enc_workers(AV1_COMP *cpi,
       accumulate_rd_opt(&cpi->td, thread_data->td);
       cpi->td.mb.txfm_search_info.txb_split_count +=
           thread_data->td->mb.txfm_search_info.txb_split_count;
+      cpi->td.mb.motion_search_time += thread_data->td->mb.motion_search_time;
+      cpi->td.mb.rd_search_time += thread_data->td->mb.rd_search_time;
 #if CONFIG_SPEED_STATS
       cpi->td.mb.txfm_search_info.tx_search_count +=
           thread_data->td->mb.txfm_search_info.tx_search_count;
@@ -1640,7 +1723,8 @@ static inline void prepare_enc_workers(AV1_COMP *cpi, AVxWorkerHook hook,
         }
       }
     }
-    av1_alloc_mb_data(cpi, &thread_data->td->mb);
+    av1_alloc_mb_data(cpi, &thread_data->td->mb,
+                      av1_get_scratch_pool(cpi, thread_data->td));
 
     // Reset rtc counters.
     av1_init_rtc_counters(&thread_data->td->mb);
@@ -1702,7 +1786,8 @@ static inline void fp_prepare_enc_workers(AV1_COMP *cpi, AVxWorkerHook hook,
       // Before encoding a frame, copy the thread data from cpi.
       thread_data->td->mb = cpi->td.mb;
     }
-    av1_alloc_src_diff_buf(cm, &thread_data->td->mb);
+    av1_alloc_src_diff_buf(cm, &thread_data->td->mb,
+                           av1_get_scratch_pool(cpi, thread_data->td));
   }
 }
 #endif
@@ -1897,7 +1982,9 @@ static void lpf_pipeline_mt_init(AV1_COMP *cpi, int num_workers) {
   assert(method == LPF_PICK_FROM_Q);
   assert(cpi->oxcf.algo_cfg.loopfilter_control != LOOPFILTER_SELECTIVELY);
 
+  av1_start_stage_timing(cpi, AOM_ENC_STAGE_LOOP_FILTER_PICK);
   av1_pick_filter_level(cpi->source, cpi, method);
+  av1_end_stage_timing(cpi, AOM_ENC_STAGE_LOOP_FILTER_PICK);
 
   struct loopfilter *lf = &cm->lf;
   const int plane_start = 0;
@@ -2116,6 +2203,41 @@ void av1_tpl_row_mt_sync_read(AV1TplRowMultiThreadSync *tpl_row_mt_sync, int r,
 #endif  // CONFIG_MULTITHREAD
 }
 
+void av1_tpl_row_mt_sync_read_atomic(AV1TplRowMultiThreadSync *tpl_mt_sync,
+                                     int r, int c) {
+#if CONFIG_MULTITHREAD
+  if (r) {
+    av1_row_sync_wait(&tpl_mt_sync->mutex_[r - 1], &tpl_mt_sync->cond_[r - 1],
+                      &tpl_mt_sync->num_waiters[r - 1],
+                      &tpl_mt_sync->num_finished_cols[r - 1],
+                      c + tpl_mt_sync->sync_range);
+  }
+#else
+  (void)tpl_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void av1_tpl_row_mt_sync_write_atomic(AV1TplRowMultiThreadSync *tpl_mt_sync,
+                                      int r, int c, int cols) {
+#if CONFIG_MULTITHREAD
+  const int nsync = tpl_mt_sync->sync_range;
+
+  // Publish progress at the same granularity as av1_tpl_row_mt_sync_write().
+  if (c < cols - 1 && c % nsync) return;
+  av1_row_sync_update(&tpl_mt_sync->mutex_[r], &tpl_mt_sync->cond_[r],
+                      &tpl_mt_sync->num_waiters[r],
+                      &tpl_mt_sync->num_finished_cols[r],
+                      c < cols - 1 ? c : cols + nsync);
+#else
+  (void)tpl_mt_sync;
+  (void)r;
+  (void)c;
+  (void)cols;
+#endif  // CONFIG_MULTITHREAD
+}
+
 void av1_tpl_row_mt_sync_write(AV1TplRowMultiThreadSync *tpl_row_mt_sync, int r,
                                int c, int cols) {
 #if CONFIG_MULTITHREAD
@@ -2246,6 +2368,7 @@ void av1_tpl_dealloc(AV1TplRowMultiThreadSync *tpl_sync) {
       pthread_cond_destroy(&tpl_sync->cond_[i]);
     aom_free(tpl_sync->cond_);
   }
+  aom_free(tpl_sync->num_waiters);
 #endif  // CONFIG_MULTITHREAD
 
   aom_free(tpl_sync->num_finished_cols);
@@ -2273,6 +2396,9 @@ static void av1_tpl_alloc(AV1TplRowMultiThreadSync *tpl_sync, AV1_COMMON *cm,
       for (int i = 0; i < mb_rows; ++i)
         pthread_cond_init(&tpl_sync->cond_[i], NULL);
     }
+
+    CHECK_MEM_ERROR(cm, tpl_sync->num_waiters,
+                    aom_calloc(mb_rows, sizeof(*tpl_sync->num_waiters)));
   }
 #endif  // CONFIG_MULTITHREAD
   CHECK_MEM_ERROR(cm, tpl_sync->num_finished_cols,
@@ -2313,6 +2439,7 @@ static inline void prepare_tpl_workers(AV1_COMP *cpi, AVxWorkerHook hook,
       // called from tpl, hence set the buffers to defaults.
       av1_init_obmc_buffer(&thread_data->td->mb.obmc_buffer);
       if (!tpl_alloc_temp_buffers(&thread_data->td->tpl_tmp_buffers,
+                                  av1_get_scratch_pool(cpi, thread_data->td),
                                   cpi->ppi->tpl_data.tpl_bsize_1d)) {
         aom_internal_error(cpi->common.error, AOM_CODEC_MEM_ERROR,
                            "Error allocating tpl data");
@@ -2494,6 +2621,7 @@ static void prepare_tf_workers(AV1_COMP *cpi, AVxWorkerHook hook,
       // called from tf, hence set the buffers to defaults.
       av1_init_obmc_buffer(&thread_data->td->mb.obmc_buffer);
       if (!tf_alloc_and_reset_data(&thread_data->td->tf_data,
+                                   av1_get_scratch_pool(cpi, thread_data->td),
                                    cpi->tf_ctx.num_pels, is_highbitdepth)) {
         aom_internal_error(cpi->common.error, AOM_CODEC_MEM_ERROR,
                            "Error allocating temporal filter data");
@@ -2682,7 +2810,8 @@ static inline void prepare_gm_workers(AV1_COMP *cpi, AVxWorkerHook hook,
     }
 
     if (thread_data->td != &cpi->td)
-      gm_alloc_data(cpi, &thread_data->td->gm_data);
+      gm_alloc_data(cpi, &thread_data->td->gm_data,
+                    av1_get_scratch_pool(cpi, thread_data->td));
   }
 }
 
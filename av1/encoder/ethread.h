@@ -39,6 +39,13 @@ void av1_row_mt_sync_read_dummy(AV1EncRowMultiThreadSync *row_mt_sync, int r,
 void av1_row_mt_sync_write_dummy(AV1EncRowMultiThreadSync *row_mt_sync, int r,
                                  int c, int cols);
 
+// Variants of av1_row_mt_sync_read()/av1_row_mt_sync_write() used in
+// ROW_SYNC_ATOMIC mode.
+void av1_row_mt_sync_read_atomic(AV1EncRowMultiThreadSync *row_mt_sync, int r,
+                                 int c);
+void av1_row_mt_sync_write_atomic(AV1EncRowMultiThreadSync *row_mt_sync, int r,
+                                  int c, int cols);
+
 void av1_encode_tiles_mt(struct AV1_COMP *cpi);
 void av1_encode_tiles_row_mt(struct AV1_COMP *cpi);
 
@@ -67,6 +74,10 @@ void av1_tpl_row_mt_sync_read(AV1TplRowMultiThreadSync *tpl_mt_sync, int r,
                               int c);
 void av1_tpl_row_mt_sync_write(AV1TplRowMultiThreadSync *tpl_mt_sync, int r,
                                int c, int cols);
+void av1_tpl_row_mt_sync_read_atomic(AV1TplRowMultiThreadSync *tpl_mt_sync,
+                                     int r, int c);
+void av1_tpl_row_mt_sync_write_atomic(AV1TplRowMultiThreadSync *tpl_mt_sync,
+                                      int r, int c, int cols);
 
 void av1_mc_flow_dispenser_mt(AV1_COMP *cpi);
 
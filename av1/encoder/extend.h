@@ -19,6 +19,8 @@
 extern "C" {
 #endif
 
+// Copies src into dst and extends the borders of dst. If src and dst are
+// the same frame, only extends its borders.
 void av1_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
@@ -1149,7 +1149,8 @@ static void first_pass_tiles(AV1_COMP *cpi, const BLOCK_SIZE fp_block_size) {
   const int tile_cols = cm->tiles.cols;
   const int tile_rows = cm->tiles.rows;
 
-  av1_alloc_src_diff_buf(cm, &cpi->td.mb);
+  av1_alloc_src_diff_buf(cm, &cpi->td.mb,
+                         av1_get_scratch_pool(cpi, &cpi->td));
   for (int tile_row = 0; tile_row < tile_rows; ++tile_row) {
     for (int tile_col = 0; tile_col < tile_cols; ++tile_col) {
       TileDataEnc *const tile_data =
@@ -1454,8 +1455,11 @@ void av1_first_pass(AV1_COMP *cpi, const int64_t ts_duration) {
   enc_row_mt->sync_write_ptr = av1_row_mt_sync_write_dummy;
 
   if (mt_info->num_workers > 1) {
-    enc_row_mt->sync_read_ptr = av1_row_mt_sync_read;
-    enc_row_mt->sync_write_ptr = av1_row_mt_sync_write;
+    const int atomic_sync = cpi->oxcf.row_mt_sync_mode == ROW_SYNC_ATOMIC;
+    enc_row_mt->sync_read_ptr =
+        atomic_sync ? av1_row_mt_sync_read_atomic : av1_row_mt_sync_read;
+    enc_row_mt->sync_write_ptr =
+        atomic_sync ? av1_row_mt_sync_write_atomic : av1_row_mt_sync_write;
     av1_fp_encode_tiles_row_mt(cpi);
   } else {
     first_pass_tiles(cpi, fp_block_size);
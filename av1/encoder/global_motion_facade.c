@@ -425,7 +425,8 @@ void av1_compute_global_motion_facade(AV1_COMP *cpi) {
     setup_global_motion_info_params(cpi);
     // Terminate early if the total number of reference frames is zero.
     if (cpi->gm_info.num_ref_frames[0] || cpi->gm_info.num_ref_frames[1]) {
-      gm_alloc_data(cpi, &cpi->td.gm_data);
+      gm_alloc_data(cpi, &cpi->td.gm_data,
+                    av1_get_scratch_pool(cpi, &cpi->td));
       if (cpi->mt_info.num_workers > 1)
         av1_global_motion_estimation_mt(cpi);
       else
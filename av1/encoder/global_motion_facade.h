@@ -19,28 +19,33 @@ struct yv12_buffer_config;
 struct AV1_COMP;
 
 // Allocates memory for members of GlobalMotionData.
-static inline void gm_alloc_data(AV1_COMP *cpi, GlobalMotionData *gm_data) {
+static inline void gm_alloc_data(AV1_COMP *cpi, GlobalMotionData *gm_data,
+                                 AomMemPool *pool) {
   AV1_COMMON *cm = &cpi->common;
   GlobalMotionInfo *gm_info = &cpi->gm_info;
 
-  CHECK_MEM_ERROR(cm, gm_data->segment_map,
-                  aom_malloc(sizeof(*gm_data->segment_map) *
+  CHECK_MEM_ERROR(
+      cm, gm_data->segment_map,
+      aom_mem_pool_alloc(pool, 16,
+                         sizeof(*gm_data->segment_map) *
                              gm_info->segment_map_w * gm_info->segment_map_h));
 
   av1_zero_array(gm_data->motion_models, RANSAC_NUM_MOTIONS);
   for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
     CHECK_MEM_ERROR(cm, gm_data->motion_models[m].inliers,
-                    aom_malloc(sizeof(*gm_data->motion_models[m].inliers) * 2 *
-                               MAX_CORNERS));
+                    aom_mem_pool_alloc(
+                        pool, 16,
+                        sizeof(*gm_data->motion_models[m].inliers) * 2 *
+                            MAX_CORNERS));
   }
 }
 
 // Deallocates the memory allocated for members of GlobalMotionData.
 static inline void gm_dealloc_data(GlobalMotionData *gm_data) {
-  aom_free(gm_data->segment_map);
+  aom_mem_pool_free(gm_data->segment_map);
   gm_data->segment_map = NULL;
   for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
-    aom_free(gm_data->motion_models[m].inliers);
+    aom_mem_pool_free(gm_data->motion_models[m].inliers);
     gm_data->motion_models[m].inliers = NULL;
   }
 }
@@ -13,6 +13,8 @@
 
 #include "config/aom_config.h"
 
+#include "aom_dsp/flow_estimation/corner_detect.h"
+#include "aom_dsp/pyramid.h"
 #include "aom_scale/yv12config.h"
 #include "av1/common/common.h"
 #include "av1/encoder/encoder.h"
@@ -30,12 +32,24 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx, int *idx) {
   return buf;
 }
 
+/* Hands the application frame referenced by the entry back, if any */
+static void release_external_frame(struct lookahead_ctx *ctx,
+                                   struct lookahead_entry *buf) {
+  if (!buf->is_external) return;
+  ctx->release_cb(ctx->release_cb_priv, buf->frame_priv);
+  buf->is_external = false;
+  buf->frame_priv = NULL;
+}
+
 void av1_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
     if (ctx->buf) {
       int i;
 
-      for (i = 0; i < ctx->max_sz; i++) aom_free_frame_buffer(&ctx->buf[i].img);
+      for (i = 0; i < ctx->max_sz; i++) {
+        release_external_frame(ctx, &ctx->buf[i]);
+        aom_free_frame_buffer(&ctx->buf[i].img);
+      }
       free(ctx->buf);
     }
     free(ctx);
@@ -45,7 +59,9 @@ void av1_lookahead_destroy(struct lookahead_ctx *ctx) {
 struct lookahead_ctx *av1_lookahead_init(
     int width, int height, int subsampling_x, int subsampling_y,
     int use_highbitdepth, int depth, int border_in_pixels, int byte_alignment,
-    int num_lap_buffers, bool is_all_intra, bool alloc_pyramid) {
+    int num_lap_buffers, bool is_all_intra, bool alloc_pyramid,
+    struct AomMemAccount *mem_account, av1_lookahead_release_fn_t release_cb,
+    void *release_cb_priv) {
   int lag_in_frames = AOMMAX(1, depth);
 
   // For all-intra frame encoding, previous source frames are not required.
@@ -68,6 +84,9 @@ struct lookahead_ctx *av1_lookahead_init(
     ctx->max_sz = depth;
     ctx->push_frame_count = 0;
     ctx->max_pre_frames = max_pre_frames;
+    ctx->border_in_pixels = border_in_pixels;
+    ctx->release_cb = release_cb;
+    ctx->release_cb_priv = release_cb_priv;
     ctx->read_ctxs[ENCODE_STAGE].pop_sz = ctx->max_sz - ctx->max_pre_frames;
     ctx->read_ctxs[ENCODE_STAGE].valid = 1;
     if (num_lap_buffers) {
@@ -77,6 +96,10 @@ struct lookahead_ctx *av1_lookahead_init(
     ctx->buf = calloc(depth, sizeof(*ctx->buf));
     if (!ctx->buf) goto fail;
     for (int i = 0; i < depth; i++) {
+      ctx->buf[i].img.mem_account = mem_account;
+      ctx->buf[i].img.mem_tag = AV1_MEM_LOOKAHEAD;
+      // In zero-copy mode the pixels are provided by the application.
+      if (release_cb != NULL) continue;
       if (aom_realloc_frame_buffer(
               &ctx->buf[i].img, width, height, subsampling_x, subsampling_y,
               use_highbitdepth, border_in_pixels, byte_alignment, NULL, NULL,
@@ -96,9 +119,59 @@ int av1_lookahead_full(const struct lookahead_ctx *ctx) {
   return ctx->read_ctxs[ENCODE_STAGE].sz >= ctx->read_ctxs[ENCODE_STAGE].pop_sz;
 }
 
-int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
-                       int64_t ts_start, int64_t ts_end, int use_highbitdepth,
-                       bool alloc_pyramid, aom_enc_frame_flags_t flags) {
+// Points the image of the entry at the application frame 'src'. The borders
+// of 'src' are then extended in place by the caller.
+static int set_external_frame(struct lookahead_entry *buf,
+                              const YV12_BUFFER_CONFIG *src, int border,
+                              int use_highbitdepth, bool alloc_pyramid) {
+  YV12_BUFFER_CONFIG *const img = &buf->img;
+  assert(img->buffer_alloc == NULL);
+#if !CONFIG_REALTIME_ONLY
+  if (alloc_pyramid) {
+    const bool larger_dimensions = src->y_crop_width > img->y_crop_width ||
+                                   src->y_crop_height > img->y_crop_height;
+    if (img->y_pyramid == NULL || larger_dimensions) {
+      aom_free_pyramid(img->y_pyramid);
+      img->y_pyramid = aom_alloc_pyramid(src->y_crop_width,
+                                         src->y_crop_height, use_highbitdepth);
+      if (!img->y_pyramid) return 1;
+    }
+    if (img->corners == NULL) {
+      img->corners = av1_alloc_corner_list();
+      if (!img->corners) return 1;
+    }
+  }
+#else
+  (void)use_highbitdepth;
+  (void)alloc_pyramid;
+#endif  // !CONFIG_REALTIME_ONLY
+
+  img->y_crop_width = src->y_crop_width;
+  img->y_crop_height = src->y_crop_height;
+  img->y_width = ALIGN_POWER_OF_TWO(src->y_crop_width, 3);
+  img->y_height = ALIGN_POWER_OF_TWO(src->y_crop_height, 3);
+  img->y_stride = src->y_stride;
+  img->uv_crop_width = src->uv_crop_width;
+  img->uv_crop_height = src->uv_crop_height;
+  img->uv_width = img->y_width >> src->subsampling_x;
+  img->uv_height = img->y_height >> src->subsampling_y;
+  img->uv_stride = src->uv_stride;
+  img->y_buffer = src->y_buffer;
+  img->u_buffer = src->u_buffer;
+  img->v_buffer = src->v_buffer;
+  img->border = border;
+  img->subsampling_x = src->subsampling_x;
+  img->subsampling_y = src->subsampling_y;
+  img->monochrome = src->monochrome;
+  img->flags = src->flags;
+  return 0;
+}
+
+// Copies 'src' into the frame buffer of the entry, reallocating it if 'src' is
+// larger.
+static int copy_frame(struct lookahead_entry *buf,
+                      const YV12_BUFFER_CONFIG *src, int use_highbitdepth,
+                      bool alloc_pyramid) {
   int width = src->y_crop_width;
   int height = src->y_crop_height;
   int uv_width = src->uv_crop_width;
@@ -107,17 +180,6 @@ int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
   int subsampling_y = src->subsampling_y;
   int larger_dimensions, new_dimensions;
 
-  assert(ctx->read_ctxs[ENCODE_STAGE].valid == 1);
-  if (ctx->read_ctxs[ENCODE_STAGE].sz + ctx->max_pre_frames > ctx->max_sz)
-    return 1;
-
-  ctx->read_ctxs[ENCODE_STAGE].sz++;
-  if (ctx->read_ctxs[LAP_STAGE].valid) {
-    ctx->read_ctxs[LAP_STAGE].sz++;
-  }
-
-  struct lookahead_entry *buf = pop(ctx, &ctx->write_idx);
-
   new_dimensions = width != buf->img.y_crop_width ||
                    height != buf->img.y_crop_height ||
                    uv_width != buf->img.uv_crop_width ||
@@ -130,6 +192,8 @@ int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
   if (larger_dimensions) {
     YV12_BUFFER_CONFIG new_img;
     memset(&new_img, 0, sizeof(new_img));
+    new_img.mem_account = buf->img.mem_account;
+    new_img.mem_tag = buf->img.mem_tag;
     if (aom_alloc_frame_buffer(&new_img, width, height, subsampling_x,
                                subsampling_y, use_highbitdepth,
                                AOM_BORDER_IN_PIXELS, 0, alloc_pyramid, 0))
@@ -149,6 +213,36 @@ int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
     buf->img.subsampling_y = src->subsampling_y;
   }
   av1_copy_and_extend_frame(src, &buf->img);
+  return 0;
+}
+
+int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
+                       int64_t ts_start, int64_t ts_end, int use_highbitdepth,
+                       bool alloc_pyramid, aom_enc_frame_flags_t flags,
+                       void *frame_priv) {
+  assert(ctx->read_ctxs[ENCODE_STAGE].valid == 1);
+  if (ctx->read_ctxs[ENCODE_STAGE].sz + ctx->max_pre_frames > ctx->max_sz)
+    return 1;
+
+  ctx->read_ctxs[ENCODE_STAGE].sz++;
+  if (ctx->read_ctxs[LAP_STAGE].valid) {
+    ctx->read_ctxs[LAP_STAGE].sz++;
+  }
+
+  struct lookahead_entry *buf = pop(ctx, &ctx->write_idx);
+
+  if (ctx->release_cb != NULL) {
+    // The entry is being reused, so its previous frame is no longer read.
+    release_external_frame(ctx, buf);
+    if (set_external_frame(buf, src, ctx->border_in_pixels, use_highbitdepth,
+                           alloc_pyramid))
+      return 1;
+    buf->is_external = true;
+    buf->frame_priv = frame_priv;
+    av1_copy_and_extend_frame(&buf->img, &buf->img);
+  } else if (copy_frame(buf, src, use_highbitdepth, alloc_pyramid)) {
+    return 1;
+  }
 
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
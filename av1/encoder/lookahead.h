@@ -30,12 +30,19 @@ extern "C" {
 #define MAX_TOTAL_BUFFERS (MAX_LAG_BUFFERS + MAX_LAP_BUFFERS)
 #define LAP_LAG_IN_FRAMES 17
 
+// Hands a frame referenced in zero-copy mode back to the application.
+typedef void (*av1_lookahead_release_fn_t)(void *cb_priv, void *frame_priv);
+
 struct lookahead_entry {
   YV12_BUFFER_CONFIG img;
   int64_t ts_start;
   int64_t ts_end;
   int display_idx;
   aom_enc_frame_flags_t flags;
+  // In zero-copy mode, img points into an application frame, identified by
+  // frame_priv, until the entry is reused.
+  bool is_external;
+  void *frame_priv;
 };
 
 // The max of past frames we want to keep in the queue.
@@ -58,18 +65,30 @@ struct lookahead_ctx {
   int push_frame_count; /* Number of frames that have been pushed in the queue*/
   uint8_t
       max_pre_frames; /* Maximum number of past frames allowed in the queue */
+  int border_in_pixels; /* Border of the frames in the queue */
+  /* Zero-copy mode if not NULL */
+  av1_lookahead_release_fn_t release_cb;
+  void *release_cb_priv;
 };
 /*!\endcond */
 
 /**\brief Initializes the lookahead stage
  *
  * The lookahead stage is a queue of frame buffers on which some analysis
- * may be done when buffers are enqueued.
+ * may be done when buffers are enqueued. The frame buffers are accounted to
+ * mem_account (which may be NULL) under AV1_MEM_LOOKAHEAD.
+ *
+ * If release_cb is not NULL the queue is in zero-copy mode: it references the
+ * frames pushed instead of copying them, so no frame buffers are allocated,
+ * and hands each frame back through release_cb once its entry is reused or
+ * the queue is destroyed.
  */
 struct lookahead_ctx *av1_lookahead_init(
     int width, int height, int subsampling_x, int subsampling_y,
     int use_highbitdepth, int depth, int border_in_pixels, int byte_alignment,
-    int num_lap_buffers, bool is_all_intra, bool alloc_pyramid);
+    int num_lap_buffers, bool is_all_intra, bool alloc_pyramid,
+    struct AomMemAccount *mem_account, av1_lookahead_release_fn_t release_cb,
+    void *release_cb_priv);
 
 /**\brief Destroys the lookahead stage
  */
@@ -82,7 +101,9 @@ int av1_lookahead_full(const struct lookahead_ctx *ctx);
 /**\brief Enqueue a source buffer
  *
  * This function will copy the source image into a new framebuffer with
- * the expected stride/border.
+ * the expected stride/border. In zero-copy mode it instead extends the
+ * borders of the source image in place and keeps a reference to it; the
+ * image must then have a border of at least ctx->border_in_pixels.
  *
  * \param[in] ctx               Pointer to the lookahead context
  * \param[in] src               Pointer to the image to enqueue
@@ -92,10 +113,13 @@ int av1_lookahead_full(const struct lookahead_ctx *ctx);
  * \param[in] alloc_pyramid     Whether to allocate a downsampling pyramid
  *                              for each frame buffer
  * \param[in] flags             Flags set on this frame
+ * \param[in] frame_priv        Passed to the release callback in zero-copy
+ *                              mode
  */
 int av1_lookahead_push(struct lookahead_ctx *ctx, const YV12_BUFFER_CONFIG *src,
                        int64_t ts_start, int64_t ts_end, int use_highbitdepth,
-                       bool alloc_pyramid, aom_enc_frame_flags_t flags);
+                       bool alloc_pyramid, aom_enc_frame_flags_t flags,
+                       void *frame_priv);
 
 /**\brief Get the next source buffer to encode
  *
@@ -127,6 +127,7 @@ void av1_make_default_fullpel_ms_params(
   ms_params->sdf = ms_params->vfp->sdf;
   ms_params->sdx4df = ms_params->vfp->sdx4df;
   ms_params->sdx3df = ms_params->vfp->sdx3df;
+  ms_params->sdx8df = ms_params->vfp->sdx8df;
 
   if (mv_sf->use_downsampled_sad == 2 && block_size_high[bsize] >= 16) {
     assert(ms_params->vfp->sdsf != NULL);
@@ -135,6 +136,8 @@ void av1_make_default_fullpel_ms_params(
     ms_params->sdx4df = ms_params->vfp->sdsx4df;
     // Skip version of sadx3 is not available yet
     ms_params->sdx3df = ms_params->vfp->sdsx4df;
+    // Nor is the skip version of sadx8.
+    ms_params->sdx8df = NULL;
   } else if (mv_sf->use_downsampled_sad == 1 && block_size_high[bsize] >= 16 &&
              !is_key_frame) {
     FULLPEL_MV start_mv_clamped = start_mv;
@@ -166,6 +169,7 @@ void av1_make_default_fullpel_ms_params(
       assert(ms_params->vfp->sdsx4df != NULL);
       ms_params->sdx4df = ms_params->vfp->sdsx4df;
       ms_params->sdx3df = ms_params->vfp->sdsx4df;
+      ms_params->sdx8df = NULL;
     }
   }
 }
@@ -674,6 +678,24 @@ static inline int get_mvpred_sad(const FULLPEL_MOTION_SEARCH_PARAMS *ms_params,
   return ms_params->sdf(src_buf, src_stride, ref_address, ref_stride);
 }
 
+// Computes the sads of 8 reference blocks. Falls back to two 4-way calls when
+// there is no 8-way kernel, e.g. for high bitdepth or downsampled sad.
+static inline void get_mvpred_sad8(
+    const FULLPEL_MOTION_SEARCH_PARAMS *ms_params,
+    const struct buf_2d *const src, const uint8_t *const ref_address[8],
+    const int ref_stride, unsigned int sads[8]) {
+  const uint8_t *src_buf = src->buf;
+  const int src_stride = src->stride;
+
+  if (ms_params->sdx8df != NULL) {
+    ms_params->sdx8df(src_buf, src_stride, ref_address, ref_stride, sads);
+    return;
+  }
+  ms_params->sdx4df(src_buf, src_stride, ref_address, ref_stride, sads);
+  ms_params->sdx4df(src_buf, src_stride, ref_address + 4, ref_stride,
+                    sads + 4);
+}
+
 static inline int get_mvpred_compound_var_cost(
     const FULLPEL_MOTION_SEARCH_PARAMS *ms_params, const FULLPEL_MV *this_mv,
     FULLPEL_MV_STATS *mv_stats) {
@@ -1405,7 +1427,23 @@ static int diamond_search_sad(FULLPEL_MV start_mv, unsigned int start_mv_sad,
       all_in &= best_mv->col + site[4].mv.col <= ms_params->mv_limits.col_max;
 
       if (all_in) {
-        for (int idx = 1; idx <= num_searches; idx += 4) {
+        int idx = 1;
+        for (; idx + 7 <= num_searches; idx += 8) {
+          unsigned char const *block_offset[8];
+          unsigned int sads[8];
+
+          for (int j = 0; j < 8; ++j) {
+            block_offset[j] = site[idx + j].offset + best_address;
+          }
+
+          get_mvpred_sad8(ms_params, src, block_offset, ref_stride, sads);
+
+          for (int j = 0; j < 8; ++j) {
+            update_best_site(sads[j], best_mv, site, idx + j, mv_cost_params,
+                             &bestsad, &best_site);
+          }
+        }
+        for (; idx <= num_searches; idx += 4) {
           unsigned char const *block_offset[4];
           unsigned int sads[4];
 
@@ -1575,8 +1613,28 @@ static int exhaustive_mesh_search(FULLPEL_MV start_mv,
         update_mvs_and_sad(sad, &mv, mv_cost_params, &best_sad,
                            /*raw_best_sad=*/NULL, best_mv, second_best_mv);
       } else {
-        // 4 sads in a single call if we are checking every location
-        if (c + 3 <= end_col) {
+        // 8 or 4 sads in a single call if we are checking every location
+        if (c + 7 <= end_col) {
+          unsigned int sads[8];
+          const uint8_t *addrs[8];
+          for (i = 0; i < 8; ++i) {
+            const FULLPEL_MV mv = { start_mv.row + r, start_mv.col + c + i };
+            addrs[i] = get_buf_from_fullmv(ref, &mv);
+          }
+
+          get_mvpred_sad8(ms_params, src, addrs, ref_stride, sads);
+
+          for (i = 0; i < 8; ++i) {
+            if (sads[i] < best_sad) {
+              const FULLPEL_MV mv = { start_mv.row + r, start_mv.col + c + i };
+              update_mvs_and_sad(sads[i], &mv, mv_cost_params, &best_sad,
+                                 /*raw_best_sad=*/NULL, best_mv,
+                                 second_best_mv);
+            }
+          }
+          // The second group of 4 columns has been checked as well.
+          c += 4;
+        } else if (c + 3 <= end_col) {
           unsigned int sads[4];
           const uint8_t *addrs[4];
           for (i = 0; i < 4; ++i) {
@@ -1873,6 +1931,7 @@ int av1_full_pixel_search(const FULLPEL_MV start_mv,
       new_ms_params.sdf = new_ms_params.vfp->sdf;
       new_ms_params.sdx4df = new_ms_params.vfp->sdx4df;
       new_ms_params.sdx3df = new_ms_params.vfp->sdx3df;
+      new_ms_params.sdx8df = new_ms_params.vfp->sdx8df;
 
       return av1_full_pixel_search(start_mv, &new_ms_params, step_param,
                                    cost_list, best_mv, best_mv_stats,
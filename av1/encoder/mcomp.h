@@ -131,6 +131,8 @@ typedef struct {
   aom_sad_fn_t sdf;
   aom_sad_multi_d_fn_t sdx4df;
   aom_sad_multi_d_fn_t sdx3df;
+  // May be NULL, see get_mvpred_sad8().
+  aom_sad_multi_d_fn_t sdx8df;
 } FULLPEL_MOTION_SEARCH_PARAMS;
 
 typedef struct {
@@ -117,11 +117,11 @@ static inline void get_mv_candidate_from_tpl(const AV1_COMP *const cpi,
   }
 }
 
-void av1_single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
-                              BLOCK_SIZE bsize, int ref_idx, int *rate_mv,
-                              int search_range, inter_mode_info *mode_info,
-                              int_mv *best_mv,
-                              struct HandleInterModeArgs *const args) {
+static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
+                                 BLOCK_SIZE bsize, int ref_idx, int *rate_mv,
+                                 int search_range, inter_mode_info *mode_info,
+                                 int_mv *best_mv,
+                                 struct HandleInterModeArgs *const args) {
   MACROBLOCKD *xd = &x->e_mbd;
   const AV1_COMMON *cm = &cpi->common;
   const MotionVectorSearchParams *mv_search_params = &cpi->mv_search_params;
@@ -543,11 +543,25 @@ void av1_single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   }
 }
 
+void av1_single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
+                              BLOCK_SIZE bsize, int ref_idx, int *rate_mv,
+                              int search_range, inter_mode_info *mode_info,
+                              int_mv *best_mv,
+                              struct HandleInterModeArgs *const args) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  single_motion_search(cpi, x, bsize, ref_idx, rate_mv, search_range,
+                       mode_info, best_mv, args);
+  av1_accumulate_stage_time(&timer, &x->motion_search_time);
+}
+
 int av1_joint_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
                             BLOCK_SIZE bsize, int_mv *cur_mv,
                             const uint8_t *mask, int mask_stride, int *rate_mv,
                             int allow_second_mv, int joint_me_num_refine_iter,
                             bool use_subpel_mv_cost_none) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
   const AV1_COMMON *const cm = &cpi->common;
   const int num_planes = av1_num_planes(cm);
   const int pw = block_size_wide[bsize];
@@ -751,6 +765,7 @@ int av1_joint_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
                                 mv_costs->mv_cost_stack, MV_COST_WEIGHT);
   }
 
+  av1_accumulate_stage_time(&timer, &x->motion_search_time);
   return AOMMIN(last_besterr[0], last_besterr[1]);
 }
 
@@ -761,6 +776,8 @@ int av1_compound_single_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
                                       const uint8_t *second_pred,
                                       const uint8_t *mask, int mask_stride,
                                       int *rate_mv, int ref_idx) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
   const AV1_COMMON *const cm = &cpi->common;
   const int num_planes = av1_num_planes(cm);
   MACROBLOCKD *xd = &x->e_mbd;
@@ -863,6 +880,7 @@ int av1_compound_single_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
 
   *rate_mv += av1_mv_bit_cost(this_mv, &ref_mv.as_mv, mv_costs->nmv_joint_cost,
                               mv_costs->mv_cost_stack, MV_COST_WEIGHT);
+  av1_accumulate_stage_time(&timer, &x->motion_search_time);
   return bestsme;
 }
 
@@ -995,6 +1013,8 @@ int_mv av1_simple_motion_search_sse_var(AV1_COMP *const cpi, MACROBLOCK *x,
                                         FULLPEL_MV start_mv, int num_planes,
                                         int use_subpixel, unsigned int *sse,
                                         unsigned int *var) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
   assert(num_planes == 1 &&
          "Currently simple_motion_search only supports luma plane");
   assert(!frame_is_intra_only(&cpi->common) &&
@@ -1091,5 +1111,6 @@ int_mv av1_simple_motion_search_sse_var(AV1_COMP *const cpi, MACROBLOCK *x,
     *sse = best_mv_stats.sse;
   }
 
+  av1_accumulate_stage_time(&timer, &x->motion_search_time);
   return best_mv;
 }
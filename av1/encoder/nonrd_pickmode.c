@@ -2945,9 +2945,12 @@ static AOM_FORCE_INLINE bool handle_inter_mode_nonrd(
     aom_usec_timer_start(&x->ms_stat_nonrd.timer2);
 #endif
     // Find the best motion vector for single/compound mode.
+    struct aom_usec_timer ms_timer;
+    aom_usec_timer_start(&ms_timer);
     const bool skip_newmv = search_new_mv(
         cpi, x, search_state->frame_mv, ref_frame, gf_temporal_ref, bsize,
         mi_row, mi_col, &rate_mv, &search_state->best_rdc);
+    av1_accumulate_stage_time(&ms_timer, &x->motion_search_time);
 #if COLLECT_NONRD_PICK_MODE_STAT
     aom_usec_timer_mark(&x->ms_stat_nonrd.timer2);
     x->ms_stat_nonrd.ms_time[bsize][this_mode] +=
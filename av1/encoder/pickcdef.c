@@ -505,6 +505,69 @@ static inline uint64_t get_filt_error(
   return curr_sse;
 }
 
+// Computes the error after CDEF filtering of an 8-bit luma plane for every
+// strength. The primary strength of each 8x8 block is scaled down by its
+// directional variance, so several strengths often result in the same filter
+// for a block. The error of each block is cached per effective pair of
+// strengths and each distinct filter is run only once.
+static inline void get_luma_filt_error_all_strengths(
+    const CdefSearchCtx *cdef_search_ctx, const struct macroblockd_plane *pd,
+    cdef_list *dlist, int dir[CDEF_NBLOCKS][CDEF_NBLOCKS], int *dirinit,
+    int var[CDEF_NBLOCKS][CDEF_NBLOCKS], uint16_t *in, uint8_t *ref_buffer,
+    int ref_stride, int row, int col, int cdef_count, uint64_t *curr_mse) {
+  const int total_strengths = cdef_search_ctx->total_strengths;
+  int pri_strengths[TOTAL_STRENGTHS];
+  int sec_strengths[TOTAL_STRENGTHS];
+  // Indexed by the effective primary strength plus 1, or 0 if the primary
+  // filter is disabled, and by the secondary strength.
+  uint64_t sse_cache[CDEF_PRI_STRENGTHS + 1][CDEF_SEC_STRENGTHS];
+  DECLARE_ALIGNED(32, uint8_t, tmp_dst8[1 << (MAX_SB_SIZE_LOG2 * 2)]);
+
+  assert(!cdef_search_ctx->use_highbitdepth);
+  for (int gi = 0; gi < total_strengths; gi++) {
+    get_cdef_filter_strengths(cdef_search_ctx->pick_method, &pri_strengths[gi],
+                              &sec_strengths[gi], gi);
+    curr_mse[gi] = 0;
+  }
+  if (!*dirinit) {
+    av1_cdef_find_dirs(in, dlist, var, cdef_count, /*coeff_shift=*/0, dir);
+    *dirinit = 1;
+  }
+
+  for (int bi = 0; bi < cdef_count; bi++) {
+    const int by_pos = dlist[bi].by << 3;
+    const int bx_pos = dlist[bi].bx << 3;
+    const int32_t block_var = var[dlist[bi].by][dlist[bi].bx];
+    const ptrdiff_t buf_offset =
+        (ptrdiff_t)(row + by_pos) * ref_stride + (col + bx_pos);
+    memset(sse_cache, 0xff, sizeof(sse_cache));
+    for (int gi = 0; gi < total_strengths; gi++) {
+      const int pri_strength = pri_strengths[gi];
+      const int sec_strength = sec_strengths[gi];
+      const int t = cdef_adjust_strength(pri_strength, block_var);
+      uint64_t *const sse = &sse_cache[pri_strength ? t + 1 : 0][sec_strength];
+      if (*sse == UINT64_MAX) {
+        if (t == 0 && sec_strength == 0) {
+          // The block is left unfiltered.
+          const ptrdiff_t dst_offset =
+              (ptrdiff_t)(row + by_pos) * pd->dst.stride + (col + bx_pos);
+          *sse = aom_sse(&ref_buffer[buf_offset], ref_stride,
+                         &pd->dst.buf[dst_offset], pd->dst.stride, 8, 8);
+        } else {
+          av1_cdef_filter_fb(tmp_dst8, NULL, (1 << MAX_SB_SIZE_LOG2), in, 0, 0,
+                             dir, dirinit, var, AOM_PLANE_Y, &dlist[bi], 1,
+                             pri_strength, sec_strength + (sec_strength == 3),
+                             cdef_search_ctx->damping, /*coeff_shift=*/0);
+          *sse = aom_sse(&ref_buffer[buf_offset], ref_stride,
+                         &tmp_dst8[by_pos * (1 << MAX_SB_SIZE_LOG2) + bx_pos],
+                         (1 << MAX_SB_SIZE_LOG2), 8, 8);
+        }
+      }
+      curr_mse[gi] += *sse;
+    }
+  }
+}
+
 // Calculates MSE at block level.
 // Inputs:
 //   cdef_search_ctx: Pointer to the structure containing parameters related to
@@ -605,18 +668,29 @@ void av1_cdef_mse_calc_block(CdefSearchCtx *cdef_search_ctx,
         inbuf, hfilt_size, vfilt_size, is_fb_on_frm_left_boundary,
         is_fb_on_frm_right_boundary, is_fb_on_frm_top_boundary,
         is_fb_on_frm_bottom_boundary);
-    for (int gi = 0; gi < cdef_search_ctx->total_strengths; gi++) {
-      int pri_strength, sec_strength;
-      get_cdef_filter_strengths(cdef_search_ctx->pick_method, &pri_strength,
-                                &sec_strength, gi);
-      const uint64_t curr_mse = get_filt_error(
+    uint64_t curr_mse[TOTAL_STRENGTHS];
+    // Chroma strengths are not scaled per block, so the chroma planes gain
+    // nothing from caching and are filtered a whole filter block at a time.
+    if (!cdef_search_ctx->use_highbitdepth && pli == AOM_PLANE_Y) {
+      get_luma_filt_error_all_strengths(
           cdef_search_ctx, &pd, dlist, dir, &dirinit, var, in, ref_buffer[pli],
-          ref_stride[pli], row, col, pri_strength, sec_strength, cdef_count,
-          pli, coeff_shift, bs);
+          ref_stride[pli], row, col, cdef_count, curr_mse);
+    } else {
+      for (int gi = 0; gi < cdef_search_ctx->total_strengths; gi++) {
+        int pri_strength, sec_strength;
+        get_cdef_filter_strengths(cdef_search_ctx->pick_method, &pri_strength,
+                                  &sec_strength, gi);
+        curr_mse[gi] = get_filt_error(
+            cdef_search_ctx, &pd, dlist, dir, &dirinit, var, in,
+            ref_buffer[pli], ref_stride[pli], row, col, pri_strength,
+            sec_strength, cdef_count, pli, coeff_shift, bs);
+      }
+    }
+    for (int gi = 0; gi < cdef_search_ctx->total_strengths; gi++) {
       if (pli < 2)
-        cdef_search_ctx->mse[pli][sb_count][gi] = curr_mse;
+        cdef_search_ctx->mse[pli][sb_count][gi] = curr_mse[gi];
       else
-        cdef_search_ctx->mse[1][sb_count][gi] += curr_mse;
+        cdef_search_ctx->mse[1][sb_count][gi] += curr_mse[gi];
     }
   }
   cdef_search_ctx->sb_index[sb_count] =
@@ -88,7 +88,8 @@ static int64_t try_filter_frame(const YV12_BUFFER_CONFIG *sd,
 
   av1_loop_filter_frame_mt(&cm->cur_frame->buf, cm, &cpi->td.mb.e_mbd, plane,
                            plane + 1, partial_frame, mt_info->workers,
-                           num_workers, &mt_info->lf_row_sync, lpf_opt_level);
+                           num_workers, &mt_info->lf_row_sync, lpf_opt_level,
+                           /*row_output=*/NULL);
 
   filt_err = aom_get_sse_plane(sd, &cm->cur_frame->buf, plane,
                                cm->seq_params->use_highbitdepth);
@@ -1625,6 +1625,7 @@ void av1_temporal_filter(AV1_COMP *cpi, const int filter_frame_lookahead_idx,
   // it is more beneficial to use non-zero strength filtering.
   // Only parallel level 0 frames go through temporal filtering.
   assert(cpi->ppi->gf_group.frame_parallel_level[gf_frame_index] == 0);
+  av1_start_stage_timing(cpi, AOM_ENC_STAGE_TEMPORAL_FILTER);
 
   // Initialize temporal filter context structure.
   init_tf_ctx(cpi, filter_frame_lookahead_idx, gf_frame_index,
@@ -1632,7 +1633,8 @@ void av1_temporal_filter(AV1_COMP *cpi, const int filter_frame_lookahead_idx,
 
   // Allocate and reset temporal filter buffers.
   const int is_highbitdepth = tf_ctx->is_highbitdepth;
-  if (!tf_alloc_and_reset_data(tf_data, tf_ctx->num_pels, is_highbitdepth)) {
+  if (!tf_alloc_and_reset_data(tf_data, av1_get_scratch_pool(cpi, &cpi->td),
+                               tf_ctx->num_pels, is_highbitdepth)) {
     aom_internal_error(cpi->common.error, AOM_CODEC_MEM_ERROR,
                        "Error allocating temporal filter data");
   }
@@ -1648,6 +1650,7 @@ void av1_temporal_filter(AV1_COMP *cpi, const int filter_frame_lookahead_idx,
   }
   // Deallocate temporal filter buffers.
   tf_dealloc_data(tf_data, is_highbitdepth);
+  av1_end_stage_timing(cpi, AOM_ENC_STAGE_TEMPORAL_FILTER);
 }
 
 int av1_is_temporal_filter_on(const AV1EncoderConfig *oxcf) {
@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 
+#include "aom_mem/aom_mem_pool.h"
 #include "aom_util/aom_pthread.h"
 
 #ifdef __cplusplus
@@ -360,23 +361,26 @@ int av1_check_show_filtered_frame(const YV12_BUFFER_CONFIG *frame,
 // Allocates memory for members of TemporalFilterData.
 // Inputs:
 //   tf_data: Pointer to the structure containing temporal filter related data.
+//   pool: Scratch memory pool of the thread the buffers are allocated for.
 //   num_pels: Number of pixels in the block across all planes.
 //   is_high_bitdepth: Whether the frame is high-bitdepth or not.
 // Returns:
 //   True if allocation is successful and false otherwise.
 static inline bool tf_alloc_and_reset_data(TemporalFilterData *tf_data,
-                                           int num_pels, int is_high_bitdepth) {
-  tf_data->tmp_mbmi = (MB_MODE_INFO *)aom_calloc(1, sizeof(*tf_data->tmp_mbmi));
-  tf_data->accum =
-      (uint32_t *)aom_memalign(16, num_pels * sizeof(*tf_data->accum));
-  tf_data->count =
-      (uint16_t *)aom_memalign(16, num_pels * sizeof(*tf_data->count));
+                                           AomMemPool *pool, int num_pels,
+                                           int is_high_bitdepth) {
+  tf_data->tmp_mbmi = (MB_MODE_INFO *)aom_mem_pool_calloc(
+      pool, 16, sizeof(*tf_data->tmp_mbmi));
+  tf_data->accum = (uint32_t *)aom_mem_pool_alloc(
+      pool, 16, num_pels * sizeof(*tf_data->accum));
+  tf_data->count = (uint16_t *)aom_mem_pool_alloc(
+      pool, 16, num_pels * sizeof(*tf_data->count));
   if (is_high_bitdepth)
     tf_data->pred = CONVERT_TO_BYTEPTR(
-        aom_memalign(32, num_pels * 2 * sizeof(*tf_data->pred)));
+        aom_mem_pool_alloc(pool, 32, num_pels * 2 * sizeof(*tf_data->pred)));
   else
-    tf_data->pred =
-        (uint8_t *)aom_memalign(32, num_pels * sizeof(*tf_data->pred));
+    tf_data->pred = (uint8_t *)aom_mem_pool_alloc(
+        pool, 32, num_pels * sizeof(*tf_data->pred));
   // In case of an allocation failure, other successfully allocated buffers will
   // be freed by the tf_dealloc_data() call in encoder_destroy().
   if (!(tf_data->tmp_mbmi && tf_data->accum && tf_data->count && tf_data->pred))
@@ -411,13 +415,13 @@ static inline void tf_dealloc_data(TemporalFilterData *tf_data,
                                    int is_high_bitdepth) {
   if (is_high_bitdepth)
     tf_data->pred = (uint8_t *)CONVERT_TO_SHORTPTR(tf_data->pred);
-  aom_free(tf_data->tmp_mbmi);
+  aom_mem_pool_free(tf_data->tmp_mbmi);
   tf_data->tmp_mbmi = NULL;
-  aom_free(tf_data->accum);
+  aom_mem_pool_free(tf_data->accum);
   tf_data->accum = NULL;
-  aom_free(tf_data->count);
+  aom_mem_pool_free(tf_data->count);
   tf_data->count = NULL;
-  aom_free(tf_data->pred);
+  aom_mem_pool_free(tf_data->pred);
   tf_data->pred = NULL;
 }
 
@@ -181,17 +181,23 @@ void av1_setup_tpl_buffers(AV1_PRIMARY *const ppi,
   // allocations are avoided for buffers in tpl_data.
   if (lag_in_frames <= 1) return;
 
-  AOM_CHECK_MEM_ERROR(&ppi->error, tpl_data->txfm_stats_list,
-                      aom_calloc(MAX_LENGTH_TPL_FRAME_STATS,
-                                 sizeof(*tpl_data->txfm_stats_list)));
+  AomMemAccount *const mem_account = &ppi->mem_account;
+  AOM_CHECK_MEM_ERROR(
+      &ppi->error, tpl_data->txfm_stats_list,
+      aom_calloc_tagged(mem_account, AV1_MEM_TPL, MAX_LENGTH_TPL_FRAME_STATS,
+                        sizeof(*tpl_data->txfm_stats_list)));
 
   for (int frame = 0; frame < lag_in_frames; ++frame) {
     AOM_CHECK_MEM_ERROR(
         &ppi->error, tpl_data->tpl_stats_pool[frame],
-        aom_calloc(tpl_data->tpl_stats_buffer[frame].width *
-                       tpl_data->tpl_stats_buffer[frame].height,
-                   sizeof(*tpl_data->tpl_stats_buffer[frame].tpl_stats_ptr)));
-
+        aom_calloc_tagged(
+            mem_account, AV1_MEM_TPL,
+            tpl_data->tpl_stats_buffer[frame].width *
+                tpl_data->tpl_stats_buffer[frame].height,
+            sizeof(*tpl_data->tpl_stats_buffer[frame].tpl_stats_ptr)));
+
+    tpl_data->tpl_rec_pool[frame].mem_account = mem_account;
+    tpl_data->tpl_rec_pool[frame].mem_tag = AV1_MEM_TPL;
     if (aom_alloc_frame_buffer(
             &tpl_data->tpl_rec_pool[frame], width, height,
             seq_params->subsampling_x, seq_params->subsampling_y,
@@ -201,6 +207,8 @@ void av1_setup_tpl_buffers(AV1_PRIMARY *const ppi,
                          "Failed to allocate frame buffer");
   }
 
+  tpl_data->prev_gop_arf_src.mem_account = mem_account;
+  tpl_data->prev_gop_arf_src.mem_tag = AV1_MEM_TPL;
   if (aom_alloc_frame_buffer(
           &tpl_data->prev_gop_arf_src, width, height, seq_params->subsampling_x,
           seq_params->subsampling_y, seq_params->use_highbitdepth,
@@ -2092,8 +2100,8 @@ static void trim_tpl_stats(struct aom_internal_error_info *error_info,
   extrc_tpl_gop_stats->frame_stats_list = new_frame_stats;
 }
 
-int av1_tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
-                        const EncodeFrameParams *const frame_params) {
+static int tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
+                           const EncodeFrameParams *const frame_params) {
 #if CONFIG_COLLECT_COMPONENT_TIMING
   start_timing(cpi, av1_tpl_setup_stats_time);
 #endif
@@ -2140,7 +2148,9 @@ int av1_tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
   }
 
   TplBuffers *tpl_tmp_buffers = &cpi->td.tpl_tmp_buffers;
-  if (!tpl_alloc_temp_buffers(tpl_tmp_buffers, tpl_data->tpl_bsize_1d)) {
+  if (!tpl_alloc_temp_buffers(tpl_tmp_buffers,
+                              av1_get_scratch_pool(cpi, &cpi->td),
+                              tpl_data->tpl_bsize_1d)) {
     aom_internal_error(cpi->common.error, AOM_CODEC_MEM_ERROR,
                        "Error allocating tpl data");
   }
@@ -2181,8 +2191,12 @@ int av1_tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
 
     init_mc_flow_dispenser(cpi, frame_idx, pframe_qindex);
     if (mt_info->num_workers > 1) {
-      tpl_row_mt->sync_read_ptr = av1_tpl_row_mt_sync_read;
-      tpl_row_mt->sync_write_ptr = av1_tpl_row_mt_sync_write;
+      const int atomic_sync = cpi->oxcf.row_mt_sync_mode == ROW_SYNC_ATOMIC;
+      tpl_row_mt->sync_read_ptr = atomic_sync ? av1_tpl_row_mt_sync_read_atomic
+                                              : av1_tpl_row_mt_sync_read;
+      tpl_row_mt->sync_write_ptr = atomic_sync
+                                       ? av1_tpl_row_mt_sync_write_atomic
+                                       : av1_tpl_row_mt_sync_write;
       av1_mc_flow_dispenser_mt(cpi);
     } else {
       mc_flow_dispenser(cpi);
@@ -2262,6 +2276,14 @@ int av1_tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
   return eval_gop_length(beta, gop_eval);
 }
 
+int av1_tpl_setup_stats(AV1_COMP *cpi, int gop_eval,
+                        const EncodeFrameParams *const frame_params) {
+  av1_start_stage_timing(cpi, AOM_ENC_STAGE_TPL);
+  const int ret = tpl_setup_stats(cpi, gop_eval, frame_params);
+  av1_end_stage_timing(cpi, AOM_ENC_STAGE_TPL);
+  return ret;
+}
+
 void av1_tpl_rdmult_setup(AV1_COMP *cpi) {
   const AV1_COMMON *const cm = &cpi->common;
   const int tpl_idx = cpi->gf_frame_index;
@@ -30,6 +30,7 @@ struct TPL_INFO;
 #include "config/aom_config.h"
 
 #include "aom/aom_tpl.h"
+#include "aom_mem/aom_mem_pool.h"
 #include "aom_scale/yv12config.h"
 #include "aom_util/aom_pthread.h"
 
@@ -58,6 +59,8 @@ typedef struct AV1TplRowMultiThreadSync {
   // Synchronization objects for top-right dependency.
   pthread_mutex_t *mutex_;
   pthread_cond_t *cond_;
+  // Number of threads blocked on cond_[i], used in ROW_SYNC_ATOMIC mode.
+  int *num_waiters;
 #endif
   // Buffer to store the macroblock whose encoding is complete.
   // num_finished_cols[i] stores the number of macroblocks which finished
@@ -439,34 +442,35 @@ void av1_setup_tpl_buffers(struct AV1_PRIMARY *const ppi,
                            int height, int byte_alignment, int lag_in_frames);
 
 static inline void tpl_dealloc_temp_buffers(TplBuffers *tpl_tmp_buffers) {
-  aom_free(tpl_tmp_buffers->predictor8);
+  aom_mem_pool_free(tpl_tmp_buffers->predictor8);
   tpl_tmp_buffers->predictor8 = NULL;
-  aom_free(tpl_tmp_buffers->src_diff);
+  aom_mem_pool_free(tpl_tmp_buffers->src_diff);
   tpl_tmp_buffers->src_diff = NULL;
-  aom_free(tpl_tmp_buffers->coeff);
+  aom_mem_pool_free(tpl_tmp_buffers->coeff);
   tpl_tmp_buffers->coeff = NULL;
-  aom_free(tpl_tmp_buffers->qcoeff);
+  aom_mem_pool_free(tpl_tmp_buffers->qcoeff);
   tpl_tmp_buffers->qcoeff = NULL;
-  aom_free(tpl_tmp_buffers->dqcoeff);
+  aom_mem_pool_free(tpl_tmp_buffers->dqcoeff);
   tpl_tmp_buffers->dqcoeff = NULL;
 }
 
 static inline bool tpl_alloc_temp_buffers(TplBuffers *tpl_tmp_buffers,
+                                          AomMemPool *pool,
                                           uint8_t tpl_bsize_1d) {
   // Number of pixels in a tpl block
   const int tpl_block_pels = tpl_bsize_1d * tpl_bsize_1d;
 
   // Allocate temporary buffers used in mode estimation.
-  tpl_tmp_buffers->predictor8 = (uint8_t *)aom_memalign(
-      32, tpl_block_pels * 2 * sizeof(*tpl_tmp_buffers->predictor8));
-  tpl_tmp_buffers->src_diff = (int16_t *)aom_memalign(
-      32, tpl_block_pels * sizeof(*tpl_tmp_buffers->src_diff));
-  tpl_tmp_buffers->coeff = (tran_low_t *)aom_memalign(
-      32, tpl_block_pels * sizeof(*tpl_tmp_buffers->coeff));
-  tpl_tmp_buffers->qcoeff = (tran_low_t *)aom_memalign(
-      32, tpl_block_pels * sizeof(*tpl_tmp_buffers->qcoeff));
-  tpl_tmp_buffers->dqcoeff = (tran_low_t *)aom_memalign(
-      32, tpl_block_pels * sizeof(*tpl_tmp_buffers->dqcoeff));
+  tpl_tmp_buffers->predictor8 = (uint8_t *)aom_mem_pool_alloc(
+      pool, 32, tpl_block_pels * 2 * sizeof(*tpl_tmp_buffers->predictor8));
+  tpl_tmp_buffers->src_diff = (int16_t *)aom_mem_pool_alloc(
+      pool, 32, tpl_block_pels * sizeof(*tpl_tmp_buffers->src_diff));
+  tpl_tmp_buffers->coeff = (tran_low_t *)aom_mem_pool_alloc(
+      pool, 32, tpl_block_pels * sizeof(*tpl_tmp_buffers->coeff));
+  tpl_tmp_buffers->qcoeff = (tran_low_t *)aom_mem_pool_alloc(
+      pool, 32, tpl_block_pels * sizeof(*tpl_tmp_buffers->qcoeff));
+  tpl_tmp_buffers->dqcoeff = (tran_low_t *)aom_mem_pool_alloc(
+      pool, 32, tpl_block_pels * sizeof(*tpl_tmp_buffers->dqcoeff));
 
   if (!(tpl_tmp_buffers->predictor8 && tpl_tmp_buffers->src_diff &&
         tpl_tmp_buffers->coeff && tpl_tmp_buffers->qcoeff &&
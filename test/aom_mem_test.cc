@@ -10,6 +10,7 @@
  */
 
 #include "aom_mem/aom_mem.h"
+#include "aom_mem/aom_mem_pool.h"
 
 #include <cstdio>
 #include <cstddef>
@@ -32,3 +33,62 @@ TEST(AomMemTest, NullParams) {
   ASSERT_EQ(aom_memset16(nullptr, 0, 0), nullptr);
   aom_free(nullptr);
 }
+
+TEST(AomMemTest, TaggedHugePagesCountMapping) {
+  AomMemAccount account = {};
+  account.huge_pages = AOM_HUGE_PAGES_TRANSPARENT;
+  const size_t size = AOM_HUGE_PAGE_SIZE + 1;
+  void *const mem = aom_malloc_tagged(&account, 1, size);
+  ASSERT_NE(mem, nullptr);
+#if defined(__linux__)
+  // The mapping is a whole number of huge pages.
+  EXPECT_EQ(account.total, 2 * AOM_HUGE_PAGE_SIZE);
+#else
+  EXPECT_EQ(account.total, size);
+#endif
+  EXPECT_EQ(account.bytes[1], account.total);
+  aom_free(mem);
+  EXPECT_EQ(account.total, 0u);
+
+  // A mapping that does not fit in the limit falls back to malloc().
+  account.limit = size;
+  void *const limited = aom_malloc_tagged(&account, 1, size);
+  ASSERT_NE(limited, nullptr);
+  EXPECT_EQ(account.total, size);
+  aom_free(limited);
+  EXPECT_EQ(account.total, 0u);
+}
+
+TEST(AomMemPoolTest, DropsStaleSizes) {
+  AomMemPool pool = {};
+  aom_mem_pool_set_tag(&pool, 1);
+  void *const cached = aom_mem_pool_alloc(&pool, 16, 100);
+  void *const in_use = aom_mem_pool_alloc(&pool, 16, 200);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_NE(in_use, nullptr);
+  aom_mem_pool_free(cached);
+  EXPECT_EQ(pool.num_heap_allocs, 2u);
+
+  // Same tag: the freed buffer is handed out again.
+  EXPECT_EQ(aom_mem_pool_alloc(&pool, 16, 100), cached);
+  EXPECT_EQ(pool.num_heap_allocs, 2u);
+  aom_mem_pool_free(cached);
+  const size_t bytes = pool.bytes;
+
+  // New tag: the cached buffer is dropped at once, the buffer in use when it
+  // is freed.
+  aom_mem_pool_set_tag(&pool, 2);
+  EXPECT_EQ(pool.free_list, nullptr);
+  EXPECT_LT(pool.bytes, bytes);
+  aom_mem_pool_free(in_use);
+  EXPECT_EQ(pool.free_list, nullptr);
+  EXPECT_EQ(pool.bytes, 0u);
+
+  // Buffers allocated under the new tag are cached again.
+  void *const buf = aom_mem_pool_alloc(&pool, 16, 300);
+  ASSERT_NE(buf, nullptr);
+  aom_mem_pool_free(buf);
+  EXPECT_NE(pool.free_list, nullptr);
+  aom_mem_pool_trim(&pool);
+  EXPECT_EQ(pool.bytes, 0u);
+}
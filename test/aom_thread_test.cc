@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+
+#include "config/aom_config.h"
+
+#include "aom_ports/aom_timer.h"
+#include "aom_util/aom_thread.h"
+
+namespace {
+
+constexpr int kNumWorkers = 16;
+
+int AddOne(void *data1, void *data2) {
+  (void)data2;
+  ++*static_cast<int *>(data1);
+  return 1;
+}
+
+int ReturnData2(void *data1, void *data2) {
+  (void)data1;
+  return static_cast<int>(reinterpret_cast<intptr_t>(data2));
+}
+
+// Workers are either given a thread of their own or bound to a pool of
+// GetParam() threads (0 meaning no pool).
+class AomThreadTest : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override {
+    if (GetParam() > 0) {
+      pool_ = aom_thread_pool_create(GetParam());
+#if CONFIG_MULTITHREAD
+      ASSERT_NE(pool_, nullptr);
+      ASSERT_EQ(aom_thread_pool_num_threads(pool_), GetParam());
+#else
+      ASSERT_EQ(pool_, nullptr);
+#endif
+    }
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (AVxWorker &worker : workers_) {
+      winterface->init(&worker);
+      worker.pool = pool_;
+      ASSERT_TRUE(winterface->reset(&worker));
+    }
+  }
+
+  void TearDown() override {
+    for (AVxWorker &worker : workers_) {
+      aom_get_worker_interface()->end(&worker);
+    }
+    aom_thread_pool_destroy(pool_);
+  }
+
+  AVxThreadPool *pool_ = nullptr;
+  AVxWorker workers_[kNumWorkers];
+};
+
+TEST_P(AomThreadTest, LaunchAndSync) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int counters[kNumWorkers] = { 0 };
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < kNumWorkers; ++i) {
+      workers_[i].hook = AddOne;
+      workers_[i].data1 = &counters[i];
+      winterface->launch(&workers_[i]);
+    }
+    for (AVxWorker &worker : workers_) {
+      EXPECT_TRUE(winterface->sync(&worker));
+    }
+  }
+  for (int counter : counters) EXPECT_EQ(counter, 10);
+}
+
+TEST_P(AomThreadTest, Execute) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int counter = 0;
+  workers_[0].hook = AddOne;
+  workers_[0].data1 = &counter;
+  winterface->execute(&workers_[0]);
+  EXPECT_EQ(counter, 1);
+  EXPECT_TRUE(winterface->sync(&workers_[0]));
+}
+
+TEST_P(AomThreadTest, HookError) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  for (int i = 0; i < kNumWorkers; ++i) {
+    workers_[i].hook = ReturnData2;
+    workers_[i].data2 = reinterpret_cast<void *>(intptr_t{ i & 1 });
+    winterface->launch(&workers_[i]);
+  }
+  for (int i = 0; i < kNumWorkers; ++i) {
+    EXPECT_EQ(winterface->sync(&workers_[i]), (i & 1) == 1);
+  }
+  // reset() clears the error.
+  for (AVxWorker &worker : workers_) {
+    EXPECT_TRUE(winterface->reset(&worker));
+    EXPECT_EQ(worker.had_error, 0);
+  }
+}
+
+// A job that launches a second worker and waits for it, as the encoder does
+// when a frame-level worker starts tile workers.
+struct NestedJob {
+  AVxWorker *inner;
+  int counter;
+};
+
+int LaunchInner(void *data1, void *data2) {
+  (void)data2;
+  NestedJob *const job = static_cast<NestedJob *>(data1);
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  job->inner->hook = AddOne;
+  job->inner->data1 = &job->counter;
+  winterface->launch(job->inner);
+  return winterface->sync(job->inner);
+}
+
+TEST_P(AomThreadTest, NestedLaunch) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  constexpr int kNumJobs = kNumWorkers / 2;
+  NestedJob jobs[kNumJobs];
+  for (int i = 0; i < kNumJobs; ++i) {
+    jobs[i].inner = &workers_[kNumJobs + i];
+    jobs[i].counter = 0;
+    workers_[i].hook = LaunchInner;
+    workers_[i].data1 = &jobs[i];
+    winterface->launch(&workers_[i]);
+  }
+  for (int i = 0; i < kNumJobs; ++i) {
+    EXPECT_TRUE(winterface->sync(&workers_[i]));
+    EXPECT_EQ(jobs[i].counter, 1);
+  }
+}
+
+// Measures the cost of a launch()/sync() cycle of all the workers with an
+// empty hook, i.e. the scheduling overhead per task.
+TEST_P(AomThreadTest, DISABLED_Speed) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  constexpr int kNumRounds = 20000;
+  int counters[kNumWorkers] = { 0 };
+  for (int i = 0; i < kNumWorkers; ++i) {
+    workers_[i].hook = AddOne;
+    workers_[i].data1 = &counters[i];
+  }
+  aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (AVxWorker &worker : workers_) winterface->launch(&worker);
+    for (AVxWorker &worker : workers_) winterface->sync(&worker);
+  }
+  aom_usec_timer_mark(&timer);
+  const double elapsed_us = static_cast<double>(aom_usec_timer_elapsed(&timer));
+  printf("%2d pool threads, %d workers: %7.3f us/task\n", GetParam(),
+         kNumWorkers, elapsed_us / (kNumRounds * kNumWorkers));
+  for (int counter : counters) EXPECT_EQ(counter, kNumRounds);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPerWorker, AomThreadTest, ::testing::Values(0));
+#if CONFIG_MULTITHREAD
+INSTANTIATE_TEST_SUITE_P(Pool, AomThreadTest, ::testing::Values(1, 2, 4, 16));
+#endif
+
+}  // namespace
@@ -385,6 +385,11 @@ INSTANTIATE_TEST_SUITE_P(AVX2, AV1LbdInvTxfm2d,
                          ::testing::Values(av1_lowbd_inv_txfm2d_add_avx2));
 #endif  // HAVE_AVX2
 
+#if HAVE_AVX512 && CONFIG_HIGHWAY
+INSTANTIATE_TEST_SUITE_P(AVX512, AV1LbdInvTxfm2d,
+                         ::testing::Values(av1_lowbd_inv_txfm2d_add_avx512));
+#endif  // HAVE_AVX512 && CONFIG_HIGHWAY
+
 #if HAVE_NEON
 // TODO(bug 528050364): Enable this test after issues with
 // arm-linux-gnueabi-gcc-14+ are addressed.
@@ -13,12 +13,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "config/aom_dsp_rtcd.h"
+
 #include "test/acm_random.h"
+#include "test/register_state_check.h"
 #include "aom/aom_integer.h"
 #include "aom_dsp/bitreader.h"
 #include "aom_dsp/bitwriter.h"
+#include "aom_ports/aom_timer.h"
 
 using libaom_test::ACMRandom;
 
@@ -171,3 +179,312 @@ TEST(AV1, TestHasOverflowed) {
     ASSERT_TRUE(aom_reader_has_overflowed(&br));
   }
 }
+
+TEST(AV1, TestSymbolIO) {
+  const int kSymbols = 10000;
+  const int kBufferSize = 4 * kSymbols;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int nsyms = 2; nsyms <= 16; ++nsyms) {
+    aom_cdf_prob enc_cdf[CDF_SIZE(16)];
+    aom_cdf_prob dec_cdf[CDF_SIZE(16)];
+    // Start from a uniform distribution.
+    for (int i = 0; i < nsyms; ++i) {
+      enc_cdf[i] = AOM_ICDF(CDF_PROB_TOP * (i + 1) / nsyms);
+    }
+    enc_cdf[nsyms] = 0;
+    memcpy(dec_cdf, enc_cdf, sizeof(enc_cdf));
+    std::vector<int> symbols(kSymbols);
+    // Skewed symbol statistics make the CDFs adapt away from uniform.
+    for (int &s : symbols) s = rnd(2) ? rnd(nsyms) : rnd(1 + nsyms / 4);
+
+    aom_writer bw;
+    std::vector<uint8_t> bw_buffer(kBufferSize);
+    aom_start_encode(&bw, bw_buffer.data(), kBufferSize);
+    bw.allow_update_cdf = 1;
+    for (int s : symbols) aom_write_symbol(&bw, s, enc_cdf, nsyms);
+    GTEST_ASSERT_GE(aom_stop_encode(&bw), 0);
+
+    aom_reader br;
+    aom_reader_init(&br, bw_buffer.data(), bw.pos);
+    br.allow_update_cdf = 1;
+    for (int i = 0; i < kSymbols; ++i) {
+      GTEST_ASSERT_EQ(aom_read_symbol(&br, dec_cdf, nsyms, nullptr),
+                      symbols[i])
+          << "pos: " << i << " nsyms: " << nsyms;
+    }
+    EXPECT_EQ(memcmp(enc_cdf, dec_cdf, sizeof(enc_cdf)), 0);
+    ASSERT_FALSE(aom_reader_has_overflowed(&br));
+  }
+}
+
+TEST(AV1, TestSymbolRunIO) {
+  const int kContexts = 8;
+  const int kSymbols = 10000;
+  const int kBufferSize = 4 * kSymbols;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int allow_update_cdf = 0; allow_update_cdf <= 1; ++allow_update_cdf) {
+    std::vector<aom_cdf_prob> cdfs(kContexts * CDF_SIZE(16));
+    uint8_t nsyms[kContexts];
+    for (int c = 0; c < kContexts; ++c) {
+      nsyms[c] = 2 + rnd(15);
+      aom_cdf_prob *cdf = &cdfs[c * CDF_SIZE(16)];
+      for (int i = 0; i < nsyms[c]; ++i) {
+        cdf[i] = AOM_ICDF(CDF_PROB_TOP * (i + 1) / nsyms[c]);
+      }
+    }
+    std::vector<aom_cdf_prob> run_cdfs(cdfs);
+    std::vector<int> ctx(kSymbols);
+    std::vector<uint8_t> symbols(kSymbols);
+    for (int i = 0; i < kSymbols; ++i) {
+      ctx[i] = rnd(kContexts);
+      symbols[i] = rnd(2) ? rnd(nsyms[ctx[i]]) : 0;
+    }
+
+    // Write the symbols one at a time, and as runs of random lengths in
+    // which contexts repeat.
+    aom_writer bw;
+    std::vector<uint8_t> bw_buffer(kBufferSize);
+    aom_start_encode(&bw, bw_buffer.data(), kBufferSize);
+    bw.allow_update_cdf = allow_update_cdf;
+    for (int i = 0; i < kSymbols; ++i) {
+      aom_write_symbol(&bw, symbols[i], &cdfs[ctx[i] * CDF_SIZE(16)],
+                       nsyms[ctx[i]]);
+    }
+    GTEST_ASSERT_GE(aom_stop_encode(&bw), 0);
+
+    aom_writer run_bw;
+    std::vector<uint8_t> run_bw_buffer(kBufferSize);
+    aom_start_encode(&run_bw, run_bw_buffer.data(), kBufferSize);
+    run_bw.allow_update_cdf = allow_update_cdf;
+    for (int i = 0; i < kSymbols;) {
+      const int n = std::min<int>(rnd(65), kSymbols - i);
+      aom_cdf_prob *run[64];
+      uint8_t run_nsyms[64];
+      for (int j = 0; j < n; ++j) {
+        run[j] = &run_cdfs[ctx[i + j] * CDF_SIZE(16)];
+        run_nsyms[j] = nsyms[ctx[i + j]];
+      }
+      aom_write_symbols(&run_bw, &symbols[i], run, run_nsyms, n);
+      i += n;
+    }
+    GTEST_ASSERT_GE(aom_stop_encode(&run_bw), 0);
+
+    ASSERT_EQ(bw.pos, run_bw.pos);
+    EXPECT_EQ(memcmp(bw_buffer.data(), run_bw_buffer.data(), bw.pos), 0);
+    EXPECT_EQ(cdfs, run_cdfs);
+  }
+}
+
+// Reports the throughput of the entropy decoder on a high-rate stream, which
+// mixes adaptive symbols from several contexts, booleans and literal bits
+// roughly as coefficient coding at a low quantizer does.
+TEST(AV1, DISABLED_DecodeSpeed) {
+  const int kContexts = 16;
+  const int kSymbols = 1 << 20;
+  const int kRuns = 20;
+  const int kBufferSize = 2 * kSymbols;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  std::vector<int> nsyms(kContexts);
+  std::vector<aom_cdf_prob> init_cdfs(kContexts * CDF_SIZE(16));
+  for (int c = 0; c < kContexts; ++c) {
+    nsyms[c] = 4 + rnd(13);
+    aom_cdf_prob *cdf = &init_cdfs[c * CDF_SIZE(16)];
+    for (int i = 0; i < nsyms[c]; ++i) {
+      cdf[i] = AOM_ICDF(CDF_PROB_TOP * (i + 1) / nsyms[c]);
+    }
+  }
+  // Each element is a context and a symbol, a boolean probability and a
+  // value, or a literal bit (-1) and its value.
+  std::vector<int> ctx(kSymbols);
+  std::vector<int> values(kSymbols);
+  for (int i = 0; i < kSymbols; ++i) {
+    const int type = rnd(4);
+    if (type < 2) {
+      ctx[i] = rnd(kContexts);
+      values[i] = rnd(nsyms[ctx[i]]);
+    } else if (type == 2) {
+      ctx[i] = kContexts + 1 + rnd(255);
+      values[i] = rnd(256) < ctx[i] - kContexts;
+    } else {
+      ctx[i] = -1;
+      values[i] = rnd(2);
+    }
+  }
+
+  std::vector<aom_cdf_prob> cdfs(init_cdfs);
+  aom_writer bw;
+  std::vector<uint8_t> bw_buffer(kBufferSize);
+  aom_start_encode(&bw, bw_buffer.data(), kBufferSize);
+  bw.allow_update_cdf = 1;
+  for (int i = 0; i < kSymbols; ++i) {
+    if (ctx[i] < 0) {
+      aom_write_bit(&bw, values[i]);
+    } else if (ctx[i] > kContexts) {
+      aom_write(&bw, values[i], ctx[i] - kContexts);
+    } else {
+      aom_write_symbol(&bw, values[i], &cdfs[ctx[i] * CDF_SIZE(16)],
+                       nsyms[ctx[i]]);
+    }
+  }
+  GTEST_ASSERT_GE(aom_stop_encode(&bw), 0);
+
+  int mismatches = 0;
+  aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  for (int run = 0; run < kRuns; ++run) {
+    cdfs = init_cdfs;
+    aom_reader br;
+    aom_reader_init(&br, bw_buffer.data(), bw.pos);
+    br.allow_update_cdf = 1;
+    for (int i = 0; i < kSymbols; ++i) {
+      int value;
+      if (ctx[i] < 0) {
+        value = aom_read_bit(&br, nullptr);
+      } else if (ctx[i] > kContexts) {
+        value = aom_read(&br, ctx[i] - kContexts, nullptr);
+      } else {
+        value = aom_read_symbol(&br, &cdfs[ctx[i] * CDF_SIZE(16)],
+                                nsyms[ctx[i]], nullptr);
+      }
+      mismatches += value != values[i];
+    }
+  }
+  aom_usec_timer_mark(&timer);
+  const double elapsed = static_cast<double>(aom_usec_timer_elapsed(&timer));
+  EXPECT_EQ(mismatches, 0);
+  printf("%u bytes: %.1f Mbit/s, %.1f Msymbols/s\n", bw.pos,
+         8.0 * bw.pos * kRuns / elapsed,
+         static_cast<double>(kSymbols) * kRuns / elapsed);
+}
+
+namespace {
+
+using FindSymbolFunc = int (*)(unsigned int c, unsigned int rng,
+                               const uint16_t *icdf, int nsyms);
+using UpdateCdfFunc = void (*)(uint16_t *cdf, int val, int nsyms);
+using CdfFuncs = std::tuple<FindSymbolFunc, UpdateCdfFunc>;
+
+// Compares the SIMD CDF search and adaptation used by the entropy decoder
+// with the C versions.
+class CdfSimdTest : public ::testing::TestWithParam<CdfFuncs> {
+ public:
+  void SetUp() override {
+    find_symbol_ = std::get<0>(GetParam());
+    update_cdf_ = std::get<1>(GetParam());
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+ protected:
+  // Fills cdf with a random valid inverse CDF of nsyms symbols followed by a
+  // random adaptation counter.
+  void RandomCdf(uint16_t *cdf, int nsyms) {
+    int probs[16];
+    for (int i = 0; i < nsyms - 1; ++i) probs[i] = 1 + rnd_(CDF_PROB_TOP - 1);
+    std::sort(probs, probs + nsyms - 1);
+    for (int i = 0; i < nsyms - 1; ++i) cdf[i] = AOM_ICDF(probs[i]);
+    cdf[nsyms - 1] = AOM_ICDF(CDF_PROB_TOP);
+    cdf[nsyms] = rnd_(33);
+  }
+
+  void RunSpeedTest(int nsyms);
+
+  FindSymbolFunc find_symbol_;
+  UpdateCdfFunc update_cdf_;
+  ACMRandom rnd_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(CdfSimdTest);
+
+TEST_P(CdfSimdTest, FindSymbol) {
+  uint16_t cdf[CDF_SIZE(16)];
+  for (int iter = 0; iter < 100000; ++iter) {
+    const int nsyms = 2 + rnd_(15);
+    RandomCdf(cdf, nsyms);
+    // The decoder keeps 32768 <= rng < 65536 and the window below rng.
+    const unsigned int rng = 32768 + rnd_(32768);
+    const unsigned int c = iter & 1 ? rnd_(rng) : rng - 1 - rnd_(64);
+    const int ref = aom_ec_find_symbol_c(c, rng, cdf, nsyms);
+    int tst;
+    API_REGISTER_STATE_CHECK(tst = find_symbol_(c, rng, cdf, nsyms));
+    ASSERT_EQ(ref, tst) << "nsyms: " << nsyms << " c: " << c
+                        << " rng: " << rng;
+  }
+}
+
+TEST_P(CdfSimdTest, UpdateCdf) {
+  // The guard entries after the adaptation counter must not be touched.
+  uint16_t ref[CDF_SIZE(16) + 8];
+  uint16_t tst[CDF_SIZE(16) + 8];
+  for (int iter = 0; iter < 100000; ++iter) {
+    const int nsyms = 2 + rnd_(15);
+    for (uint16_t &p : ref) p = rnd_.Rand16();
+    RandomCdf(ref, nsyms);
+    memcpy(tst, ref, sizeof(ref));
+    const int val = rnd_(nsyms);
+    aom_update_cdf_c(ref, val, nsyms);
+    API_REGISTER_STATE_CHECK(update_cdf_(tst, val, nsyms));
+    for (size_t i = 0; i < sizeof(ref) / sizeof(ref[0]); ++i) {
+      ASSERT_EQ(ref[i], tst[i])
+          << "nsyms: " << nsyms << " val: " << val << " index: " << i;
+    }
+  }
+}
+
+// Decodes a sequence of symbols with the C and the SIMD kernels and reports
+// the throughput in symbols per second. As in a real decoder, consecutive
+// symbols are coded with different contexts.
+void CdfSimdTest::RunSpeedTest(int nsyms) {
+  const int kSymbols = 1 << 16;
+  const int kRuns = 200;
+  const int kContexts = 16;
+  std::vector<unsigned int> rng(kSymbols);
+  std::vector<unsigned int> c(kSymbols);
+  std::vector<int> ctx(kSymbols);
+  for (int i = 0; i < kSymbols; ++i) {
+    rng[i] = 32768 + rnd_(32768);
+    c[i] = rnd_(rng[i]);
+    ctx[i] = rnd_(kContexts);
+  }
+  uint16_t init_cdf[kContexts][CDF_SIZE(16)];
+  for (auto &cdf : init_cdf) RandomCdf(cdf, nsyms);
+
+  const FindSymbolFunc find_funcs[2] = { aom_ec_find_symbol_c, find_symbol_ };
+  const UpdateCdfFunc update_funcs[2] = { aom_update_cdf_c, update_cdf_ };
+  const char *names[2] = { "C", "SIMD" };
+  int checksum[2] = { 0, 0 };
+  for (int f = 0; f < 2; ++f) {
+    uint16_t cdf[kContexts][CDF_SIZE(16)];
+    memcpy(cdf, init_cdf, sizeof(cdf));
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int run = 0; run < kRuns; ++run) {
+      for (int i = 0; i < kSymbols; ++i) {
+        const int s = find_funcs[f](c[i], rng[i], cdf[ctx[i]], nsyms);
+        update_funcs[f](cdf[ctx[i]], s, nsyms);
+        checksum[f] += s;
+      }
+    }
+    aom_usec_timer_mark(&timer);
+    const double elapsed = static_cast<double>(aom_usec_timer_elapsed(&timer));
+    printf("%2d symbols %-4s: %7.1f Msymbols/s\n", nsyms, names[f],
+           static_cast<double>(kSymbols) * kRuns / elapsed);
+  }
+  EXPECT_EQ(checksum[0], checksum[1]);
+}
+
+TEST_P(CdfSimdTest, DISABLED_Speed) {
+  for (int nsyms : { 4, 8, 13, 16 }) RunSpeedTest(nsyms);
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(SSE2, CdfSimdTest,
+                         ::testing::Values(CdfFuncs(aom_ec_find_symbol_sse2,
+                                                    aom_update_cdf_sse2)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(AVX2, CdfSimdTest,
+                         ::testing::Values(CdfFuncs(aom_ec_find_symbol_avx2,
+                                                    aom_update_cdf_avx2)));
+#endif  // HAVE_AVX2
+
+}  // namespace
@@ -608,6 +608,57 @@ TEST_P(CDEFFindDirDualSpeedTest, DISABLED_TestSpeed) {
   test_finddir_dual_speed(finddir_, ref_finddir_);
 }
 
+// Times av1_cdef_filter_fb() on a fully coded 64x64 filter block of 8-bit
+// 4:2:0 video. The luma plane includes the direction search.
+TEST(CDEFFilterFbSpeedTest, DISABLED_TestSpeed) {
+  const int iterations = 20000;
+  const int kLevel = 8;
+  const int kSecStrength = 2;
+  const int kDamping = 5;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, static uint16_t, src[CDEF_INBUF_SIZE]);
+  DECLARE_ALIGNED(16, static uint8_t, dst[CDEF_BLOCKSIZE * CDEF_BLOCKSIZE]);
+  const uint16_t *const in = src + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
+  const int nblocks = CDEF_BLOCKSIZE / 8;
+  cdef_list dlist[nblocks * nblocks];
+  int dir[CDEF_NBLOCKS][CDEF_NBLOCKS] = {};
+  int var[CDEF_NBLOCKS][CDEF_NBLOCKS] = {};
+  int cdef_count = 0;
+  for (int by = 0; by < nblocks; by++) {
+    for (int bx = 0; bx < nblocks; bx++) {
+      dlist[cdef_count].by = by;
+      dlist[cdef_count].bx = bx;
+      cdef_count++;
+    }
+  }
+
+  static const char *const kPlaneNames[] = { "Y", "U", "V" };
+  for (int pli = 0; pli < 3; pli++) {
+    const int dec = pli != 0;
+    const int size = CDEF_BLOCKSIZE >> dec;
+    // Noisy diagonal ramps, so that blocks have a dominant direction.
+    for (int i = 0; i < CDEF_INBUF_SIZE; i++) {
+      const int r = i / CDEF_BSTRIDE;
+      const int c = i % CDEF_BSTRIDE;
+      src[i] = ((r * 3 + c) * 2 & 127) + rnd(32);
+    }
+
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < iterations; i++) {
+      av1_cdef_filter_fb(dst, nullptr, size, in, dec, dec, dir, nullptr, var,
+                         pli, dlist, cdef_count, kLevel, kSecStrength,
+                         kDamping, /*coeff_shift=*/0);
+    }
+    aom_usec_timer_mark(&timer);
+    const double elapsed_time =
+        static_cast<double>(aom_usec_timer_elapsed(&timer));
+    std::cout << kPlaneNames[pli] << " " << size << "x" << size << ": "
+              << iterations * size * size / elapsed_time << " Mpixels/s"
+              << std::endl;
+  }
+}
+
 TEST_P(CDEFCopyRect8to16Test, TestSIMDNoMismatch) {
   test_copy_rect_8_to_16(test_func_, ref_func_);
 }
@@ -769,6 +820,33 @@ INSTANTIATE_TEST_SUITE_P(
 #endif  // CONFIG_AV1_HIGHBITDEPTH
 #endif
 
+#if HAVE_AVX512 && CONFIG_HIGHWAY
+static const CdefFilterBlockFunctions kCdefFilterFuncAvx512[] = {
+  { &cdef_filter_8_0_avx512, &cdef_filter_8_1_avx512, &cdef_filter_8_2_avx512,
+    &cdef_filter_8_3_avx512 }
+};
+
+static const CdefFilterBlockFunctions kCdefFilterHighbdFuncAvx512[] = {
+  { &cdef_filter_16_0_avx512, &cdef_filter_16_1_avx512,
+    &cdef_filter_16_2_avx512, &cdef_filter_16_3_avx512 }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, CDEFBlockTest,
+    ::testing::Combine(::testing::ValuesIn(kCdefFilterFuncAvx512),
+                       ::testing::ValuesIn(kCdefFilterFuncC),
+                       ::testing::Values(BLOCK_4X4, BLOCK_4X8, BLOCK_8X4,
+                                         BLOCK_8X8),
+                       ::testing::Range(0, 16), ::testing::Values(8)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, CDEFBlockHighbdTest,
+    ::testing::Combine(::testing::ValuesIn(kCdefFilterHighbdFuncAvx512),
+                       ::testing::ValuesIn(kCdefFilterHighbdFuncC),
+                       ::testing::Values(BLOCK_4X4, BLOCK_4X8, BLOCK_8X4,
+                                         BLOCK_8X8),
+                       ::testing::Range(0, 16), ::testing::Range(10, 13, 2)));
+#endif  // HAVE_AVX512 && CONFIG_HIGHWAY
+
 #if HAVE_NEON
 static const CdefFilterBlockFunctions kCdefFilterFuncNeon[] = {
   { &cdef_filter_8_0_neon, &cdef_filter_8_1_neon, &cdef_filter_8_2_neon,
@@ -925,6 +1003,23 @@ INSTANTIATE_TEST_SUITE_P(AVX2, CDEFFindDirDualSpeedTest,
                                                       &cdef_find_dir_dual_c)));
 #endif
 
+#if HAVE_AVX512 && CONFIG_HIGHWAY
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, CDEFSpeedTest,
+    ::testing::Combine(::testing::ValuesIn(kCdefFilterFuncAvx512),
+                       ::testing::ValuesIn(kCdefFilterFuncC),
+                       ::testing::Values(BLOCK_4X4, BLOCK_4X8, BLOCK_8X4,
+                                         BLOCK_8X8),
+                       ::testing::Range(0, 16), ::testing::Values(8)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, CDEFSpeedHighbdTest,
+    ::testing::Combine(::testing::ValuesIn(kCdefFilterHighbdFuncAvx512),
+                       ::testing::ValuesIn(kCdefFilterHighbdFuncC),
+                       ::testing::Values(BLOCK_4X4, BLOCK_4X8, BLOCK_8X4,
+                                         BLOCK_8X8),
+                       ::testing::Range(0, 16), ::testing::Values(10)));
+#endif  // HAVE_AVX512 && CONFIG_HIGHWAY
+
 #if HAVE_NEON
 INSTANTIATE_TEST_SUITE_P(
     NEON, CDEFSpeedTest,
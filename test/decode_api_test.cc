@@ -9,12 +9,19 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "config/aom_config.h"
 
+#include "aom/aomcx.h"
 #include "aom/aomdx.h"
 #include "aom/aom_decoder.h"
+#include "aom/aom_encoder.h"
+#include "test/acm_random.h"
 
 namespace {
 
@@ -80,4 +87,434 @@ TEST(DecodeAPI, Buganizer503691210) {
   EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&dec));
 }
 
+#if CONFIG_AV1_ENCODER
+void FillImageRandom(aom_image_t *img) {
+  ::libaom_test::ACMRandom rnd;
+  rnd.Reset(::libaom_test::ACMRandom::DeterministicSeed());
+  for (int p = 0; p < 3; ++p) {
+    uint8_t *buf = img->planes[p];
+    const int h = p == 0 ? (int)img->h : (int)((img->h + 1) / 2);
+    const int w = p == 0 ? (int)img->w : (int)((img->w + 1) / 2);
+    for (int r = 0; r < h; ++r) {
+      for (int c = 0; c < w; ++c) {
+        buf[c] = rnd.Rand8();
+      }
+      buf += img->stride[p];
+    }
+  }
+}
+
+// Returns the first 'rows' luma rows of 'img' and the matching chroma rows.
+std::vector<uint8_t> CopyImageRows(const aom_image_t *img, unsigned int rows) {
+  const int bytes_per_sample = (img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  std::vector<uint8_t> data;
+  for (int plane = 0; plane < 3; ++plane) {
+    const unsigned int shift_x = plane ? img->x_chroma_shift : 0;
+    const unsigned int shift_y = plane ? img->y_chroma_shift : 0;
+    const size_t width =
+        ((img->d_w + shift_x) >> shift_x) * bytes_per_sample;
+    const unsigned int plane_rows = (rows + shift_y) >> shift_y;
+    for (unsigned int y = 0; y < plane_rows; ++y) {
+      const uint8_t *const row = img->planes[plane] + y * img->stride[plane];
+      data.insert(data.end(), row, row + width);
+    }
+  }
+  return data;
+}
+
+// Fills an 8-bit 4:2:0 image with noisy blocks that move with 'frame', which
+// the encoder codes with the in-loop filters enabled.
+void FillImageBlocks(aom_image_t *img, int frame) {
+  ::libaom_test::ACMRandom rnd;
+  rnd.Reset(::libaom_test::ACMRandom::DeterministicSeed());
+  for (int p = 0; p < 3; ++p) {
+    uint8_t *buf = img->planes[p];
+    const int h = p == 0 ? (int)img->h : (int)((img->h + 1) / 2);
+    const int w = p == 0 ? (int)img->w : (int)((img->w + 1) / 2);
+    for (int r = 0; r < h; ++r) {
+      for (int c = 0; c < w; ++c) {
+        const int block = ((r + frame) / 12 + (c + 2 * frame) / 20) & 1;
+        buf[c] = (block ? 64 : 176) + (r + c) % 24 + rnd.Rand8() % 16;
+      }
+      buf += img->stride[p];
+    }
+  }
+}
+
+// Rows of a frame reported by the row output callback of the decoder, with a
+// copy of the rows taken when they were reported.
+struct RowOutputReports {
+  std::vector<unsigned int> rows;
+  std::vector<std::vector<uint8_t>> snapshots;
+};
+
+void RecordRowOutput(void *priv, const aom_image_t *img, unsigned int rows) {
+  RowOutputReports *const reports = static_cast<RowOutputReports *>(priv);
+  reports->rows.push_back(rows);
+  reports->snapshots.push_back(CopyImageRows(img, rows));
+}
+
+// Encodes frames, with CDEF enabled or not, then decodes them with the given
+// number of threads and checks that the rows reported by the row output
+// callback were final.
+void DecodeWithRowOutput(bool enable_cdef, int threads,
+                         int *num_partial_reports) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_ENABLE_CDEF, enable_cdef ? 1 : 0),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  std::vector<std::vector<uint8_t>> frames;
+  for (int frame = 0; frame < 4; ++frame) {
+    FillImageRandom(image);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames.emplace_back(buf, buf + pkt->data.frame.sz);
+    }
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+
+  aom_codec_dec_cfg_t dec_cfg = {};
+  dec_cfg.threads = threads;
+  aom_codec_ctx_t dec;
+  ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+            AOM_CODEC_OK);
+  RowOutputReports reports;
+  aom_row_output_init row_output = { RecordRowOutput, &reports };
+  ASSERT_EQ(aom_codec_control(&dec, AV1D_SET_ROW_OUTPUT_CB, &row_output),
+            AOM_CODEC_OK);
+  for (const std::vector<uint8_t> &frame : frames) {
+    reports = RowOutputReports();
+    ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+              AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_image_t *img = aom_codec_get_frame(&dec, &iter);
+    ASSERT_NE(img, nullptr);
+    ASSERT_FALSE(reports.rows.empty());
+    EXPECT_EQ(reports.rows.back(), img->d_h);
+    for (size_t i = 0; i < reports.rows.size(); ++i) {
+      if (i > 0) {
+        EXPECT_GT(reports.rows[i], reports.rows[i - 1]);
+      }
+      EXPECT_EQ(reports.snapshots[i], CopyImageRows(img, reports.rows[i]));
+    }
+    *num_partial_reports += static_cast<int>(reports.rows.size()) - 1;
+  }
+  ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+}
+
+TEST(DecodeAPI, RowOutput) {
+  for (bool enable_cdef : { false, true }) {
+    for (int threads : { 1, 4 }) {
+      SCOPED_TRACE(testing::Message() << "enable_cdef: " << enable_cdef
+                                      << " threads: " << threads);
+      int num_partial_reports = 0;
+      ASSERT_NO_FATAL_FAILURE(
+          DecodeWithRowOutput(enable_cdef, threads, &num_partial_reports));
+      // The rows of some of the frames are reported before the frame is done.
+      EXPECT_GT(num_partial_reports, 0);
+    }
+  }
+}
+
+// The deblocking filter and CDEF run as one pass when the decoder has several
+// threads. Checks that the pass, which also saves the deblocked lines used by
+// loop restoration, produces the same frames as the single threaded decoder.
+TEST(DecodeAPI, LoopFilterCdefMultiThread) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_GOOD_QUALITY),
+            AOM_CODEC_OK);
+  cfg.g_w = 200;
+  cfg.g_h = 250;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_end_usage = AOM_Q;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 2), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CQ_LEVEL, 52), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_ENABLE_RESTORATION, 1),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  std::vector<std::vector<uint8_t>> frames;
+  for (int frame = 0; frame < 3; ++frame) {
+    FillImageBlocks(image, frame);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames.emplace_back(buf, buf + pkt->data.frame.sz);
+    }
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+
+  std::vector<std::vector<uint8_t>> decoded[2];
+  const int threads[2] = { 1, 4 };
+  for (int i = 0; i < 2; ++i) {
+    aom_codec_dec_cfg_t dec_cfg = {};
+    dec_cfg.threads = threads[i];
+    aom_codec_ctx_t dec;
+    ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+              AOM_CODEC_OK);
+    for (const std::vector<uint8_t> &frame : frames) {
+      ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+                AOM_CODEC_OK);
+      aom_codec_iter_t iter = nullptr;
+      const aom_image_t *img = aom_codec_get_frame(&dec, &iter);
+      ASSERT_NE(img, nullptr);
+      decoded[i].push_back(CopyImageRows(img, img->d_h));
+    }
+    ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+  }
+  EXPECT_EQ(decoded[0], decoded[1]);
+}
+
+TEST(DecodeAPI, FrameDecodeTime) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_TILE_COLUMNS, 1), AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  FillImageRandom(image);
+  ASSERT_EQ(aom_codec_encode(&enc, image, 0, 1, 0), AOM_CODEC_OK);
+  aom_img_free(image);
+  aom_codec_iter_t iter = nullptr;
+  const aom_codec_cx_pkt_t *pkt = aom_codec_get_cx_data(&enc, &iter);
+  ASSERT_NE(pkt, nullptr);
+  ASSERT_EQ(pkt->kind, AOM_CODEC_CX_FRAME_PKT);
+  const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+  const std::vector<uint8_t> frame(buf, buf + pkt->data.frame.sz);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+
+  for (int threads : { 1, 4 }) {
+    aom_codec_dec_cfg_t dec_cfg = {};
+    dec_cfg.threads = threads;
+    aom_codec_ctx_t dec;
+    ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+              AOM_CODEC_OK);
+    aom_frame_decode_time_t time;
+    // No frame is decoded yet.
+    EXPECT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_DECODE_TIME, &time),
+              AOM_CODEC_ERROR);
+    ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+              AOM_CODEC_OK);
+    ASSERT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_DECODE_TIME, &time),
+              AOM_CODEC_OK);
+    EXPECT_GE(time.tiles_decode_us, 0);
+    EXPECT_GE(time.decode_us, time.tiles_decode_us);
+    EXPECT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_DECODE_TIME, nullptr),
+              AOM_CODEC_INVALID_PARAM);
+    ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+  }
+}
+
+TEST(DecodeAPI, FrameStageStats) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  std::vector<std::vector<uint8_t>> frames;
+  for (int frame = 0; frame < 4; ++frame) {
+    FillImageBlocks(image, frame);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames.emplace_back(buf, buf + pkt->data.frame.sz);
+    }
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+
+  for (int block_stage_timing : { 0, 1 }) {
+    for (int threads : { 1, 4 }) {
+      SCOPED_TRACE(testing::Message()
+                   << "block_stage_timing: " << block_stage_timing
+                   << " threads: " << threads);
+      aom_codec_dec_cfg_t dec_cfg = {};
+      dec_cfg.threads = threads;
+      aom_codec_ctx_t dec;
+      ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+                AOM_CODEC_OK);
+      aom_dec_stage_stats_t stats;
+      // No frame is decoded yet.
+      EXPECT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_STAGE_STATS, &stats),
+                AOM_CODEC_ERROR);
+      ASSERT_EQ(aom_codec_control(&dec, AV1D_SET_BLOCK_STAGE_TIMING,
+                                  block_stage_timing),
+                AOM_CODEC_OK);
+      int64_t block_stage_us = 0;
+      for (const std::vector<uint8_t> &frame : frames) {
+        ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+                  AOM_CODEC_OK);
+        aom_codec_iter_t iter = nullptr;
+        ASSERT_NE(aom_codec_get_frame(&dec, &iter), nullptr);
+        ASSERT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_STAGE_STATS, &stats),
+                  AOM_CODEC_OK);
+        for (int i = 0; i < AOM_DEC_STAGE_COUNT; ++i) {
+          EXPECT_GE(stats.stage_us[i], 0);
+        }
+        EXPECT_GE(stats.idle_us, 0);
+        EXPECT_GT(stats.num_blocks, 0u);
+        EXPECT_GT(stats.num_coded_tx_blocks, 0u);
+        // The film grain stage is only timed when grain is applied.
+        EXPECT_EQ(stats.stage_us[AOM_DEC_STAGE_FILM_GRAIN], 0);
+        block_stage_us += stats.stage_us[AOM_DEC_STAGE_ENTROPY_DECODE] +
+                          stats.stage_us[AOM_DEC_STAGE_PREDICTION] +
+                          stats.stage_us[AOM_DEC_STAGE_INVERSE_TRANSFORM];
+      }
+      if (block_stage_timing) {
+        EXPECT_GT(block_stage_us, 0);
+      } else {
+        EXPECT_EQ(block_stage_us, 0);
+      }
+      EXPECT_EQ(aom_codec_control(&dec, AV1D_GET_FRAME_STAGE_STATS, nullptr),
+                AOM_CODEC_INVALID_PARAM);
+      ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+    }
+  }
+}
+
+// Frame buffers handed out by the get frame buffer callback of the decoder.
+struct CountingFrameBuffers {
+  int num_gets = 0;
+  int num_in_use = 0;
+};
+
+int GetCountingFrameBuffer(void *priv, size_t min_size,
+                           aom_codec_frame_buffer_t *fb) {
+  CountingFrameBuffers *const buffers =
+      static_cast<CountingFrameBuffers *>(priv);
+  fb->data = static_cast<uint8_t *>(calloc(min_size, 1));
+  if (fb->data == nullptr) return -1;
+  fb->size = min_size;
+  fb->priv = nullptr;
+  buffers->num_gets++;
+  buffers->num_in_use++;
+  return 0;
+}
+
+int ReleaseCountingFrameBuffer(void *priv, aom_codec_frame_buffer_t *fb) {
+  CountingFrameBuffers *const buffers =
+      static_cast<CountingFrameBuffers *>(priv);
+  free(fb->data);
+  fb->data = nullptr;
+  buffers->num_in_use--;
+  return 0;
+}
+
+TEST(DecodeAPI, InPlaceFilmGrain) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 176;
+  cfg.g_h = 144;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_FILM_GRAIN_TEST_VECTOR, 1),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  std::vector<std::vector<uint8_t>> frames;
+  constexpr int kNumFrames = 8;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    FillImageBlocks(image, frame);
+    // Every other frame is not used as a reference, so its grain can be
+    // added in place.
+    aom_svc_ref_frame_config_t ref_frame_config = {};
+    ref_frame_config.reference[0] = 1;
+    ref_frame_config.refresh[0] = !(frame & 1);
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_SVC_REF_FRAME_CONFIG,
+                                &ref_frame_config),
+              AOM_CODEC_OK);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames.emplace_back(buf, buf + pkt->data.frame.sz);
+    }
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+
+  for (int threads : { 1, 4 }) {
+    SCOPED_TRACE(testing::Message() << "threads: " << threads);
+    std::vector<std::vector<uint8_t>> outputs[2];
+    CountingFrameBuffers buffers[2];
+    for (int in_place : { 0, 1 }) {
+      aom_codec_dec_cfg_t dec_cfg = {};
+      dec_cfg.threads = threads;
+      aom_codec_ctx_t dec;
+      ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+                AOM_CODEC_OK);
+      ASSERT_EQ(aom_codec_set_frame_buffer_functions(
+                    &dec, GetCountingFrameBuffer, ReleaseCountingFrameBuffer,
+                    &buffers[in_place]),
+                AOM_CODEC_OK);
+      ASSERT_EQ(
+          aom_codec_control(&dec, AV1D_SET_INPLACE_FILM_GRAIN, in_place),
+          AOM_CODEC_OK);
+      for (const std::vector<uint8_t> &frame : frames) {
+        ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+                  AOM_CODEC_OK);
+        aom_codec_iter_t iter = nullptr;
+        const aom_image_t *img;
+        while ((img = aom_codec_get_frame(&dec, &iter)) != nullptr) {
+          outputs[in_place].push_back(CopyImageRows(img, img->d_h));
+        }
+      }
+      ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+      EXPECT_EQ(buffers[in_place].num_in_use, 0);
+    }
+    ASSERT_EQ(outputs[0].size(), static_cast<size_t>(kNumFrames));
+    EXPECT_EQ(outputs[0], outputs[1]);
+    // The frames that are not kept as references do not need a second
+    // buffer for the grain.
+    EXPECT_EQ(buffers[1].num_gets, buffers[0].num_gets - kNumFrames / 2);
+  }
+}
+#endif  // CONFIG_AV1_ENCODER
+
 }  // namespace
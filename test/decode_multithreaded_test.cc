@@ -179,4 +179,105 @@ AV1_INSTANTIATE_TEST_SUITE(AV1DecodeMultiThreadedLSTestLarge,
                            ::testing::Values(1), ::testing::Values(0, 3),
                            ::testing::Values(0, 1));
 
+class AV1DecodeFrameParallelTest
+    : public ::libaom_test::CodecTestWith2Params<int, int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  AV1DecodeFrameParallelTest()
+      : EncoderTest(GET_PARAM(0)), n_tile_cols_(GET_PARAM(1)),
+        lag_in_frames_(GET_PARAM(2)), num_serial_frames_(0),
+        num_frame_parallel_frames_(0) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.allow_lowbitdepth = 1;
+    cfg.threads = 1;
+    serial_dec_ = codec_->CreateDecoder(cfg, 0);
+    cfg.threads = 2;
+    frame_parallel_dec_ = codec_->CreateDecoder(cfg, 0);
+    frame_parallel_dec_->Control(AV1D_SET_FRAME_PARALLEL, 1);
+  }
+
+  ~AV1DecodeFrameParallelTest() override {
+    delete serial_dec_;
+    delete frame_parallel_dec_;
+  }
+
+  void SetUp() override { InitializeConfig(libaom_test::kTwoPassGood); }
+
+  void PreEncodeFrameHook(libaom_test::VideoSource *video,
+                          libaom_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(AV1E_SET_TILE_COLUMNS, n_tile_cols_);
+      encoder->Control(AOME_SET_CPUUSED, 5);
+    }
+  }
+
+  // Adds all the frames output by the last decode call to 'md5'.
+  static int AddFrames(::libaom_test::Decoder *dec, ::libaom_test::MD5 *md5) {
+    int num_frames = 0;
+    ::libaom_test::DxDataIterator dec_iter = dec->GetDxData();
+    const aom_image_t *img;
+    while ((img = dec_iter.Next()) != nullptr) {
+      md5->Add(img);
+      ++num_frames;
+    }
+    return num_frames;
+  }
+
+  void FramePktHook(const aom_codec_cx_pkt_t *pkt) override {
+    const uint8_t *const data =
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf);
+    aom_codec_err_t res = serial_dec_->DecodeFrame(data, pkt->data.frame.sz);
+    if (res != AOM_CODEC_OK) {
+      abort_ = true;
+      ASSERT_EQ(AOM_CODEC_OK, res) << serial_dec_->DecodeError();
+    }
+    num_serial_frames_ += AddFrames(serial_dec_, &md5_serial_);
+
+    res = frame_parallel_dec_->DecodeFrame(data, pkt->data.frame.sz);
+    if (res != AOM_CODEC_OK) {
+      abort_ = true;
+      ASSERT_EQ(AOM_CODEC_OK, res) << frame_parallel_dec_->DecodeError();
+    }
+    num_frame_parallel_frames_ +=
+        AddFrames(frame_parallel_dec_, &md5_frame_parallel_);
+  }
+
+  void DoTest() {
+    cfg_.rc_target_bitrate = 500;
+    cfg_.g_lag_in_frames = lag_in_frames_;
+    cfg_.rc_end_usage = AOM_VBR;
+
+    libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, 20);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+    // The last temporal unit is output by the flush.
+    ASSERT_EQ(AOM_CODEC_OK, frame_parallel_dec_->DecodeFrame(nullptr, 0));
+    num_frame_parallel_frames_ +=
+        AddFrames(frame_parallel_dec_, &md5_frame_parallel_);
+
+    EXPECT_GT(num_serial_frames_, 0);
+    EXPECT_EQ(num_serial_frames_, num_frame_parallel_frames_);
+    ASSERT_STREQ(md5_serial_.Get(), md5_frame_parallel_.Get());
+  }
+
+ private:
+  int n_tile_cols_;
+  int lag_in_frames_;
+  int num_serial_frames_;
+  int num_frame_parallel_frames_;
+  ::libaom_test::MD5 md5_serial_;
+  ::libaom_test::MD5 md5_frame_parallel_;
+  ::libaom_test::Decoder *serial_dec_;
+  ::libaom_test::Decoder *frame_parallel_dec_;
+};
+
+// Decode the same stream serially and with frame-parallel decoding, which
+// starts each temporal unit before the previous one is done. Both must output
+// the same frames.
+TEST_P(AV1DecodeFrameParallelTest, MD5Match) { DoTest(); }
+
+AV1_INSTANTIATE_TEST_SUITE(AV1DecodeFrameParallelTest, ::testing::Values(0, 1),
+                           ::testing::Values(0, 12));
+
 }  // namespace
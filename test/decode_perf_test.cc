@@ -9,10 +9,14 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <algorithm>
+#include <cinttypes>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "aom/aom_codec.h"
+#include "aom/aomdx.h"
 #include "aom_ports/aom_timer.h"
 #include "common/ivfenc.h"
 #include "test/codec_factory.h"
@@ -53,6 +57,40 @@ using DecodePerfParam = std::tuple<const char *, unsigned int>;
    power/temp/min max frame decode times/etc
  */
 
+// Collects the decode time of each call to aom_codec_decode() to report the
+// tail latency of the frames.
+class FrameDecodeTimes {
+ public:
+  void Add(libaom_test::Decoder *decoder) {
+    aom_frame_decode_time_t time;
+    if (aom_codec_control(decoder->GetDecoder(), AV1D_GET_FRAME_DECODE_TIME,
+                          &time) != AOM_CODEC_OK) {
+      return;
+    }
+    decode_us_.push_back(time.decode_us);
+    tiles_decode_us_.push_back(time.tiles_decode_us);
+  }
+
+  // Prints the maximum and 99th percentile of the times, in microseconds, as
+  // JSON members followed by a comma.
+  void Print() {
+    Print("FrameDecode", &decode_us_);
+    Print("TilesDecode", &tiles_decode_us_);
+  }
+
+ private:
+  static void Print(const char *name, std::vector<int64_t> *times) {
+    if (times->empty()) return;
+    std::sort(times->begin(), times->end());
+    const size_t p99 = (times->size() - 1) * 99 / 100;
+    printf("\t\"max%sTimeUs\" : %" PRId64 ",\n", name, times->back());
+    printf("\t\"p99%sTimeUs\" : %" PRId64 ",\n", name, (*times)[p99]);
+  }
+
+  std::vector<int64_t> decode_us_;
+  std::vector<int64_t> tiles_decode_us_;
+};
+
 class DecodePerfTest : public ::testing::TestWithParam<DecodePerfParam> {};
 
 TEST_P(DecodePerfTest, PerfTest) {
@@ -67,11 +105,13 @@ TEST_P(DecodePerfTest, PerfTest) {
   cfg.allow_lowbitdepth = 1;
   libaom_test::AV1Decoder decoder(cfg, 0);
 
+  FrameDecodeTimes frame_times;
   aom_usec_timer t;
   aom_usec_timer_start(&t);
 
   for (video.Begin(); video.cxdata() != nullptr; video.Next()) {
     decoder.DecodeFrame(video.cxdata(), video.frame_size());
+    frame_times.Add(&decoder);
   }
 
   aom_usec_timer_mark(&t);
@@ -86,6 +126,7 @@ TEST_P(DecodePerfTest, PerfTest) {
   printf("\t\"threadCount\" : %u,\n", threads);
   printf("\t\"decodeTimeSecs\" : %f,\n", elapsed_secs);
   printf("\t\"totalFrames\" : %u,\n", frames);
+  frame_times.Print();
   printf("\t\"framesPerSecond\" : %f\n", fps);
   printf("}\n");
 }
@@ -215,12 +256,14 @@ TEST_P(AV1NewEncodeDecodePerfTest, PerfTest) {
   cfg.allow_lowbitdepth = 1;
   libaom_test::AV1Decoder decoder(cfg, 0);
 
+  FrameDecodeTimes frame_times;
   aom_usec_timer t;
   aom_usec_timer_start(&t);
 
   for (decode_video.Begin(); decode_video.cxdata() != nullptr;
        decode_video.Next()) {
     decoder.DecodeFrame(decode_video.cxdata(), decode_video.frame_size());
+    frame_times.Add(&decoder);
   }
 
   aom_usec_timer_mark(&t);
@@ -236,6 +279,7 @@ TEST_P(AV1NewEncodeDecodePerfTest, PerfTest) {
   printf("\t\"threadCount\" : %u,\n", threads);
   printf("\t\"decodeTimeSecs\" : %f,\n", elapsed_secs);
   printf("\t\"totalFrames\" : %u,\n", decode_frames);
+  frame_times.Print();
   printf("\t\"framesPerSecond\" : %f\n", fps);
   printf("}\n");
 }
@@ -18,7 +18,11 @@
 #include <cstring>
 #include <initializer_list>
 #include <memory>
+#include <new>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -27,10 +31,16 @@
 #include "aom/aomcx.h"
 #include "aom/aom_encoder.h"
 #include "aom/aom_image.h"
+#include "aom/aom_thread_pool.h"
+#if CONFIG_AV1_DECODER
+#include "aom/aom_decoder.h"
+#include "aom/aomdx.h"
+#endif
 #include "aom_mem/aom_mem.h"
 
 #include "test/codec_factory.h"
 #include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
 #include "test/util.h"
 #include "test/video_source.h"
 
@@ -2684,4 +2694,662 @@ TEST(EncodeAPI, Buganizer503810640V2) {
   ASSERT_EQ(aom_codec_destroy(&codec), AOM_CODEC_OK);
 }
 
+#if CONFIG_MULTITHREAD
+// Encodes 'num_frames' copies of 'image' with 'enc' and appends the frames
+// it outputs to 'frames'. Returns the first error.
+aom_codec_err_t EncodeFrames(aom_codec_ctx_t *enc, const aom_image_t *image,
+                             int num_frames,
+                             std::vector<std::vector<uint8_t>> *frames) {
+  for (int frame = 0; frame < num_frames; ++frame) {
+    const aom_codec_err_t res = aom_codec_encode(enc, image, frame, 1, 0);
+    if (res != AOM_CODEC_OK) return res;
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames->emplace_back(buf, buf + pkt->data.frame.sz);
+    }
+  }
+  return AOM_CODEC_OK;
+}
+
+// Encoders (and a decoder) sharing an application-owned thread pool must
+// produce the same output as instances running their own threads. The
+// encoders sharing the pool run concurrently, each on its own thread.
+TEST(EncodeAPI, SharedThreadPool) {
+  constexpr int kNumEncoders = 3;
+  constexpr int kNumFrames = 4;
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 640;
+  cfg.g_h = 480;
+  cfg.g_threads = 4;
+
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  FillImageRandom(image);
+
+  // Fewer threads than the encoders have workers, so that jobs of different
+  // encoders queue up behind each other.
+  aom_thread_pool_t *pool = aom_thread_pool_create(2);
+  ASSERT_NE(pool, nullptr);
+
+  // frames[shared][encoder][frame]
+  std::vector<std::vector<uint8_t>> frames[2][kNumEncoders];
+  for (int shared = 0; shared < 2; ++shared) {
+    aom_codec_ctx_t enc[kNumEncoders];
+    for (aom_codec_ctx_t &codec : enc) {
+      ASSERT_EQ(aom_codec_enc_init(&codec, iface, &cfg, 0), AOM_CODEC_OK);
+      ASSERT_EQ(aom_codec_control(&codec, AOME_SET_CPUUSED, 9), AOM_CODEC_OK);
+      if (shared) {
+        ASSERT_EQ(aom_codec_control(&codec, AV1E_SET_THREAD_POOL, pool),
+                  AOM_CODEC_OK);
+      }
+    }
+    if (shared) {
+      aom_codec_err_t res[kNumEncoders];
+      std::vector<std::thread> threads;
+      for (int i = 0; i < kNumEncoders; ++i) {
+        threads.emplace_back([&, i]() {
+          res[i] = EncodeFrames(&enc[i], image, kNumFrames, &frames[1][i]);
+        });
+      }
+      for (std::thread &thread : threads) thread.join();
+      for (int i = 0; i < kNumEncoders; ++i) {
+        ASSERT_EQ(res[i], AOM_CODEC_OK) << "encoder " << i;
+      }
+    } else {
+      for (int i = 0; i < kNumEncoders; ++i) {
+        ASSERT_EQ(EncodeFrames(&enc[i], image, kNumFrames, &frames[0][i]),
+                  AOM_CODEC_OK);
+      }
+    }
+    // The pool cannot be attached once the encoder has created its workers.
+    EXPECT_EQ(aom_codec_control(&enc[0], AV1E_SET_THREAD_POOL, pool),
+              AOM_CODEC_ERROR);
+    for (aom_codec_ctx_t &codec : enc) {
+      ASSERT_EQ(aom_codec_destroy(&codec), AOM_CODEC_OK);
+    }
+  }
+  for (int i = 0; i < kNumEncoders; ++i) {
+    EXPECT_EQ(frames[0][i].size(), static_cast<size_t>(kNumFrames));
+    EXPECT_EQ(frames[0][i], frames[1][i]);
+  }
+
+#if CONFIG_AV1_DECODER
+  std::string md5[2];
+  for (int shared = 0; shared < 2; ++shared) {
+    aom_codec_dec_cfg_t dec_cfg = {};
+    dec_cfg.threads = 4;
+    aom_codec_ctx_t dec;
+    ASSERT_EQ(aom_codec_dec_init(&dec, aom_codec_av1_dx(), &dec_cfg, 0),
+              AOM_CODEC_OK);
+    if (shared) {
+      ASSERT_EQ(aom_codec_control(&dec, AV1D_SET_THREAD_POOL, pool),
+                AOM_CODEC_OK);
+    }
+    ::libaom_test::MD5 md5_dec;
+    for (const std::vector<uint8_t> &frame : frames[1][0]) {
+      ASSERT_EQ(aom_codec_decode(&dec, frame.data(), frame.size(), nullptr),
+                AOM_CODEC_OK);
+      aom_codec_iter_t iter = nullptr;
+      const aom_image_t *img;
+      while ((img = aom_codec_get_frame(&dec, &iter)) != nullptr) {
+        md5_dec.Add(img);
+      }
+    }
+    md5[shared] = md5_dec.Get();
+    ASSERT_EQ(aom_codec_destroy(&dec), AOM_CODEC_OK);
+  }
+  EXPECT_EQ(md5[0], md5[1]);
+#endif  // CONFIG_AV1_DECODER
+
+  aom_thread_pool_destroy(pool);
+  aom_img_free(image);
+}
+#endif  // CONFIG_MULTITHREAD
+
+#if !CONFIG_REALTIME_ONLY
+// Once every coding stage has run, the per-frame scratch buffers are served
+// from the buffers freed by earlier frames without any heap allocation.
+TEST(EncodeAPI, ScratchMemStats) {
+  constexpr int kNumFrames = 24;
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_GOOD_QUALITY),
+            AOM_CODEC_OK);
+  cfg.g_w = 176;
+  cfg.g_h = 144;
+  cfg.g_threads = 2;
+  cfg.g_lag_in_frames = 8;
+
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 5), AOM_CODEC_OK);
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_GET_SCRATCH_MEM_STATS, nullptr),
+            AOM_CODEC_INVALID_PARAM);
+
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+
+  aom_scratch_mem_stats_t stats[2];
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      FillImageRandom(image);
+      ASSERT_EQ(aom_codec_encode(&enc, image, pass * kNumFrames + frame, 1, 0),
+                AOM_CODEC_OK);
+      aom_codec_iter_t iter = nullptr;
+      while (aom_codec_get_cx_data(&enc, &iter) != nullptr) {
+      }
+    }
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_GET_SCRATCH_MEM_STATS, &stats[pass]),
+              AOM_CODEC_OK);
+  }
+  EXPECT_GT(stats[0].peak_bytes, 0u);
+  EXPECT_GT(stats[0].num_heap_allocs, 0u);
+  EXPECT_GT(stats[1].num_allocs, stats[0].num_allocs);
+  EXPECT_EQ(stats[1].num_heap_allocs, stats[0].num_heap_allocs);
+  EXPECT_EQ(stats[1].peak_bytes, stats[0].peak_bytes);
+
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+// Encodes a few frames with the given memory budget (in MiB, 0 = none) and
+// returns the memory usage reported by the encoder.
+void EncodeWithMemoryBudget(unsigned int budget_mib,
+                            aom_memory_usage_t *usage) {
+  constexpr int kNumFrames = 32;
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_GOOD_QUALITY),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  cfg.g_threads = 4;
+  cfg.g_lag_in_frames = 16;
+
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 6), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_MEMORY_BUDGET, budget_mib),
+            AOM_CODEC_OK);
+
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    FillImageRandom(image);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    while (aom_codec_get_cx_data(&enc, &iter) != nullptr) {
+    }
+  }
+  // The budget can only be set before the first frame.
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_MEMORY_BUDGET, 0u),
+            AOM_CODEC_INVALID_PARAM);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_GET_MEMORY_USAGE, usage),
+            AOM_CODEC_OK);
+
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+TEST(EncodeAPI, MemoryBudget) {
+  aom_memory_usage_t usage;
+  ASSERT_NO_FATAL_FAILURE(EncodeWithMemoryBudget(0, &usage));
+  EXPECT_GT(usage.lookahead_bytes, 0u);
+  EXPECT_GT(usage.tpl_bytes, 0u);
+  EXPECT_GT(usage.frame_buffer_bytes, 0u);
+  EXPECT_GT(usage.thread_data_bytes, 0u);
+  EXPECT_EQ(usage.total_bytes,
+            usage.lookahead_bytes + usage.tpl_bytes +
+                usage.frame_buffer_bytes + usage.thread_data_bytes);
+  EXPECT_GE(usage.peak_total_bytes, usage.total_bytes);
+
+  // A budget below the unconstrained usage makes the encoder scale down.
+  const unsigned int budget_mib =
+      static_cast<unsigned int>(usage.peak_total_bytes >> 20);
+  aom_memory_usage_t budget_usage;
+  ASSERT_NO_FATAL_FAILURE(EncodeWithMemoryBudget(budget_mib, &budget_usage));
+  EXPECT_LE(budget_usage.peak_total_bytes, uint64_t{ budget_mib } << 20);
+  EXPECT_LT(budget_usage.peak_total_bytes, usage.peak_total_bytes);
+}
+
+TEST(EncodeAPI, MemoryBudgetTooSmall) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_GOOD_QUALITY),
+            AOM_CODEC_OK);
+  cfg.g_w = 1920;
+  cfg.g_h = 1080;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_MEMORY_BUDGET, 1u),
+            AOM_CODEC_INVALID_PARAM);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+#endif  // !CONFIG_REALTIME_ONLY
+
+void CountSourceFrameRelease(void *cb_priv, void *user_priv) {
+  std::vector<int> *const releases = static_cast<std::vector<int> *>(cb_priv);
+  ++(*releases)[reinterpret_cast<intptr_t>(user_priv)];
+}
+
+// Encodes frames with a moving pattern, either copying them into the
+// lookahead or letting the encoder reference them, and returns the stream.
+void EncodeSourceFrames(bool zero_copy, std::vector<uint8_t> *stream,
+                        std::vector<int> *releases) {
+  constexpr int kNumFrames = 10;
+  constexpr int kWidth = 176;
+  constexpr int kHeight = 144;
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, kUsage), AOM_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 4;
+
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 6), AOM_CODEC_OK);
+  int border = 0;
+  if (zero_copy) {
+    aom_source_frame_cb_t cb = { CountSourceFrameRelease, releases };
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_SOURCE_FRAME_CB, &cb),
+              AOM_CODEC_OK);
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_GET_SOURCE_BORDER, &border),
+              AOM_CODEC_OK);
+    EXPECT_GT(border, 0);
+    releases->assign(kNumFrames, 0);
+  }
+
+  std::vector<aom_image_t> images(kNumFrames);
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    aom_image_t *const img = &images[frame];
+    ASSERT_NE(aom_img_alloc_with_border(img, AOM_IMG_FMT_I420, kWidth, kHeight,
+                                        32, 1, border),
+              nullptr);
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane == 0 ? kWidth : (kWidth + 1) / 2;
+      const int h = plane == 0 ? kHeight : (kHeight + 1) / 2;
+      for (int r = 0; r < h; ++r) {
+        for (int c = 0; c < w; ++c) {
+          img->planes[plane][r * img->stride[plane] + c] =
+              static_cast<uint8_t>((r + c + 2 * frame) * 4);
+        }
+      }
+    }
+    img->user_priv = reinterpret_cast<void *>(static_cast<intptr_t>(frame));
+  }
+
+  for (int frame = 0; frame <= kNumFrames; ++frame) {
+    aom_image_t *const img = frame < kNumFrames ? &images[frame] : nullptr;
+    ASSERT_EQ(aom_codec_encode(&enc, img, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      stream->insert(stream->end(), buf, buf + pkt->data.frame.sz);
+    }
+  }
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+  for (aom_image_t &img : images) aom_img_free(&img);
+}
+
+TEST(EncodeAPI, ZeroCopySource) {
+  std::vector<uint8_t> copied_stream;
+  std::vector<uint8_t> referenced_stream;
+  std::vector<int> releases;
+  ASSERT_NO_FATAL_FAILURE(EncodeSourceFrames(false, &copied_stream, nullptr));
+  ASSERT_NO_FATAL_FAILURE(
+      EncodeSourceFrames(true, &referenced_stream, &releases));
+  EXPECT_FALSE(copied_stream.empty());
+  EXPECT_EQ(copied_stream, referenced_stream);
+  // Every frame is released exactly once.
+  for (int count : releases) EXPECT_EQ(count, 1);
+}
+
+TEST(EncodeAPI, ZeroCopySourceBorderTooSmall) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, kUsage), AOM_CODEC_OK);
+  cfg.g_w = 176;
+  cfg.g_h = 144;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  std::vector<int> releases(1, 0);
+  aom_source_frame_cb_t cb = { CountSourceFrameRelease, &releases };
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_SOURCE_FRAME_CB, &cb),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 32);
+  ASSERT_NE(image, nullptr);
+  FillImage(image, 128);
+  EXPECT_EQ(aom_codec_encode(&enc, image, 0, 1, 0), AOM_CODEC_INVALID_PARAM);
+  // The callback can no longer be changed once encoding has started.
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_SOURCE_FRAME_CB, &cb),
+            AOM_CODEC_ERROR);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+  aom_img_free(image);
+  // Refused images are not taken.
+  EXPECT_EQ(releases[0], 0);
+}
+
+// Frame buffers handed out to the encoder through
+// AV1E_SET_FRAME_BUFFER_FUNCTIONS.
+struct EncoderFrameBuffers {
+  std::vector<std::unique_ptr<uint8_t[]>> buffers;
+  std::vector<int> releases;
+
+  static int Get(void *priv, size_t min_size, aom_codec_frame_buffer_t *fb) {
+    EncoderFrameBuffers *const self = static_cast<EncoderFrameBuffers *>(priv);
+    self->buffers.emplace_back(new (std::nothrow) uint8_t[min_size]());
+    if (self->buffers.back() == nullptr) return -1;
+    self->releases.push_back(0);
+    fb->data = self->buffers.back().get();
+    fb->size = min_size;
+    fb->priv = reinterpret_cast<void *>(
+        static_cast<intptr_t>(self->buffers.size() - 1));
+    return 0;
+  }
+
+  static int Release(void *priv, aom_codec_frame_buffer_t *fb) {
+    EncoderFrameBuffers *const self = static_cast<EncoderFrameBuffers *>(priv);
+    const size_t index = reinterpret_cast<intptr_t>(fb->priv);
+    if (index >= self->buffers.size() ||
+        fb->data != self->buffers[index].get()) {
+      return -1;
+    }
+    ++self->releases[index];
+    return 0;
+  }
+};
+
+// Encodes frames at 88x72 and then 176x144, with the frame buffers of the
+// encoder obtained from 'frame_buffers' if it is not null.
+void EncodeWithResolutionSwitch(EncoderFrameBuffers *frame_buffers,
+                                std::vector<uint8_t> *stream,
+                                int *releases_before_destroy) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, kUsage), AOM_CODEC_OK);
+  cfg.g_w = 88;
+  cfg.g_h = 72;
+  cfg.g_forced_max_frame_width = 176;
+  cfg.g_forced_max_frame_height = 144;
+  cfg.g_lag_in_frames = 0;
+
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 6), AOM_CODEC_OK);
+  aom_frame_buffer_functions_t fns = { EncoderFrameBuffers::Get,
+                                       EncoderFrameBuffers::Release,
+                                       frame_buffers };
+  if (frame_buffers != nullptr) {
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_FRAME_BUFFER_FUNCTIONS, &fns),
+              AOM_CODEC_OK);
+  }
+
+  int pts = 0;
+  for (int size = 1; size <= 2; ++size) {
+    if (size == 2) {
+      cfg.g_w = 176;
+      cfg.g_h = 144;
+      ASSERT_EQ(aom_codec_enc_config_set(&enc, &cfg), AOM_CODEC_OK);
+    }
+    aom_image_t *image =
+        aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+    ASSERT_NE(image, nullptr);
+    for (int frame = 0; frame < 4; ++frame, ++pts) {
+      FillImage(image, static_cast<uint8_t>(64 + 16 * pts));
+      ASSERT_EQ(aom_codec_encode(&enc, image, pts, 1, 0), AOM_CODEC_OK);
+      aom_codec_iter_t iter = nullptr;
+      const aom_codec_cx_pkt_t *pkt;
+      while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+        if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+        const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+        stream->insert(stream->end(), buf, buf + pkt->data.frame.sz);
+      }
+    }
+    aom_img_free(image);
+  }
+  if (frame_buffers != nullptr) {
+    // The frame buffer functions can no longer be changed.
+    EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_FRAME_BUFFER_FUNCTIONS, &fns),
+              AOM_CODEC_ERROR);
+    *releases_before_destroy = 0;
+    for (int count : frame_buffers->releases) {
+      *releases_before_destroy += count;
+    }
+  }
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+TEST(EncodeAPI, ExternalFrameBuffers) {
+  std::vector<uint8_t> internal_stream;
+  std::vector<uint8_t> external_stream;
+  EncoderFrameBuffers frame_buffers;
+  int releases_before_destroy = 0;
+  ASSERT_NO_FATAL_FAILURE(
+      EncodeWithResolutionSwitch(nullptr, &internal_stream, nullptr));
+  ASSERT_NO_FATAL_FAILURE(EncodeWithResolutionSwitch(
+      &frame_buffers, &external_stream, &releases_before_destroy));
+  EXPECT_FALSE(internal_stream.empty());
+  EXPECT_EQ(internal_stream, external_stream);
+  EXPECT_FALSE(frame_buffers.buffers.empty());
+  // The buffers of the smaller frames are exchanged for larger ones.
+  EXPECT_GT(releases_before_destroy, 0);
+  // Every buffer is released exactly once.
+  for (int count : frame_buffers.releases) EXPECT_EQ(count, 1);
+}
+
+TEST(EncodeAPI, ExternalFrameBuffersInvalidParam) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, kUsage), AOM_CODEC_OK);
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  aom_frame_buffer_functions_t fns = { EncoderFrameBuffers::Get, nullptr,
+                                       nullptr };
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_FRAME_BUFFER_FUNCTIONS, &fns),
+            AOM_CODEC_INVALID_PARAM);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+// Encodes frames large enough for the frame buffers to be placed in huge
+// pages when 'huge_pages' asks for them.
+void EncodeWithHugePages(int huge_pages, std::vector<uint8_t> *stream) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 1280;
+  cfg.g_h = 720;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_HUGE_PAGES, huge_pages),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  for (int frame = 0; frame < 3; ++frame) {
+    FillImage(image, static_cast<uint8_t>(96 + 8 * frame));
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      stream->insert(stream->end(), buf, buf + pkt->data.frame.sz);
+    }
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+TEST(EncodeAPI, HugePages) {
+  std::vector<uint8_t> reference_stream;
+  ASSERT_NO_FATAL_FAILURE(EncodeWithHugePages(0, &reference_stream));
+  EXPECT_FALSE(reference_stream.empty());
+  // Huge pages only change where the buffers live, not the output.
+  for (int huge_pages = 1; huge_pages <= 2; ++huge_pages) {
+    std::vector<uint8_t> stream;
+    ASSERT_NO_FATAL_FAILURE(EncodeWithHugePages(huge_pages, &stream));
+    EXPECT_EQ(stream, reference_stream) << "huge_pages=" << huge_pages;
+  }
+}
+
+TEST(EncodeAPI, HugePagesInvalidParam) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, kUsage), AOM_CODEC_OK);
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_HUGE_PAGES, -1),
+            AOM_CODEC_INVALID_PARAM);
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_SET_HUGE_PAGES, 3),
+            AOM_CODEC_INVALID_PARAM);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+// Encodes frames split into 2 tile groups and returns the output packets of
+// each temporal unit.
+void EncodeTileGroups(bool tile_group_output,
+                      std::vector<std::vector<aom_codec_cx_pkt_t>> *units,
+                      std::vector<std::vector<uint8_t>> *unit_data) {
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_REALTIME),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 10), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_TILE_COLUMNS, 1), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_TILE_ROWS, 1), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_NUM_TG, 2), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AV1E_SET_TILE_GROUP_OUTPUT,
+                              tile_group_output ? 1u : 0u),
+            AOM_CODEC_OK);
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+  for (int frame = 0; frame < 4; ++frame) {
+    FillImageRandom(image);
+    ASSERT_EQ(aom_codec_encode(&enc, image, frame, 1, 0), AOM_CODEC_OK);
+    std::vector<aom_codec_cx_pkt_t> pkts;
+    std::vector<uint8_t> data;
+    aom_codec_iter_t iter = nullptr;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      pkts.push_back(*pkt);
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      data.insert(data.end(), buf, buf + pkt->data.frame.sz);
+    }
+    units->push_back(pkts);
+    unit_data->push_back(data);
+  }
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+
+TEST(EncodeAPI, TileGroupOutput) {
+  std::vector<std::vector<aom_codec_cx_pkt_t>> units;
+  std::vector<std::vector<uint8_t>> unit_data;
+  std::vector<std::vector<aom_codec_cx_pkt_t>> tg_units;
+  std::vector<std::vector<uint8_t>> tg_unit_data;
+  ASSERT_NO_FATAL_FAILURE(EncodeTileGroups(false, &units, &unit_data));
+  ASSERT_NO_FATAL_FAILURE(EncodeTileGroups(true, &tg_units, &tg_unit_data));
+  // The packets carry the same temporal units.
+  EXPECT_EQ(tg_unit_data, unit_data);
+  ASSERT_EQ(tg_units.size(), units.size());
+  for (size_t i = 0; i < tg_units.size(); ++i) {
+    ASSERT_EQ(units[i].size(), 1u);
+    // Frame header, then the 2 tile groups.
+    ASSERT_EQ(tg_units[i].size(), 3u);
+    size_t offset = 0;
+    for (size_t j = 0; j < tg_units[i].size(); ++j) {
+      const aom_codec_cx_pkt_t &pkt = tg_units[i][j];
+      EXPECT_EQ(pkt.data.frame.partition_id, static_cast<int>(j));
+      EXPECT_EQ(pkt.data.frame.pts, units[i][0].data.frame.pts);
+      const bool is_last = j + 1 == tg_units[i].size();
+      EXPECT_EQ(pkt.data.frame.flags,
+                units[i][0].data.frame.flags |
+                    (is_last ? 0 : AOM_FRAME_IS_FRAGMENT));
+      // The packet buffers are reused by later frames, so check the copy.
+      ASSERT_LT(offset, tg_unit_data[i].size());
+      if (j > 0) {
+        const uint8_t obu_type = (tg_unit_data[i][offset] >> 3) & 0xf;
+        EXPECT_EQ(obu_type, OBU_TILE_GROUP);
+      }
+      offset += pkt.data.frame.sz;
+    }
+  }
+}
+
+#if !CONFIG_REALTIME_ONLY
+TEST(EncodeAPI, FrameStageTimes) {
+  constexpr int kNumFrames = 12;
+  aom_codec_iface_t *iface = aom_codec_av1_cx();
+  aom_codec_enc_cfg_t cfg;
+  ASSERT_EQ(aom_codec_enc_config_default(iface, &cfg, AOM_USAGE_GOOD_QUALITY),
+            AOM_CODEC_OK);
+  cfg.g_w = 352;
+  cfg.g_h = 288;
+  cfg.g_threads = 1;
+  cfg.g_lag_in_frames = 8;
+
+  aom_codec_ctx_t enc;
+  ASSERT_EQ(aom_codec_enc_init(&enc, iface, &cfg, 0), AOM_CODEC_OK);
+  ASSERT_EQ(aom_codec_control(&enc, AOME_SET_CPUUSED, 4), AOM_CODEC_OK);
+  EXPECT_EQ(aom_codec_control(&enc, AV1E_GET_FRAME_STAGE_TIMES, nullptr),
+            AOM_CODEC_INVALID_PARAM);
+
+  aom_image_t *image =
+      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg.g_w, cfg.g_h, 1);
+  ASSERT_NE(image, nullptr);
+
+  int64_t total_us[AOM_ENC_STAGE_COUNT] = { 0 };
+  for (int frame = 0; frame <= kNumFrames; ++frame) {
+    // The last call flushes the encoder.
+    aom_image_t *const img = frame < kNumFrames ? image : nullptr;
+    if (img != nullptr) FillImageRandom(img);
+    ASSERT_EQ(aom_codec_encode(&enc, img, frame, 1, 0), AOM_CODEC_OK);
+    aom_codec_iter_t iter = nullptr;
+    while (aom_codec_get_cx_data(&enc, &iter) != nullptr) {
+    }
+    aom_frame_stage_times_t times;
+    ASSERT_EQ(aom_codec_control(&enc, AV1E_GET_FRAME_STAGE_TIMES, &times),
+              AOM_CODEC_OK);
+    for (int stage = 0; stage < AOM_ENC_STAGE_COUNT; ++stage) {
+      EXPECT_GE(times.stage_us[stage], 0);
+      total_us[stage] += times.stage_us[stage];
+    }
+    // These stages are timed on the calling thread within the encode call.
+    EXPECT_LE(times.stage_us[AOM_ENC_STAGE_TPL], times.encode_us);
+    EXPECT_LE(times.stage_us[AOM_ENC_STAGE_TEMPORAL_FILTER], times.encode_us);
+    EXPECT_LE(times.stage_us[AOM_ENC_STAGE_BITSTREAM_PACKING],
+              times.encode_us);
+  }
+  EXPECT_GT(total_us[AOM_ENC_STAGE_MOTION_SEARCH], 0);
+  EXPECT_GT(total_us[AOM_ENC_STAGE_RD_SEARCH], 0);
+  EXPECT_GT(total_us[AOM_ENC_STAGE_TPL], 0);
+  EXPECT_GT(total_us[AOM_ENC_STAGE_TEMPORAL_FILTER], 0);
+  EXPECT_GT(total_us[AOM_ENC_STAGE_BITSTREAM_PACKING], 0);
+
+  aom_img_free(image);
+  ASSERT_EQ(aom_codec_destroy(&enc), AOM_CODEC_OK);
+}
+#endif  // !CONFIG_REALTIME_ONLY
+
 }  // namespace
@@ -9,10 +9,20 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include "gtest/gtest.h"
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "aom/aom_codec.h"
+#include "aom/aomcx.h"
 #include "aom_ports/aom_timer.h"
 #include "test/codec_factory.h"
 #include "test/encode_test_driver.h"
@@ -53,13 +63,58 @@ const EncodePerfTestVideo kAV1EncodePerfTestVectors[] = {
 const int kEncodePerfTestSpeeds[] = { 5, 6, 7, 8 };
 const int kEncodePerfTestThreads[] = { 1, 2, 4 };
 
+// Counts the data TLB read misses of the calling thread and of the threads it
+// creates afterwards. Reports -1 where the counter is not available.
+class DtlbMissCounter {
+ public:
+  DtlbMissCounter() {
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  ~DtlbMissCounter() {
+#if defined(__linux__)
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+
+  int64_t Read() const {
+#if defined(__linux__)
+    uint64_t count;
+    if (fd_ >= 0 && read(fd_, &count, sizeof(count)) == sizeof(count)) {
+      return static_cast<int64_t>(count);
+    }
+#endif
+    return -1;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
 class AV1EncodePerfTest
     : public ::libaom_test::CodecTestWithParam<libaom_test::TestMode>,
       public ::libaom_test::EncoderTest {
  protected:
   AV1EncodePerfTest()
       : EncoderTest(GET_PARAM(0)), min_psnr_(kMaxPsnr), nframes_(0),
-        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1) {}
+        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1), huge_pages_(0) {}
 
   ~AV1EncodePerfTest() override = default;
 
@@ -88,6 +143,7 @@ class AV1EncodePerfTest
       encoder->Control(AV1E_SET_TILE_COLUMNS, log2_tile_columns);
       encoder->Control(AV1E_SET_FRAME_PARALLEL_DECODING, 1);
       encoder->Control(AOME_SET_ENABLEAUTOALTREF, 0);
+      encoder->Control(AV1E_SET_HUGE_PAGES, huge_pages_);
     }
   }
 
@@ -111,12 +167,15 @@ class AV1EncodePerfTest
 
   void set_threads(unsigned int threads) { threads_ = threads; }
 
+  void set_huge_pages(int huge_pages) { huge_pages_ = huge_pages; }
+
  private:
   double min_psnr_;
   unsigned int nframes_;
   libaom_test::TestMode encoding_mode_;
   unsigned speed_;
   unsigned int threads_;
+  int huge_pages_;
 };
 
 TEST_P(AV1EncodePerfTest, PerfTest) {
@@ -176,6 +235,57 @@ TEST_P(AV1EncodePerfTest, PerfTest) {
   }
 }
 
+// Compares the encoding time and the data TLB misses with the frame buffers in
+// regular pages and in huge pages (see AV1E_SET_HUGE_PAGES).
+TEST_P(AV1EncodePerfTest, HugePagesPerfTest) {
+  const int kSpeed = 7;
+  const int kThreads = 2;
+  for (const EncodePerfTestVideo &test_video : kAV1EncodePerfTestVectors) {
+    for (int huge_pages = 0; huge_pages <= 2; ++huge_pages) {
+      set_threads(kThreads);
+      SetUp();
+
+      const aom_rational timebase = { 33333333, 1000000000 };
+      cfg_.g_timebase = timebase;
+      cfg_.rc_target_bitrate = test_video.bitrate;
+
+      init_flags_ = AOM_CODEC_USE_PSNR;
+
+      const unsigned frames = test_video.frames;
+      const char *video_name = test_video.name;
+      libaom_test::I420VideoSource video(video_name, test_video.width,
+                                         test_video.height, timebase.den,
+                                         timebase.num, 0, test_video.frames);
+      set_speed(kSpeed);
+      set_huge_pages(huge_pages);
+
+      DtlbMissCounter dtlb_misses;
+      aom_usec_timer t;
+      aom_usec_timer_start(&t);
+
+      ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+      aom_usec_timer_mark(&t);
+      const int64_t misses = dtlb_misses.Read();
+      const double elapsed_secs = aom_usec_timer_elapsed(&t) / kUsecsInSec;
+
+      printf("{\n");
+      printf("\t\"type\" : \"encode_perf_test\",\n");
+      printf("\t\"version\" : \"%s\",\n", aom_codec_version_str());
+      printf("\t\"videoName\" : \"%s\",\n", video_name);
+      printf("\t\"encodeTimeSecs\" : %f,\n", elapsed_secs);
+      printf("\t\"totalFrames\" : %u,\n", frames);
+      printf("\t\"framesPerSecond\" : %f,\n", frames / elapsed_secs);
+      printf("\t\"minPsnr\" : %f,\n", min_psnr());
+      printf("\t\"speed\" : %d,\n", kSpeed);
+      printf("\t\"threads\" : %d,\n", kThreads);
+      printf("\t\"hugePages\" : %d,\n", huge_pages);
+      printf("\t\"dtlbReadMisses\" : %lld\n", static_cast<long long>(misses));
+      printf("}\n");
+    }
+  }
+}
+
 AV1_INSTANTIATE_TEST_SUITE(AV1EncodePerfTest,
                            ::testing::Values(::libaom_test::kRealTime));
 }  // namespace
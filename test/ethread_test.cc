@@ -221,7 +221,7 @@ class AVxEncoderThreadTest
       : EncoderTest(GET_PARAM(0)), encoder_initialized_(false),
         encoding_mode_(GET_PARAM(1)), set_cpu_used_(GET_PARAM(2)),
         tile_cols_(GET_PARAM(3)), tile_rows_(GET_PARAM(4)),
-        row_mt_(GET_PARAM(5)) {
+        row_mt_(GET_PARAM(5)), row_mt_sync_mode_(0) {
     init_flags_ = AOM_CODEC_USE_PSNR;
     aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
     cfg.w = 1280;
@@ -264,6 +264,7 @@ class AVxEncoderThreadTest
       SetTileSize(encoder);
       encoder->Control(AOME_SET_CPUUSED, set_cpu_used_);
       encoder->Control(AV1E_SET_ROW_MT, row_mt_);
+      encoder->Control(AV1E_SET_ROW_MT_SYNC_MODE, row_mt_sync_mode_);
       if (encoding_mode_ == ::libaom_test::kOnePassGood ||
           encoding_mode_ == ::libaom_test::kTwoPassGood) {
         encoder->Control(AOME_SET_ENABLEAUTOALTREF, 1);
@@ -445,6 +446,7 @@ class AVxEncoderThreadTest
   int tile_cols_;
   int tile_rows_;
   int row_mt_;
+  unsigned int row_mt_sync_mode_;
   ::libaom_test::Decoder *decoder_;
   std::vector<size_t> size_enc_;
   std::vector<std::string> md5_enc_;
@@ -488,6 +490,38 @@ AV1_INSTANTIATE_TEST_SUITE(AVxEncoderThreadTestLarge,
                            ::testing::Values(0, 1));
 #endif  // !defined(AOM_VALGRIND_BUILD)
 
+// The row synchronization mode must not change the encoder output.
+class AVxEncoderThreadRowSyncTest : public AVxEncoderThreadTest {};
+
+TEST_P(AVxEncoderThreadRowSyncTest, EncoderResultTest) {
+  ::libaom_test::YUVVideoSource video("niklas_640_480_30.yuv", AOM_IMG_FMT_I420,
+                                      640, 480, 30, 1, 15, 26);
+  cfg_.rc_target_bitrate = 1000;
+  cfg_.large_scale_tile = 0;
+  cfg_.g_threads = 4;
+  decoder_->Control(AV1_SET_TILE_MODE, 0);
+
+  row_mt_sync_mode_ = 0;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const std::vector<size_t> mutex_size_enc = size_enc_;
+  const std::vector<std::string> mutex_md5_enc = md5_enc_;
+  const std::vector<std::string> mutex_md5_dec = md5_dec_;
+  size_enc_.clear();
+  md5_enc_.clear();
+  md5_dec_.clear();
+
+  row_mt_sync_mode_ = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_EQ(mutex_size_enc, size_enc_);
+  ASSERT_EQ(mutex_md5_enc, md5_enc_);
+  ASSERT_EQ(mutex_md5_dec, md5_dec_);
+}
+
+AV1_INSTANTIATE_TEST_SUITE(AVxEncoderThreadRowSyncTest,
+                           ::testing::Values(::libaom_test::kTwoPassGood),
+                           ::testing::Values(3), ::testing::Values(0, 1),
+                           ::testing::Values(0), ::testing::Values(1));
+
 TEST_P(AVxEncoderThreadTest, EncoderResultTest) {
   cfg_.large_scale_tile = 0;
   decoder_->Control(AV1_SET_TILE_MODE, 0);
@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "config/aom_config.h"
+#include "config/av1_rtcd.h"
+
+#include "aom/aom_image.h"
+#include "aom_dsp/grain_params.h"
+#include "aom_ports/aom_timer.h"
+#include "aom_util/aom_thread.h"
+#include "av1/decoder/grain_synthesis.h"
+#include "test/acm_random.h"
+#include "test/util.h"
+
+namespace {
+
+using libaom_test::ACMRandom;
+
+using AddLumaGrainFunc = void (*)(uint8_t *luma, int luma_stride,
+                                  const int *grain, int grain_stride,
+                                  int width, int height,
+                                  const int *scaling_lut, int scaling_shift,
+                                  int min_value, int max_value);
+using AddChromaGrainFunc = void (*)(
+    uint8_t *chroma, int chroma_stride, const uint8_t *luma, int luma_stride,
+    const int *grain, int grain_stride, int width, int height,
+    int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut,
+    int luma_mult, int chroma_mult, int offset, int scaling_shift,
+    int min_value, int max_value);
+using HighbdAddLumaGrainFunc = void (*)(uint16_t *luma, int luma_stride,
+                                        const int *grain, int grain_stride,
+                                        int width, int height,
+                                        const int *scaling_lut,
+                                        int scaling_shift, int min_value,
+                                        int max_value, int bit_depth);
+using HighbdAddChromaGrainFunc = void (*)(
+    uint16_t *chroma, int chroma_stride, const uint16_t *luma,
+    int luma_stride, const int *grain, int grain_stride, int width, int height,
+    int chroma_subsamp_x, int chroma_subsamp_y, const int *scaling_lut,
+    int luma_mult, int chroma_mult, int offset, int scaling_shift,
+    int min_value, int max_value, int bit_depth);
+
+struct GrainKernels {
+  AddLumaGrainFunc luma;
+  AddChromaGrainFunc chroma;
+  HighbdAddLumaGrainFunc highbd_luma;
+  HighbdAddChromaGrainFunc highbd_chroma;
+};
+
+// Largest block the kernels are called on by add_noise_to_block().
+constexpr int kMaxWidth = 64 + 3;
+constexpr int kMaxHeight = 64;
+constexpr int kStride = 2 * kMaxWidth + 5;
+constexpr int kGrainStride = kMaxWidth + 7;
+
+class GrainKernelTest : public ::testing::TestWithParam<GrainKernels> {
+ protected:
+  void SetUp() override {
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+    luma_.resize(2 * kMaxHeight * kStride);
+    ref_.resize(kMaxHeight * kStride);
+    out_.resize(kMaxHeight * kStride);
+    grain_.resize(kMaxHeight * kGrainStride);
+  }
+
+  // Fills the buffers with random samples of 'bit_depth' bits and a random
+  // scaling function, grain and scaling shift.
+  void FillRandom(int bit_depth) {
+    const int max_value = (1 << bit_depth) - 1;
+    for (uint16_t &v : luma_) v = rnd_.Rand16() & max_value;
+    for (uint16_t &v : ref_) v = rnd_.Rand16() & max_value;
+    out_ = ref_;
+    const int grain_max = 128 << (bit_depth - 8);
+    for (int &v : grain_) {
+      v = rnd_.PseudoUniform(2 * grain_max) - grain_max;
+    }
+    for (int &v : scaling_lut_) v = rnd_.Rand8();
+    scaling_shift_ = 8 + rnd_.PseudoUniform(4);
+  }
+
+  void CheckEqual(int width, int height) const {
+    for (int i = 0; i < height; ++i) {
+      for (int j = 0; j < width; ++j) {
+        ASSERT_EQ(ref_[i * kStride + j], out_[i * kStride + j])
+            << "at (" << i << ", " << j << ") " << width << "x" << height;
+      }
+    }
+  }
+
+  ACMRandom rnd_;
+  std::vector<uint16_t> luma_;
+  std::vector<uint16_t> ref_;
+  std::vector<uint16_t> out_;
+  std::vector<int> grain_;
+  int scaling_lut_[256];
+  int scaling_shift_;
+};
+
+TEST_P(GrainKernelTest, Luma) {
+  std::vector<uint8_t> ref8(ref_.size()), out8(out_.size());
+  for (int iter = 0; iter < 200; ++iter) {
+    FillRandom(8);
+    const int width = 1 + rnd_.PseudoUniform(kMaxWidth);
+    const int height = 1 + rnd_.PseudoUniform(kMaxHeight);
+    const int min_value = rnd_.PseudoUniform(2) ? 16 : 0;
+    const int max_value = min_value ? 235 : 255;
+    for (size_t i = 0; i < ref_.size(); ++i) ref8[i] = ref_[i] & 0xff;
+    out8 = ref8;
+    av1_add_luma_grain_c(ref8.data(), kStride, grain_.data(), kGrainStride,
+                         width, height, scaling_lut_, scaling_shift_,
+                         min_value, max_value);
+    GetParam().luma(out8.data(), kStride, grain_.data(), kGrainStride, width,
+                    height, scaling_lut_, scaling_shift_, min_value,
+                    max_value);
+    ASSERT_EQ(ref8, out8) << width << "x" << height;
+  }
+}
+
+TEST_P(GrainKernelTest, Chroma) {
+  std::vector<uint8_t> luma8(luma_.size());
+  std::vector<uint8_t> ref8(ref_.size()), out8(out_.size());
+  for (int iter = 0; iter < 200; ++iter) {
+    FillRandom(8);
+    const int width = 1 + rnd_.PseudoUniform(kMaxWidth);
+    const int height = 1 + rnd_.PseudoUniform(kMaxHeight);
+    const int ssx = rnd_.PseudoUniform(2);
+    const int ssy = ssx ? rnd_.PseudoUniform(2) : 0;
+    const int luma_mult = rnd_.PseudoUniform(256) - 128;
+    const int chroma_mult = rnd_.PseudoUniform(256) - 128;
+    const int offset = rnd_.PseudoUniform(512) - 256;
+    for (size_t i = 0; i < luma_.size(); ++i) luma8[i] = luma_[i] & 0xff;
+    for (size_t i = 0; i < ref_.size(); ++i) ref8[i] = ref_[i] & 0xff;
+    out8 = ref8;
+    av1_add_chroma_grain_c(ref8.data(), kStride, luma8.data(), kStride,
+                           grain_.data(), kGrainStride, width, height, ssx,
+                           ssy, scaling_lut_, luma_mult, chroma_mult, offset,
+                           scaling_shift_, 0, 255);
+    GetParam().chroma(out8.data(), kStride, luma8.data(), kStride,
+                      grain_.data(), kGrainStride, width, height, ssx, ssy,
+                      scaling_lut_, luma_mult, chroma_mult, offset,
+                      scaling_shift_, 0, 255);
+    ASSERT_EQ(ref8, out8) << width << "x" << height << " ssx " << ssx
+                          << " ssy " << ssy;
+  }
+}
+
+TEST_P(GrainKernelTest, HighbdLuma) {
+  for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+    for (int iter = 0; iter < 100; ++iter) {
+      FillRandom(bit_depth);
+      const int width = 1 + rnd_.PseudoUniform(kMaxWidth);
+      const int height = 1 + rnd_.PseudoUniform(kMaxHeight);
+      const int max_value = (1 << bit_depth) - 1;
+      av1_highbd_add_luma_grain_c(ref_.data(), kStride, grain_.data(),
+                                  kGrainStride, width, height, scaling_lut_,
+                                  scaling_shift_, 0, max_value, bit_depth);
+      GetParam().highbd_luma(out_.data(), kStride, grain_.data(),
+                             kGrainStride, width, height, scaling_lut_,
+                             scaling_shift_, 0, max_value, bit_depth);
+      ASSERT_NO_FATAL_FAILURE(CheckEqual(width, height))
+          << "bit_depth " << bit_depth;
+    }
+  }
+}
+
+TEST_P(GrainKernelTest, HighbdChroma) {
+  for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+    for (int iter = 0; iter < 100; ++iter) {
+      FillRandom(bit_depth);
+      const int width = 1 + rnd_.PseudoUniform(kMaxWidth);
+      const int height = 1 + rnd_.PseudoUniform(kMaxHeight);
+      const int ssx = rnd_.PseudoUniform(2);
+      const int ssy = ssx ? rnd_.PseudoUniform(2) : 0;
+      const int luma_mult = rnd_.PseudoUniform(256) - 128;
+      const int chroma_mult = rnd_.PseudoUniform(256) - 128;
+      const int offset = (rnd_.PseudoUniform(512) - 256)
+                         << (bit_depth - 8);
+      const int max_value = (1 << bit_depth) - 1;
+      av1_highbd_add_chroma_grain_c(
+          ref_.data(), kStride, luma_.data(), kStride, grain_.data(),
+          kGrainStride, width, height, ssx, ssy, scaling_lut_, luma_mult,
+          chroma_mult, offset, scaling_shift_, 0, max_value, bit_depth);
+      GetParam().highbd_chroma(out_.data(), kStride, luma_.data(), kStride,
+                               grain_.data(), kGrainStride, width, height, ssx,
+                               ssy, scaling_lut_, luma_mult, chroma_mult,
+                               offset, scaling_shift_, 0, max_value,
+                               bit_depth);
+      ASSERT_NO_FATAL_FAILURE(CheckEqual(width, height))
+          << "bit_depth " << bit_depth << " ssx " << ssx << " ssy " << ssy;
+    }
+  }
+}
+
+TEST_P(GrainKernelTest, DISABLED_Speed) {
+  FillRandom(8);
+  std::vector<uint8_t> luma8(luma_.size());
+  std::vector<uint8_t> out8(out_.size());
+  for (size_t i = 0; i < luma_.size(); ++i) luma8[i] = luma_[i] & 0xff;
+  for (size_t i = 0; i < out_.size(); ++i) out8[i] = out_[i] & 0xff;
+  const int kIters = 100000;
+  const AddLumaGrainFunc funcs[2] = { av1_add_luma_grain_c, GetParam().luma };
+  const AddChromaGrainFunc chroma_funcs[2] = { av1_add_chroma_grain_c,
+                                               GetParam().chroma };
+  double elapsed[2];
+  for (int f = 0; f < 2; ++f) {
+    aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    for (int i = 0; i < kIters; ++i) {
+      funcs[f](out8.data(), kStride, grain_.data(), kGrainStride, 32, 32,
+               scaling_lut_, scaling_shift_, 0, 255);
+      chroma_funcs[f](out8.data(), kStride, luma8.data(), kStride,
+                      grain_.data(), kGrainStride, 16, 16, 1, 1, scaling_lut_,
+                      -64, 96, 128, scaling_shift_, 0, 255);
+    }
+    aom_usec_timer_mark(&timer);
+    elapsed[f] = static_cast<double>(aom_usec_timer_elapsed(&timer));
+  }
+  printf("c_time: %.0f us, simd_time: %.0f us, scaling: %4.2f\n", elapsed[0],
+         elapsed[1], elapsed[0] / elapsed[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(C, GrainKernelTest,
+                         ::testing::Values(GrainKernels{
+                             av1_add_luma_grain_c, av1_add_chroma_grain_c,
+                             av1_highbd_add_luma_grain_c,
+                             av1_highbd_add_chroma_grain_c }));
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(AVX2, GrainKernelTest,
+                         ::testing::Values(GrainKernels{
+                             av1_add_luma_grain_avx2,
+                             av1_add_chroma_grain_avx2,
+                             av1_highbd_add_luma_grain_avx2,
+                             av1_highbd_add_chroma_grain_avx2 }));
+#endif  // HAVE_AVX2
+
+struct GrainFrameParam {
+  aom_img_fmt_t fmt;
+  int bit_depth;
+  int width;
+  int height;
+  int overlap;
+};
+
+std::ostream &operator<<(std::ostream &os, const GrainFrameParam &p) {
+  return os << "fmt " << p.fmt << " bit_depth " << p.bit_depth << " "
+            << p.width << "x" << p.height << " overlap " << p.overlap;
+}
+
+// Checks that splitting the rows of a frame between workers, and adding the
+// grain in place, give the same image as av1_add_film_grain().
+class GrainSynthesisMTTest : public ::testing::TestWithParam<GrainFrameParam> {
+ protected:
+  static constexpr int kNumWorkers = 4;
+
+  void SetUp() override {
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (AVxWorker &worker : workers_) {
+      winterface->init(&worker);
+      ASSERT_TRUE(winterface->reset(&worker));
+    }
+  }
+
+  void TearDown() override {
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (AVxWorker &worker : workers_) winterface->end(&worker);
+  }
+
+  AVxWorker workers_[kNumWorkers];
+};
+
+aom_film_grain_t MakeGrainParams(ACMRandom *rnd, int bit_depth, int overlap) {
+  aom_film_grain_t params = {};
+  params.apply_grain = 1;
+  params.update_parameters = 1;
+  params.num_y_points = 2;
+  params.scaling_points_y[0][0] = 0;
+  params.scaling_points_y[0][1] = 20 + rnd->PseudoUniform(100);
+  params.scaling_points_y[1][0] = 255;
+  params.scaling_points_y[1][1] = 20 + rnd->PseudoUniform(100);
+  params.num_cb_points = 2;
+  params.scaling_points_cb[0][0] = 0;
+  params.scaling_points_cb[0][1] = 20 + rnd->PseudoUniform(100);
+  params.scaling_points_cb[1][0] = 255;
+  params.scaling_points_cb[1][1] = 20 + rnd->PseudoUniform(100);
+  params.num_cr_points = 1;
+  params.scaling_points_cr[0][0] = 128;
+  params.scaling_points_cr[0][1] = 20 + rnd->PseudoUniform(100);
+  params.scaling_shift = 8 + rnd->PseudoUniform(4);
+  params.ar_coeff_lag = 2;
+  for (int i = 0; i < 24; ++i) {
+    params.ar_coeffs_y[i] = rnd->PseudoUniform(32) - 16;
+  }
+  for (int i = 0; i < 25; ++i) {
+    params.ar_coeffs_cb[i] = rnd->PseudoUniform(32) - 16;
+    params.ar_coeffs_cr[i] = rnd->PseudoUniform(32) - 16;
+  }
+  params.ar_coeff_shift = 7;
+  params.grain_scale_shift = 0;
+  params.overlap_flag = overlap;
+  params.clip_to_restricted_range = rnd->PseudoUniform(2);
+  params.bit_depth = bit_depth;
+  params.random_seed = rnd->Rand16();
+  params.cb_mult = 128 + rnd->PseudoUniform(64);
+  params.cb_luma_mult = 128 + rnd->PseudoUniform(64);
+  params.cb_offset = 256;
+  params.cr_mult = 128 + rnd->PseudoUniform(64);
+  params.cr_luma_mult = 128 + rnd->PseudoUniform(64);
+  params.cr_offset = 256;
+  return params;
+}
+
+// Copies the visible samples of src to dst, which must be at least as large.
+void CopyImage(const aom_image_t &src, aom_image_t *dst, int bps) {
+  dst->d_w = src.d_w;
+  dst->d_h = src.d_h;
+  dst->bit_depth = src.bit_depth;
+  dst->mc = src.mc;
+  for (int plane = 0; plane < 3; ++plane) {
+    const int h = aom_img_plane_height(&src, plane);
+    const int row_bytes = aom_img_plane_width(&src, plane) * bps;
+    for (int y = 0; y < h; ++y) {
+      memcpy(dst->planes[plane] + y * dst->stride[plane],
+             src.planes[plane] + y * src.stride[plane], row_bytes);
+    }
+  }
+}
+
+void CheckSameImage(const aom_image_t &ref, const aom_image_t &out, int bps) {
+  for (int plane = 0; plane < 3; ++plane) {
+    const int h = aom_img_plane_height(&ref, plane);
+    const int row_bytes = aom_img_plane_width(&ref, plane) * bps;
+    for (int y = 0; y < h; ++y) {
+      ASSERT_EQ(memcmp(ref.planes[plane] + y * ref.stride[plane],
+                       out.planes[plane] + y * out.stride[plane], row_bytes),
+                0)
+          << "plane " << plane << " row " << y;
+    }
+  }
+}
+
+TEST_P(GrainSynthesisMTTest, MatchesSingleThreaded) {
+  const GrainFrameParam &p = GetParam();
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int w_even = (p.width + 1) & ~1;
+  const int h_even = (p.height + 1) & ~1;
+
+  aom_image_t src;
+  ASSERT_NE(aom_img_alloc(&src, p.fmt, p.width, p.height, 32), nullptr);
+  src.bit_depth = p.bit_depth;
+  src.mc = AOM_CICP_MC_BT_709;
+  const int bps = (src.fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  for (int plane = 0; plane < 3; ++plane) {
+    const int h = aom_img_plane_height(&src, plane);
+    const int w = aom_img_plane_width(&src, plane);
+    for (int y = 0; y < h; ++y) {
+      uint8_t *const row = src.planes[plane] + y * src.stride[plane];
+      for (int x = 0; x < w; ++x) {
+        if (bps == 2) {
+          reinterpret_cast<uint16_t *>(row)[x] =
+              rnd.Rand16() & ((1 << p.bit_depth) - 1);
+        } else {
+          row[x] = rnd.Rand8();
+        }
+      }
+    }
+  }
+
+  aom_image_t ref, out, in_place;
+  ASSERT_NE(aom_img_alloc(&ref, p.fmt, w_even, h_even, 32), nullptr);
+  ASSERT_NE(aom_img_alloc(&out, p.fmt, w_even, h_even, 32), nullptr);
+  // The grain is also added in place to a copy of src that has room for the
+  // even dimensions, like the frame buffers of the decoder.
+  ASSERT_NE(aom_img_alloc(&in_place, p.fmt, w_even, h_even, 32), nullptr);
+
+  for (int iter = 0; iter < 4; ++iter) {
+    const aom_film_grain_t params =
+        MakeGrainParams(&rnd, p.bit_depth, p.overlap);
+    ASSERT_EQ(av1_add_film_grain(&params, &src, &ref), 0);
+    for (int num_workers = 1; num_workers <= kNumWorkers; ++num_workers) {
+      ASSERT_EQ(
+          av1_add_film_grain_mt(&params, &src, &out, workers_, num_workers),
+          0);
+      ASSERT_NO_FATAL_FAILURE(CheckSameImage(ref, out, bps))
+          << "workers " << num_workers;
+
+      CopyImage(src, &in_place, bps);
+      ASSERT_EQ(av1_add_film_grain_mt(&params, &in_place, &in_place, workers_,
+                                      num_workers),
+                0);
+      ASSERT_NO_FATAL_FAILURE(CheckSameImage(ref, in_place, bps))
+          << "in place, workers " << num_workers;
+    }
+  }
+
+  aom_img_free(&src);
+  aom_img_free(&ref);
+  aom_img_free(&out);
+  aom_img_free(&in_place);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AV1, GrainSynthesisMTTest,
+    ::testing::Values(GrainFrameParam{ AOM_IMG_FMT_I420, 8, 176, 144, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I420, 8, 175, 143, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I420, 8, 175, 143, 0 },
+                      GrainFrameParam{ AOM_IMG_FMT_I420, 8, 33, 17, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I444, 8, 97, 130, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I422, 8, 130, 97, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I42016, 10, 175, 143, 1 },
+                      GrainFrameParam{ AOM_IMG_FMT_I44416, 12, 66, 99, 0 }));
+
+}  // namespace
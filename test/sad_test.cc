@@ -404,6 +404,37 @@ class SADx3Test : public ::testing::WithParamInterface<SadMxNx4Param>,
   }
 };
 
+class SADx8Test : public ::testing::WithParamInterface<SadMxNx4Param>,
+                  public SADTestBase {
+ public:
+  SADx8Test() : SADTestBase(GET_PARAM(0), GET_PARAM(1), GET_PARAM(3)) {}
+
+ protected:
+  // Only 4 reference blocks are allocated, so the last 4 references repeat
+  // them in reverse order.
+  static int BlockIndex(int ref_idx) {
+    return ref_idx < 4 ? ref_idx : 7 - ref_idx;
+  }
+
+  void SADs(unsigned int *results) {
+    const uint8_t *references[8];
+    for (int i = 0; i < 8; ++i) references[i] = GetReference(BlockIndex(i));
+
+    API_REGISTER_STATE_CHECK(GET_PARAM(2)(
+        source_data_, source_stride_, references, reference_stride_, results));
+  }
+
+  void CheckSADs() {
+    unsigned int reference_sad, exp_sad[8];
+    SADs(exp_sad);
+    for (int i = 0; i < 8; ++i) {
+      reference_sad = ReferenceSAD(BlockIndex(i));
+
+      EXPECT_EQ(reference_sad, exp_sad[i]) << "reference " << i;
+    }
+  }
+};
+
 class SADSkipx4Test : public ::testing::WithParamInterface<SadMxNx4Param>,
                       public SADTestBase {
  public:
@@ -858,6 +889,55 @@ TEST_P(SADx3Test, DISABLED_Speed) {
   SpeedSAD();
 }
 
+// SADx8
+TEST_P(SADx8Test, MaxRef) {
+  FillConstant(source_data_, source_stride_, 0);
+  FillConstant(GetReference(0), reference_stride_, mask_);
+  FillConstant(GetReference(1), reference_stride_, mask_);
+  FillConstant(GetReference(2), reference_stride_, mask_);
+  FillConstant(GetReference(3), reference_stride_, mask_);
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, MaxSrc) {
+  FillConstant(source_data_, source_stride_, mask_);
+  FillConstant(GetReference(0), reference_stride_, 0);
+  FillConstant(GetReference(1), reference_stride_, 0);
+  FillConstant(GetReference(2), reference_stride_, 0);
+  FillConstant(GetReference(3), reference_stride_, 0);
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, UnalignedRef) {
+  // The reference frame, but not the source frame, may be unaligned for
+  // certain types of searches.
+  int tmp_stride = reference_stride_;
+  reference_stride_ -= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRandom(GetReference(0), reference_stride_);
+  FillRandom(GetReference(1), reference_stride_);
+  FillRandom(GetReference(2), reference_stride_);
+  FillRandom(GetReference(3), reference_stride_);
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8Test, ShortSrc) {
+  int tmp_stride = source_stride_;
+  source_stride_ >>= 1;
+  int test_count = 1000;
+  while (test_count > 0) {
+    FillRandom(source_data_, source_stride_);
+    FillRandom(GetReference(0), reference_stride_);
+    FillRandom(GetReference(1), reference_stride_);
+    FillRandom(GetReference(2), reference_stride_);
+    FillRandom(GetReference(3), reference_stride_);
+    CheckSADs();
+    test_count -= 1;
+  }
+  source_stride_ = tmp_stride;
+}
+
 // SADSkipx4
 TEST_P(SADSkipx4Test, MaxRef) {
   FillConstant(source_data_, source_stride_, 0);
@@ -1404,6 +1484,34 @@ const SadMxNx4Param x3d_c_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(C, SADx3Test, ::testing::ValuesIn(x3d_c_tests));
 
+const SadMxNx4Param x8d_c_tests[] = {
+  make_tuple(128, 128, &aom_sad128x128x8d_c, -1),
+  make_tuple(128, 64, &aom_sad128x64x8d_c, -1),
+  make_tuple(64, 128, &aom_sad64x128x8d_c, -1),
+  make_tuple(64, 64, &aom_sad64x64x8d_c, -1),
+  make_tuple(64, 32, &aom_sad64x32x8d_c, -1),
+  make_tuple(32, 64, &aom_sad32x64x8d_c, -1),
+  make_tuple(32, 32, &aom_sad32x32x8d_c, -1),
+  make_tuple(32, 16, &aom_sad32x16x8d_c, -1),
+  make_tuple(16, 32, &aom_sad16x32x8d_c, -1),
+  make_tuple(16, 16, &aom_sad16x16x8d_c, -1),
+  make_tuple(16, 8, &aom_sad16x8x8d_c, -1),
+  make_tuple(8, 16, &aom_sad8x16x8d_c, -1),
+  make_tuple(8, 8, &aom_sad8x8x8d_c, -1),
+  make_tuple(8, 4, &aom_sad8x4x8d_c, -1),
+  make_tuple(4, 8, &aom_sad4x8x8d_c, -1),
+  make_tuple(4, 4, &aom_sad4x4x8d_c, -1),
+#if !CONFIG_REALTIME_ONLY
+  make_tuple(64, 16, &aom_sad64x16x8d_c, -1),
+  make_tuple(16, 64, &aom_sad16x64x8d_c, -1),
+  make_tuple(32, 8, &aom_sad32x8x8d_c, -1),
+  make_tuple(8, 32, &aom_sad8x32x8d_c, -1),
+  make_tuple(16, 4, &aom_sad16x4x8d_c, -1),
+  make_tuple(4, 16, &aom_sad4x16x8d_c, -1),
+#endif  // !CONFIG_REALTIME_ONLY
+};
+INSTANTIATE_TEST_SUITE_P(C, SADx8Test, ::testing::ValuesIn(x8d_c_tests));
+
 const SadMxNx4Param skip_x4d_c_tests[] = {
   make_tuple(128, 128, &aom_sad_skip_128x128x4d_c, -1),
   make_tuple(128, 64, &aom_sad_skip_128x64x4d_c, -1),
@@ -2913,6 +3021,18 @@ const SadMxNx4Param x3d_avx2_tests[] = {
 #endif  // CONFIG_AV1_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADx3Test, ::testing::ValuesIn(x3d_avx2_tests));
+
+#if CONFIG_HIGHWAY
+const SadMxNx4Param x8d_avx2_tests[] = {
+  make_tuple(128, 128, &aom_sad128x128x8d_avx2, -1),
+  make_tuple(128, 64, &aom_sad128x64x8d_avx2, -1),
+  make_tuple(64, 128, &aom_sad64x128x8d_avx2, -1),
+  make_tuple(64, 64, &aom_sad64x64x8d_avx2, -1),
+  make_tuple(64, 32, &aom_sad64x32x8d_avx2, -1),
+};
+INSTANTIATE_TEST_SUITE_P(AVX2, SADx8Test,
+                         ::testing::ValuesIn(x8d_avx2_tests));
+#endif  // CONFIG_HIGHWAY
 #endif  // HAVE_AVX2
 
 #if CONFIG_HIGHWAY && HAVE_AVX512
@@ -2974,6 +3094,16 @@ const SadSkipMxNx4Param skip_x4d_avx512_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(AVX512, SADSkipx4Test,
                          ::testing::ValuesIn(skip_x4d_avx512_tests));
+
+const SadMxNx4Param x8d_avx512_tests[] = {
+  make_tuple(128, 128, &aom_sad128x128x8d_avx512, -1),
+  make_tuple(128, 64, &aom_sad128x64x8d_avx512, -1),
+  make_tuple(64, 128, &aom_sad64x128x8d_avx512, -1),
+  make_tuple(64, 64, &aom_sad64x64x8d_avx512, -1),
+  make_tuple(64, 32, &aom_sad64x32x8d_avx512, -1),
+};
+INSTANTIATE_TEST_SUITE_P(AVX512, SADx8Test,
+                         ::testing::ValuesIn(x8d_avx512_tests));
 #endif  // CONFIG_HIGHWAY && HAVE_AVX512
 
 }  // namespace
@@ -143,6 +143,7 @@ endif()
 if(NOT BUILD_SHARED_LIBS)
   list(APPEND AOM_UNIT_TEST_COMMON_SOURCES
               "${AOM_ROOT}/test/aom_mem_test.cc"
+              "${AOM_ROOT}/test/aom_thread_test.cc"
               "${AOM_ROOT}/test/av1_common_int_test.cc"
               "${AOM_ROOT}/test/av1_scale_test.cc"
               "${AOM_ROOT}/test/bitwriter_buffer_test.cc"
@@ -191,6 +192,9 @@ if(NOT BUILD_SHARED_LIBS)
     add_to_libaom_test_srcs(AOM_UNIT_TEST_COMMON_INTRIN_AVX2)
   endif()
 
+  list(APPEND AOM_UNIT_TEST_DECODER_SOURCES
+              "${AOM_ROOT}/test/grain_synthesis_test.cc")
+
   if(CONFIG_MULTITHREAD)
     list(APPEND AOM_UNIT_TEST_DECODER_SOURCES
                 "${AOM_ROOT}/test/grain_synthesis_race_test.cc")
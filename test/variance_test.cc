@@ -3055,6 +3055,129 @@ INSTANTIATE_TEST_SUITE_P(
                                 0)));
 #endif  // HAVE_AVX2
 
+#if HAVE_AVX512 && CONFIG_HIGHWAY
+const VarianceParams kArrayVariance_avx512[] = {
+  VarianceParams(7, 7, &aom_variance128x128_avx512),
+  VarianceParams(7, 6, &aom_variance128x64_avx512),
+  VarianceParams(6, 7, &aom_variance64x128_avx512),
+  VarianceParams(6, 6, &aom_variance64x64_avx512),
+  VarianceParams(6, 5, &aom_variance64x32_avx512),
+  VarianceParams(5, 6, &aom_variance32x64_avx512),
+  VarianceParams(5, 5, &aom_variance32x32_avx512),
+  VarianceParams(5, 4, &aom_variance32x16_avx512),
+  VarianceParams(4, 5, &aom_variance16x32_avx512),
+  VarianceParams(4, 4, &aom_variance16x16_avx512),
+  VarianceParams(4, 3, &aom_variance16x8_avx512),
+#if !CONFIG_REALTIME_ONLY
+  VarianceParams(4, 2, &aom_variance16x4_avx512),
+  VarianceParams(5, 3, &aom_variance32x8_avx512),
+  VarianceParams(4, 6, &aom_variance16x64_avx512),
+  VarianceParams(6, 4, &aom_variance64x16_avx512),
+#endif
+};
+INSTANTIATE_TEST_SUITE_P(AVX512, AvxVarianceTest,
+                         ::testing::ValuesIn(kArrayVariance_avx512));
+
+const SubpelVarianceParams kArraySubpelVariance_avx512[] = {
+  SubpelVarianceParams(7, 7, &aom_sub_pixel_variance128x128_avx512, 0),
+  SubpelVarianceParams(7, 6, &aom_sub_pixel_variance128x64_avx512, 0),
+  SubpelVarianceParams(6, 7, &aom_sub_pixel_variance64x128_avx512, 0),
+  SubpelVarianceParams(6, 6, &aom_sub_pixel_variance64x64_avx512, 0),
+  SubpelVarianceParams(6, 5, &aom_sub_pixel_variance64x32_avx512, 0),
+  SubpelVarianceParams(5, 6, &aom_sub_pixel_variance32x64_avx512, 0),
+  SubpelVarianceParams(5, 5, &aom_sub_pixel_variance32x32_avx512, 0),
+  SubpelVarianceParams(5, 4, &aom_sub_pixel_variance32x16_avx512, 0),
+  SubpelVarianceParams(4, 5, &aom_sub_pixel_variance16x32_avx512, 0),
+  SubpelVarianceParams(4, 4, &aom_sub_pixel_variance16x16_avx512, 0),
+  SubpelVarianceParams(4, 3, &aom_sub_pixel_variance16x8_avx512, 0),
+#if !CONFIG_REALTIME_ONLY
+  SubpelVarianceParams(4, 2, &aom_sub_pixel_variance16x4_avx512, 0),
+  SubpelVarianceParams(5, 3, &aom_sub_pixel_variance32x8_avx512, 0),
+  SubpelVarianceParams(4, 6, &aom_sub_pixel_variance16x64_avx512, 0),
+  SubpelVarianceParams(6, 4, &aom_sub_pixel_variance64x16_avx512, 0),
+#endif
+};
+INSTANTIATE_TEST_SUITE_P(AVX512, AvxSubpelVarianceTest,
+                         ::testing::ValuesIn(kArraySubpelVariance_avx512));
+
+const SubpelAvgVarianceParams kArraySubpelAvgVariance_avx512[] = {
+  SubpelAvgVarianceParams(7, 7, &aom_sub_pixel_avg_variance128x128_avx512, 0),
+  SubpelAvgVarianceParams(7, 6, &aom_sub_pixel_avg_variance128x64_avx512, 0),
+  SubpelAvgVarianceParams(6, 7, &aom_sub_pixel_avg_variance64x128_avx512, 0),
+  SubpelAvgVarianceParams(6, 6, &aom_sub_pixel_avg_variance64x64_avx512, 0),
+  SubpelAvgVarianceParams(6, 5, &aom_sub_pixel_avg_variance64x32_avx512, 0),
+  SubpelAvgVarianceParams(5, 6, &aom_sub_pixel_avg_variance32x64_avx512, 0),
+  SubpelAvgVarianceParams(5, 5, &aom_sub_pixel_avg_variance32x32_avx512, 0),
+  SubpelAvgVarianceParams(5, 4, &aom_sub_pixel_avg_variance32x16_avx512, 0),
+  SubpelAvgVarianceParams(4, 5, &aom_sub_pixel_avg_variance16x32_avx512, 0),
+  SubpelAvgVarianceParams(4, 4, &aom_sub_pixel_avg_variance16x16_avx512, 0),
+  SubpelAvgVarianceParams(4, 3, &aom_sub_pixel_avg_variance16x8_avx512, 0),
+#if !CONFIG_REALTIME_ONLY
+  SubpelAvgVarianceParams(4, 2, &aom_sub_pixel_avg_variance16x4_avx512, 0),
+  SubpelAvgVarianceParams(5, 3, &aom_sub_pixel_avg_variance32x8_avx512, 0),
+  SubpelAvgVarianceParams(4, 6, &aom_sub_pixel_avg_variance16x64_avx512, 0),
+  SubpelAvgVarianceParams(6, 4, &aom_sub_pixel_avg_variance64x16_avx512, 0),
+#endif
+};
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, AvxSubpelAvgVarianceTest,
+    ::testing::ValuesIn(kArraySubpelAvgVariance_avx512));
+
+#if CONFIG_AV1_HIGHBITDEPTH
+const VarianceParams kArrayHBDVariance_avx512[] = {
+  VarianceParams(7, 7, &aom_highbd_12_variance128x128_avx512, 12),
+  VarianceParams(7, 6, &aom_highbd_12_variance128x64_avx512, 12),
+  VarianceParams(6, 7, &aom_highbd_12_variance64x128_avx512, 12),
+  VarianceParams(6, 6, &aom_highbd_12_variance64x64_avx512, 12),
+  VarianceParams(6, 5, &aom_highbd_12_variance64x32_avx512, 12),
+  VarianceParams(5, 6, &aom_highbd_12_variance32x64_avx512, 12),
+  VarianceParams(5, 5, &aom_highbd_12_variance32x32_avx512, 12),
+  VarianceParams(5, 4, &aom_highbd_12_variance32x16_avx512, 12),
+  VarianceParams(4, 5, &aom_highbd_12_variance16x32_avx512, 12),
+  VarianceParams(4, 4, &aom_highbd_12_variance16x16_avx512, 12),
+  VarianceParams(4, 3, &aom_highbd_12_variance16x8_avx512, 12),
+  VarianceParams(7, 7, &aom_highbd_10_variance128x128_avx512, 10),
+  VarianceParams(7, 6, &aom_highbd_10_variance128x64_avx512, 10),
+  VarianceParams(6, 7, &aom_highbd_10_variance64x128_avx512, 10),
+  VarianceParams(6, 6, &aom_highbd_10_variance64x64_avx512, 10),
+  VarianceParams(6, 5, &aom_highbd_10_variance64x32_avx512, 10),
+  VarianceParams(5, 6, &aom_highbd_10_variance32x64_avx512, 10),
+  VarianceParams(5, 5, &aom_highbd_10_variance32x32_avx512, 10),
+  VarianceParams(5, 4, &aom_highbd_10_variance32x16_avx512, 10),
+  VarianceParams(4, 5, &aom_highbd_10_variance16x32_avx512, 10),
+  VarianceParams(4, 4, &aom_highbd_10_variance16x16_avx512, 10),
+  VarianceParams(4, 3, &aom_highbd_10_variance16x8_avx512, 10),
+  VarianceParams(7, 7, &aom_highbd_8_variance128x128_avx512, 8),
+  VarianceParams(7, 6, &aom_highbd_8_variance128x64_avx512, 8),
+  VarianceParams(6, 7, &aom_highbd_8_variance64x128_avx512, 8),
+  VarianceParams(6, 6, &aom_highbd_8_variance64x64_avx512, 8),
+  VarianceParams(6, 5, &aom_highbd_8_variance64x32_avx512, 8),
+  VarianceParams(5, 6, &aom_highbd_8_variance32x64_avx512, 8),
+  VarianceParams(5, 5, &aom_highbd_8_variance32x32_avx512, 8),
+  VarianceParams(5, 4, &aom_highbd_8_variance32x16_avx512, 8),
+  VarianceParams(4, 5, &aom_highbd_8_variance16x32_avx512, 8),
+  VarianceParams(4, 4, &aom_highbd_8_variance16x16_avx512, 8),
+  VarianceParams(4, 3, &aom_highbd_8_variance16x8_avx512, 8),
+#if !CONFIG_REALTIME_ONLY
+  VarianceParams(4, 2, &aom_highbd_12_variance16x4_avx512, 12),
+  VarianceParams(5, 3, &aom_highbd_12_variance32x8_avx512, 12),
+  VarianceParams(4, 6, &aom_highbd_12_variance16x64_avx512, 12),
+  VarianceParams(6, 4, &aom_highbd_12_variance64x16_avx512, 12),
+  VarianceParams(4, 2, &aom_highbd_10_variance16x4_avx512, 10),
+  VarianceParams(5, 3, &aom_highbd_10_variance32x8_avx512, 10),
+  VarianceParams(4, 6, &aom_highbd_10_variance16x64_avx512, 10),
+  VarianceParams(6, 4, &aom_highbd_10_variance64x16_avx512, 10),
+  VarianceParams(4, 2, &aom_highbd_8_variance16x4_avx512, 8),
+  VarianceParams(5, 3, &aom_highbd_8_variance32x8_avx512, 8),
+  VarianceParams(4, 6, &aom_highbd_8_variance16x64_avx512, 8),
+  VarianceParams(6, 4, &aom_highbd_8_variance64x16_avx512, 8),
+#endif
+};
+INSTANTIATE_TEST_SUITE_P(AVX512, AvxHBDVarianceTest,
+                         ::testing::ValuesIn(kArrayHBDVariance_avx512));
+#endif  // CONFIG_AV1_HIGHBITDEPTH
+#endif  // HAVE_AVX512 && CONFIG_HIGHWAY
+
 #if HAVE_NEON
 INSTANTIATE_TEST_SUITE_P(
     NEON, MseWxHTest,